@@ -0,0 +1,573 @@
+/**
+ * \file
+ * \brief CborEncoder and CborDecoder classes header
+ *
+ * Encoder and decoder of CBOR (RFC 8949) which don't allocate any memory - encoder writes items through a writer
+ * (CborBufferWriter for contiguous buffer or CborChainWriter for chain of buffers, e.g. pbufs), decoder reads items
+ * directly from contiguous buffer and returns pointers to strings inside it. Only definite lengths are supported and
+ * encoder always uses the shortest form of each argument, so the output is deterministically encoded. All functions
+ * except these of CborChainWriter are constexpr, so fixed payloads can be encoded at compile time.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CBOR_HPP_
+#define CBOR_HPP_
+
+#include <algorithm>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+
+/// major type of CBOR item
+enum class CborType : uint8_t
+{
+	/// unsigned integer, value is the integer
+	unsignedInteger,
+	/// negative integer, value is (-1 - integer)
+	negativeInteger,
+	/// byte string, value is its length
+	byteString,
+	/// text string, value is its length
+	textString,
+	/// array, value is the number of items
+	array,
+	/// map, value is the number of pairs of items
+	map,
+	/// tag, value is the tag number, tagged item follows
+	tag,
+	/// simple value (false - 20, true - 21, null - 22, undefined - 23, other values), value is its number
+	simple,
+	/// floating-point number, value has its raw bits (half, single or double precision)
+	floatingPoint,
+};
+
+/// CBOR item returned by CborDecoder
+struct CborItem
+{
+	/// pointer to contents of string, valid only for CborType::byteString and CborType::textString
+	const uint8_t* data;
+
+	/// value of item, its meaning depends on \a type
+	uint64_t value;
+
+	/// major type of item
+	CborType type;
+};
+
+/**
+ * \brief CborBufferWriter class writes encoded bytes to contiguous buffer.
+ */
+
+class CborBufferWriter
+{
+public:
+
+	/**
+	 * \brief CborBufferWriter's constructor
+	 *
+	 * \param [out] buffer is a pointer to buffer
+	 * \param [in] size is the size of \a buffer, bytes
+	 */
+
+	constexpr CborBufferWriter(uint8_t* const buffer, const size_t size) :
+			buffer_{buffer},
+			size_{size},
+			length_{}
+	{
+
+	}
+
+	/**
+	 * \return number of bytes written to buffer
+	 */
+
+	constexpr size_t getLength() const
+	{
+		return length_;
+	}
+
+	/**
+	 * \brief Writes bytes to buffer.
+	 *
+	 * Nothing is written if there's not enough space in buffer for all bytes.
+	 *
+	 * \tparam T is the type of written bytes, uint8_t or char
+	 *
+	 * \param [in] data is a pointer to written bytes
+	 * \param [in] length is the number of bytes at \a data
+	 *
+	 * \return true if bytes were written, false if there was not enough space in buffer
+	 */
+
+	template<typename T>
+	constexpr bool write(const T* const data, const size_t length)
+	{
+		if (length > size_ - length_)
+			return false;
+
+		for (size_t i {}; i < length; ++i)
+			buffer_[length_ + i] = static_cast<uint8_t>(data[i]);
+		length_ += length;
+		return true;
+	}
+
+private:
+
+	/// pointer to buffer
+	uint8_t* buffer_;
+
+	/// size of buffer, bytes
+	size_t size_;
+
+	/// number of bytes written to buffer
+	size_t length_;
+};
+
+/**
+ * \brief CborChainWriter class writes encoded bytes to a chain of buffers, e.g. pbufs.
+ *
+ * Each buffer is filled completely before the next one is used, so an item may be split between buffers.
+ *
+ * \tparam Node is the type of element of chain, must have \a payload (pointer to buffer), \a len (size of buffer) and
+ * \a next (pointer to next element) members
+ */
+
+template<typename Node>
+class CborChainWriter
+{
+public:
+
+	/**
+	 * \brief CborChainWriter's constructor
+	 *
+	 * \param [in] head is a reference to the first element of chain
+	 */
+
+	explicit CborChainWriter(Node& head) :
+			node_{&head},
+			offset_{},
+			length_{}
+	{
+
+	}
+
+	/**
+	 * \return number of bytes written to chain
+	 */
+
+	size_t getLength() const
+	{
+		return length_;
+	}
+
+	/**
+	 * \brief Writes bytes to chain.
+	 *
+	 * \tparam T is the type of written bytes, uint8_t or char
+	 *
+	 * \param [in] data is a pointer to written bytes
+	 * \param [in] length is the number of bytes at \a data
+	 *
+	 * \return true if bytes were written, false if there was not enough space in chain (bytes which fit were written)
+	 */
+
+	template<typename T>
+	bool write(const T* const data, const size_t length)
+	{
+		size_t written {};
+		while (written < length)
+		{
+			if (node_ == nullptr)
+				return false;
+
+			const size_t available = node_->len - offset_;
+			if (available == 0)
+			{
+				node_ = node_->next;
+				offset_ = {};
+				continue;
+			}
+
+			const auto chunk = std::min(available, length - written);
+			const auto output = static_cast<uint8_t*>(node_->payload) + offset_;
+			for (size_t i {}; i < chunk; ++i)
+				output[i] = static_cast<uint8_t>(data[written + i]);
+			written += chunk;
+			offset_ += chunk;
+			length_ += chunk;
+		}
+
+		return true;
+	}
+
+private:
+
+	/// pointer to current element of chain, nullptr if the end of chain was reached
+	Node* node_;
+
+	/// offset of next byte in current element of chain
+	size_t offset_;
+
+	/// number of bytes written to chain
+	size_t length_;
+};
+
+/**
+ * \brief CborEncoder class encodes CBOR items.
+ *
+ * Errors are sticky - after the first item which didn't fit in the output, nothing else is written and isValid()
+ * returns false, so a whole message can be encoded without checking each item.
+ *
+ * \tparam Writer is the type of writer, CborBufferWriter or CborChainWriter
+ */
+
+template<typename Writer>
+class CborEncoder
+{
+public:
+
+	/**
+	 * \brief CborEncoder's constructor
+	 *
+	 * \param [in] writer is a reference to writer used for output
+	 */
+
+	constexpr explicit CborEncoder(Writer& writer) :
+			writer_{writer},
+			valid_{true}
+	{
+
+	}
+
+	/**
+	 * \brief Encodes header of array.
+	 *
+	 * \param [in] count is the number of items in array, they must be encoded after the header
+	 */
+
+	constexpr void beginArray(const uint64_t count)
+	{
+		encodeHead(CborType::array, count);
+	}
+
+	/**
+	 * \brief Encodes header of map.
+	 *
+	 * \param [in] count is the number of pairs of items in map, keys and values must be encoded after the header
+	 */
+
+	constexpr void beginMap(const uint64_t count)
+	{
+		encodeHead(CborType::map, count);
+	}
+
+	/**
+	 * \param [in] value is the encoded boolean value
+	 */
+
+	constexpr void encodeBool(const bool value)
+	{
+		encodeHead(CborType::simple, value == true ? 21 : 20);
+	}
+
+	/**
+	 * \param [in] data is a pointer to encoded byte string
+	 * \param [in] length is the length of byte string, bytes
+	 */
+
+	constexpr void encodeBytes(const uint8_t* const data, const size_t length)
+	{
+		encodeHead(CborType::byteString, length);
+		write(data, length);
+	}
+
+	/**
+	 * \brief Encodes decimal fraction (tag 4), i.e. mantissa * 10^exponent.
+	 *
+	 * \param [in] mantissa is the mantissa
+	 * \param [in] exponent is the exponent
+	 */
+
+	constexpr void encodeDecimalFraction(const int64_t mantissa, const int64_t exponent)
+	{
+		encodeTag(4);
+		beginArray(2);
+		encodeSigned(exponent);
+		encodeSigned(mantissa);
+	}
+
+	/**
+	 * \brief Encodes null.
+	 */
+
+	constexpr void encodeNull()
+	{
+		encodeHead(CborType::simple, 22);
+	}
+
+	/**
+	 * \param [in] value is the encoded signed integer
+	 */
+
+	constexpr void encodeSigned(const int64_t value)
+	{
+		if (value >= 0)
+			encodeHead(CborType::unsignedInteger, value);
+		else
+			encodeHead(CborType::negativeInteger, -1 - value);
+	}
+
+	/**
+	 * \brief Encodes tag, tagged item must be encoded after it.
+	 *
+	 * \param [in] tag is the tag number
+	 */
+
+	constexpr void encodeTag(const uint64_t tag)
+	{
+		encodeHead(CborType::tag, tag);
+	}
+
+	/**
+	 * \param [in] text is a pointer to encoded text string, UTF-8
+	 * \param [in] length is the length of text string, bytes
+	 */
+
+	constexpr void encodeText(const char* const text, const size_t length)
+	{
+		encodeHead(CborType::textString, length);
+		write(text, length);
+	}
+
+	/**
+	 * \param [in] text is a pointer to encoded null-terminated text string, UTF-8
+	 */
+
+	constexpr void encodeText(const char* const text)
+	{
+		encodeText(text, std::char_traits<char>::length(text));
+	}
+
+	/**
+	 * \param [in] value is the encoded unsigned integer
+	 */
+
+	constexpr void encodeUnsigned(const uint64_t value)
+	{
+		encodeHead(CborType::unsignedInteger, value);
+	}
+
+	/**
+	 * \return true if all items were written, false if at least one item didn't fit in the output
+	 */
+
+	constexpr bool isValid() const
+	{
+		return valid_;
+	}
+
+private:
+
+	/**
+	 * \brief Encodes initial byte of item and its argument, in the shortest form.
+	 *
+	 * \param [in] type is the major type of item, CborType::floatingPoint is not allowed
+	 * \param [in] argument is the argument of item
+	 */
+
+	constexpr void encodeHead(const CborType type, const uint64_t argument)
+	{
+		const uint8_t major = static_cast<uint8_t>(type) << 5;
+		uint8_t head[9] {};
+		size_t length {1};
+		if (argument < 24)
+			head[0] = major | argument;
+		else
+		{
+			const size_t size {argument <= UINT8_MAX ? 1u : argument <= UINT16_MAX ? 2u : argument <= UINT32_MAX ?
+					4u : 8u};
+			head[0] = major | (size == 1 ? 24 : size == 2 ? 25 : size == 4 ? 26 : 27);
+			for (size_t i {}; i < size; ++i)
+				head[size - i] = argument >> (8 * i);
+			length += size;
+		}
+
+		write(head, length);
+	}
+
+	/**
+	 * \brief Writes bytes through writer, unless an earlier write failed.
+	 *
+	 * \tparam T is the type of written bytes, uint8_t or char
+	 *
+	 * \param [in] data is a pointer to written bytes
+	 * \param [in] length is the number of bytes at \a data
+	 */
+
+	template<typename T>
+	constexpr void write(const T* const data, const size_t length)
+	{
+		if (valid_ == true)
+			valid_ = writer_.write(data, length);
+	}
+
+	/// reference to writer used for output
+	Writer& writer_;
+
+	/// true if all items were written, false otherwise
+	bool valid_;
+};
+
+/**
+ * \brief CborDecoder class decodes CBOR items from contiguous buffer.
+ *
+ * Items are returned one by one, in the order of encoding - contents of arrays, maps and tags are returned as separate
+ * items after their header. Strings are not copied, CborItem::data points to their contents inside the buffer.
+ */
+
+class CborDecoder
+{
+public:
+
+	/**
+	 * \brief CborDecoder's constructor
+	 *
+	 * \param [in] data is a pointer to decoded buffer
+	 * \param [in] size is the size of \a data, bytes
+	 */
+
+	constexpr CborDecoder(const uint8_t* const data, const size_t size) :
+			data_{data},
+			size_{size},
+			position_{}
+	{
+
+	}
+
+	/**
+	 * \return number of bytes which were not decoded yet
+	 */
+
+	constexpr size_t getRemaining() const
+	{
+		return size_ - position_;
+	}
+
+	/**
+	 * \brief Decodes next item.
+	 *
+	 * \param [out] item is a reference to variable for decoded item, not modified if false is returned
+	 *
+	 * \return true if item was decoded, false if the end of buffer was reached or the item is malformed, truncated or
+	 * has indefinite length
+	 */
+
+	constexpr bool next(CborItem& item)
+	{
+		if (position_ >= size_)
+			return false;
+
+		const auto initial = data_[position_];
+		const auto major = static_cast<CborType>(initial >> 5);
+		const uint8_t additional = initial & 0x1f;
+		if (additional >= 28)	// reserved or indefinite length?
+			return false;
+
+		const size_t size {additional < 24 ? 0u : 1u << (additional - 24)};
+		if (size > size_ - position_ - 1)
+			return false;
+
+		uint64_t argument {additional < 24 ? additional : 0u};
+		for (size_t i {}; i < size; ++i)
+			argument = argument << 8 | data_[position_ + 1 + i];
+
+		auto type = major;
+		if (major == CborType::simple && additional >= 25)
+			type = CborType::floatingPoint;
+
+		const auto end = position_ + 1 + size;
+		if (type == CborType::byteString || type == CborType::textString)
+		{
+			if (argument > size_ - end)
+				return false;
+
+			item = {data_ + end, argument, type};
+			position_ = end + argument;
+			return true;
+		}
+
+		item = {{}, argument, type};
+		position_ = end;
+		return true;
+	}
+
+	/**
+	 * \brief Decodes next item, which must be an integer.
+	 *
+	 * \param [out] value is a reference to variable for decoded integer, not modified if false is returned
+	 *
+	 * \return true if an integer which fits in int64_t was decoded, false otherwise (decoder's position is not changed)
+	 */
+
+	constexpr bool nextSigned(int64_t& value)
+	{
+		const auto position = position_;
+		CborItem item {};
+		if (next(item) == false || item.value > INT64_MAX ||
+				(item.type != CborType::unsignedInteger && item.type != CborType::negativeInteger))
+		{
+			position_ = position;
+			return false;
+		}
+
+		value = item.type == CborType::unsignedInteger ? static_cast<int64_t>(item.value) :
+				-1 - static_cast<int64_t>(item.value);
+		return true;
+	}
+
+	/**
+	 * \brief Skips next item, including all items nested in it.
+	 *
+	 * \return true if item was skipped, false if it is malformed or truncated
+	 */
+
+	constexpr bool skip()
+	{
+		uint64_t pending {1};
+		while (pending != 0)
+		{
+			CborItem item {};
+			if (next(item) == false)
+				return false;
+
+			--pending;
+			if (item.type == CborType::array)
+				pending += item.value;
+			else if (item.type == CborType::map)
+				pending += 2 * item.value;
+			else if (item.type == CborType::tag)
+				++pending;
+		}
+
+		return true;
+	}
+
+private:
+
+	/// pointer to decoded buffer
+	const uint8_t* data_;
+
+	/// size of decoded buffer, bytes
+	size_t size_;
+
+	/// position of next item in buffer
+	size_t position_;
+};
+
+#endif	// CBOR_HPP_
@@ -0,0 +1,194 @@
+/**
+ * \file
+ * \brief DmaWatchdog class header
+ *
+ * Like copy loops in dmaFrameCopy.hpp, checks of descriptor rings are templates, so that they can be used both with
+ * descriptors of STM32 HAL and with their host equivalents in simulation. Descriptors must have Status member.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef DMAWATCHDOG_HPP_
+#define DMAWATCHDOG_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/// fault of Ethernet DMA which requires recovery
+enum class DmaFault : uint8_t
+{
+	/// fatal bus error, reported by "abnormal interrupt", DMA stops all bus accesses
+	fatalBusError,
+	/// DMA writes received frames to descriptors which are not the next one expected by the driver
+	rxStall,
+	/// DMA doesn't release transmit descriptors
+	txStall,
+
+	/// number of faults
+	count
+};
+
+/**
+ * \brief Checks whether receive ring is stuck.
+ *
+ * DMA releases descriptors in ring order, starting from the one which is the next to be read by the driver, so if that
+ * descriptor is still owned by DMA, all other descriptors should be too. Released descriptor anywhere else means that
+ * DMA and the driver lost synchronization and the driver will never see any received frame again.
+ *
+ * \tparam OwnBit is the bit in Status of descriptor which is set when the descriptor is owned by DMA
+ * \tparam Descriptor is the type of DMA descriptor
+ * \tparam Count is the number of descriptors in ring
+ *
+ * \param [in] descriptors is a reference to array with all descriptors of receive ring
+ * \param [in] next is a pointer to descriptor which is the next to be read by the driver
+ *
+ * \return true if receive ring is stuck, false otherwise
+ */
+
+template<uint32_t OwnBit, typename Descriptor, size_t Count>
+bool isRxRingStuck(const Descriptor (&descriptors)[Count], const Descriptor* const next)
+{
+	if ((next->Status & OwnBit) == 0)	// driver has a frame to read?
+		return false;
+
+	for (auto& descriptor : descriptors)
+		if ((descriptor.Status & OwnBit) == 0)
+			return true;
+
+	return false;
+}
+
+/**
+ * \brief Checks whether transmit ring is busy.
+ *
+ * \tparam OwnBit is the bit in Status of descriptor which is set when the descriptor is owned by DMA
+ * \tparam Descriptor is the type of DMA descriptor
+ * \tparam Count is the number of descriptors in ring
+ *
+ * \param [in] descriptors is a reference to array with all descriptors of transmit ring
+ *
+ * \return true if at least one descriptor of transmit ring is owned by DMA, false otherwise
+ */
+
+template<uint32_t OwnBit, typename Descriptor, size_t Count>
+bool isTxRingBusy(const Descriptor (&descriptors)[Count])
+{
+	for (auto& descriptor : descriptors)
+		if ((descriptor.Status & OwnBit) != 0)
+			return true;
+
+	return false;
+}
+
+/**
+ * \brief DmaWatchdog class detects stalls of descriptor rings of Ethernet DMA.
+ *
+ * check() should be called periodically, with period much longer than the time of transmission of the whole transmit
+ * ring at the lowest speed of the link (4 full-size frames at 10 Mbit/s take ~5 ms). Receive ring is reported as
+ * stalled when it is stuck in \a StallChecks consecutive checks. Transmit ring is reported as stalled when it is busy
+ * in \a StallChecks consecutive checks and no frame was passed to DMA since the check before the first of them - then
+ * all frames in the ring were passed to DMA at least \a StallChecks periods ago. Fatal bus errors are reported by
+ * interrupt, so they are not detected here.
+ *
+ * \tparam StallChecks is the number of consecutive checks in which a ring must look stalled
+ */
+
+template<size_t StallChecks>
+class DmaWatchdog
+{
+	static_assert(StallChecks != 0, "StallChecks must not be 0!");
+
+public:
+
+	/**
+	 * \brief DmaWatchdog's constructor
+	 */
+
+	constexpr DmaWatchdog() :
+			transmitted_{},
+			rxStuckChecks_{},
+			txBusyChecks_{},
+			failedRecovery_{DmaFault::count}
+	{
+
+	}
+
+	/**
+	 * \brief Checks health of descriptor rings.
+	 *
+	 * \param [in] rxStuck is the result of isRxRingStuck()
+	 * \param [in] txBusy is the result of isTxRingBusy()
+	 * \param [in] transmitted is the number of frames passed to DMA so far, may wrap around
+	 * \param [out] fault is the detected fault, not modified if rings are healthy
+	 *
+	 * \return true if a fault was detected or the last recovery failed (and recovery is required), false otherwise
+	 */
+
+	bool check(const bool rxStuck, const bool txBusy, const uint32_t transmitted, DmaFault& fault)
+	{
+		rxStuckChecks_ = rxStuck == true ? rxStuckChecks_ + 1 : 0;
+		txBusyChecks_ = txBusy == true && transmitted == transmitted_ ? txBusyChecks_ + 1 : 0;
+		transmitted_ = transmitted;
+
+		if (failedRecovery_ != DmaFault::count)
+		{
+			fault = failedRecovery_;
+			failedRecovery_ = DmaFault::count;
+		}
+		else if (rxStuckChecks_ >= StallChecks)
+			fault = DmaFault::rxStall;
+		else if (txBusyChecks_ >= StallChecks)
+			fault = DmaFault::txStall;
+		else
+			return false;
+
+		reset();
+		return true;
+	}
+
+	/**
+	 * \brief Reports recovery which failed, so that it is retried in the next check().
+	 *
+	 * \param [in] fault is the fault which caused failed recovery
+	 */
+
+	void reportFailedRecovery(const DmaFault fault)
+	{
+		failedRecovery_ = fault;
+	}
+
+	/**
+	 * \brief Resets the state of watchdog.
+	 *
+	 * Should be called after each recovery, also when recovery was requested by fatal bus error.
+	 */
+
+	void reset()
+	{
+		rxStuckChecks_ = {};
+		txBusyChecks_ = {};
+	}
+
+	DmaWatchdog(const DmaWatchdog&) = delete;
+	const DmaWatchdog& operator=(const DmaWatchdog&) = delete;
+
+private:
+
+	/// number of frames passed to DMA at the last check
+	uint32_t transmitted_;
+
+	/// number of consecutive checks in which receive ring was stuck
+	size_t rxStuckChecks_;
+
+	/// number of consecutive checks in which transmit ring was busy without any new frame
+	size_t txBusyChecks_;
+
+	/// fault which caused failed recovery, DmaFault::count if the last recovery didn't fail
+	DmaFault failedRecovery_;
+};
+
+#endif	// DMAWATCHDOG_HPP_
@@ -0,0 +1,137 @@
+/**
+ * \file
+ * \brief Log2Histogram class header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LOG2HISTOGRAM_HPP_
+#define LOG2HISTOGRAM_HPP_
+
+#include <algorithm>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief Log2Histogram class is a histogram with buckets which have logarithmic width.
+ *
+ * Bucket 0 counts values equal to 0, bucket i (i > 0) counts values in [2^(i - 1); 2^i) range. Last bucket also counts
+ * all values which are greater than its range. Adding a value has constant and short execution time, so the histogram
+ * may be used for latency measurements in hot paths.
+ *
+ * \tparam BucketCount is the number of buckets, [2; 33]
+ */
+
+template<size_t BucketCount>
+class Log2Histogram
+{
+	static_assert(BucketCount >= 2 && BucketCount <= 33, "Invalid number of buckets!");
+
+public:
+
+	/**
+	 * \brief Log2Histogram's constructor
+	 */
+
+	constexpr Log2Histogram() :
+			buckets_{},
+			sum_{},
+			count_{},
+			max_{}
+	{
+
+	}
+
+	/**
+	 * \brief Adds value to histogram.
+	 *
+	 * \param [in] value is the value which will be added
+	 */
+
+	void add(const uint32_t value)
+	{
+		++buckets_[getBucketIndex(value)];
+		sum_ += value;
+		++count_;
+		max_ = std::max(max_, value);
+	}
+
+	/**
+	 * \param [in] index is the index of bucket, [0; getBucketCount())
+	 *
+	 * \return number of values in selected bucket
+	 */
+
+	uint32_t getBucket(const size_t index) const
+	{
+		return buckets_[index];
+	}
+
+	/**
+	 * \return number of values in histogram
+	 */
+
+	uint32_t getCount() const
+	{
+		return count_;
+	}
+
+	/**
+	 * \return greatest value in histogram, 0 if histogram is empty
+	 */
+
+	uint32_t getMax() const
+	{
+		return max_;
+	}
+
+	/**
+	 * \return sum of all values in histogram
+	 */
+
+	uint64_t getSum() const
+	{
+		return sum_;
+	}
+
+	/**
+	 * \param [in] value is the value for which the bucket will be selected
+	 *
+	 * \return index of bucket which counts \a value
+	 */
+
+	constexpr static size_t getBucketIndex(const uint32_t value)
+	{
+		return std::min<size_t>(value == 0 ? 0 : 32 - __builtin_clz(value), BucketCount - 1);
+	}
+
+	/**
+	 * \return number of buckets
+	 */
+
+	constexpr static size_t getBucketCount()
+	{
+		return BucketCount;
+	}
+
+private:
+
+	/// buckets with number of values
+	uint32_t buckets_[BucketCount];
+
+	/// sum of all values
+	uint64_t sum_;
+
+	/// number of values
+	uint32_t count_;
+
+	/// greatest value
+	uint32_t max_;
+};
+
+#endif	// LOG2HISTOGRAM_HPP_
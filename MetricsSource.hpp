@@ -0,0 +1,145 @@
+/**
+ * \file
+ * \brief MetricsSource class header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef METRICSSOURCE_HPP_
+#define METRICSSOURCE_HPP_
+
+#include "Log2Histogram.hpp"
+
+/// type of metric family
+enum class MetricType : uint8_t
+{
+	/// value which only increases (or is reset to 0)
+	counter,
+	/// value which can go up and down
+	gauge,
+	/// histogram with buckets which have logarithmic width (see Log2Histogram)
+	histogram,
+};
+
+/// description of metric family
+struct MetricFamily
+{
+	/// name of family, e.g. "lwip_memory_used"
+	const char* name;
+
+	/// description of family
+	const char* help;
+
+	/// name of label which distinguishes series of family, nullptr if family has only one series
+	const char* label;
+
+	/// number of series in family
+	size_t seriesCount;
+
+	/// type of family
+	MetricType type;
+};
+
+/// one series of metric family
+struct MetricSeries
+{
+	/// value of label, ignored if family has no label
+	const char* labelValue;
+
+	/// value of counter or gauge, sum of all values of histogram
+	uint64_t value;
+
+	/// numbers of values in buckets of histogram (not cumulative), only for histograms
+	uint32_t buckets[33];
+
+	/// number of buckets of histogram, only for histograms
+	uint8_t bucketCount;
+};
+
+/**
+ * \brief MetricsSource class is an interface for sources of metrics exported in Prometheus text format.
+ *
+ * All functions are called in tcpip thread, so lwIP's core is locked.
+ */
+
+class MetricsSource
+{
+public:
+
+	/**
+	 * \param [in] index is the index of family, [0; getCount())
+	 *
+	 * \return description of selected family
+	 */
+
+	virtual MetricFamily getFamily(size_t index) const = 0;
+
+	/**
+	 * \param [in] family is the index of family, [0; getCount())
+	 * \param [in] index is the index of series, [0; MetricFamily::seriesCount)
+	 *
+	 * \return selected series of selected family
+	 */
+
+	virtual MetricSeries getSeries(size_t family, size_t index) const = 0;
+
+	/**
+	 * \return number of metric families in this source
+	 */
+
+	virtual size_t getCount() const = 0;
+
+protected:
+
+	/**
+	 * \brief MetricsSource's destructor
+	 */
+
+	~MetricsSource() = default;
+};
+
+/**
+ * \brief Makes series of counter or gauge.
+ *
+ * \param [in] labelValue is the value of label, nullptr if family has no label
+ * \param [in] value is the value of counter or gauge
+ *
+ * \return series of counter or gauge
+ */
+
+inline MetricSeries makeMetricSeries(const char* const labelValue, const uint64_t value)
+{
+	MetricSeries series {};
+	series.labelValue = labelValue;
+	series.value = value;
+	return series;
+}
+
+/**
+ * \brief Makes series of histogram.
+ *
+ * \tparam BucketCount is the number of buckets of histogram
+ *
+ * \param [in] labelValue is the value of label, nullptr if family has no label
+ * \param [in] histogram is a reference to histogram
+ *
+ * \return series of histogram
+ */
+
+template<size_t BucketCount>
+MetricSeries makeMetricSeries(const char* const labelValue, const Log2Histogram<BucketCount>& histogram)
+{
+	MetricSeries series {};
+	series.labelValue = labelValue;
+	series.value = histogram.getSum();
+	for (size_t i {}; i < BucketCount; ++i)
+		series.buckets[i] = histogram.getBucket(i);
+	series.bucketCount = BucketCount;
+	return series;
+}
+
+#endif	// METRICSSOURCE_HPP_
@@ -0,0 +1,103 @@
+/**
+ * \file
+ * \brief PacketCaptureFilter struct header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PACKETCAPTUREFILTER_HPP_
+#define PACKETCAPTUREFILTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/// direction of captured frame
+enum class PacketDirection : uint8_t
+{
+	/// received frame
+	receive = 1 << 0,
+	/// transmitted frame
+	transmit = 1 << 1,
+};
+
+/**
+ * \brief PacketCaptureFilter struct is a predicate which selects frames for capture.
+ *
+ * The predicate looks only at fixed offsets of Ethernet, IPv4 and TCP/UDP headers, so it is cheap enough to be
+ * evaluated for each frame in Ethernet driver. Fields with value 0 match any frame. Frames with TCP or UDP
+ * \a excludedPort (as source or destination port) are never selected, so the stream with captured frames doesn't
+ * capture itself.
+ */
+
+struct PacketCaptureFilter
+{
+	/**
+	 * \brief Checks whether frame should be captured.
+	 *
+	 * \param [in] frame is a pointer to frame (including MAC header)
+	 * \param [in] length is the length of frame, bytes
+	 * \param [in] direction is the direction of frame
+	 *
+	 * \return true if frame should be captured, false otherwise
+	 */
+
+	bool matches(const uint8_t* const frame, const size_t length, const PacketDirection direction) const
+	{
+		if ((directions & static_cast<uint8_t>(direction)) == 0)
+			return false;
+
+		constexpr size_t etherTypeOffset {12};
+		constexpr size_t ipv4Offset {14};
+		if (length < ipv4Offset)
+			return false;
+
+		const uint16_t frameEtherType = frame[etherTypeOffset] << 8 | frame[etherTypeOffset + 1];
+		if (etherType != 0 && frameEtherType != etherType)
+			return false;
+
+		const auto needsPorts = ipProtocol != 0 || port != 0 || excludedPort != 0;
+		if (needsPorts == false)
+			return true;
+		if (frameEtherType != 0x0800 || length < ipv4Offset + 20)
+			return port == 0 && ipProtocol == 0;
+
+		const uint8_t frameIpProtocol {frame[ipv4Offset + 9]};
+		if (ipProtocol != 0 && frameIpProtocol != ipProtocol)
+			return false;
+		if (frameIpProtocol != 6 && frameIpProtocol != 17)	// neither TCP nor UDP?
+			return port == 0;
+		if ((frame[ipv4Offset + 6] & 0x1f) != 0 || frame[ipv4Offset + 7] != 0)	// not the first fragment?
+			return port == 0;
+
+		const size_t portsOffset {ipv4Offset + (frame[ipv4Offset] & 0xf) * 4u};
+		if (length < portsOffset + 4)
+			return port == 0;
+
+		const uint16_t sourcePort = frame[portsOffset] << 8 | frame[portsOffset + 1];
+		const uint16_t destinationPort = frame[portsOffset + 2] << 8 | frame[portsOffset + 3];
+		if (excludedPort != 0 && (sourcePort == excludedPort || destinationPort == excludedPort))
+			return false;
+		return port == 0 || sourcePort == port || destinationPort == port;
+	}
+
+	/// selected EtherType (e.g. 0x0800 for IPv4 or 0x0806 for ARP), 0 - any
+	uint16_t etherType;
+
+	/// selected TCP or UDP port (source or destination), 0 - any
+	uint16_t port;
+
+	/// excluded TCP or UDP port (source or destination), 0 - none
+	uint16_t excludedPort;
+
+	/// selected IPv4 protocol (e.g. 6 for TCP or 17 for UDP), 0 - any
+	uint8_t ipProtocol;
+
+	/// bitmask with selected directions (PacketDirection values)
+	uint8_t directions;
+};
+
+#endif	// PACKETCAPTUREFILTER_HPP_
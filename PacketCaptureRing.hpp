@@ -0,0 +1,231 @@
+/**
+ * \file
+ * \brief PacketCaptureRing class header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PACKETCAPTURERING_HPP_
+#define PACKETCAPTURERING_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * \brief PacketCaptureRing class is a ring buffer with captured frames, stored as records of pcap file.
+ *
+ * Each record consists of pcap record header followed by captured bytes of frame, so records can be streamed to pcap
+ * file or socket without any conversion. When there is not enough free space for new record, the oldest records are
+ * overwritten. Records are read with a position kept by the reader, so any number of readers may read the ring
+ * independently - if the record at reader's position was already overwritten, reading restarts from the oldest
+ * record.
+ *
+ * The object is not thread-safe, synchronization (if required) must be provided by the user.
+ *
+ * \tparam Capacity is the size of storage for records, bytes, must be a power of 2
+ */
+
+template<size_t Capacity>
+class PacketCaptureRing
+{
+	static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2!");
+
+public:
+
+	/// header of pcap file (in native byte order), sent before all records
+	struct FileHeader
+	{
+		/// magic number, 0xa1b2c3d4 for timestamps with microseconds
+		uint32_t magicNumber;
+
+		/// major version of format, 2
+		uint16_t versionMajor;
+
+		/// minor version of format, 4
+		uint16_t versionMinor;
+
+		/// offset of timezone, unused
+		int32_t timezoneOffset;
+
+		/// accuracy of timestamps, unused
+		uint32_t timestampAccuracy;
+
+		/// max number of captured bytes of each frame
+		uint32_t snapLength;
+
+		/// type of link, 1 for Ethernet
+		uint32_t linkType;
+	};
+
+	/// header of record, the same as record header of pcap file (in native byte order)
+	struct RecordHeader
+	{
+		/// timestamp, seconds
+		uint32_t seconds;
+
+		/// timestamp, microseconds
+		uint32_t microseconds;
+
+		/// number of captured bytes of frame
+		uint32_t capturedLength;
+
+		/// length of frame, bytes
+		uint32_t originalLength;
+	};
+
+	/**
+	 * \brief PacketCaptureRing's constructor
+	 */
+
+	constexpr PacketCaptureRing() :
+			storage_{},
+			head_{},
+			tail_{},
+			overwritten_{}
+	{
+
+	}
+
+	/**
+	 * \return number of records which were overwritten by newer records
+	 */
+
+	size_t getOverwrittenCount() const
+	{
+		return overwritten_;
+	}
+
+	/**
+	 * \return position of the oldest record in ring buffer
+	 */
+
+	size_t getTail() const
+	{
+		return tail_;
+	}
+
+	/**
+	 * \brief Reads record.
+	 *
+	 * \param [in,out] position is a reference to position of record which will be read, it is advanced to the next
+	 * record on success; if the record at this position was already overwritten, the oldest record is read instead
+	 * \param [out] buffer is a buffer for record (header and captured bytes)
+	 * \param [in] size is the size of \a buffer, bytes, must be large enough for the largest written record
+	 *
+	 * \return size of record copied to \a buffer, bytes, 0 if there are no more records
+	 */
+
+	size_t read(size_t& position, void* const buffer, const size_t size) const
+	{
+		if (head_ - position > head_ - tail_)	// record at position was overwritten?
+			position = tail_;
+		if (position == head_)
+			return {};
+
+		RecordHeader header;
+		copyFrom(position, &header, sizeof(header));
+		const auto recordSize = sizeof(header) + header.capturedLength;
+		if (recordSize > size)
+			return {};
+
+		copyFrom(position, buffer, recordSize);
+		position += recordSize;
+		return recordSize;
+	}
+
+	/**
+	 * \brief Writes record, overwriting the oldest records if needed.
+	 *
+	 * \param [in] header is a reference to header of record
+	 * \param [in] data is a pointer to captured bytes of frame, RecordHeader::capturedLength bytes
+	 *
+	 * \return true if record was written, false if it is larger than the whole ring buffer
+	 */
+
+	bool write(const RecordHeader& header, const void* const data)
+	{
+		const auto recordSize = sizeof(header) + header.capturedLength;
+		if (recordSize > Capacity)
+			return false;
+
+		while (Capacity - (head_ - tail_) < recordSize)
+		{
+			RecordHeader oldestHeader;
+			copyFrom(tail_, &oldestHeader, sizeof(oldestHeader));
+			tail_ += sizeof(oldestHeader) + oldestHeader.capturedLength;
+			++overwritten_;
+		}
+
+		copyTo(head_, &header, sizeof(header));
+		copyTo(head_ + sizeof(header), data, header.capturedLength);
+		head_ += recordSize;
+		return true;
+	}
+
+	/**
+	 * \return size of storage for records, bytes
+	 */
+
+	constexpr static size_t capacity()
+	{
+		return Capacity;
+	}
+
+	PacketCaptureRing(const PacketCaptureRing&) = delete;
+	PacketCaptureRing(PacketCaptureRing&&) = delete;
+	const PacketCaptureRing& operator=(const PacketCaptureRing&) = delete;
+	PacketCaptureRing& operator=(PacketCaptureRing&&) = delete;
+
+private:
+
+	/**
+	 * \brief Copies bytes from storage, wrapping around its end.
+	 *
+	 * \param [in] position is the free-running position of the first copied byte
+	 * \param [out] destination is a pointer to destination buffer
+	 * \param [in] size is the number of copied bytes
+	 */
+
+	void copyFrom(const size_t position, void* const destination, const size_t size) const
+	{
+		const auto offset = position % Capacity;
+		const auto first = size < Capacity - offset ? size : Capacity - offset;
+		memcpy(destination, storage_ + offset, first);
+		memcpy(static_cast<uint8_t*>(destination) + first, storage_, size - first);
+	}
+
+	/**
+	 * \brief Copies bytes to storage, wrapping around its end.
+	 *
+	 * \param [in] position is the free-running position of the first copied byte
+	 * \param [in] source is a pointer to source buffer
+	 * \param [in] size is the number of copied bytes
+	 */
+
+	void copyTo(const size_t position, const void* const source, const size_t size)
+	{
+		const auto offset = position % Capacity;
+		const auto first = size < Capacity - offset ? size : Capacity - offset;
+		memcpy(storage_ + offset, source, first);
+		memcpy(storage_, static_cast<const uint8_t*>(source) + first, size - first);
+	}
+
+	/// storage for records
+	uint8_t storage_[Capacity];
+
+	/// free-running position of the end of the newest record
+	size_t head_;
+
+	/// free-running position of the oldest record
+	size_t tail_;
+
+	/// number of overwritten records
+	size_t overwritten_;
+};
+
+#endif	// PACKETCAPTURERING_HPP_
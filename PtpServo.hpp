@@ -0,0 +1,199 @@
+/**
+ * \file
+ * \brief PtpServo class header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PTPSERVO_HPP_
+#define PTPSERVO_HPP_
+
+#include <algorithm>
+
+#include <cstdint>
+
+/// correction of local clock requested by PtpServo
+struct PtpCorrection
+{
+	/// offset which should be subtracted from local clock at once, 0 if local clock should not be stepped, nanoseconds
+	int64_t step;
+
+	/// frequency adjustment of local clock, parts per billion
+	int32_t frequency;
+};
+
+/**
+ * \brief PtpServo class synchronizes local clock with master clock using measurements of end-to-end delay mechanism of
+ * PTP.
+ *
+ * Each measurement consists of four timestamps - t1 (Sync sent by master, master's time), t2 (Sync received, local
+ * time), t3 (Delay_Req sent, local time) and t4 (Delay_Req received by master, master's time). Mean path delay
+ * ((t2 - t1) + (t4 - t3)) / 2 is smoothed with exponential moving average (weight 1/8) and offset from master is
+ * t2 - t1 minus smoothed delay. The first offset and any offset larger than step threshold are corrected with a
+ * step, smaller offsets are corrected with frequency adjustment from PI controller. Gains of the controller (0.7 and
+ * 0.3) are the same as the defaults of linuxptp, offset is scaled by the interval between Sync messages, so the
+ * controller works with any sync interval.
+ *
+ * \warning The object is not thread-safe.
+ */
+
+class PtpServo
+{
+public:
+
+	/**
+	 * \brief PtpServo's constructor
+	 *
+	 * \param [in] stepThreshold is the max offset which is corrected with frequency adjustment, nanoseconds
+	 * \param [in] maxFrequency is the max absolute value of frequency adjustment, parts per billion
+	 */
+
+	constexpr PtpServo(const int64_t stepThreshold, const int32_t maxFrequency) :
+			stepThreshold_{stepThreshold},
+			delay_{},
+			integral_{},
+			offset_{},
+			previousT1_{},
+			steps_{},
+			frequency_{},
+			maxFrequency_{maxFrequency},
+			measured_{}
+	{
+
+	}
+
+	/**
+	 * \return smoothed mean path delay, nanoseconds
+	 */
+
+	int64_t getDelay() const
+	{
+		return delay_;
+	}
+
+	/**
+	 * \return current frequency adjustment, parts per billion
+	 */
+
+	int32_t getFrequency() const
+	{
+		return frequency_;
+	}
+
+	/**
+	 * \return offset from master in the last measurement, before its correction, nanoseconds
+	 */
+
+	int64_t getOffset() const
+	{
+		return offset_;
+	}
+
+	/**
+	 * \return number of steps of local clock
+	 */
+
+	uint32_t getSteps() const
+	{
+		return steps_;
+	}
+
+	/**
+	 * \return true if local clock was stepped at least once and the last offset didn't exceed step threshold, false
+	 * otherwise
+	 */
+
+	bool isSynchronized() const
+	{
+		return steps_ != 0 && offset_ <= stepThreshold_ && offset_ >= -stepThreshold_;
+	}
+
+	/**
+	 * \brief Resets the state of servo, so that the next measurement steps local clock.
+	 *
+	 * Should be called when master changes or when local clock was disturbed.
+	 */
+
+	void reset()
+	{
+		delay_ = {};
+		integral_ = {};
+		offset_ = {};
+		frequency_ = {};
+		measured_ = {};
+	}
+
+	/**
+	 * \brief Updates servo with new measurement.
+	 *
+	 * \param [in] t1 is the time of transmission of Sync by master, master's time, nanoseconds
+	 * \param [in] t2 is the time of reception of Sync, local time, nanoseconds
+	 * \param [in] t3 is the time of transmission of Delay_Req, local time, nanoseconds
+	 * \param [in] t4 is the time of reception of Delay_Req by master, master's time, nanoseconds
+	 *
+	 * \return correction which should be applied to local clock
+	 */
+
+	PtpCorrection update(const int64_t t1, const int64_t t2, const int64_t t3, const int64_t t4)
+	{
+		const auto delay = ((t2 - t1) + (t4 - t3)) / 2;
+		delay_ = measured_ == false ? delay : delay_ + (delay - delay_) / 8;
+		offset_ = t2 - t1 - delay_;
+
+		const auto interval = t1 - previousT1_;
+		previousT1_ = t1;
+
+		if (measured_ == false || offset_ > stepThreshold_ || offset_ < -stepThreshold_)
+		{
+			measured_ = true;
+			++steps_;
+			return {offset_, frequency_};
+		}
+
+		// interval of Sync messages may be unknown after reset or disturbed by lost messages, assume 1 s then
+		constexpr int64_t nominalInterval {1000000000};
+		const auto scaledOffset = offset_ * nominalInterval / (interval > 0 && interval < 16 * nominalInterval ?
+				interval : nominalInterval);
+		integral_ = std::clamp<int64_t>(integral_ + scaledOffset * 3 / 10, -maxFrequency_, maxFrequency_);
+		frequency_ = -std::clamp<int64_t>(scaledOffset * 7 / 10 + integral_, -maxFrequency_, maxFrequency_);
+		return {0, frequency_};
+	}
+
+	PtpServo(const PtpServo&) = delete;
+	const PtpServo& operator=(const PtpServo&) = delete;
+
+private:
+
+	/// max offset which is corrected with frequency adjustment, nanoseconds
+	int64_t stepThreshold_;
+
+	/// smoothed mean path delay, nanoseconds
+	int64_t delay_;
+
+	/// integral term of PI controller, parts per billion
+	int64_t integral_;
+
+	/// offset from master in the last measurement, nanoseconds
+	int64_t offset_;
+
+	/// t1 of the previous measurement, nanoseconds
+	int64_t previousT1_;
+
+	/// number of steps of local clock
+	uint32_t steps_;
+
+	/// current frequency adjustment, parts per billion
+	int32_t frequency_;
+
+	/// max absolute value of frequency adjustment, parts per billion
+	int32_t maxFrequency_;
+
+	/// true if at least one measurement was made since reset, false otherwise
+	bool measured_;
+};
+
+#endif	// PTPSERVO_HPP_
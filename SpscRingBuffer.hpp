@@ -0,0 +1,146 @@
+/**
+ * \file
+ * \brief SpscRingBuffer class header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SPSCRINGBUFFER_HPP_
+#define SPSCRINGBUFFER_HPP_
+
+#include <atomic>
+
+#include <cstddef>
+
+/**
+ * \brief SpscRingBuffer class is a lock-free ring buffer for single producer and single consumer.
+ *
+ * push() may be called only by one producer (thread or interrupt) and pop() may be called only by one consumer (thread
+ * or interrupt), but both of them may be called concurrently. Neither of them blocks, disables interrupts or uses any
+ * kernel primitive - if waiting is needed, it must be implemented by the user (e.g. by notifying the consumer only when
+ * it sleeps).
+ *
+ * \tparam T is the type of elements, should be trivially copyable
+ * \tparam Capacity is the max number of elements in ring buffer, must be a power of 2
+ */
+
+template<typename T, size_t Capacity>
+class SpscRingBuffer
+{
+	static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2!");
+
+public:
+
+	/**
+	 * \brief SpscRingBuffer's constructor
+	 */
+
+	constexpr SpscRingBuffer() :
+			elements_{},
+			head_{},
+			tail_{}
+	{
+
+	}
+
+	/**
+	 * \brief Checks whether ring buffer is empty.
+	 *
+	 * \note The result may be outdated immediately, unless it is called by consumer and the result is false, or it is
+	 * called by producer and the result is true.
+	 *
+	 * \return true if ring buffer is empty, false otherwise
+	 */
+
+	bool empty() const
+	{
+		return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * \brief Checks whether ring buffer is full.
+	 *
+	 * \note The result may be outdated immediately, unless it is called by producer and the result is false, or it is
+	 * called by consumer and the result is true.
+	 *
+	 * \return true if ring buffer is full, false otherwise
+	 */
+
+	bool full() const
+	{
+		return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire) == Capacity;
+	}
+
+	/**
+	 * \brief Pops the oldest element from ring buffer.
+	 *
+	 * \warning This function may be called only by consumer.
+	 *
+	 * \param [out] value is a reference to variable for popped element
+	 *
+	 * \return true if element was popped, false if ring buffer is empty
+	 */
+
+	bool pop(T& value)
+	{
+		const auto tail = tail_.load(std::memory_order_relaxed);
+		if (tail == head_.load(std::memory_order_acquire))
+			return false;
+
+		value = elements_[tail % Capacity];
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * \brief Pushes element to ring buffer.
+	 *
+	 * \warning This function may be called only by producer.
+	 *
+	 * \param [in] value is a reference to element which will be pushed
+	 *
+	 * \return true if element was pushed, false if ring buffer is full
+	 */
+
+	bool push(const T& value)
+	{
+		const auto head = head_.load(std::memory_order_relaxed);
+		if (head - tail_.load(std::memory_order_acquire) == Capacity)
+			return false;
+
+		elements_[head % Capacity] = value;
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * \return max number of elements in ring buffer
+	 */
+
+	constexpr static size_t capacity()
+	{
+		return Capacity;
+	}
+
+	SpscRingBuffer(const SpscRingBuffer&) = delete;
+	SpscRingBuffer(SpscRingBuffer&&) = delete;
+	const SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+	SpscRingBuffer& operator=(SpscRingBuffer&&) = delete;
+
+private:
+
+	/// storage for elements
+	T elements_[Capacity];
+
+	/// free-running index of next element which will be pushed, modified only by producer
+	std::atomic<size_t> head_;
+
+	/// free-running index of next element which will be popped, modified only by consumer
+	std::atomic<size_t> tail_;
+};
+
+#endif	// SPSCRINGBUFFER_HPP_
@@ -0,0 +1,58 @@
+/**
+ * \file
+ * \brief StatisticsSource class header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef STATISTICSSOURCE_HPP_
+#define STATISTICSSOURCE_HPP_
+
+#include <cstddef>
+
+/**
+ * \brief StatisticsSource class is an interface for a source of statistics which are periodically published via MQTT.
+ *
+ * Each source provides a number of entries. Every entry is published as a separate MQTT message, to a topic with
+ * "stats/" prefix.
+ */
+
+class StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats one entry of statistics.
+	 *
+	 * \param [in] index is the index of entry, [0; getCount())
+	 * \param [out] topic is a buffer for topic of entry (relative to "stats/", e.g. "memory/PBUF_POOL")
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	virtual int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const = 0;
+
+	/**
+	 * \return number of entries in this source
+	 */
+
+	virtual size_t getCount() const = 0;
+
+protected:
+
+	/**
+	 * \brief StatisticsSource's destructor
+	 */
+
+	~StatisticsSource() = default;
+};
+
+#endif	// STATISTICSSOURCE_HPP_
@@ -0,0 +1,499 @@
+/**
+ * \file
+ * \brief TelemetryEngine class header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TELEMETRYENGINE_HPP_
+#define TELEMETRYENGINE_HPP_
+
+#include "Cbor.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// data point published by exception
+struct TelemetryPoint
+{
+	/// topic of data point, appended to common prefix of telemetry topics
+	const char* topic;
+
+	/// function which samples data point, its result is a fixed-point value with \a decimals digits after decimal point
+	int32_t (*source)(const void* argument);
+
+	/// argument passed to \a source
+	const void* argument;
+
+	/// min change of value (relative to the last published value) which is published, 0 publishes any change
+	uint32_t deadband;
+
+	/// interval between samples, milliseconds, must not be 0
+	uint32_t samplePeriod;
+
+	/// min interval between publishes, milliseconds, changes are delayed until it passes
+	uint32_t minInterval;
+
+	/// max interval between publishes, milliseconds, unchanged value is published again when it passes, 0 disables
+	uint32_t maxInterval;
+
+	/// number of digits after decimal point in value returned by \a source
+	uint8_t decimals;
+};
+
+/// value of data point which should be published
+struct TelemetryUpdate
+{
+	/// index of data point in TelemetryEngine
+	size_t point;
+
+	/// sampled value
+	int32_t value;
+};
+
+/// timestamped sample of data point, element of batch encoded with encodeTelemetryBatch()
+struct TelemetrySample
+{
+	/// pointer to sampled data point
+	const TelemetryPoint* point;
+
+	/// time of sample, milliseconds
+	uint32_t time;
+
+	/// sampled value
+	int32_t value;
+};
+
+/**
+ * \brief Encodes batch of samples as CBOR.
+ *
+ * Batch is a map with two entries - "t" with time of the batch and "s" with array of samples. Each sample is an array
+ * with topic of data point, time of sample relative to time of the batch (milliseconds, may be negative) and value -
+ * integer if data point has no decimals, decimal fraction (tag 4) otherwise. For example a batch with die temperature
+ * 25.3 (1 decimal) sampled 10 ms before time of the batch is {"t": <time>, "s": [["temperature", -10, 4([-1, 253])]]}.
+ *
+ * \tparam Writer is the type of writer used by \a encoder
+ *
+ * \param [in] encoder is a reference to CborEncoder used for encoding
+ * \param [in] time is the time of batch, milliseconds
+ * \param [in] samples is a pointer to array with samples
+ * \param [in] count is the number of elements in \a samples
+ *
+ * \return true if the whole batch was encoded, false if it didn't fit in the output of \a encoder
+ */
+
+template<typename Writer>
+constexpr bool encodeTelemetryBatch(CborEncoder<Writer>& encoder, const uint32_t time,
+		const TelemetrySample* const samples, const size_t count)
+{
+	encoder.beginMap(2);
+	encoder.encodeText("t", 1);
+	encoder.encodeUnsigned(time);
+	encoder.encodeText("s", 1);
+	encoder.beginArray(count);
+	for (size_t i {}; i < count; ++i)
+	{
+		const auto& sample = samples[i];
+		encoder.beginArray(3);
+		encoder.encodeText(sample.point->topic);
+		encoder.encodeSigned(static_cast<int32_t>(sample.time - time));
+		if (sample.point->decimals == 0)
+			encoder.encodeSigned(sample.value);
+		else
+			encoder.encodeDecimalFraction(sample.value, -sample.point->decimals);
+	}
+
+	return encoder.isValid();
+}
+
+/**
+ * \brief Formats fixed-point value of data point.
+ *
+ * \param [in] value is the fixed-point value
+ * \param [in] decimals is the number of digits after decimal point in \a value
+ * \param [out] buffer is a buffer for formatted value, 13 bytes is enough for any value with up to 9 decimals
+ * \param [in] size is the size of \a buffer, bytes
+ *
+ * \return length of formatted value (without terminating null character), 0 if \a buffer is too small
+ */
+
+inline size_t formatTelemetryValue(const int32_t value, const uint8_t decimals, char* const buffer, const size_t size)
+{
+	char digits[12];
+	size_t count {};
+	auto magnitude = value < 0 ? 0 - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+	do
+	{
+		digits[count++] = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while (magnitude != 0 || count <= decimals);
+
+	const size_t length {(value < 0) + count + (decimals != 0)};
+	if (length >= size)
+		return {};
+
+	auto output = buffer;
+	if (value < 0)
+		*output++ = '-';
+	while (count != 0)
+	{
+		if (count-- == decimals)
+			*output++ = '.';
+		*output++ = digits[count];
+	}
+	*output = {};
+	return length;
+}
+
+/**
+ * \brief Encodes MQTT PUBLISH packet with QoS 0 and without retain flag.
+ *
+ * Packets encoded one after another can be written to MQTT connection at once, so they are sent in one TCP segment.
+ *
+ * \param [out] buffer is a buffer for encoded packet
+ * \param [in] size is the size of \a buffer, bytes
+ * \param [in] prefix is the first part of topic
+ * \param [in] topic is the second part of topic
+ * \param [in] payload is a pointer to payload
+ * \param [in] payloadLength is the length of payload, bytes
+ *
+ * \return length of encoded packet, 0 if \a buffer is too small or the packet would be too large
+ */
+
+inline size_t encodeMqttPublish(uint8_t* const buffer, const size_t size, const char* const prefix,
+		const char* const topic, const void* const payload, const size_t payloadLength)
+{
+	const auto prefixLength = strlen(prefix);
+	const auto topicLength = prefixLength + strlen(topic);
+	const auto remainingLength = 2 + topicLength + payloadLength;
+	if (topicLength > UINT16_MAX || remainingLength >= 128 * 128)
+		return {};
+
+	const size_t length {1 + (remainingLength < 128 ? 1u : 2u) + remainingLength};
+	if (length > size)
+		return {};
+
+	auto output = buffer;
+	*output++ = 0x30;	// PUBLISH, QoS 0
+	if (remainingLength < 128)
+		*output++ = remainingLength;
+	else
+	{
+		*output++ = (remainingLength & 0x7f) | 0x80;
+		*output++ = remainingLength >> 7;
+	}
+	*output++ = topicLength >> 8;
+	*output++ = topicLength & 0xff;
+	memcpy(output, prefix, prefixLength);
+	memcpy(output + prefixLength, topic, topicLength - prefixLength);
+	memcpy(output + topicLength, payload, payloadLength);
+	return length;
+}
+
+/**
+ * \brief TelemetryEngine class samples registered data points on their schedules and selects values which should be
+ * published.
+ *
+ * Data points are kept in a binary min-heap ordered by the time of their next sample, so each call to sample() costs
+ * O(log n) per sampled data point and nothing for data points which are not due. Sampled value is published if it
+ * differs from the last published value by at least deadband and min interval has passed since the last publish, or if
+ * max interval has passed since the last publish. A change which is delayed by min interval is sampled again as soon
+ * as min interval passes, unchanged value is sampled again exactly when max interval passes.
+ *
+ * Updates selected by sample() are expected to be published together, as one batch. Only updates passed to commit()
+ * are considered published - values which could not be published are sampled and evaluated again in their next sample.
+ *
+ * Times are in milliseconds and may wrap around - all scheduled times must be within 2^31 ms from current time.
+ *
+ * \warning The object is not thread-safe.
+ *
+ * \tparam Capacity is the max number of data points
+ */
+
+template<size_t Capacity>
+class TelemetryEngine
+{
+	static_assert(Capacity != 0 && Capacity <= UINT16_MAX, "Invalid capacity!");
+
+public:
+
+	/**
+	 * \brief TelemetryEngine's constructor
+	 */
+
+	constexpr TelemetryEngine() :
+			points_{},
+			states_{},
+			heap_{},
+			samples_{},
+			size_{}
+	{
+
+	}
+
+	/**
+	 * \brief Registers data point.
+	 *
+	 * Data point is sampled for the first time in the next call to sample() and its first sampled value is always
+	 * published.
+	 *
+	 * \param [in] point is a reference to data point, must stay valid as long as the engine is used
+	 * \param [in] now is current time, milliseconds
+	 *
+	 * \return true if data point was registered, false if the engine is full or data point is invalid (sample period
+	 * is 0 or max interval is smaller than min interval)
+	 */
+
+	bool add(const TelemetryPoint& point, const uint32_t now)
+	{
+		if (size_ == Capacity || point.source == nullptr || point.samplePeriod == 0 ||
+				(point.maxInterval != 0 && point.maxInterval < point.minInterval))
+			return false;
+
+		points_[size_] = &point;
+		states_[size_] = {now, {}, {}, {}};
+		heap_[size_] = size_;
+		siftUp(size_);
+		++size_;
+		return true;
+	}
+
+	/**
+	 * \brief Marks accepted updates as published.
+	 *
+	 * \param [in] updates is a pointer to array with updates returned by sample()
+	 * \param [in] count is the number of elements in \a updates
+	 * \param [in] now is current time, milliseconds
+	 */
+
+	void commit(const TelemetryUpdate* const updates, const size_t count, const uint32_t now)
+	{
+		for (size_t i {}; i < count; ++i)
+		{
+			auto& state = states_[updates[i].point];
+			state.published = now;
+			state.value = updates[i].value;
+			state.valid = true;
+		}
+	}
+
+	/**
+	 * \return time of the next sample, milliseconds, valid only if at least one data point is registered
+	 */
+
+	uint32_t getNextSample() const
+	{
+		return states_[heap_[0]].due;
+	}
+
+	/**
+	 * \param [in] index is the index of data point, [0; size())
+	 *
+	 * \return reference to data point
+	 */
+
+	const TelemetryPoint& getPoint(const size_t index) const
+	{
+		return *points_[index];
+	}
+
+	/**
+	 * \return number of samples taken since construction
+	 */
+
+	uint32_t getSamples() const
+	{
+		return samples_;
+	}
+
+	/**
+	 * \brief Schedules all data points for immediate sampling and forgets their published values, so that all of them
+	 * are published in the next call(s) to sample().
+	 *
+	 * Should be called when published values were lost, e.g. after reconnection to MQTT broker.
+	 *
+	 * \param [in] now is current time, milliseconds
+	 */
+
+	void reset(const uint32_t now)
+	{
+		for (size_t i {}; i < size_; ++i)
+			states_[i] = {now, {}, {}, {}};
+	}
+
+	/**
+	 * \brief Samples all data points which are due and selects values which should be published.
+	 *
+	 * Sampling stops when \a maxUpdates updates were selected, remaining data points which are due are sampled in the
+	 * next call.
+	 *
+	 * \param [in] now is current time, milliseconds
+	 * \param [out] updates is a pointer to array for selected updates
+	 * \param [in] maxUpdates is the number of elements in \a updates
+	 *
+	 * \return number of selected updates
+	 */
+
+	size_t sample(const uint32_t now, TelemetryUpdate* const updates, const size_t maxUpdates)
+	{
+		size_t count {};
+		while (size_ != 0 && count < maxUpdates && isBefore(now, states_[heap_[0]].due) == false)
+		{
+			const size_t index {heap_[0]};
+			auto& point = *points_[index];
+			auto& state = states_[index];
+			const auto value = point.source(point.argument);
+			++samples_;
+
+			uint32_t due {now + point.samplePeriod};
+			const uint32_t sincePublished {now - state.published};
+			const uint64_t change = value < state.value ? int64_t{state.value} - value : int64_t{value} - state.value;
+			const auto significant = change != 0 && change >= point.deadband;
+			if (state.valid == false || (significant == true && sincePublished >= point.minInterval) ||
+					(point.maxInterval != 0 && sincePublished >= point.maxInterval))
+			{
+				updates[count++] = {index, value};
+				if (point.maxInterval != 0)
+					due = earlier(due, now + point.maxInterval);
+			}
+			else
+			{
+				if (significant == true)
+					due = earlier(due, state.published + point.minInterval);
+				if (point.maxInterval != 0)
+					due = earlier(due, state.published + point.maxInterval);
+			}
+
+			state.due = due;
+			siftDown(0);
+		}
+
+		return count;
+	}
+
+	/**
+	 * \return number of registered data points
+	 */
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+	TelemetryEngine(const TelemetryEngine&) = delete;
+	const TelemetryEngine& operator=(const TelemetryEngine&) = delete;
+
+private:
+
+	/// state of data point
+	struct State
+	{
+		/// time of the next sample, milliseconds
+		uint32_t due;
+
+		/// time of the last publish, milliseconds, valid only if \a valid is true
+		uint32_t published;
+
+		/// the last published value, valid only if \a valid is true
+		int32_t value;
+
+		/// true if the value was published since registration or reset(), false otherwise
+		bool valid;
+	};
+
+	/**
+	 * \param [in] left is the first time, milliseconds
+	 * \param [in] right is the second time, milliseconds
+	 *
+	 * \return earlier of \a left and \a right, considering wrap-around
+	 */
+
+	constexpr static uint32_t earlier(const uint32_t left, const uint32_t right)
+	{
+		return isBefore(right, left) == true ? right : left;
+	}
+
+	/**
+	 * \param [in] left is the first time, milliseconds
+	 * \param [in] right is the second time, milliseconds
+	 *
+	 * \return true if \a left is before \a right, considering wrap-around, false otherwise
+	 */
+
+	constexpr static bool isBefore(const uint32_t left, const uint32_t right)
+	{
+		return static_cast<int32_t>(left - right) < 0;
+	}
+
+	/**
+	 * \brief Moves element of heap down, until heap property is restored.
+	 *
+	 * \param [in] position is the position of moved element in heap
+	 */
+
+	void siftDown(size_t position)
+	{
+		const auto element = heap_[position];
+		const auto due = states_[element].due;
+		while (1)
+		{
+			auto child = 2 * position + 1;
+			if (child >= size_)
+				break;
+			if (child + 1 < size_ && isBefore(states_[heap_[child + 1]].due, states_[heap_[child]].due) == true)
+				++child;
+			if (isBefore(states_[heap_[child]].due, due) == false)
+				break;
+
+			heap_[position] = heap_[child];
+			position = child;
+		}
+
+		heap_[position] = element;
+	}
+
+	/**
+	 * \brief Moves element of heap up, until heap property is restored.
+	 *
+	 * \param [in] position is the position of moved element in heap
+	 */
+
+	void siftUp(size_t position)
+	{
+		const auto element = heap_[position];
+		const auto due = states_[element].due;
+		while (position != 0)
+		{
+			const auto parent = (position - 1) / 2;
+			if (isBefore(due, states_[heap_[parent]].due) == false)
+				break;
+
+			heap_[position] = heap_[parent];
+			position = parent;
+		}
+
+		heap_[position] = element;
+	}
+
+	/// registered data points
+	const TelemetryPoint* points_[Capacity];
+
+	/// states of registered data points
+	State states_[Capacity];
+
+	/// binary min-heap with indexes of data points, ordered by the time of their next sample
+	uint16_t heap_[Capacity];
+
+	/// number of samples taken since construction
+	uint32_t samples_;
+
+	/// number of registered data points
+	size_t size_;
+};
+
+#endif	// TELEMETRYENGINE_HPP_
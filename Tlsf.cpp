@@ -0,0 +1,506 @@
+/**
+ * \file
+ * \brief Tlsf class implementation
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "Tlsf.hpp"
+
+#include <algorithm>
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Aligns value down.
+ *
+ * \param [in] value is the value which will be aligned
+ * \param [in] alignment is the alignment, must be a power of 2
+ *
+ * \return \a value aligned down to \a alignment
+ */
+
+constexpr size_t alignDown(const size_t value, const size_t alignment)
+{
+	return value & ~(alignment - 1);
+}
+
+/**
+ * \brief Aligns value up.
+ *
+ * \param [in] value is the value which will be aligned
+ * \param [in] alignment is the alignment, must be a power of 2
+ *
+ * \return \a value aligned up to \a alignment
+ */
+
+constexpr size_t alignUp(const size_t value, const size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * \param [in] value is the value which will be checked, must not be 0
+ *
+ * \return index of least significant bit set in \a value
+ */
+
+size_t findFirstSet(const uint32_t value)
+{
+	return __builtin_ctz(value);
+}
+
+/**
+ * \param [in] value is the value which will be checked, must not be 0
+ *
+ * \return index of most significant bit set in \a value
+ */
+
+size_t findLastSet(const size_t value)
+{
+	return sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(value);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+Tlsf::Tlsf() :
+		nullBlock_{},
+		blocks_{},
+		secondLevelBitmaps_{},
+		firstLevelBitmap_{},
+		totalSize_{},
+		usedSize_{},
+		maxUsedSize_{},
+		allocations_{},
+		failures_{}
+{
+	nullBlock_.nextFree = &nullBlock_;
+	nullBlock_.previousFree = &nullBlock_;
+
+	for (auto& firstLevelBlocks : blocks_)
+		for (auto& block : firstLevelBlocks)
+			block = &nullBlock_;
+}
+
+bool Tlsf::addPool(void* const memory, const size_t size)
+{
+	const auto address = reinterpret_cast<uintptr_t>(memory);
+	if (alignUp(address, alignment) != address)
+		return false;
+
+	if (size < poolOverhead + blockSizeMin)
+		return false;
+
+	const auto poolSize = std::min(alignDown(size - poolOverhead, alignment), blockSizeMax - alignment);
+
+	// previousPhysical of the first block is located before the pool - it is never accessed, as the first block is
+	// always marked as having "used" previous block
+	const auto block = reinterpret_cast<BlockHeader*>(address - blockOverhead);
+	block->size = poolSize | freeBit;
+	insert(block);
+
+	// zero-sized "used" sentinel, which prevents merging with memory after the pool
+	const auto sentinel = linkNext(block);
+	sentinel->size = previousFreeBit;
+
+	totalSize_ += poolSize;
+	return true;
+}
+
+void* Tlsf::allocate(const size_t size)
+{
+	if (size == 0)
+		return {};
+
+	const auto adjustedSize = adjustRequestSize(size, alignment);
+	return prepareUsed(locateFree(adjustedSize), adjustedSize);
+}
+
+void* Tlsf::allocateAligned(const size_t requestedAlignment, const size_t size)
+{
+	assert(requestedAlignment != 0 && (requestedAlignment & (requestedAlignment - 1)) == 0);
+
+	if (size == 0)
+		return {};
+
+	const auto adjustedSize = adjustRequestSize(size, alignment);
+
+	// to make sure that there's enough space for the leading free block, the gap must be big enough for a header
+	constexpr size_t gapMinimum {sizeof(BlockHeader)};
+	const auto alignedSize = adjustedSize != 0 && requestedAlignment > alignment ?
+			adjustRequestSize(adjustedSize + requestedAlignment + gapMinimum, requestedAlignment) : adjustedSize;
+	auto block = locateFree(alignedSize);
+	if (block != nullptr)
+	{
+		const auto address = reinterpret_cast<uintptr_t>(block) + blockStartOffset;
+		auto alignedAddress = alignUp(address, requestedAlignment);
+		auto gap = alignedAddress - address;
+
+		// if gap is too small for a header, move to next aligned address
+		if (gap != 0 && gap < gapMinimum)
+		{
+			const auto offset = std::max(gapMinimum - gap, requestedAlignment);
+			alignedAddress = alignUp(alignedAddress + offset, requestedAlignment);
+			gap = alignedAddress - address;
+		}
+
+		if (gap != 0)
+		{
+			assert(gap >= gapMinimum);
+			block = trimFreeLeading(block, gap);
+		}
+	}
+
+	return prepareUsed(block, adjustedSize);
+}
+
+void Tlsf::deallocate(void* const pointer)
+{
+	if (pointer == nullptr)
+		return;
+
+	auto block = blockFromPointer(pointer);
+	assert((block->size & freeBit) == 0);
+	usedSize_ -= sizeOf(block);
+	markAsFree(block);
+	block = mergePrevious(block);
+	block = mergeNext(block);
+	insert(block);
+}
+
+void* Tlsf::reallocate(void* const pointer, const size_t size)
+{
+	if (pointer == nullptr)
+		return allocate(size);
+
+	if (size == 0)
+	{
+		deallocate(pointer);
+		return {};
+	}
+
+	const auto block = blockFromPointer(pointer);
+	const auto next = nextBlock(block);
+	const auto currentSize = sizeOf(block);
+	const auto combinedSize = currentSize + sizeOf(next) + blockOverhead;
+	const auto adjustedSize = adjustRequestSize(size, alignment);
+	if (adjustedSize == 0)
+	{
+		++failures_;
+		return {};
+	}
+
+	// block cannot be resized in place?
+	if (adjustedSize > currentSize && ((next->size & freeBit) == 0 || adjustedSize > combinedSize))
+	{
+		const auto newPointer = allocate(size);
+		if (newPointer != nullptr)
+		{
+			memcpy(newPointer, pointer, std::min(currentSize, size));
+			deallocate(pointer);
+		}
+
+		return newPointer;
+	}
+
+	if (adjustedSize > currentSize)
+	{
+		mergeNext(block);
+		markAsUsed(block);
+	}
+
+	trimUsed(block, adjustedSize);
+	usedSize_ = usedSize_ - currentSize + sizeOf(block);
+	maxUsedSize_ = std::max(maxUsedSize_, usedSize_);
+	++allocations_;
+	return pointer;
+}
+
+Tlsf::Statistics Tlsf::getStatistics() const
+{
+	Statistics statistics {};
+	statistics.totalSize = totalSize_;
+	statistics.usedSize = usedSize_;
+	statistics.maxUsedSize = maxUsedSize_;
+	statistics.allocations = allocations_;
+	statistics.failures = failures_;
+
+	for (auto firstLevelBitmap = firstLevelBitmap_; firstLevelBitmap != 0; firstLevelBitmap &= firstLevelBitmap - 1)
+	{
+		const auto firstLevelIndex = findFirstSet(firstLevelBitmap);
+		for (auto secondLevelBitmap = secondLevelBitmaps_[firstLevelIndex]; secondLevelBitmap != 0;
+				secondLevelBitmap &= secondLevelBitmap - 1)
+		{
+			const auto secondLevelIndex = findFirstSet(secondLevelBitmap);
+			for (auto block = blocks_[firstLevelIndex][secondLevelIndex]; block != &nullBlock_;
+					block = block->nextFree)
+			{
+				const auto size = sizeOf(block);
+				statistics.freeSize += size;
+				statistics.largestFreeBlockSize = std::max(statistics.largestFreeBlockSize, size);
+				++statistics.freeBlocks;
+			}
+		}
+	}
+
+	return statistics;
+}
+
+size_t Tlsf::getUsableSize(const void* const pointer)
+{
+	return pointer != nullptr ? sizeOf(blockFromPointer(pointer)) : 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private static functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+size_t Tlsf::adjustRequestSize(const size_t size, const size_t requestedAlignment)
+{
+	if (size == 0)
+		return {};
+
+	const auto alignedSize = alignUp(size, requestedAlignment);
+	if (alignedSize < size || alignedSize >= blockSizeMax)	// overflow or too large?
+		return {};
+
+	return std::max(alignedSize, blockSizeMin);
+}
+
+Tlsf::BlockHeader* Tlsf::blockFromPointer(const void* const pointer)
+{
+	return reinterpret_cast<BlockHeader*>(reinterpret_cast<uintptr_t>(pointer) - blockStartOffset);
+}
+
+Tlsf::BlockHeader* Tlsf::linkNext(BlockHeader* const block)
+{
+	const auto next = nextBlock(block);
+	next->previousPhysical = block;
+	return next;
+}
+
+void Tlsf::mappingInsert(const size_t size, size_t& firstLevelIndex, size_t& secondLevelIndex)
+{
+	if (size < smallBlockSize)
+	{
+		firstLevelIndex = {};
+		secondLevelIndex = size / (smallBlockSize / secondLevelIndexCount);
+		return;
+	}
+
+	const auto lastSet = findLastSet(size);
+	secondLevelIndex = (size >> (lastSet - secondLevelIndexCountLog2)) ^ secondLevelIndexCount;
+	firstLevelIndex = lastSet - (firstLevelIndexShift - 1);
+}
+
+void Tlsf::mappingSearch(size_t size, size_t& firstLevelIndex, size_t& secondLevelIndex)
+{
+	// round up to the next list, so that any block found there is big enough
+	if (size >= smallBlockSize)
+		size += (size_t{1} << (findLastSet(size) - secondLevelIndexCountLog2)) - 1;
+
+	mappingInsert(size, firstLevelIndex, secondLevelIndex);
+}
+
+void Tlsf::markAsFree(BlockHeader* const block)
+{
+	const auto next = linkNext(block);
+	next->size |= previousFreeBit;
+	block->size |= freeBit;
+}
+
+void Tlsf::markAsUsed(BlockHeader* const block)
+{
+	const auto next = nextBlock(block);
+	next->size &= ~previousFreeBit;
+	block->size &= ~freeBit;
+}
+
+Tlsf::BlockHeader* Tlsf::nextBlock(const BlockHeader* const block)
+{
+	return reinterpret_cast<BlockHeader*>(reinterpret_cast<uintptr_t>(block) + blockStartOffset + sizeOf(block) -
+			blockOverhead);
+}
+
+Tlsf::BlockHeader* Tlsf::split(BlockHeader* const block, const size_t size)
+{
+	const auto remaining = reinterpret_cast<BlockHeader*>(reinterpret_cast<uintptr_t>(block) + blockStartOffset +
+			size - blockOverhead);
+	const auto remainingSize = sizeOf(block) - (size + blockOverhead);
+	assert(remainingSize >= blockSizeMin);
+	remaining->size = remainingSize;
+	block->size = size | (block->size & (freeBit | previousFreeBit));
+	markAsFree(remaining);
+	return remaining;
+}
+
+Tlsf::BlockHeader* Tlsf::absorb(BlockHeader* const previous, BlockHeader* const block)
+{
+	previous->size += sizeOf(block) + blockOverhead;
+	linkNext(previous);
+	return previous;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void Tlsf::insert(BlockHeader* const block)
+{
+	size_t firstLevelIndex;
+	size_t secondLevelIndex;
+	mappingInsert(sizeOf(block), firstLevelIndex, secondLevelIndex);
+
+	const auto current = blocks_[firstLevelIndex][secondLevelIndex];
+	block->nextFree = current;
+	block->previousFree = &nullBlock_;
+	current->previousFree = block;
+	blocks_[firstLevelIndex][secondLevelIndex] = block;
+	firstLevelBitmap_ |= uint32_t{1} << firstLevelIndex;
+	secondLevelBitmaps_[firstLevelIndex] |= uint32_t{1} << secondLevelIndex;
+}
+
+Tlsf::BlockHeader* Tlsf::locateFree(const size_t size)
+{
+	if (size == 0)
+		return {};
+
+	size_t firstLevelIndex;
+	size_t secondLevelIndex;
+	mappingSearch(size, firstLevelIndex, secondLevelIndex);
+	if (firstLevelIndex >= firstLevelIndexCount)
+		return {};
+
+	auto secondLevelBitmap = secondLevelBitmaps_[firstLevelIndex] & (~uint32_t{} << secondLevelIndex);
+	if (secondLevelBitmap == 0)
+	{
+		const auto firstLevelBitmap = firstLevelBitmap_ & (~uint32_t{} << (firstLevelIndex + 1));
+		if (firstLevelBitmap == 0)
+			return {};
+
+		firstLevelIndex = findFirstSet(firstLevelBitmap);
+		secondLevelBitmap = secondLevelBitmaps_[firstLevelIndex];
+	}
+
+	secondLevelIndex = findFirstSet(secondLevelBitmap);
+	const auto block = blocks_[firstLevelIndex][secondLevelIndex];
+	assert(sizeOf(block) >= size);
+	removeFree(block, firstLevelIndex, secondLevelIndex);
+	return block;
+}
+
+Tlsf::BlockHeader* Tlsf::mergeNext(BlockHeader* block)
+{
+	const auto next = nextBlock(block);
+	if ((next->size & freeBit) != 0)
+	{
+		remove(next);
+		block = absorb(block, next);
+	}
+
+	return block;
+}
+
+Tlsf::BlockHeader* Tlsf::mergePrevious(BlockHeader* block)
+{
+	if ((block->size & previousFreeBit) != 0)
+	{
+		const auto previous = block->previousPhysical;
+		remove(previous);
+		block = absorb(previous, block);
+	}
+
+	return block;
+}
+
+void* Tlsf::prepareUsed(BlockHeader* const block, const size_t size)
+{
+	if (block == nullptr)
+	{
+		++failures_;
+		return {};
+	}
+
+	// trim the trailing part of block if it is big enough to be a separate block
+	if (sizeOf(block) >= sizeof(BlockHeader) + size)
+	{
+		const auto remaining = split(block, size);
+		linkNext(block);
+		remaining->size |= previousFreeBit;
+		insert(remaining);
+	}
+
+	markAsUsed(block);
+	usedSize_ += sizeOf(block);
+	maxUsedSize_ = std::max(maxUsedSize_, usedSize_);
+	++allocations_;
+	return reinterpret_cast<uint8_t*>(block) + blockStartOffset;
+}
+
+void Tlsf::remove(BlockHeader* const block)
+{
+	size_t firstLevelIndex;
+	size_t secondLevelIndex;
+	mappingInsert(sizeOf(block), firstLevelIndex, secondLevelIndex);
+	removeFree(block, firstLevelIndex, secondLevelIndex);
+}
+
+void Tlsf::removeFree(BlockHeader* const block, const size_t firstLevelIndex, const size_t secondLevelIndex)
+{
+	const auto previous = block->previousFree;
+	const auto next = block->nextFree;
+	next->previousFree = previous;
+	previous->nextFree = next;
+
+	if (blocks_[firstLevelIndex][secondLevelIndex] != block)
+		return;
+
+	blocks_[firstLevelIndex][secondLevelIndex] = next;
+	if (next != &nullBlock_)
+		return;
+
+	secondLevelBitmaps_[firstLevelIndex] &= ~(uint32_t{1} << secondLevelIndex);
+	if (secondLevelBitmaps_[firstLevelIndex] == 0)
+		firstLevelBitmap_ &= ~(uint32_t{1} << firstLevelIndex);
+}
+
+Tlsf::BlockHeader* Tlsf::trimFreeLeading(BlockHeader* const block, const size_t size)
+{
+	if (sizeOf(block) < sizeof(BlockHeader) + size)
+		return block;
+
+	// leading part is returned to segregated lists, remaining part is used
+	const auto remaining = split(block, size - blockOverhead);
+	remaining->size |= previousFreeBit;
+	linkNext(block);
+	insert(block);
+	return remaining;
+}
+
+void Tlsf::trimUsed(BlockHeader* const block, const size_t size)
+{
+	if (sizeOf(block) < sizeof(BlockHeader) + size)
+		return;
+
+	// trailing part is returned to segregated lists, after merging with next physical block (if it is free)
+	auto remaining = split(block, size);
+	remaining->size &= ~previousFreeBit;
+	remaining = mergeNext(remaining);
+	insert(remaining);
+}
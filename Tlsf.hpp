@@ -0,0 +1,441 @@
+/**
+ * \file
+ * \brief Tlsf class header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TLSF_HPP_
+#define TLSF_HPP_
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief Tlsf class is a "Two-Level Segregated Fit" memory allocator.
+ *
+ * Both allocation and deallocation have O(1) complexity, which makes their execution time bounded and independent of
+ * the number and layout of used and free blocks. Free blocks are kept in a matrix of segregated lists - first level
+ * selects power of 2 range of sizes, second level splits this range linearly into 32 sub-ranges. Two levels of bitmaps
+ * allow to find suitable non-empty list with just a few "count leading/trailing zeros" instructions.
+ *
+ * Based on "TLSF: a New Dynamic Memory Allocator for Real-Time Systems" by M. Masmano, I. Ripoll, A. Crespo and
+ * J. Real and on the implementation by Matthew Conte.
+ *
+ * The object is not thread-safe, synchronization (if required) must be provided by the user.
+ */
+
+class Tlsf
+{
+public:
+
+	/// statistics of allocator
+	struct Statistics
+	{
+		/// total usable size of all pools, bytes
+		size_t totalSize;
+
+		/// size of all used blocks, bytes
+		size_t usedSize;
+
+		/// high-water mark of \a usedSize, bytes
+		size_t maxUsedSize;
+
+		/// size of all free blocks, bytes
+		size_t freeSize;
+
+		/// size of the largest free block, bytes
+		size_t largestFreeBlockSize;
+
+		/// number of free blocks
+		size_t freeBlocks;
+
+		/// number of successful allocations
+		size_t allocations;
+
+		/// number of failed allocations
+		size_t failures;
+	};
+
+	/// alignment of all blocks returned by allocator, bytes
+	constexpr static size_t alignment {alignof(std::max_align_t)};
+
+	/// overhead of single pool, bytes
+	constexpr static size_t poolOverhead {2 * alignment};
+
+	/**
+	 * \brief Tlsf's constructor
+	 *
+	 * Allocator is constructed without any pools, they must be added with addPool().
+	 */
+
+	Tlsf();
+
+	/**
+	 * \brief Adds memory pool to allocator.
+	 *
+	 * \param [in] memory is a pointer to memory for the pool, must be aligned to \a alignment
+	 * \param [in] size is the size of \a memory, bytes
+	 *
+	 * \return true if pool was added, false if \a memory is not properly aligned or \a size is invalid
+	 */
+
+	bool addPool(void* memory, size_t size);
+
+	/**
+	 * \brief Allocates a block of memory.
+	 *
+	 * \param [in] size is the requested size of block, bytes
+	 *
+	 * \return pointer to allocated block aligned to \a alignment, nullptr if \a size is 0 or if there's no free block
+	 * big enough
+	 */
+
+	void* allocate(size_t size);
+
+	/**
+	 * \brief Allocates a block of memory with requested alignment.
+	 *
+	 * \param [in] requestedAlignment is the requested alignment of block, must be a power of 2
+	 * \param [in] size is the requested size of block, bytes
+	 *
+	 * \return pointer to allocated block aligned to \a requestedAlignment, nullptr if \a size is 0 or if there's no
+	 * free block big enough
+	 */
+
+	void* allocateAligned(size_t requestedAlignment, size_t size);
+
+	/**
+	 * \brief Deallocates a block of memory.
+	 *
+	 * \param [in] pointer is a pointer to block that will be deallocated, must have been returned by this object,
+	 * nullptr is ignored
+	 */
+
+	void deallocate(void* pointer);
+
+	/**
+	 * \brief Changes the size of allocated block of memory.
+	 *
+	 * If possible, the block is resized in place, otherwise a new block is allocated, contents of old block are copied
+	 * and old block is deallocated.
+	 *
+	 * \param [in] pointer is a pointer to block that will be resized, must have been returned by this object, nullptr
+	 * is equivalent to allocate()
+	 * \param [in] size is the new size of block, bytes, 0 is equivalent to deallocate()
+	 *
+	 * \return pointer to resized block, nullptr if \a size is 0 or if there's no free block big enough (in that case
+	 * \a pointer is not modified)
+	 */
+
+	void* reallocate(void* pointer, size_t size);
+
+	/**
+	 * \brief Gets statistics of allocator.
+	 *
+	 * \note Execution time of this function depends on the number of free blocks.
+	 *
+	 * \return statistics of allocator
+	 */
+
+	Statistics getStatistics() const;
+
+	/**
+	 * \param [in] pointer is a pointer to allocated block, must have been returned by any Tlsf object
+	 *
+	 * \return usable size of block, bytes
+	 */
+
+	static size_t getUsableSize(const void* pointer);
+
+	Tlsf(const Tlsf&) = delete;
+	Tlsf(Tlsf&&) = delete;
+	const Tlsf& operator=(const Tlsf&) = delete;
+	Tlsf& operator=(Tlsf&&) = delete;
+
+private:
+
+	/// header of block
+	struct BlockHeader
+	{
+		/// previous physical block, valid only if it is free, located in the last bytes of previous block
+		alignas(alignment) BlockHeader* previousPhysical;
+
+		/// size of block, bytes, two lowest bits are used as flags (freeBit and previousFreeBit)
+		alignas(alignment) size_t size;
+
+		/// next free block in segregated list, valid only if this block is free, located at the start of usable memory
+		alignas(alignment) BlockHeader* nextFree;
+
+		/// previous free block in segregated list, valid only if this block is free
+		BlockHeader* previousFree;
+	};
+
+	/// base-2 logarithm of number of second level lists
+	constexpr static size_t secondLevelIndexCountLog2 {5};
+
+	/// number of second level lists
+	constexpr static size_t secondLevelIndexCount {1 << secondLevelIndexCountLog2};
+
+	/// base-2 logarithm of limit of block size
+	constexpr static size_t firstLevelIndexMax {sizeof(size_t) == 8 ? 32 : 30};
+
+	/// shift of first level index, blocks smaller than (1 << firstLevelIndexShift) are all in the first list
+	constexpr static size_t firstLevelIndexShift {secondLevelIndexCountLog2 + __builtin_ctzl(alignment)};
+
+	/// number of first level lists
+	constexpr static size_t firstLevelIndexCount {firstLevelIndexMax - firstLevelIndexShift + 1};
+
+	/// limit of size of "small" blocks, which are kept in the first list
+	constexpr static size_t smallBlockSize {size_t{1} << firstLevelIndexShift};
+
+	/// overhead of used block, bytes
+	constexpr static size_t blockOverhead {alignment};
+
+	/// offset of usable memory from the beginning of block header, bytes
+	constexpr static size_t blockStartOffset {offsetof(BlockHeader, nextFree)};
+
+	/// minimal size of block, bytes
+	constexpr static size_t blockSizeMin {sizeof(BlockHeader) - blockOverhead};
+
+	/// limit of size of block, bytes
+	constexpr static size_t blockSizeMax {size_t{1} << firstLevelIndexMax};
+
+	/// bit in BlockHeader::size set if block is free
+	constexpr static size_t freeBit {1 << 0};
+
+	/// bit in BlockHeader::size set if previous physical block is free
+	constexpr static size_t previousFreeBit {1 << 1};
+
+	static_assert(sizeof(uint32_t) * CHAR_BIT >= secondLevelIndexCount, "Second level bitmap is too small!");
+	static_assert(sizeof(uint32_t) * CHAR_BIT >= firstLevelIndexCount, "First level bitmap is too small!");
+	static_assert(sizeof(BlockHeader) == blockSizeMin + blockOverhead, "Invalid layout of BlockHeader!");
+	static_assert(smallBlockSize / secondLevelIndexCount == alignment, "Invalid granularity of first list!");
+
+	/**
+	 * \brief Converts requested size of block to actual size.
+	 *
+	 * \param [in] size is the requested size of block, bytes
+	 * \param [in] requestedAlignment is the requested alignment of block
+	 *
+	 * \return actual size of block, 0 if \a size is 0 or if it is too large
+	 */
+
+	static size_t adjustRequestSize(size_t size, size_t requestedAlignment);
+
+	/**
+	 * \param [in] pointer is a pointer to usable memory of block
+	 *
+	 * \return pointer to header of block
+	 */
+
+	static BlockHeader* blockFromPointer(const void* pointer);
+
+	/**
+	 * \brief Links next physical block with \a block.
+	 *
+	 * \param [in] block is a pointer to block
+	 *
+	 * \return pointer to next physical block
+	 */
+
+	static BlockHeader* linkNext(BlockHeader* block);
+
+	/**
+	 * \brief Finds indexes of list to which block of given size belongs.
+	 *
+	 * \param [in] size is the size of block, bytes
+	 * \param [out] firstLevelIndex is a reference to variable for first level index
+	 * \param [out] secondLevelIndex is a reference to variable for second level index
+	 */
+
+	static void mappingInsert(size_t size, size_t& firstLevelIndex, size_t& secondLevelIndex);
+
+	/**
+	 * \brief Finds indexes of first list which may contain block of given size.
+	 *
+	 * \param [in] size is the size of block, bytes
+	 * \param [out] firstLevelIndex is a reference to variable for first level index
+	 * \param [out] secondLevelIndex is a reference to variable for second level index
+	 */
+
+	static void mappingSearch(size_t size, size_t& firstLevelIndex, size_t& secondLevelIndex);
+
+	/**
+	 * \brief Marks block as free.
+	 *
+	 * \param [in] block is a pointer to block
+	 */
+
+	static void markAsFree(BlockHeader* block);
+
+	/**
+	 * \brief Marks block as used.
+	 *
+	 * \param [in] block is a pointer to block
+	 */
+
+	static void markAsUsed(BlockHeader* block);
+
+	/**
+	 * \param [in] block is a pointer to block
+	 *
+	 * \return pointer to next physical block
+	 */
+
+	static BlockHeader* nextBlock(const BlockHeader* block);
+
+	/**
+	 * \param [in] block is a pointer to block
+	 *
+	 * \return size of block, bytes
+	 */
+
+	constexpr static size_t sizeOf(const BlockHeader* const block)
+	{
+		return block->size & ~(freeBit | previousFreeBit);
+	}
+
+	/**
+	 * \brief Splits block into two parts.
+	 *
+	 * \param [in] block is a pointer to block which will be split
+	 * \param [in] size is the size of first part, bytes
+	 *
+	 * \return pointer to second part, which is marked as free
+	 */
+
+	static BlockHeader* split(BlockHeader* block, size_t size);
+
+	/**
+	 * \brief Absorbs block into previous physical block.
+	 *
+	 * \param [in] previous is a pointer to previous physical block of \a block
+	 * \param [in] block is a pointer to block
+	 *
+	 * \return \a previous
+	 */
+
+	static BlockHeader* absorb(BlockHeader* previous, BlockHeader* block);
+
+	/**
+	 * \brief Inserts free block into its segregated list.
+	 *
+	 * \param [in] block is a pointer to free block
+	 */
+
+	void insert(BlockHeader* block);
+
+	/**
+	 * \brief Finds and removes free block of given size from segregated lists.
+	 *
+	 * \param [in] size is the size of block, bytes
+	 *
+	 * \return pointer to found block, nullptr if there is no free block big enough
+	 */
+
+	BlockHeader* locateFree(size_t size);
+
+	/**
+	 * \brief Merges block with next physical block if it is free.
+	 *
+	 * \param [in] block is a pointer to block
+	 *
+	 * \return pointer to merged block
+	 */
+
+	BlockHeader* mergeNext(BlockHeader* block);
+
+	/**
+	 * \brief Merges block with previous physical block if it is free.
+	 *
+	 * \param [in] block is a pointer to block
+	 *
+	 * \return pointer to merged block
+	 */
+
+	BlockHeader* mergePrevious(BlockHeader* block);
+
+	/**
+	 * \brief Trims found free block to requested size and marks it as used.
+	 *
+	 * \param [in] block is a pointer to free block, may be nullptr
+	 * \param [in] size is the requested size of block, bytes
+	 *
+	 * \return pointer to usable memory of \a block, nullptr if \a block is nullptr
+	 */
+
+	void* prepareUsed(BlockHeader* block, size_t size);
+
+	/**
+	 * \brief Removes free block from its segregated list.
+	 *
+	 * \param [in] block is a pointer to free block
+	 */
+
+	void remove(BlockHeader* block);
+
+	/**
+	 * \brief Removes free block from selected segregated list.
+	 *
+	 * \param [in] block is a pointer to free block
+	 * \param [in] firstLevelIndex is the first level index of list
+	 * \param [in] secondLevelIndex is the second level index of list
+	 */
+
+	void removeFree(BlockHeader* block, size_t firstLevelIndex, size_t secondLevelIndex);
+
+	/**
+	 * \brief Splits the leading part of free block and returns it to segregated lists.
+	 *
+	 * \param [in] block is a pointer to free block
+	 * \param [in] size is the size of leading part, bytes
+	 *
+	 * \return pointer to remaining part of block
+	 */
+
+	BlockHeader* trimFreeLeading(BlockHeader* block, size_t size);
+
+	/**
+	 * \brief Splits the trailing part of used block and returns it to segregated lists.
+	 *
+	 * \param [in] block is a pointer to used block
+	 * \param [in] size is the requested size of block, bytes
+	 */
+
+	void trimUsed(BlockHeader* block, size_t size);
+
+	/// empty block, used as a terminator of segregated lists
+	BlockHeader nullBlock_;
+
+	/// segregated lists of free blocks
+	BlockHeader* blocks_[firstLevelIndexCount][secondLevelIndexCount];
+
+	/// bitmaps of non-empty second level lists
+	uint32_t secondLevelBitmaps_[firstLevelIndexCount];
+
+	/// bitmap of first level lists with non-empty second level lists
+	uint32_t firstLevelBitmap_;
+
+	/// total usable size of all pools, bytes
+	size_t totalSize_;
+
+	/// size of all used blocks, bytes
+	size_t usedSize_;
+
+	/// high-water mark of usedSize_, bytes
+	size_t maxUsedSize_;
+
+	/// number of successful allocations
+	size_t allocations_;
+
+	/// number of failed allocations
+	size_t failures_;
+};
+
+#endif	// TLSF_HPP_
@@ -0,0 +1,264 @@
+/**
+ * \file
+ * \brief TxScheduler class header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TXSCHEDULER_HPP_
+#define TXSCHEDULER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/// class of transmitted frame
+enum class TxClass : uint8_t
+{
+	/// latency-sensitive frames - ARP, ICMP, DNS, DHCP, MQTT, TCP segments without payload and DSCP CS3 or higher
+	control,
+	/// all other frames
+	bulk,
+
+	/// number of classes
+	count
+};
+
+/**
+ * \brief Classifies transmitted frame.
+ *
+ * Like PacketCaptureFilter, the classifier looks only at fixed offsets of Ethernet, IPv4 and TCP/UDP headers. DSCP is
+ * checked first, so that a pcb with IP_TOS set by the application is always treated as control traffic. Segments of
+ * MQTT connections (port 1883 or 8883) are control traffic regardless of their length, so keep-alives and PUBACKs are
+ * never stuck behind a bulk transfer.
+ *
+ * \param [in] frame is a pointer to frame (including MAC header)
+ * \param [in] length is the number of contiguous bytes at \a frame
+ *
+ * \return class of frame
+ */
+
+inline TxClass classifyFrame(const uint8_t* const frame, const size_t length)
+{
+	constexpr size_t etherTypeOffset {12};
+	constexpr size_t ipv4Offset {14};
+	if (length < ipv4Offset)
+		return TxClass::bulk;
+
+	const uint16_t etherType = frame[etherTypeOffset] << 8 | frame[etherTypeOffset + 1];
+	if (etherType == 0x0806)	// ARP?
+		return TxClass::control;
+	if (etherType != 0x0800 || length < ipv4Offset + 20)
+		return TxClass::bulk;
+
+	constexpr uint8_t dscpCs3 {24};
+	if ((frame[ipv4Offset + 1] >> 2) >= dscpCs3)
+		return TxClass::control;
+
+	const uint8_t ipProtocol {frame[ipv4Offset + 9]};
+	if (ipProtocol == 1)	// ICMP?
+		return TxClass::control;
+	if (ipProtocol != 6 && ipProtocol != 17)	// neither TCP nor UDP?
+		return TxClass::bulk;
+	if ((frame[ipv4Offset + 6] & 0x1f) != 0 || frame[ipv4Offset + 7] != 0)	// not the first fragment?
+		return TxClass::bulk;
+
+	const size_t ipv4HeaderLength {(frame[ipv4Offset] & 0xf) * 4u};
+	const size_t portsOffset {ipv4Offset + ipv4HeaderLength};
+	if (length < portsOffset + 4)
+		return TxClass::bulk;
+
+	const uint16_t sourcePort = frame[portsOffset] << 8 | frame[portsOffset + 1];
+	const uint16_t destinationPort = frame[portsOffset + 2] << 8 | frame[portsOffset + 3];
+	if (ipProtocol == 17)
+	{
+		const auto controlPort = [](const uint16_t port)
+				{
+					return port == 53 || port == 67 || port == 68;	// DNS or DHCP?
+				};
+		return controlPort(sourcePort) == true || controlPort(destinationPort) == true ? TxClass::control :
+				TxClass::bulk;
+	}
+
+	const auto mqttPort = [](const uint16_t port)
+			{
+				return port == 1883 || port == 8883;
+			};
+	if (mqttPort(sourcePort) == true || mqttPort(destinationPort) == true)
+		return TxClass::control;
+
+	if (length < portsOffset + 13)
+		return TxClass::bulk;
+
+	const size_t ipv4TotalLength = frame[ipv4Offset + 2] << 8 | frame[ipv4Offset + 3];
+	const size_t tcpHeaderLength {(frame[portsOffset + 12] >> 4) * 4u};
+	// pure ACK, SYN, FIN or RST
+	return ipv4TotalLength <= ipv4HeaderLength + tcpHeaderLength ? TxClass::control : TxClass::bulk;
+}
+
+/**
+ * \brief TxScheduler class is a set of FIFO queues of transmitted frames, one per TxClass, served with strict priority.
+ *
+ * Control queue is always served first, except when \a StarvationLimit control frames were served in a row while bulk
+ * queue was not empty - then one bulk frame is served, so bulk traffic is slowed down by a flood of control frames, but
+ * never stopped.
+ *
+ * \warning The object is not thread-safe.
+ *
+ * \tparam T is the type of queued element
+ * \tparam Capacity is the capacity of each queue, must be a power of 2
+ * \tparam StarvationLimit is the max number of control frames served in a row while bulk queue is not empty
+ */
+
+template<typename T, size_t Capacity, size_t StarvationLimit>
+class TxScheduler
+{
+	static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2!");
+	static_assert(StarvationLimit != 0, "StarvationLimit must not be 0!");
+
+public:
+
+	/**
+	 * \brief TxScheduler's constructor
+	 */
+
+	constexpr TxScheduler() :
+			queues_{},
+			controlStreak_{},
+			starvationGuardCount_{}
+	{
+
+	}
+
+	/**
+	 * \return true if all queues are empty, false otherwise
+	 */
+
+	bool empty() const
+	{
+		for (auto& queue : queues_)
+			if (queue.head != queue.tail)
+				return false;
+
+		return true;
+	}
+
+	/**
+	 * \brief Returns element which should be served next, without removing it.
+	 *
+	 * \param [out] txClass is the class of returned element, not modified if all queues are empty
+	 *
+	 * \return pointer to element which should be served next, nullptr if all queues are empty
+	 */
+
+	T* front(TxClass& txClass)
+	{
+		auto& control = queues_[static_cast<size_t>(TxClass::control)];
+		auto& bulk = queues_[static_cast<size_t>(TxClass::bulk)];
+		const auto bulkWaiting = bulk.head != bulk.tail;
+		if (control.head != control.tail && (bulkWaiting == false || controlStreak_ < StarvationLimit))
+		{
+			txClass = TxClass::control;
+			return &control.elements[control.tail % Capacity];
+		}
+		if (bulkWaiting == false)
+			return {};
+
+		txClass = TxClass::bulk;
+		return &bulk.elements[bulk.tail % Capacity];
+	}
+
+	/**
+	 * \return number of bulk elements served only because of the starvation guard
+	 */
+
+	uint32_t getStarvationGuardCount() const
+	{
+		return starvationGuardCount_;
+	}
+
+	/**
+	 * \brief Removes element returned by the last call to front().
+	 *
+	 * \param [in] txClass is the class of removed element, as returned by front()
+	 */
+
+	void pop(const TxClass txClass)
+	{
+		auto& queue = queues_[static_cast<size_t>(txClass)];
+		++queue.tail;
+
+		if (txClass == TxClass::bulk)
+		{
+			if (controlStreak_ >= StarvationLimit && queues_[static_cast<size_t>(TxClass::control)].head !=
+					queues_[static_cast<size_t>(TxClass::control)].tail)
+				++starvationGuardCount_;
+			controlStreak_ = {};
+		}
+		else if (queues_[static_cast<size_t>(TxClass::bulk)].head != queues_[static_cast<size_t>(TxClass::bulk)].tail)
+			++controlStreak_;
+		else
+			controlStreak_ = {};
+	}
+
+	/**
+	 * \brief Pushes element to the back of queue.
+	 *
+	 * \param [in] txClass is the class of pushed element
+	 * \param [in] value is the pushed element
+	 *
+	 * \return true if element was pushed, false if queue of \a txClass is full
+	 */
+
+	bool push(const TxClass txClass, const T& value)
+	{
+		auto& queue = queues_[static_cast<size_t>(txClass)];
+		if (queue.head - queue.tail == Capacity)
+			return false;
+
+		queue.elements[queue.head % Capacity] = value;
+		++queue.head;
+		return true;
+	}
+
+	/**
+	 * \return capacity of each queue
+	 */
+
+	constexpr static size_t capacity()
+	{
+		return Capacity;
+	}
+
+	TxScheduler(const TxScheduler&) = delete;
+	const TxScheduler& operator=(const TxScheduler&) = delete;
+
+private:
+
+	/// FIFO queue of one class
+	struct Queue
+	{
+		/// storage for elements
+		T elements[Capacity];
+
+		/// number of pushed elements, wraps around
+		size_t head;
+
+		/// number of popped elements, wraps around
+		size_t tail;
+	};
+
+	/// queues of all classes
+	Queue queues_[static_cast<size_t>(TxClass::count)];
+
+	/// number of control elements served in a row while bulk queue was not empty
+	size_t controlStreak_;
+
+	/// number of bulk elements served only because of the starvation guard
+	uint32_t starvationGuardCount_;
+};
+
+#endif	// TXSCHEDULER_HPP_
@@ -0,0 +1,236 @@
+/**
+ * \file
+ * \brief Benchmark comparing latency of Tlsf with latency of host's malloc()
+ *
+ * Both allocators execute exactly the same pseudo-random sequence of allocations and deallocations, with sizes similar
+ * to the ones used by the application (small control blocks, pbufs and occasional thread stacks). Latency of each
+ * operation is measured separately, so not only the average, but also percentiles and the worst case are reported.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "Tlsf.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single operation of workload
+struct Operation
+{
+	/// size of allocated block, 0 for deallocation
+	size_t size;
+
+	/// index of slot in which the pointer is stored
+	size_t slot;
+};
+
+/// latencies of operations of one type, nanoseconds
+using Latencies = std::vector<uint32_t>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of operations in workload
+constexpr size_t operationsCount {2000000};
+
+/// max number of simultaneously allocated blocks
+constexpr size_t slotsCount {256};
+
+/// size of memory pool for Tlsf, bytes
+constexpr size_t poolSize {1024 * 1024};
+
+/// memory pool for Tlsf
+alignas(Tlsf::alignment) uint8_t pool[poolSize];
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Generates pseudo-random workload.
+ *
+ * \return vector with operations
+ */
+
+std::vector<Operation> generateWorkload()
+{
+	std::mt19937 generator {1};
+	std::uniform_int_distribution<size_t> slotDistribution {0, slotsCount - 1};
+	std::uniform_int_distribution<size_t> typeDistribution {0, 99};
+	std::uniform_int_distribution<size_t> smallDistribution {16, 256};
+	std::uniform_int_distribution<size_t> mediumDistribution {256, 1600};
+	std::uniform_int_distribution<size_t> largeDistribution {2048, 8192};
+
+	std::vector<Operation> workload;
+	workload.reserve(operationsCount);
+	std::vector<bool> allocated(slotsCount);
+	while (workload.size() < operationsCount)
+	{
+		const auto slot = slotDistribution(generator);
+		if (allocated[slot] == true)
+			workload.push_back({0, slot});
+		else
+		{
+			const auto type = typeDistribution(generator);
+			const auto size = type < 70 ? smallDistribution(generator) : type < 97 ? mediumDistribution(generator) :
+					largeDistribution(generator);
+			workload.push_back({size, slot});
+		}
+
+		allocated[slot] = !allocated[slot];
+	}
+
+	return workload;
+}
+
+/**
+ * \brief Prints summary of latencies.
+ *
+ * \param [in] name is the name of allocator and operation
+ * \param [in,out] latencies is a reference to latencies, they are sorted by this function
+ */
+
+void printLatencies(const char* const name, Latencies& latencies)
+{
+	if (latencies.empty() == true)
+		return;
+
+	std::sort(latencies.begin(), latencies.end());
+	uint64_t sum {};
+	for (const auto latency : latencies)
+		sum += latency;
+
+	const auto percentile = [&latencies](const size_t permille)
+			{
+				return latencies[(latencies.size() - 1) * permille / 1000];
+			};
+	printf("%-18s %10zu %10.1f %8u %8u %8u %10u\n", name, latencies.size(),
+			static_cast<double>(sum) / latencies.size(), percentile(500), percentile(990), percentile(999),
+			latencies.back());
+}
+
+/**
+ * \brief Runs workload and measures latency of each operation.
+ *
+ * \param [in] name is the name of allocator
+ * \param [in] workload is a reference to workload
+ * \param [in] allocate is a functor used to allocate memory
+ * \param [in] deallocate is a functor used to deallocate memory
+ */
+
+template<typename Allocate, typename Deallocate>
+void runWorkload(const char* const name, const std::vector<Operation>& workload, Allocate allocate,
+		Deallocate deallocate)
+{
+	Latencies allocationLatencies;
+	Latencies deallocationLatencies;
+	allocationLatencies.reserve(workload.size());
+	deallocationLatencies.reserve(workload.size());
+	void* slots[slotsCount] {};
+	size_t failures {};
+
+	for (const auto& operation : workload)
+	{
+		auto& slot = slots[operation.slot];
+		if (operation.size != 0)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			slot = allocate(operation.size);
+			const auto end = std::chrono::steady_clock::now();
+			allocationLatencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+			if (slot == nullptr)
+				++failures;
+			else
+				memset(slot, 0x5a, std::min<size_t>(operation.size, 64));
+		}
+		else
+		{
+			const auto start = std::chrono::steady_clock::now();
+			deallocate(slot);
+			const auto end = std::chrono::steady_clock::now();
+			deallocationLatencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+			slot = {};
+		}
+	}
+
+	for (const auto slot : slots)
+		deallocate(slot);
+
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%s/allocate", name);
+	printLatencies(buffer, allocationLatencies);
+	snprintf(buffer, sizeof(buffer), "%s/deallocate", name);
+	printLatencies(buffer, deallocationLatencies);
+	if (failures != 0)
+		printf("%s: %zu failed allocations\n", name, failures);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	const auto workload = generateWorkload();
+
+	// touch whole pool, so that page faults don't affect measurements
+	memset(pool, 0, sizeof(pool));
+
+	Tlsf tlsf;
+	if (tlsf.addPool(pool, sizeof(pool)) == false)
+	{
+		fprintf(stderr, "Could not add pool to Tlsf\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("%-18s %10s %10s %8s %8s %8s %10s\n", "[ns]", "count", "average", "p50", "p99", "p99.9", "max");
+
+	// warm-up of host's malloc(), so that its arena is already extended to the size required by the workload
+	{
+		void* slots[slotsCount] {};
+		for (size_t i {}; i < workload.size() / 10; ++i)
+		{
+			auto& slot = slots[workload[i].slot];
+			std::free(slot);
+			slot = workload[i].size != 0 ? std::malloc(workload[i].size) : nullptr;
+		}
+		for (const auto slot : slots)
+			std::free(slot);
+	}
+
+	runWorkload("malloc", workload, std::malloc, std::free);
+	runWorkload("tlsf", workload,
+			[&tlsf](const size_t size)
+			{
+				return tlsf.allocate(size);
+			},
+			[&tlsf](void* const pointer)
+			{
+				tlsf.deallocate(pointer);
+			});
+
+	const auto statistics = tlsf.getStatistics();
+	printf("\ntlsf: total=%zu max used=%zu free blocks after run=%zu failures=%zu\n", statistics.totalSize,
+			statistics.maxUsedSize, statistics.freeBlocks, statistics.failures);
+	return statistics.usedSize == 0 && statistics.freeBlocks == 1 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
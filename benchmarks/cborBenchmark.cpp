@@ -0,0 +1,481 @@
+/**
+ * \file
+ * \brief Verification and benchmark of CBOR encoding of telemetry
+ *
+ * CborEncoder is verified against examples from appendix A of RFC 8949 (also at compile time), with contiguous buffer
+ * and with a chain of small buffers (like pbufs), and CborDecoder is verified by decoding the same examples and
+ * truncated inputs. Then batches of timestamped samples are encoded in three ways - as one MQTT publish per value with
+ * ASCII payload (like TELEMETRY without TELEMETRY_CBOR, timestamps are lost), as one publish with JSON payload and as
+ * one publish with CBOR payload (encodeTelemetryBatch()) - and size of payloads, total size of MQTT packets, number of
+ * publishes and encoding time are printed for each size of batch.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "TelemetryEngine.hpp"
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// element of chain of buffers, equivalent of pbuf
+struct Node
+{
+	/// next element of chain
+	Node* next;
+
+	/// pointer to buffer
+	void* payload;
+
+	/// size of buffer, bytes
+	uint16_t len;
+};
+
+/// example from RFC 8949
+struct Example
+{
+	/// description of example
+	const char* name;
+
+	/// expected encoding
+	std::vector<uint8_t> expected;
+
+	/// function which encodes the example
+	void (*encode)(CborEncoder<CborBufferWriter>& encoder);
+};
+
+/// format of telemetry
+struct Format
+{
+	/// name of format
+	const char* name;
+
+	/**
+	 * \brief Encodes batch of samples.
+	 *
+	 * \param [in] samples is a pointer to array with samples
+	 * \param [in] count is the number of elements in \a samples
+	 * \param [out] buffer is a buffer for MQTT packets
+	 * \param [in] size is the size of \a buffer, bytes
+	 * \param [out] payloadBytes is a reference to variable for total size of payloads, bytes
+	 *
+	 * \return number of MQTT packets
+	 */
+
+	size_t (*encode)(const TelemetrySample* samples, size_t count, uint8_t* buffer, size_t size,
+			size_t& payloadBytes);
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// prefix of topics, same length as in the application
+constexpr char topicPrefix[] {"distortos/0.7.0/ST,32F746GDISCOVERY/telemetry/"};
+
+/// topic of batches
+constexpr char batchTopic[] {"batch"};
+
+/// data points of simulated samples
+const TelemetryPoint points[]
+{
+		{"temperature", {}, {}, 5, 1000, 5000, 300000, 1},
+		{"vdda", {}, {}, 20, 1000, 5000, 300000, 3},
+		{"pressure", {}, {}, 10, 1000, 5000, 300000, 2},
+		{"flow", {}, {}, 1, 1000, 5000, 300000, 0},
+};
+
+/// CBOR encoded at compile time - [1, "a", 4([-2, 27315])]
+constexpr auto compileTimeEncoding = []()
+		{
+			std::array<uint8_t, 16> buffer {};
+			CborBufferWriter writer {buffer.data(), buffer.size()};
+			CborEncoder<CborBufferWriter> encoder {writer};
+			encoder.beginArray(3);
+			encoder.encodeUnsigned(1);
+			encoder.encodeText("a");
+			encoder.encodeDecimalFraction(27315, -2);
+			return buffer;
+		}();
+
+static_assert(compileTimeEncoding[0] == 0x83 && compileTimeEncoding[1] == 0x01 && compileTimeEncoding[2] == 0x61 &&
+		compileTimeEncoding[3] == 'a' && compileTimeEncoding[4] == 0xc4 && compileTimeEncoding[5] == 0x82 &&
+		compileTimeEncoding[6] == 0x21 && compileTimeEncoding[7] == 0x19 && compileTimeEncoding[8] == 0x6a &&
+		compileTimeEncoding[9] == 0xb3, "Invalid encoding at compile time!");
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Encodes batch as one MQTT publish per value with ASCII payload.
+ *
+ * \param [in] samples is a pointer to array with samples
+ * \param [in] count is the number of elements in \a samples
+ * \param [out] buffer is a buffer for MQTT packets
+ * \param [in] size is the size of \a buffer, bytes
+ * \param [out] payloadBytes is a reference to variable for total size of payloads, bytes
+ *
+ * \return number of MQTT packets
+ */
+
+size_t encodePerValue(const TelemetrySample* const samples, const size_t count, uint8_t* const buffer,
+		const size_t size, size_t& payloadBytes)
+{
+	size_t length {};
+	payloadBytes = {};
+	for (size_t i {}; i < count; ++i)
+	{
+		char payload[13];
+		const auto payloadLength = formatTelemetryValue(samples[i].value, samples[i].point->decimals, payload,
+				sizeof(payload));
+		payloadBytes += payloadLength;
+		length += encodeMqttPublish(buffer + length, size - length, topicPrefix, samples[i].point->topic, payload,
+				payloadLength);
+	}
+
+	return count;
+}
+
+/**
+ * \brief Encodes batch as one MQTT publish with JSON payload, with the same structure as CBOR batch.
+ *
+ * \param [in] samples is a pointer to array with samples
+ * \param [in] count is the number of elements in \a samples
+ * \param [out] buffer is a buffer for MQTT packets
+ * \param [in] size is the size of \a buffer, bytes
+ * \param [out] payloadBytes is a reference to variable for total size of payloads, bytes
+ *
+ * \return number of MQTT packets
+ */
+
+size_t encodeJson(const TelemetrySample* const samples, const size_t count, uint8_t* const buffer, const size_t size,
+		size_t& payloadBytes)
+{
+	static char payload[32 * 1024];
+	const auto time = samples[count - 1].time;
+	auto length = static_cast<size_t>(snprintf(payload, sizeof(payload), "{\"t\":%" PRIu32 ",\"s\":[", time));
+	for (size_t i {}; i < count; ++i)
+	{
+		char value[13];
+		formatTelemetryValue(samples[i].value, samples[i].point->decimals, value, sizeof(value));
+		length += snprintf(payload + length, sizeof(payload) - length, "%s[\"%s\",%" PRId32 ",%s]", i == 0 ? "" : ",",
+				samples[i].point->topic, static_cast<int32_t>(samples[i].time - time), value);
+	}
+	length += snprintf(payload + length, sizeof(payload) - length, "]}");
+	payloadBytes = length;
+	encodeMqttPublish(buffer, size, topicPrefix, batchTopic, payload, length);
+	return 1;
+}
+
+/**
+ * \brief Encodes batch as one MQTT publish with CBOR payload.
+ *
+ * \param [in] samples is a pointer to array with samples
+ * \param [in] count is the number of elements in \a samples
+ * \param [out] buffer is a buffer for MQTT packets
+ * \param [in] size is the size of \a buffer, bytes
+ * \param [out] payloadBytes is a reference to variable for total size of payloads, bytes
+ *
+ * \return number of MQTT packets
+ */
+
+size_t encodeCbor(const TelemetrySample* const samples, const size_t count, uint8_t* const buffer, const size_t size,
+		size_t& payloadBytes)
+{
+	static uint8_t payload[32 * 1024];
+	CborBufferWriter writer {payload, sizeof(payload)};
+	CborEncoder<CborBufferWriter> encoder {writer};
+	encodeTelemetryBatch(encoder, samples[count - 1].time, samples, count);
+	payloadBytes = writer.getLength();
+	encodeMqttPublish(buffer, size, topicPrefix, batchTopic, payload, writer.getLength());
+	return 1;
+}
+
+/**
+ * \brief Verifies encoder and decoder with examples from RFC 8949.
+ *
+ * \return true if all checks passed, false otherwise
+ */
+
+bool verifyExamples()
+{
+	const Example examples[]
+	{
+			{"0", {0x00}, [](auto& encoder) { encoder.encodeUnsigned(0); }},
+			{"23", {0x17}, [](auto& encoder) { encoder.encodeUnsigned(23); }},
+			{"24", {0x18, 0x18}, [](auto& encoder) { encoder.encodeUnsigned(24); }},
+			{"1000", {0x19, 0x03, 0xe8}, [](auto& encoder) { encoder.encodeUnsigned(1000); }},
+			{"1000000", {0x1a, 0x00, 0x0f, 0x42, 0x40}, [](auto& encoder) { encoder.encodeUnsigned(1000000); }},
+			{"1000000000000", {0x1b, 0x00, 0x00, 0x00, 0xe8, 0xd4, 0xa5, 0x10, 0x00},
+					[](auto& encoder) { encoder.encodeUnsigned(1000000000000); }},
+			{"18446744073709551615", {0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+					[](auto& encoder) { encoder.encodeUnsigned(UINT64_MAX); }},
+			{"-1", {0x20}, [](auto& encoder) { encoder.encodeSigned(-1); }},
+			{"-100", {0x38, 0x63}, [](auto& encoder) { encoder.encodeSigned(-100); }},
+			{"-1000", {0x39, 0x03, 0xe7}, [](auto& encoder) { encoder.encodeSigned(-1000); }},
+			{"false", {0xf4}, [](auto& encoder) { encoder.encodeBool(false); }},
+			{"true", {0xf5}, [](auto& encoder) { encoder.encodeBool(true); }},
+			{"null", {0xf6}, [](auto& encoder) { encoder.encodeNull(); }},
+			{"1(1363896240)", {0xc1, 0x1a, 0x51, 0x4b, 0x67, 0xb0},
+					[](auto& encoder) { encoder.encodeTag(1); encoder.encodeUnsigned(1363896240); }},
+			{"h'01020304'", {0x44, 0x01, 0x02, 0x03, 0x04},
+					[](auto& encoder) { const uint8_t bytes[] {1, 2, 3, 4}; encoder.encodeBytes(bytes, 4); }},
+			{"\"\"", {0x60}, [](auto& encoder) { encoder.encodeText(""); }},
+			{"\"IETF\"", {0x64, 0x49, 0x45, 0x54, 0x46}, [](auto& encoder) { encoder.encodeText("IETF"); }},
+			{"[1, [2, 3], [4, 5]]", {0x83, 0x01, 0x82, 0x02, 0x03, 0x82, 0x04, 0x05},
+					[](auto& encoder)
+					{
+						encoder.beginArray(3);
+						encoder.encodeUnsigned(1);
+						encoder.beginArray(2);
+						encoder.encodeUnsigned(2);
+						encoder.encodeUnsigned(3);
+						encoder.beginArray(2);
+						encoder.encodeUnsigned(4);
+						encoder.encodeUnsigned(5);
+					}},
+			{"{\"a\": 1, \"b\": [2, 3]}", {0xa2, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0x02, 0x03},
+					[](auto& encoder)
+					{
+						encoder.beginMap(2);
+						encoder.encodeText("a");
+						encoder.encodeUnsigned(1);
+						encoder.encodeText("b");
+						encoder.beginArray(2);
+						encoder.encodeUnsigned(2);
+						encoder.encodeUnsigned(3);
+					}},
+	};
+
+	bool success {true};
+	for (auto& example : examples)
+	{
+		uint8_t buffer[16] {};
+		CborBufferWriter writer {buffer, sizeof(buffer)};
+		CborEncoder<CborBufferWriter> encoder {writer};
+		example.encode(encoder);
+		if (encoder.isValid() == false || writer.getLength() != example.expected.size() ||
+				std::equal(example.expected.begin(), example.expected.end(), buffer) == false)
+		{
+			printf("invalid encoding of %s\n", example.name);
+			success = false;
+		}
+
+		// decoder must consume the whole example as one item and reject all truncated versions of it
+		CborDecoder decoder {example.expected.data(), example.expected.size()};
+		if (decoder.skip() == false || decoder.getRemaining() != 0)
+		{
+			printf("invalid decoding of %s\n", example.name);
+			success = false;
+		}
+		for (size_t length {}; length < example.expected.size(); ++length)
+		{
+			CborDecoder truncatedDecoder {example.expected.data(), length};
+			if (truncatedDecoder.skip() == true)
+			{
+				printf("truncated encoding of %s (%zu bytes) was not rejected\n", example.name, length);
+				success = false;
+			}
+		}
+
+		// output which is too small by one byte must be detected
+		if (example.expected.size() > 1)
+		{
+			CborBufferWriter smallWriter {buffer, example.expected.size() - 1};
+			CborEncoder<CborBufferWriter> smallEncoder {smallWriter};
+			example.encode(smallEncoder);
+			if (smallEncoder.isValid() == true)
+			{
+				printf("too small output for %s was not detected\n", example.name);
+				success = false;
+			}
+		}
+	}
+
+	{
+		const uint8_t encoded[] {0x3b, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x64, 0x49, 0x45, 0x54, 0x46};
+		CborDecoder decoder {encoded, sizeof(encoded)};
+		int64_t value {};
+		CborItem item {};
+		if (decoder.nextSigned(value) == false || value != INT64_MIN || decoder.nextSigned(value) == true ||
+				decoder.next(item) == false || item.type != CborType::textString || item.value != 4 ||
+				std::equal(item.data, item.data + item.value, "IETF") == false)
+		{
+			printf("invalid decoding of -9223372036854775808, \"IETF\"\n");
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+/**
+ * \brief Verifies that batch encoded to a chain of small buffers is identical to batch encoded to contiguous buffer
+ * and that it can be decoded.
+ *
+ * \param [in] samples is a reference to vector with samples
+ *
+ * \return true if all checks passed, false otherwise
+ */
+
+bool verifyBatch(const std::vector<TelemetrySample>& samples)
+{
+	std::vector<uint8_t> contiguous(4096);
+	CborBufferWriter writer {contiguous.data(), contiguous.size()};
+	CborEncoder<CborBufferWriter> encoder {writer};
+	encodeTelemetryBatch(encoder, samples.back().time, samples.data(), samples.size());
+	contiguous.resize(writer.getLength());
+
+	std::vector<uint8_t> storage(contiguous.size());
+	std::vector<Node> nodes((storage.size() + 6) / 7);
+	for (size_t i {}; i < nodes.size(); ++i)
+		nodes[i] = {i + 1 < nodes.size() ? &nodes[i + 1] : nullptr, storage.data() + 7 * i,
+				static_cast<uint16_t>(std::min<size_t>(7, storage.size() - 7 * i))};
+	CborChainWriter<Node> chainWriter {nodes.front()};
+	CborEncoder<CborChainWriter<Node>> chainEncoder {chainWriter};
+	const auto chainValid = encodeTelemetryBatch(chainEncoder, samples.back().time, samples.data(), samples.size());
+	bool success {true};
+	if (encoder.isValid() == false || chainValid == false || storage != contiguous)
+	{
+		printf("batch encoded to chain of buffers differs from batch encoded to contiguous buffer\n");
+		success = false;
+	}
+
+	CborChainWriter<Node> shortChainWriter {nodes.front()};
+	nodes.back().len -= 1;
+	CborEncoder<CborChainWriter<Node>> shortChainEncoder {shortChainWriter};
+	if (encodeTelemetryBatch(shortChainEncoder, samples.back().time, samples.data(), samples.size()) == true)
+	{
+		printf("too short chain of buffers was not detected\n");
+		success = false;
+	}
+
+	// {"t": time, "s": [[topic, offset, value], ...]}
+	CborDecoder decoder {contiguous.data(), contiguous.size()};
+	CborItem item {};
+	int64_t value {};
+	bool valid {decoder.next(item) == true && item.type == CborType::map && item.value == 2 &&
+			decoder.next(item) == true && item.type == CborType::textString && decoder.nextSigned(value) == true &&
+			value == samples.back().time && decoder.next(item) == true && item.type == CborType::textString &&
+			decoder.next(item) == true && item.type == CborType::array && item.value == samples.size()};
+	for (size_t i {}; i < samples.size() && valid == true; ++i)
+	{
+		const auto& sample = samples[i];
+		const auto topicLength = strlen(sample.point->topic);
+		valid = decoder.next(item) == true && item.type == CborType::array && item.value == 3 &&
+				decoder.next(item) == true && item.type == CborType::textString && item.value == topicLength &&
+				std::equal(item.data, item.data + topicLength, sample.point->topic) == true &&
+				decoder.nextSigned(value) == true && value == static_cast<int32_t>(sample.time - samples.back().time);
+		if (valid == true && sample.point->decimals != 0)
+			valid = decoder.next(item) == true && item.type == CborType::tag && item.value == 4 &&
+					decoder.next(item) == true && item.type == CborType::array && item.value == 2 &&
+					decoder.nextSigned(value) == true && value == -sample.point->decimals;
+		valid = valid == true && decoder.nextSigned(value) == true && value == sample.value;
+	}
+	if (valid == false || decoder.getRemaining() != 0)
+	{
+		printf("decoded batch differs from encoded batch\n");
+		success = false;
+	}
+
+	return success;
+}
+
+/**
+ * \brief Creates timestamped samples of all data points, taken every 100 ms.
+ *
+ * \param [in] count is the number of samples
+ *
+ * \return vector with \a count samples
+ */
+
+std::vector<TelemetrySample> makeSamples(const size_t count)
+{
+	std::vector<TelemetrySample> samples(count);
+	uint32_t time {123456789};
+	for (size_t i {}; i < count; ++i)
+	{
+		const auto& point = points[i % std::size(points)];
+		if (i % std::size(points) == 0)
+			time += 100;
+		const auto variation = static_cast<int32_t>(i % 50);
+		const int32_t value {point.decimals == 0 ? 42 + variation % 7 : point.decimals == 1 ? 253 - variation % 5 :
+				point.decimals == 2 ? 101325 + variation : 3301 + variation % 3};
+		samples[i] = {&point, time, value};
+	}
+
+	return samples;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	bool success {verifyExamples()};
+	for (const size_t count : {1, 8, 64})
+		success &= verifyBatch(makeSamples(count));
+
+	const Format formats[]
+	{
+			{"per value", encodePerValue},
+			{"JSON", encodeJson},
+			{"CBOR", encodeCbor},
+	};
+
+	printf("%8s %10s %10s %12s %10s %12s %12s\n", "samples", "format", "payload", "MQTT bytes", "publishes",
+			"ns/batch", "ns/sample");
+	std::vector<uint8_t> buffer(128 * 1024);
+	for (const size_t count : {1, 8, 64, 256})
+	{
+		const auto samples = makeSamples(count);
+		for (auto& format : formats)
+		{
+			size_t payloadBytes {};
+			const auto publishes = format.encode(samples.data(), samples.size(), buffer.data(), buffer.size(),
+					payloadBytes);
+			size_t mqttBytes {};
+			for (size_t i {}; i < publishes; ++i)
+			{
+				const size_t remainingLength {buffer[mqttBytes + 1] < 128 ? buffer[mqttBytes + 1] :
+						(buffer[mqttBytes + 1] & 0x7fu) | buffer[mqttBytes + 2] << 7};
+				mqttBytes += 1 + (remainingLength < 128 ? 1 : 2) + remainingLength;
+			}
+
+			const auto iterations = std::max<size_t>(100000 / count, 100);
+			const auto start = std::chrono::steady_clock::now();
+			for (size_t i {}; i < iterations; ++i)
+			{
+				format.encode(samples.data(), samples.size(), buffer.data(), buffer.size(), payloadBytes);
+				asm volatile("" : : "r" (buffer.data()) : "memory");
+			}
+			const auto end = std::chrono::steady_clock::now();
+			const auto nanoseconds = static_cast<double>(
+					std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / iterations;
+			printf("%8zu %10s %10zu %12zu %10zu %12.1f %12.1f\n", count, format.name, payloadBytes, mqttBytes,
+					publishes, nanoseconds, nanoseconds / count);
+		}
+	}
+
+	return success == true ? EXIT_SUCCESS : EXIT_FAILURE;
+}
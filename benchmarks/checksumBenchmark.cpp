@@ -0,0 +1,192 @@
+/**
+ * \file
+ * \brief Benchmark of optimized internet checksum
+ *
+ * internetChecksum() and internetChecksumCopy() are compared with generic algorithm of lwIP (lwip_standard_chksum()
+ * with LWIP_CHKSUM_ALGORITHM 2, which sums 16-bit words, reproduced below) and with memcpy() followed by generic
+ * algorithm (lwip_chksum_copy()). Before measurement results of both implementations are compared for all alignments
+ * and many lengths.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "internetChecksum.h"
+
+#include <chrono>
+#include <random>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// max length of checksummed data, bytes
+constexpr size_t maxLength {1500};
+
+/// number of checksums in each run
+constexpr size_t checksumsCount {1000000};
+
+/// lengths of checksummed data used in benchmark - IPv4 header, small MQTT publish, default IPv4 MTU, full TCP segment
+constexpr size_t lengths[] {20, 64, 576, 1480};
+
+/// source buffer
+alignas(8) uint8_t sourceBuffer[maxLength + 8];
+
+/// destination buffer
+alignas(8) uint8_t destinationBuffer[maxLength + 8];
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Generic algorithm of lwIP, equivalent of lwip_standard_chksum() with LWIP_CHKSUM_ALGORITHM 2.
+ *
+ * \param [in] data is a pointer to summed data
+ * \param [in] length is the length of \a data, bytes
+ *
+ * \return one's complement sum of \a data folded to 16 bits (not complemented), in network byte order
+ */
+
+uint16_t genericChecksum(const void* const data, int length)
+{
+	auto byte = static_cast<const uint8_t*>(data);
+	uint32_t sum {};
+	uint16_t word {};
+	const auto odd = (reinterpret_cast<uintptr_t>(byte) & 1) != 0;
+	if (odd == true && length > 0)
+	{
+		reinterpret_cast<uint8_t*>(&word)[1] = *byte++;
+		--length;
+	}
+
+	while (length > 1)
+	{
+		uint16_t value;
+		memcpy(&value, byte, sizeof(value));
+		sum += value;
+		byte += 2;
+		length -= 2;
+	}
+
+	if (length > 0)
+		reinterpret_cast<uint8_t*>(&word)[0] = *byte;
+
+	sum += word;
+	sum = (sum >> 16) + (sum & 0xffff);
+	sum = (sum >> 16) + (sum & 0xffff);
+	if (odd == true)
+		sum = ((sum & 0xff) << 8) | ((sum & 0xff00) >> 8);
+
+	return sum;
+}
+
+/**
+ * \brief Compares results of optimized and generic implementation.
+ *
+ * \return true if results are equal for all tested alignments and lengths, false otherwise
+ */
+
+bool verify()
+{
+	std::mt19937 generator {1};
+	for (size_t pass {}; pass < 4; ++pass)
+	{
+		for (auto& byte : sourceBuffer)
+			// first pass with all bytes equal to 0xff, which is the worst case for carries
+			byte = pass == 0 ? 0xff : generator();
+
+		for (size_t offset {}; offset < 8; ++offset)
+			for (size_t length {}; length <= maxLength; ++length)
+			{
+				const auto expected = genericChecksum(sourceBuffer + offset, length);
+				const auto actual = internetChecksum(sourceBuffer + offset, length);
+				memset(destinationBuffer, {}, sizeof(destinationBuffer));
+				const auto actualCopy = internetChecksumCopy(destinationBuffer + 7 - offset, sourceBuffer + offset,
+						length);
+				if (actual != expected || actualCopy != expected ||
+						memcmp(destinationBuffer + 7 - offset, sourceBuffer + offset, length) != 0)
+				{
+					fprintf(stderr, "Mismatch for offset %zu, length %zu: expected 0x%04x, got 0x%04x and 0x%04x\n",
+							offset, length, expected, actual, actualCopy);
+					return false;
+				}
+			}
+	}
+
+	return true;
+}
+
+/**
+ * \brief Measures average time of single call of function.
+ *
+ * \param [in] function is the measured function, called with index of call
+ *
+ * \return average time of single call, nanoseconds
+ */
+
+template<typename Function>
+double measure(const Function function)
+{
+	uint32_t sum {};
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i {}; i < checksumsCount; ++i)
+		sum += function(i);
+	const auto end = std::chrono::steady_clock::now();
+
+	// use the result, so that the compiler can't remove the calls
+	volatile auto result = sum;
+	static_cast<void>(result);
+	return std::chrono::duration<double, std::nano>(end - start).count() / checksumsCount;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	if (verify() == false)
+		return EXIT_FAILURE;
+
+	printf("%-6s %6s %10s %10s %8s %12s %12s %8s\n", "[ns]", "offset", "generic", "optimized", "speedup",
+			"generic copy", "optimized copy", "speedup");
+	for (const auto length : lengths)
+		for (const size_t offset : {0, 1, 2})
+		{
+			const auto source = sourceBuffer + offset;
+			const auto generic = measure([source, length](const size_t i)
+					{
+						return genericChecksum(source, length - i % 2);
+					});
+			const auto optimized = measure([source, length](const size_t i)
+					{
+						return internetChecksum(source, length - i % 2);
+					});
+			const auto genericCopy = measure([source, length](const size_t i)
+					{
+						memcpy(destinationBuffer, source, length - i % 2);
+						return genericChecksum(destinationBuffer, length - i % 2);
+					});
+			const auto optimizedCopy = measure([source, length](const size_t i)
+					{
+						return internetChecksumCopy(destinationBuffer, source, length - i % 2);
+					});
+			printf("%-6zu %6zu %10.1f %10.1f %7.2fx %12.1f %14.1f %7.2fx\n", length, offset, generic, optimized,
+					generic / optimized, genericCopy, optimizedCopy, genericCopy / optimizedCopy);
+		}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,393 @@
+/**
+ * \file
+ * \brief Simulation of recovery of Ethernet DMA with fault injection
+ *
+ * A simulated MAC with the same chained descriptor rings as on target (4 receive and 4 transmit descriptors) exchanges
+ * frames with the driver in steps of 1 ms of virtual time. The driver reads received frames and passes frames for
+ * transmission to DMA exactly like lowLevelInput() and lowLevelOutput(), DmaWatchdog checks the rings every 100 ms and
+ * fatal bus errors are reported immediately, like by "abnormal interrupt". Recovery reinitializes both rings and
+ * restarts simulated DMA, like recoverDma(). Each scenario injects one fault (or none) in the middle of traffic and is
+ * verified - the fault must be detected with the expected DmaFault, the rings must be recovered exactly once (after
+ * the requested number of failed recoveries, like when software reset doesn't complete without clocks from PHY) and
+ * traffic must flow in both directions afterwards, while scenarios without faults must not trigger any recovery.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "DmaWatchdog.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// host equivalent of ETH_DMADescTypeDef, with members used by the driver
+struct DmaDescriptor
+{
+	/// status
+	uint32_t Status;
+
+	/// address of next descriptor
+	DmaDescriptor* Buffer2NextDescAddr;
+};
+
+/// fault injected into simulated MAC
+enum class InjectedFault : uint8_t
+{
+	/// no fault
+	none,
+	/// DMA stops all bus accesses and reports fatal bus error
+	fatalBusError,
+	/// receive DMA skips one descriptor and loses synchronization with the driver
+	rxDesynchronization,
+	/// transmit DMA stops releasing descriptors
+	txHang,
+};
+
+/// scenario of simulation
+struct Scenario
+{
+	/// name of scenario
+	const char* name;
+
+	/// injected fault
+	InjectedFault injectedFault;
+
+	/// number of frames received in each step
+	size_t rxFramesPerStep;
+
+	/// number of frames passed by the driver to DMA in each step
+	size_t txFramesPerStep;
+
+	/// true if recovery is expected, false otherwise
+	bool recoveryExpected;
+
+	/// fault which should be detected, valid only if \a recoveryExpected is true
+	DmaFault expectedFault;
+
+	/// number of recoveries which fail before the one which succeeds
+	size_t failedRecoveries;
+};
+
+/// simulated MAC with chained descriptor rings
+class SimulatedMac
+{
+public:
+
+	/// number of descriptors in each ring, same as ETH_RXBUFNB and ETH_TXBUFNB
+	constexpr static size_t descriptorsCount {4};
+
+	/// bit in Status of descriptor which is set when the descriptor is owned by DMA
+	constexpr static uint32_t ownBit {UINT32_C(1) << 31};
+
+	/// max number of frames transmitted in each step, 100 Mbit/s link transmits ~8 full-size frames per 1 ms
+	constexpr static size_t txFramesPerStep {8};
+
+	/**
+	 * \brief Initializes both rings and starts DMA, equivalent of HAL_ETH_DMARxDescListInit(),
+	 * HAL_ETH_DMATxDescListInit() and HAL_ETH_Start().
+	 *
+	 * Injected fault is cleared.
+	 */
+
+	void start()
+	{
+		for (size_t i {}; i < descriptorsCount; ++i)
+		{
+			rxDescriptors[i] = {ownBit, &rxDescriptors[(i + 1) % descriptorsCount]};
+			txDescriptors[i] = {{}, &txDescriptors[(i + 1) % descriptorsCount]};
+		}
+
+		rxDma_ = rxDescriptors;
+		txDma_ = txDescriptors;
+		fault_ = InjectedFault::none;
+	}
+
+	/**
+	 * \brief Injects fault.
+	 *
+	 * \param [in] fault is the injected fault
+	 */
+
+	void inject(const InjectedFault fault)
+	{
+		fault_ = fault;
+		if (fault == InjectedFault::rxDesynchronization)
+			rxDma_ = rxDma_->Buffer2NextDescAddr;
+	}
+
+	/**
+	 * \return true if fatal bus error was injected, false otherwise
+	 */
+
+	bool isFatalBusError() const
+	{
+		return fault_ == InjectedFault::fatalBusError;
+	}
+
+	/**
+	 * \brief Receives frame from the wire.
+	 *
+	 * \return true if frame was written to receive ring, false if it was lost
+	 */
+
+	bool receive()
+	{
+		if (fault_ == InjectedFault::fatalBusError || (rxDma_->Status & ownBit) == 0)
+			return false;
+
+		rxDma_->Status &= ~ownBit;
+		rxDma_ = rxDma_->Buffer2NextDescAddr;
+		return true;
+	}
+
+	/**
+	 * \brief Transmits frames from transmit ring to the wire, as many as the link allows in one step.
+	 */
+
+	void transmit()
+	{
+		if (fault_ == InjectedFault::fatalBusError || fault_ == InjectedFault::txHang)
+			return;
+
+		for (size_t i {}; i < txFramesPerStep && (txDma_->Status & ownBit) != 0; ++i)
+		{
+			txDma_->Status &= ~ownBit;
+			txDma_ = txDma_->Buffer2NextDescAddr;
+		}
+	}
+
+	/// receive ring
+	DmaDescriptor rxDescriptors[descriptorsCount];
+
+	/// transmit ring
+	DmaDescriptor txDescriptors[descriptorsCount];
+
+private:
+
+	/// descriptor which will be used by receive DMA for the next frame
+	DmaDescriptor* rxDma_;
+
+	/// descriptor which will be transmitted next by transmit DMA
+	DmaDescriptor* txDma_;
+
+	/// injected fault
+	InjectedFault fault_;
+};
+
+/// results of simulation of one scenario
+struct Results
+{
+	/// numbers of frames received by the driver before and after the fault
+	size_t received[2];
+
+	/// numbers of frames passed to DMA before and after the fault
+	size_t transmitted[2];
+
+	/// number of frames lost by receive DMA
+	size_t rxLost;
+
+	/// number of frames which could not be passed to DMA
+	size_t txLost;
+
+	/// number of recoveries, including failed ones
+	size_t recoveries;
+
+	/// fault detected by the first recovery
+	DmaFault detectedFault;
+
+	/// time from injection of fault to the first recovery, milliseconds
+	size_t detectionTime;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// simulated time of each scenario, milliseconds
+constexpr size_t simulatedTime {10000};
+
+/// time of injection of fault, milliseconds
+constexpr size_t injectionTime {simulatedTime / 2};
+
+/// period of checking health of DMA, milliseconds
+constexpr size_t dmaCheckPeriod {100};
+
+/// names of faults detected by the driver
+const char* const faultNames[]
+{
+		"fatalBusError",
+		"rxStall",
+		"txStall",
+};
+
+/// all scenarios
+const Scenario scenarios[]
+{
+		{"idle", InjectedFault::none, 0, 0, false, {}, 0},
+		{"saturated TX", InjectedFault::none, 1, 12, false, {}, 0},
+		{"full RX ring", InjectedFault::none, 4, 1, false, {}, 0},
+		{"fatal bus error", InjectedFault::fatalBusError, 2, 2, true, DmaFault::fatalBusError, 0},
+		{"fatal, reset fails", InjectedFault::fatalBusError, 2, 2, true, DmaFault::fatalBusError, 3},
+		{"RX desync", InjectedFault::rxDesynchronization, 2, 2, true, DmaFault::rxStall, 0},
+		{"RX desync, TX idle", InjectedFault::rxDesynchronization, 2, 0, true, DmaFault::rxStall, 0},
+		{"TX hang", InjectedFault::txHang, 2, 2, true, DmaFault::txStall, 0},
+		{"TX hang, RX idle", InjectedFault::txHang, 0, 2, true, DmaFault::txStall, 0},
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Simulates one scenario.
+ *
+ * \param [in] scenario is a reference to simulated scenario
+ *
+ * \return results of simulation
+ */
+
+Results simulate(const Scenario& scenario)
+{
+	constexpr auto ownBit = SimulatedMac::ownBit;
+
+	SimulatedMac mac;
+	DmaWatchdog<2> dmaWatchdog;
+	DmaDescriptor* rxNext;
+	DmaDescriptor* txNext;
+	uint32_t transmittedFrames {};
+	bool fatalBusErrorReported {};
+	Results results {};
+
+	const auto recover = [&](const DmaFault fault, const size_t now)
+			{
+				if (results.recoveries++ == 0)
+				{
+					results.detectedFault = fault;
+					results.detectionTime = now - injectionTime;
+				}
+
+				// equivalent of resetEthernet() which timed out, MAC is left stopped
+				if (results.recoveries <= scenario.failedRecoveries)
+				{
+					dmaWatchdog.reportFailedRecovery(fault);
+					return;
+				}
+
+				mac.start();
+				fatalBusErrorReported = {};
+				rxNext = mac.rxDescriptors;
+				txNext = mac.txDescriptors;
+				dmaWatchdog.reset();
+			};
+
+	mac.start();
+	rxNext = mac.rxDescriptors;
+	txNext = mac.txDescriptors;
+	for (size_t now {}; now < simulatedTime; ++now)
+	{
+		const auto afterFault = now >= injectionTime;
+		if (now == injectionTime)
+			mac.inject(scenario.injectedFault);
+
+		for (size_t i {}; i < scenario.rxFramesPerStep; ++i)
+			if (mac.receive() == false)
+				++results.rxLost;
+
+		// equivalent of lowLevelInput()
+		while ((rxNext->Status & ownBit) == 0)
+		{
+			++results.received[afterFault];
+			rxNext->Status |= ownBit;
+			rxNext = rxNext->Buffer2NextDescAddr;
+		}
+
+		// equivalent of lowLevelOutput()
+		for (size_t i {}; i < scenario.txFramesPerStep; ++i)
+		{
+			if ((txNext->Status & ownBit) != 0)
+			{
+				++results.txLost;
+				continue;
+			}
+
+			txNext->Status |= ownBit;
+			txNext = txNext->Buffer2NextDescAddr;
+			++transmittedFrames;
+			++results.transmitted[afterFault];
+		}
+
+		mac.transmit();
+
+		// "abnormal interrupt" is reported once, until DMA is restarted
+		if (mac.isFatalBusError() == true && fatalBusErrorReported == false)
+		{
+			fatalBusErrorReported = true;
+			recover(DmaFault::fatalBusError, now);
+		}
+
+		DmaFault fault;
+		if (now % dmaCheckPeriod == 0 &&
+				dmaWatchdog.check(isRxRingStuck<ownBit>(mac.rxDescriptors, rxNext),
+						isTxRingBusy<ownBit>(mac.txDescriptors), transmittedFrames, fault) == true)
+			recover(fault, now);
+	}
+
+	return results;
+}
+
+/**
+ * \brief Verifies results of simulation.
+ *
+ * \param [in] scenario is a reference to simulated scenario
+ * \param [in] results is a reference to results of simulation of \a scenario
+ *
+ * \return true if results are as expected, false otherwise
+ */
+
+bool verify(const Scenario& scenario, const Results& results)
+{
+	if (scenario.recoveryExpected == false)
+		return results.recoveries == 0;
+
+	// traffic after the fault must include much more than the frames exchanged before recovery
+	constexpr size_t minFramesPerStep {simulatedTime / 4};
+	return results.recoveries == 1 + scenario.failedRecoveries && results.detectedFault == scenario.expectedFault &&
+			(scenario.rxFramesPerStep == 0 || results.received[1] > minFramesPerStep * scenario.rxFramesPerStep) &&
+			(scenario.txFramesPerStep == 0 || results.transmitted[1] > minFramesPerStep * scenario.txFramesPerStep);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	printf("%-20s %10s %10s %8s %8s %10s %14s %9s %6s\n", "scenario", "received", "passed", "RX lost", "TX lost",
+			"recoveries", "detected", "time [ms]", "result");
+	bool success {true};
+	for (const auto& scenario : scenarios)
+	{
+		const auto results = simulate(scenario);
+		const auto passed = verify(scenario, results);
+		success &= passed;
+		printf("%-20s %10zu %10zu %8zu %8zu %10zu %14s %9zu %6s\n", scenario.name,
+				results.received[0] + results.received[1], results.transmitted[0] + results.transmitted[1],
+				results.rxLost, results.txLost, results.recoveries,
+				results.recoveries != 0 ? faultNames[static_cast<size_t>(results.detectedFault)] : "-",
+				results.recoveries != 0 ? results.detectionTime : 0, passed == true ? "OK" : "FAIL");
+	}
+
+	return success == true ? EXIT_SUCCESS : EXIT_FAILURE;
+}
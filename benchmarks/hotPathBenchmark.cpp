@@ -0,0 +1,705 @@
+/**
+ * \file
+ * \brief Benchmark suite of hot paths of the application, with regression check against stored baseline
+ *
+ * Each benchmark runs one operation from a critical path of the application in a loop: copy loops of Ethernet driver
+ * (dmaFrameCopy.hpp with host equivalents of DMA descriptors and pbufs), formatting and parsing of topics exactly like
+ * in main.cpp and - when sources of lwIP are available - internet checksum, pbuf_alloc() + pbuf_free() and encoding of
+ * MQTT publish, with lwIP configured as on target. Each benchmark is calibrated to run for a few milliseconds and is
+ * repeated several times, the best result is reported, as it is the least affected by noise of the host.
+ *
+ * Absolute times depend on the host (CPU, its clock, compiler), so they are not compared directly. Before and after
+ * the suite a calibration loop (bitwise CRC-32, pure integer work, independent from the code of the application) is
+ * measured in the same way and the best of these two results is used as the unit of speed of the host in this run.
+ *
+ * Results are written in CSV format (name and nanoseconds per operation, the first entry is the calibration loop). When
+ * a baseline in the same format is given, ratio of each result to the calibration loop is compared with the same ratio
+ * in the baseline and the program fails if any benchmark is slower than the baseline by more than the threshold. It
+ * also fails if any benchmark has no result in the baseline (e.g. baseline measured without lwIP), as it isn't checked.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "dmaFrameCopy.hpp"
+#include "internetChecksum.h"
+#include "mqttTopics.hpp"
+
+#if HOT_PATH_BENCHMARK_LWIP == 1
+
+#include "lwip/apps/mqtt.h"
+#include "lwip/apps/mqtt_priv.h"
+
+#include "lwip/inet_chksum.h"
+#include "lwip/init.h"
+#include "lwip/tcp.h"
+
+#endif	// HOT_PATH_BENCHMARK_LWIP == 1
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// single benchmark
+struct Benchmark
+{
+	/// name of benchmark, used as a key in results and baseline
+	const char* name;
+
+	/**
+	 * \brief Runs benchmarked operation.
+	 *
+	 * \param [in] iterations is the number of operations
+	 *
+	 * \return value derived from results of operations, prevents the compiler from removing them
+	 */
+
+	size_t (*function)(size_t iterations);
+};
+
+/// host equivalent of ETH_DMADescTypeDef, with members used by copy loops, addresses are as long as pointers
+struct DmaDescriptor
+{
+	/// status
+	uint32_t Status;
+
+	/// address of buffer
+	uintptr_t Buffer1Addr;
+
+	/// address of next descriptor
+	uintptr_t Buffer2NextDescAddr;
+};
+
+/// host equivalent of pbuf, with members used by copy loops
+struct HostPbuf
+{
+	/// next pbuf in chain
+	HostPbuf* next;
+
+	/// pointer to data
+	void* payload;
+
+	/// length of this pbuf
+	uint16_t len;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of each DMA buffer, bytes, ETH_RX_BUF_SIZE and ETH_TX_BUF_SIZE of STM32 HAL
+constexpr size_t dmaBufferSize {1524};
+
+/// number of DMA descriptors, ETH_RXBUFNB and ETH_TXBUFNB of STM32 HAL
+constexpr size_t dmaDescriptorsCount {4};
+
+/// "own" bit in status of DMA descriptor, ETH_DMATXDESC_OWN of STM32 HAL
+constexpr uint32_t dmaOwnBit {UINT32_C(1) << 31};
+
+/// size of pbuf from PBUF_POOL, PBUF_POOL_BUFSIZE of lwIP-configuration.h
+constexpr size_t poolPbufSize {1516};
+
+/// size of headers of TCP segment (Ethernet, IPv4, TCP), bytes
+constexpr size_t tcpHeadersSize {54};
+
+/// min duration of single run of benchmark
+constexpr std::chrono::milliseconds minRunDuration {20};
+
+/// number of runs of each benchmark
+constexpr size_t runsCount {7};
+
+/// default threshold of regression, percent
+constexpr double defaultThreshold {10};
+
+/// chain of DMA descriptors
+DmaDescriptor dmaDescriptors[dmaDescriptorsCount];
+
+/// DMA buffers
+uint8_t dmaBuffers[dmaDescriptorsCount][dmaBufferSize] __attribute__ ((aligned(4)));
+
+/// storage for payloads of pbufs
+uint8_t pbufStorage[2][poolPbufSize] __attribute__ ((aligned(4)));
+
+/// name of calibration loop in results and baseline
+constexpr char calibrationName[] {"calibration"};
+
+/// topics of incoming publishes, the same mix as received by the application
+const char* const incomingTopics[]
+{
+		LEDS_TOPIC_PREFIX "/0" LEDS_TOPIC_SUFFIX,
+		LEDS_TOPIC_PREFIX "/1" LEDS_TOPIC_SUFFIX,
+		LEDS_TOPIC_PREFIX "/2" LEDS_TOPIC_SUFFIX,
+		IPERF_TOPIC,
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Prevents the compiler from optimizing out computation of value and accesses to memory.
+ *
+ * \param [in] value is the value which must be computed
+ */
+
+template<typename T>
+void doNotOptimize(const T& value)
+{
+	asm volatile ("" : : "r,m" (value) : "memory");
+}
+
+/**
+ * \brief Calibration loop - bitwise CRC-32 of 64 bytes.
+ *
+ * Its speed depends only on the speed of the core (no memory accesses outside of L1 cache, no library calls), so the
+ * ratio of time of any benchmark to time of this loop doesn't depend much on the host.
+ *
+ * \param [in] iterations is the number of calculated CRCs
+ *
+ * \return value derived from calculated CRCs
+ */
+
+size_t calibration(const size_t iterations)
+{
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		doNotOptimize(pbufStorage);
+		uint32_t crc {UINT32_MAX};
+		for (size_t j {}; j < 64; ++j)
+		{
+			crc ^= pbufStorage[0][(i + j) % 2 + j];
+			for (size_t bit {}; bit < 8; ++bit)
+				crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0xedb88320 : 0);
+		}
+		sum += crc;
+	}
+	return sum;
+}
+
+/**
+ * \brief Links DMA descriptors into a ring, like HAL_ETH_DMARxDescListInit() and HAL_ETH_DMATxDescListInit().
+ */
+
+void initializeDmaDescriptors()
+{
+	for (size_t i {}; i < dmaDescriptorsCount; ++i)
+	{
+		dmaDescriptors[i].Buffer1Addr = reinterpret_cast<uintptr_t>(dmaBuffers[i]);
+		dmaDescriptors[i].Buffer2NextDescAddr = reinterpret_cast<uintptr_t>(&dmaDescriptors[(i + 1) %
+				dmaDescriptorsCount]);
+	}
+
+	for (size_t i {}; i < sizeof(dmaBuffers); ++i)
+		(&dmaBuffers[0][0])[i] = i;
+}
+
+/**
+ * \brief Benchmark of copy loop of lowLevelInput().
+ *
+ * \tparam FrameSize is the size of received frame, bytes
+ *
+ * \param [in] iterations is the number of copied frames
+ *
+ * \return value derived from copied frames
+ */
+
+template<size_t FrameSize>
+size_t rxCopy(const size_t iterations)
+{
+	static_assert(FrameSize <= poolPbufSize);
+	HostPbuf pbuf {nullptr, pbufStorage[0], FrameSize};
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		copyFromDmaBuffers<dmaBufferSize>(&dmaDescriptors[i % dmaDescriptorsCount], &pbuf);
+		doNotOptimize(pbufStorage);
+		sum += pbufStorage[0][FrameSize - 1];
+	}
+	return sum;
+}
+
+/**
+ * \brief Benchmark of copy loop of lowLevelOutput().
+ *
+ * \tparam FrameSize is the size of transmitted frame, bytes, frames longer than tcpHeadersSize are chained like TCP
+ * segments with data - pbuf with headers followed by pbuf with data
+ *
+ * \param [in] iterations is the number of copied frames
+ *
+ * \return value derived from copied frames
+ */
+
+template<size_t FrameSize>
+size_t txCopy(const size_t iterations)
+{
+	constexpr bool chained {FrameSize > tcpHeadersSize};
+	HostPbuf data {nullptr, pbufStorage[1], FrameSize - tcpHeadersSize};
+	HostPbuf headers {chained == true ? &data : nullptr, pbufStorage[0], chained == true ? tcpHeadersSize : FrameSize};
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		sum += copyToDmaBuffers<dmaBufferSize, dmaOwnBit>(&dmaDescriptors[i % dmaDescriptorsCount], &headers);
+		doNotOptimize(dmaBuffers);
+	}
+	return sum;
+}
+
+/**
+ * \brief Benchmark of formatting of topic with state of button, like in main().
+ *
+ * \param [in] iterations is the number of formatted topics
+ *
+ * \return value derived from formatted topics
+ */
+
+size_t buttonsTopicFormat(const size_t iterations)
+{
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		char topic[std::size(BUTTONS_TOPIC_PREFIX "/?" BUTTONS_TOPIC_SUFFIX)];
+		sum += sniprintf(topic, std::size(topic), BUTTONS_TOPIC_PREFIX "/%zu" BUTTONS_TOPIC_SUFFIX, i % 10);
+		doNotOptimize(topic);
+	}
+	return sum;
+}
+
+/**
+ * \brief Benchmark of formatting of statistics entry, like in publishStatistics() with MemoryStatisticsSource.
+ *
+ * \param [in] iterations is the number of formatted entries
+ *
+ * \return value derived from formatted entries
+ */
+
+size_t statisticsEntryFormat(const size_t iterations)
+{
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		constexpr size_t prefixLength {std::size(STATISTICS_TOPIC_PREFIX) - 1};
+		char topic[128] {STATISTICS_TOPIC_PREFIX};
+		char payload[128];
+		sum += sniprintf(topic + prefixLength, std::size(topic) - prefixLength, "memory/%s", "PBUF_POOL");
+		sum += sniprintf(payload, std::size(payload), "used=%zu max=%zu available=%zu errors=%zu", i % 16, i % 32,
+				size_t{16}, size_t{});
+		doNotOptimize(topic);
+		doNotOptimize(payload);
+	}
+	return sum;
+}
+
+/**
+ * \brief Benchmark of parsing of topic of incoming publish, like in mqttIncomingPublishCallback().
+ *
+ * \param [in] iterations is the number of parsed topics
+ *
+ * \return value derived from parsed topics
+ */
+
+size_t incomingTopicParse(const size_t iterations)
+{
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		const auto topic = incomingTopics[i % std::size(incomingTopics)];
+		doNotOptimize(topic);
+		if (strcmp(topic, IPERF_TOPIC) == 0)
+		{
+			sum += 10;
+			continue;
+		}
+
+		size_t led;
+		if (siscanf(topic, LEDS_TOPIC_PREFIX "/%zu" LEDS_TOPIC_SUFFIX, &led) == 1)
+			sum += led;
+	}
+	return sum;
+}
+
+/**
+ * \brief Benchmark of internetChecksum().
+ *
+ * \tparam Length is the length of checksummed data, bytes
+ *
+ * \param [in] iterations is the number of checksums
+ *
+ * \return value derived from checksums
+ */
+
+template<size_t Length>
+size_t checksum(const size_t iterations)
+{
+	static_assert(Length <= sizeof(pbufStorage[0]));
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		doNotOptimize(pbufStorage);
+		sum += internetChecksum(pbufStorage[0] + i % 2, Length);
+	}
+	return sum;
+}
+
+/**
+ * \brief Benchmark of internetChecksumCopy(), like in tcp_write() when SOFTWARE_CHECKSUM is enabled.
+ *
+ * \tparam Length is the length of copied data, bytes
+ *
+ * \param [in] iterations is the number of copies
+ *
+ * \return value derived from checksums
+ */
+
+template<size_t Length>
+size_t checksumCopy(const size_t iterations)
+{
+	static_assert(Length <= sizeof(pbufStorage[0]));
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		sum += internetChecksumCopy(pbufStorage[1], pbufStorage[0] + i % 2, Length);
+		doNotOptimize(pbufStorage);
+	}
+	return sum;
+}
+
+#if HOT_PATH_BENCHMARK_LWIP == 1
+
+/**
+ * \brief Benchmark of lwIP's internet checksum (with LWIP_CHKSUM of the application).
+ *
+ * \tparam Length is the length of checksummed data, bytes
+ *
+ * \param [in] iterations is the number of checksums
+ *
+ * \return value derived from checksums
+ */
+
+template<size_t Length>
+size_t lwipChecksum(const size_t iterations)
+{
+	static_assert(Length <= sizeof(pbufStorage[0]));
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		doNotOptimize(pbufStorage);
+		sum += inet_chksum(pbufStorage[0] + i % 2, Length);
+	}
+	return sum;
+}
+
+/**
+ * \brief Benchmark of pbuf_alloc() and pbuf_free().
+ *
+ * \tparam Layer is the layer of allocated pbuf
+ * \tparam Length is the length of allocated pbuf, bytes
+ * \tparam Type is the type of allocated pbuf
+ *
+ * \param [in] iterations is the number of allocated and freed pbufs
+ *
+ * \return value derived from allocated pbufs
+ */
+
+template<pbuf_layer Layer, u16_t Length, pbuf_type Type>
+size_t pbufAllocateFree(const size_t iterations)
+{
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		const auto pbuf = pbuf_alloc(Layer, Length, Type);
+		if (pbuf == nullptr)
+			abort();
+		doNotOptimize(pbuf);
+		sum += pbuf->tot_len;
+		pbuf_free(pbuf);
+	}
+	return sum;
+}
+
+/**
+ * \brief Benchmark of encoding of MQTT publish by lwIP.
+ *
+ * MQTT client is marked as connected, but its TCP pcb has no space in send buffer, so mqtt_publish() only encodes the
+ * message into output ring buffer of client, which is emptied when it is full.
+ *
+ * \param [in] iterations is the number of encoded messages
+ *
+ * \return value derived from encoded messages
+ */
+
+size_t mqttPublishEncode(const size_t iterations)
+{
+	static const auto client = []()
+			{
+				const auto pcb = tcp_new();
+				const auto mqttClient = mqtt_client_new();
+				if (pcb == nullptr || mqttClient == nullptr)
+					abort();
+
+				pcb->snd_buf = {};
+				mqttClient->conn = pcb;
+				mqttClient->conn_state = 3;	// MQTT_CONNECTED from mqtt.c
+				return mqttClient;
+			}();
+
+	constexpr char topic[] {BUTTONS_TOPIC_PREFIX "/0" BUTTONS_TOPIC_SUFFIX};
+	constexpr char payload[] {"used=12 max=16 available=16 errors=0"};
+	size_t sum {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		auto ret = mqtt_publish(client, topic, payload, sizeof(payload) - 1, {}, {}, {}, {});
+		if (ret == ERR_MEM)
+		{
+			client->output.get = client->output.put;
+			ret = mqtt_publish(client, topic, payload, sizeof(payload) - 1, {}, {}, {}, {});
+		}
+		if (ret != ERR_OK)
+			abort();
+		sum += client->output.put;
+	}
+	return sum;
+}
+
+#endif	// HOT_PATH_BENCHMARK_LWIP == 1
+
+/// all benchmarks
+const Benchmark benchmarks[]
+{
+		{"rx copy 60 B", rxCopy<60>},
+		{"rx copy 1514 B", rxCopy<1514>},
+		{"tx copy 54 B", txCopy<54>},
+		{"tx copy 1514 B", txCopy<1514>},
+		{"buttons topic format", buttonsTopicFormat},
+		{"statistics entry format", statisticsEntryFormat},
+		{"incoming topic parse", incomingTopicParse},
+		{"checksum 20 B", checksum<20>},
+		{"checksum 1480 B", checksum<1480>},
+		{"checksum copy 1460 B", checksumCopy<1460>},
+#if HOT_PATH_BENCHMARK_LWIP == 1
+		{"inet_chksum 20 B", lwipChecksum<20>},
+		{"inet_chksum 1480 B", lwipChecksum<1480>},
+		{"pbuf pool 1514 B", pbufAllocateFree<PBUF_RAW, 1514, PBUF_POOL>},
+		{"pbuf ram 64 B", pbufAllocateFree<PBUF_TRANSPORT, 64, PBUF_RAM>},
+		{"pbuf ref 1460 B", pbufAllocateFree<PBUF_TRANSPORT, 1460, PBUF_REF>},
+		{"mqtt publish encode", mqttPublishEncode},
+#endif	// HOT_PATH_BENCHMARK_LWIP == 1
+};
+
+/**
+ * \brief Measures benchmark.
+ *
+ * Number of iterations is doubled until single run takes at least minRunDuration, then the benchmark is run
+ * runsCount times.
+ *
+ * \param [in] benchmark is a reference to measured benchmark
+ *
+ * \return best time of single operation, nanoseconds
+ */
+
+double measure(const Benchmark& benchmark)
+{
+	const auto run = [&benchmark](const size_t iterations)
+			{
+				const auto start = std::chrono::steady_clock::now();
+				doNotOptimize(benchmark.function(iterations));
+				return std::chrono::steady_clock::now() - start;
+			};
+
+	size_t iterations {1};
+	while (run(iterations) < minRunDuration)
+		iterations *= 2;
+
+	auto best = std::chrono::steady_clock::duration::max();
+	for (size_t i {}; i < runsCount; ++i)
+		best = std::min(best, run(iterations));
+
+	return std::chrono::duration<double, std::nano>(best).count() / iterations;
+}
+
+/**
+ * \brief Reads results from CSV file.
+ *
+ * \param [in] path is the path of CSV file
+ * \param [out] results is a reference to map in which results will be stored
+ *
+ * \return true if file was read, false otherwise
+ */
+
+bool readResults(const char* const path, std::map<std::string, double>& results)
+{
+	const auto file = fopen(path, "r");
+	if (file == nullptr)
+		return false;
+
+	char line[256];
+	while (fgets(line, sizeof(line), file) != nullptr)
+	{
+		const auto separator = strrchr(line, ',');
+		if (separator == nullptr || line[0] == '#')
+			continue;
+
+		char* end;
+		const auto nanoseconds = strtod(separator + 1, &end);
+		if (end == separator + 1)	// header or malformed line
+			continue;
+
+		results[std::string(line, separator)] = nanoseconds;
+	}
+
+	return fclose(file) == 0;
+}
+
+/**
+ * \brief Writes results to CSV file.
+ *
+ * \param [in] path is the path of CSV file
+ * \param [in] calibrationResult is the result of calibration loop, nanoseconds
+ * \param [in] results is a reference to vector with results, in the same order as benchmarks
+ *
+ * \return true if file was written, false otherwise
+ */
+
+bool writeResults(const char* const path, const double calibrationResult, const std::vector<double>& results)
+{
+	const auto file = fopen(path, "w");
+	if (file == nullptr)
+		return false;
+
+	auto success = fprintf(file, "benchmark,nanoseconds\n%s,%.2f\n", calibrationName, calibrationResult) > 0;
+	for (size_t i {}; i < results.size() && success == true; ++i)
+		success = fprintf(file, "%s,%.2f\n", benchmarks[i].name, results[i]) > 0;
+
+	return fclose(file) == 0 && success == true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main(const int argc, char** const argv)
+{
+	const char* baselinePath {};
+	const char* outputPath {};
+	auto threshold = defaultThreshold;
+	int option;
+	while ((option = getopt(argc, argv, "b:o:t:")) != -1)
+		if (option == 'b')
+			baselinePath = optarg;
+		else if (option == 'o')
+			outputPath = optarg;
+		else if (option == 't')
+			threshold = strtod(optarg, {});
+		else
+		{
+			fprintf(stderr, "Usage: %s [-b baseline.csv] [-o results.csv] [-t threshold in %%]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+
+	std::map<std::string, double> baseline;
+	if (baselinePath != nullptr && readResults(baselinePath, baseline) == false)
+	{
+		fprintf(stderr, "Could not read baseline %s\n", baselinePath);
+		return EXIT_FAILURE;
+	}
+
+	double baselineCalibration {};
+	if (baselinePath != nullptr)
+	{
+		const auto iterator = baseline.find(calibrationName);
+		if (iterator == baseline.end() || iterator->second <= 0)
+		{
+			fprintf(stderr, "Baseline %s has no result of calibration loop\n", baselinePath);
+			return EXIT_FAILURE;
+		}
+
+		baselineCalibration = iterator->second;
+	}
+
+	initializeDmaDescriptors();
+#if HOT_PATH_BENCHMARK_LWIP == 1
+	lwip_init();
+#endif	// HOT_PATH_BENCHMARK_LWIP == 1
+
+	const Benchmark calibrationBenchmark {calibrationName, calibration};
+	auto calibrationResult = measure(calibrationBenchmark);
+	std::vector<double> results;
+	for (const auto& benchmark : benchmarks)
+		results.push_back(measure(benchmark));
+	// speed of the host may change during the run (frequency scaling, other load), the best result is the least noisy
+	calibrationResult = std::min(calibrationResult, measure(calibrationBenchmark));
+
+	printf("%-24s %12s %12s %10s\n", "[ns]", "result", "baseline", "change");
+	if (baselinePath != nullptr)
+		printf("%-24s %12.2f %12.2f %10s\n", calibrationName, calibrationResult, baselineCalibration, "-");
+	else
+		printf("%-24s %12.2f %12s %10s\n", calibrationName, calibrationResult, "-", "-");
+
+	size_t regressions {};
+	size_t missing {};
+	for (size_t i {}; i < results.size(); ++i)
+	{
+		const auto& benchmark = benchmarks[i];
+		const auto result = results[i];
+		const auto iterator = baseline.find(benchmark.name);
+		if (iterator == baseline.end())
+		{
+			if (baselinePath != nullptr)
+			{
+				printf("%-24s %12.2f %12s %10s  MISSING\n", benchmark.name, result, "-", "-");
+				++missing;
+			}
+			else
+				printf("%-24s %12.2f %12s %10s\n", benchmark.name, result, "-", "-");
+			continue;
+		}
+
+		// both results are normalized to calibration loop measured on the same host
+		const auto change = (result / calibrationResult) / (iterator->second / baselineCalibration) * 100 - 100;
+		const auto regression = change > threshold;
+		printf("%-24s %12.2f %12.2f %+9.1f%%%s\n", benchmark.name, result, iterator->second, change,
+				regression == true ? "  REGRESSION" : "");
+		regressions += regression;
+	}
+
+	if (outputPath != nullptr)
+	{
+		if (writeResults(outputPath, calibrationResult, results) == false)
+		{
+			fprintf(stderr, "Could not write results to %s\n", outputPath);
+			return EXIT_FAILURE;
+		}
+
+		printf("\nresults saved to %s\n", outputPath);
+	}
+
+	if (regressions != 0)
+		printf("\n%zu benchmark(s) slower than baseline (relative to calibration loop) by more than %.1f%%\n",
+				regressions, threshold);
+	if (missing != 0)
+		printf("\n%zu benchmark(s) have no result in baseline %s - measure them on a quiet host and store the results "
+				"as the new baseline\n", missing, baselinePath);
+
+	return regressions == 0 && missing == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,39 @@
+/**
+ * \file
+ * \brief Compiler and platform abstraction of lwIP for the host
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_INCLUDE_ARCH_CC_H_
+#define BENCHMARKS_INCLUDE_ARCH_CC_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global defines
++---------------------------------------------------------------------------------------------------------------------*/
+
+#ifndef LWIP_PLATFORM_ASSERT
+
+/** handles failed assertion of lwIP */
+#define LWIP_PLATFORM_ASSERT(message)	do { \
+		fprintf(stderr, "lwIP assertion \"%s\" failed at line %d in %s\n", message, __LINE__, __FILE__); \
+		abort(); \
+} while (0)
+
+#endif	/* ndef LWIP_PLATFORM_ASSERT */
+
+#ifndef LWIP_PLATFORM_DIAG
+
+/** prints diagnostic message of lwIP */
+#define LWIP_PLATFORM_DIAG(message)		do { printf message; } while (0)
+
+#endif	/* ndef LWIP_PLATFORM_DIAG */
+
+#endif	/* BENCHMARKS_INCLUDE_ARCH_CC_H_ */
@@ -0,0 +1,63 @@
+/**
+ * \file
+ * \brief System abstraction of lwIP for the host
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_INCLUDE_ARCH_SYS_ARCH_H_
+#define BENCHMARKS_INCLUDE_ARCH_SYS_ARCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	/* def __cplusplus */
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/** lwIP's mailbox, implemented in lwipSysArch.cpp */
+struct HostMailbox;
+
+/** lwIP's mutex, implemented in lwipSysArch.cpp */
+struct HostMutex;
+
+/** lwIP's semaphore, implemented in lwipSysArch.cpp */
+struct HostSemaphore;
+
+/** lwIP's mailbox */
+typedef struct HostMailbox* sys_mbox_t;
+
+/** lwIP's mutex */
+typedef struct HostMutex* sys_mutex_t;
+
+/** type of value of lwIP's critical section */
+typedef int sys_prot_t;
+
+/** lwIP's semaphore */
+typedef struct HostSemaphore* sys_sem_t;
+
+/** lwIP's thread */
+typedef int sys_thread_t;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global defines
++---------------------------------------------------------------------------------------------------------------------*/
+
+#define sys_mbox_valid(mailbox)				(*(mailbox) != NULL)
+#define sys_mbox_set_invalid(mailbox)		(*(mailbox) = NULL)
+#define sys_mutex_valid(mutex)				(*(mutex) != NULL)
+#define sys_mutex_set_invalid(mutex)		(*(mutex) = NULL)
+#define sys_sem_valid(semaphore)			(*(semaphore) != NULL)
+#define sys_sem_set_invalid(semaphore)		(*(semaphore) = NULL)
+
+#ifdef __cplusplus
+}	/* extern "C" */
+#endif	/* def __cplusplus */
+
+#endif	/* BENCHMARKS_INCLUDE_ARCH_SYS_ARCH_H_ */
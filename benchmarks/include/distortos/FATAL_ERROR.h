@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief Host replacement of distortos' FATAL_ERROR() macro
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_INCLUDE_DISTORTOS_FATAL_ERROR_H_
+#define BENCHMARKS_INCLUDE_DISTORTOS_FATAL_ERROR_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	/* def __cplusplus */
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Prints message of fatal error and aborts the process.
+ *
+ * \param [in] file is the name of file in which the error occurred
+ * \param [in] line is the line at which the error occurred
+ * \param [in] message is the message of error
+ */
+
+void hostFatalError(const char* file, int line, const char* message) __attribute__ ((noreturn));
+
+#ifdef __cplusplus
+}	/* extern "C" */
+#endif	/* def __cplusplus */
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global defines
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Handles fatal error.
+ *
+ * \param [in] message is the message of error
+ */
+
+#define FATAL_ERROR(message)	hostFatalError(__FILE__, __LINE__, message)
+
+#endif	/* BENCHMARKS_INCLUDE_DISTORTOS_FATAL_ERROR_H_ */
@@ -0,0 +1,66 @@
+/**
+ * \file
+ * \brief Host replacement of distortos' InterruptMaskingLock class
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_INCLUDE_DISTORTOS_INTERRUPTMASKINGLOCK_HPP_
+#define BENCHMARKS_INCLUDE_DISTORTOS_INTERRUPTMASKINGLOCK_HPP_
+
+#include <mutex>
+
+namespace distortos
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \return reference to global recursive mutex which replaces masking of interrupts on the host, it is also used by
+ * sys_arch_protect()
+ */
+
+std::recursive_mutex& getInterruptMaskingMutex();
+
+/**
+ * \brief InterruptMaskingLock class is a RAII wrapper for a global recursive mutex.
+ *
+ * On the host there are no interrupts, so sections which mask interrupts on target are made mutually exclusive with
+ * all other such sections in all threads - this gives the same guarantees as masking of interrupts on a single-core
+ * microcontroller. Locks may be nested.
+ */
+
+class InterruptMaskingLock
+{
+public:
+
+	/**
+	 * \brief InterruptMaskingLock's constructor
+	 */
+
+	InterruptMaskingLock() :
+			lockGuard_{getInterruptMaskingMutex()}
+	{
+
+	}
+
+	InterruptMaskingLock(const InterruptMaskingLock&) = delete;
+	InterruptMaskingLock(InterruptMaskingLock&&) = delete;
+	const InterruptMaskingLock& operator=(const InterruptMaskingLock&) = delete;
+	InterruptMaskingLock& operator=(InterruptMaskingLock&&) = delete;
+
+private:
+
+	/// lock guard of global recursive mutex
+	std::lock_guard<std::recursive_mutex> lockGuard_;
+};
+
+}	// namespace distortos
+
+#endif	// BENCHMARKS_INCLUDE_DISTORTOS_INTERRUPTMASKINGLOCK_HPP_
@@ -0,0 +1,163 @@
+/**
+ * \file
+ * \brief Host replacement of distortos' Semaphore class
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_INCLUDE_DISTORTOS_SEMAPHORE_HPP_
+#define BENCHMARKS_INCLUDE_DISTORTOS_SEMAPHORE_HPP_
+
+#include "distortos/TickClock.hpp"
+
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
+#include <cerrno>
+
+namespace distortos
+{
+
+/**
+ * \brief Semaphore class is a counting semaphore with optional max value, implemented with std::condition_variable.
+ *
+ * It has the same interface and error codes as distortos' Semaphore.
+ */
+
+class Semaphore
+{
+public:
+
+	/// type used for semaphore's "value"
+	using Value = unsigned int;
+
+	/**
+	 * \brief Semaphore's constructor
+	 *
+	 * \param [in] value is the initial value of the semaphore
+	 * \param [in] maxValue is the max value of the semaphore
+	 */
+
+	explicit Semaphore(const Value value, const Value maxValue = std::numeric_limits<Value>::max()) :
+			conditionVariable_{},
+			mutex_{},
+			value_{value < maxValue ? value : maxValue},
+			maxValue_{maxValue}
+	{
+
+	}
+
+	/**
+	 * \return current value of semaphore
+	 */
+
+	Value getValue() const
+	{
+		const std::lock_guard<std::mutex> lockGuard {mutex_};
+		return value_;
+	}
+
+	/**
+	 * \brief Unlocks the semaphore.
+	 *
+	 * \return 0 on success, EOVERFLOW if the max value of the semaphore would be exceeded
+	 */
+
+	int post()
+	{
+		{
+			const std::lock_guard<std::mutex> lockGuard {mutex_};
+			if (value_ == maxValue_)
+				return EOVERFLOW;
+
+			++value_;
+		}
+		conditionVariable_.notify_one();
+		return 0;
+	}
+
+	/**
+	 * \brief Tries to lock the semaphore.
+	 *
+	 * \return 0 on success, EAGAIN if the semaphore is already locked
+	 */
+
+	int tryWait()
+	{
+		const std::lock_guard<std::mutex> lockGuard {mutex_};
+		if (value_ == 0)
+			return EAGAIN;
+
+		--value_;
+		return 0;
+	}
+
+	/**
+	 * \brief Tries to lock the semaphore until some time point is reached.
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 *
+	 * \return 0 on success, ETIMEDOUT if the semaphore could not be locked before the time point
+	 */
+
+	int tryWaitUntil(const TickClock::time_point timePoint)
+	{
+		const auto timeout = std::chrono::steady_clock::now() + (timePoint - TickClock::now());
+		std::unique_lock<std::mutex> uniqueLock {mutex_};
+		if (conditionVariable_.wait_until(uniqueLock, timeout,
+				[this]()
+				{
+					return value_ != 0;
+				}) == false)
+			return ETIMEDOUT;
+
+		--value_;
+		return 0;
+	}
+
+	/**
+	 * \brief Locks the semaphore, waiting as long as needed.
+	 *
+	 * \return 0 on success
+	 */
+
+	int wait()
+	{
+		std::unique_lock<std::mutex> uniqueLock {mutex_};
+		conditionVariable_.wait(uniqueLock,
+				[this]()
+				{
+					return value_ != 0;
+				});
+		--value_;
+		return 0;
+	}
+
+	Semaphore(const Semaphore&) = delete;
+	Semaphore(Semaphore&&) = delete;
+	const Semaphore& operator=(const Semaphore&) = delete;
+	Semaphore& operator=(Semaphore&&) = delete;
+
+private:
+
+	/// condition variable signalled when value is incremented
+	std::condition_variable conditionVariable_;
+
+	/// mutex which protects value
+	mutable std::mutex mutex_;
+
+	/// current value of semaphore
+	Value value_;
+
+	/// max value of semaphore
+	Value maxValue_;
+};
+
+}	// namespace distortos
+
+#endif	// BENCHMARKS_INCLUDE_DISTORTOS_SEMAPHORE_HPP_
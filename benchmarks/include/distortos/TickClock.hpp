@@ -0,0 +1,54 @@
+/**
+ * \file
+ * \brief Host replacement of distortos' TickClock class
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_INCLUDE_DISTORTOS_TICKCLOCK_HPP_
+#define BENCHMARKS_INCLUDE_DISTORTOS_TICKCLOCK_HPP_
+
+#include <chrono>
+
+namespace distortos
+{
+
+/**
+ * \brief TickClock class is a steady clock with 1 ms resolution, started when the process starts.
+ *
+ * It has the same interface and resolution as distortos' TickClock with default configuration.
+ */
+
+class TickClock
+{
+public:
+
+	/// type of tick counter
+	using rep = int64_t;
+
+	/// std::ratio type representing the tick period of the clock, seconds
+	using period = std::ratio<1, 1000>;
+
+	/// basic duration type of clock
+	using duration = std::chrono::duration<rep, period>;
+
+	/// basic time_point type of clock
+	using time_point = std::chrono::time_point<TickClock>;
+
+	/**
+	 * \return time_point representing the current value of the clock
+	 */
+
+	static time_point now();
+
+	/// this is a steady clock - it cannot be adjusted
+	static constexpr bool is_steady {true};
+};
+
+}	// namespace distortos
+
+#endif	// BENCHMARKS_INCLUDE_DISTORTOS_TICKCLOCK_HPP_
@@ -0,0 +1,24 @@
+/**
+ * \file
+ * \brief Host replacement of distortos' standard output stream of board
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_INCLUDE_DISTORTOS_BOARD_STANDARDOUTPUTSTREAM_H_
+#define BENCHMARKS_INCLUDE_DISTORTOS_BOARD_STANDARDOUTPUTSTREAM_H_
+
+#include <stdio.h>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global defines
++---------------------------------------------------------------------------------------------------------------------*/
+
+/** standard output stream of board - standard output of the process */
+#define standardOutputStream	stdout
+
+#endif	/* BENCHMARKS_INCLUDE_DISTORTOS_BOARD_STANDARDOUTPUTSTREAM_H_ */
@@ -0,0 +1,18 @@
+/**
+ * \file
+ * \brief Host replacement of distortos' version header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_INCLUDE_DISTORTOS_DISTORTOSVERSION_H_
+#define BENCHMARKS_INCLUDE_DISTORTOS_DISTORTOSVERSION_H_
+
+/** version of distortos used by the application on target, as string */
+#define DISTORTOS_VERSION_STRING	"0.7.0"
+
+#endif	/* BENCHMARKS_INCLUDE_DISTORTOS_DISTORTOSVERSION_H_ */
@@ -0,0 +1,29 @@
+/**
+ * \file
+ * \brief Configuration of host build of benchmarks, included in every compiled file
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_INCLUDE_HOSTCONFIGURATION_H_
+#define BENCHMARKS_INCLUDE_HOSTCONFIGURATION_H_
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global defines
++---------------------------------------------------------------------------------------------------------------------*/
+
+/** name of simulated board, used in MQTT topics and client ID */
+#define DISTORTOS_BOARD	"Host,Simulated"
+
+/* integer-only variants of stdio functions from newlib are mapped to regular functions from glibc */
+#define fiprintf	fprintf
+#define iprintf		printf
+#define siscanf		sscanf
+#define sniprintf	snprintf
+#define vsniprintf	vsnprintf
+
+#endif	/* BENCHMARKS_INCLUDE_HOSTCONFIGURATION_H_ */
@@ -0,0 +1,278 @@
+/**
+ * \file
+ * \brief System abstraction of lwIP for the host, implemented with threads and synchronization primitives of C++.
+ *
+ * Also implements the rest of shims from include/ which are needed by lwIP configured as on target.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/FATAL_ERROR.h"
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/Semaphore.hpp"
+
+#include "lwip/sys.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <cstdio>
+#include <cstdlib>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// lwIP's mailbox - bounded queue of pointers
+struct HostMailbox
+{
+	/// condition variable signalled when queue changes
+	std::condition_variable conditionVariable;
+
+	/// mutex which protects queue
+	std::mutex mutex;
+
+	/// queue of messages
+	std::deque<void*> messages;
+
+	/// max number of messages in queue
+	size_t size;
+};
+
+/// lwIP's mutex
+struct HostMutex
+{
+	/// mutex
+	std::mutex mutex;
+};
+
+/// lwIP's semaphore
+struct HostSemaphore
+{
+	/// semaphore
+	distortos::Semaphore semaphore;
+};
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Converts timeout of lwIP to time point of TickClock.
+ *
+ * \param [in] timeout is the timeout of lwIP, milliseconds, must not be 0
+ *
+ * \return time point at which the wait should be terminated
+ */
+
+distortos::TickClock::time_point getTimeoutTimePoint(const u32_t timeout)
+{
+	return distortos::TickClock::now() + distortos::TickClock::duration{timeout};
+}
+
+/**
+ * \brief Converts time point at which the wait was started to the time of the wait, as required by lwIP.
+ *
+ * \param [in] start is the time point at which the wait was started
+ *
+ * \return time of the wait, milliseconds
+ */
+
+u32_t getWaitTime(const distortos::TickClock::time_point start)
+{
+	return (distortos::TickClock::now() - start).count();
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+extern "C" void sys_init()
+{
+
+}
+
+extern "C" u32_t sys_now()
+{
+	return distortos::TickClock::now().time_since_epoch().count();
+}
+
+extern "C" sys_prot_t sys_arch_protect()
+{
+	distortos::getInterruptMaskingMutex().lock();
+	return {};
+}
+
+extern "C" void sys_arch_unprotect(sys_prot_t)
+{
+	distortos::getInterruptMaskingMutex().unlock();
+}
+
+extern "C" err_t sys_sem_new(sys_sem_t* const semaphore, const u8_t count)
+{
+	*semaphore = new HostSemaphore{distortos::Semaphore{count}};
+	return ERR_OK;
+}
+
+extern "C" void sys_sem_free(sys_sem_t* const semaphore)
+{
+	delete *semaphore;
+}
+
+extern "C" void sys_sem_signal(sys_sem_t* const semaphore)
+{
+	(*semaphore)->semaphore.post();
+}
+
+extern "C" u32_t sys_arch_sem_wait(sys_sem_t* const semaphore, const u32_t timeout)
+{
+	const auto start = distortos::TickClock::now();
+	if (timeout == 0)
+		(*semaphore)->semaphore.wait();
+	else if ((*semaphore)->semaphore.tryWaitUntil(getTimeoutTimePoint(timeout)) != 0)
+		return SYS_ARCH_TIMEOUT;
+
+	return getWaitTime(start);
+}
+
+extern "C" err_t sys_mutex_new(sys_mutex_t* const mutex)
+{
+	*mutex = new HostMutex;
+	return ERR_OK;
+}
+
+extern "C" void sys_mutex_free(sys_mutex_t* const mutex)
+{
+	delete *mutex;
+}
+
+extern "C" void sys_mutex_lock(sys_mutex_t* const mutex)
+{
+	(*mutex)->mutex.lock();
+}
+
+extern "C" void sys_mutex_unlock(sys_mutex_t* const mutex)
+{
+	(*mutex)->mutex.unlock();
+}
+
+extern "C" err_t sys_mbox_new(sys_mbox_t* const mailbox, const int size)
+{
+	*mailbox = new HostMailbox;
+	(*mailbox)->size = size;
+	return ERR_OK;
+}
+
+extern "C" void sys_mbox_free(sys_mbox_t* const mailbox)
+{
+	delete *mailbox;
+}
+
+extern "C" void sys_mbox_post(sys_mbox_t* const mailbox, void* const message)
+{
+	auto& hostMailbox = **mailbox;
+	{
+		std::unique_lock<std::mutex> uniqueLock {hostMailbox.mutex};
+		hostMailbox.conditionVariable.wait(uniqueLock,
+				[&hostMailbox]()
+				{
+					return hostMailbox.messages.size() < hostMailbox.size;
+				});
+		hostMailbox.messages.push_back(message);
+	}
+	hostMailbox.conditionVariable.notify_all();
+}
+
+extern "C" err_t sys_mbox_trypost(sys_mbox_t* const mailbox, void* const message)
+{
+	auto& hostMailbox = **mailbox;
+	{
+		const std::lock_guard<std::mutex> lockGuard {hostMailbox.mutex};
+		if (hostMailbox.messages.size() >= hostMailbox.size)
+			return ERR_MEM;
+
+		hostMailbox.messages.push_back(message);
+	}
+	hostMailbox.conditionVariable.notify_all();
+	return ERR_OK;
+}
+
+extern "C" err_t sys_mbox_trypost_fromisr(sys_mbox_t* const mailbox, void* const message)
+{
+	return sys_mbox_trypost(mailbox, message);
+}
+
+extern "C" u32_t sys_arch_mbox_fetch(sys_mbox_t* const mailbox, void** const message, const u32_t timeout)
+{
+	auto& hostMailbox = **mailbox;
+	const auto start = distortos::TickClock::now();
+	{
+		std::unique_lock<std::mutex> uniqueLock {hostMailbox.mutex};
+		const auto predicate = [&hostMailbox]()
+				{
+					return hostMailbox.messages.empty() == false;
+				};
+		if (timeout == 0)
+			hostMailbox.conditionVariable.wait(uniqueLock, predicate);
+		else if (hostMailbox.conditionVariable.wait_for(uniqueLock, std::chrono::milliseconds{timeout},
+				predicate) == false)
+			return SYS_ARCH_TIMEOUT;
+
+		if (message != nullptr)
+			*message = hostMailbox.messages.front();
+		hostMailbox.messages.pop_front();
+	}
+	hostMailbox.conditionVariable.notify_all();
+	return getWaitTime(start);
+}
+
+extern "C" u32_t sys_arch_mbox_tryfetch(sys_mbox_t* const mailbox, void** const message)
+{
+	auto& hostMailbox = **mailbox;
+	{
+		const std::lock_guard<std::mutex> lockGuard {hostMailbox.mutex};
+		if (hostMailbox.messages.empty() == true)
+			return SYS_MBOX_EMPTY;
+
+		if (message != nullptr)
+			*message = hostMailbox.messages.front();
+		hostMailbox.messages.pop_front();
+	}
+	hostMailbox.conditionVariable.notify_all();
+	return 0;
+}
+
+extern "C" sys_thread_t sys_thread_new(const char*, const lwip_thread_fn function, void* const argument, int, int)
+{
+	// stack size and priority are ignored - threads of the host have stacks which are big enough for C library
+	std::thread{function, argument}.detach();
+	return {};
+}
+
+extern "C" void hostFatalError(const char* const file, const int line, const char* const message)
+{
+	fprintf(stderr, "Fatal error at line %d in %s: %s\n", line, file, message);
+	abort();
+}
+
+namespace distortos
+{
+
+std::recursive_mutex& getInterruptMaskingMutex()
+{
+	static std::recursive_mutex interruptMaskingMutex;
+	return interruptMaskingMutex;
+}
+
+}	// namespace distortos
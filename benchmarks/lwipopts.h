@@ -0,0 +1,30 @@
+/**
+ * \file
+ * \brief Configuration of lwIP for hotPathBenchmark
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARKS_LWIPOPTS_H_
+#define BENCHMARKS_LWIPOPTS_H_
+
+#include "lwIP-configuration.h"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global defines
++---------------------------------------------------------------------------------------------------------------------*/
+
+/** memory alignment of the host, pointers are 8 bytes long */
+#define MEM_ALIGNMENT							8
+
+/** errno values are taken from C library of the host */
+#define LWIP_ERRNO_STDINCLUDE					1
+
+/* debug messages are not printed, otherwise they would dominate the measured time */
+#undef LWIP_DEBUG
+
+#endif	/* BENCHMARKS_LWIPOPTS_H_ */
@@ -0,0 +1,311 @@
+/**
+ * \file
+ * \brief Benchmark comparing lock-based mailbox with SpscRingBuffer-based mailbox
+ *
+ * "locked" mailbox is an equivalent of a kernel queue - every post and every fetch locks a mutex and signals a
+ * condition variable. "spsc" mailbox uses SpscRingBuffer and wakes the consumer with a semaphore only when it sleeps.
+ * Both are measured in two modes - "burst" (producer posts messages as fast as possible, throughput is reported) and
+ * "paced" (producer posts a message every few microseconds, latency from post to fetch is reported).
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "SpscRingBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// type of message - time point at which it was posted, nanoseconds
+using Message = uint64_t;
+
+/// capacity of mailboxes, same as TCPIP_MBOX_SIZE
+constexpr size_t mailboxCapacity {16};
+
+/// simple counting semaphore
+class Semaphore
+{
+public:
+
+	/**
+	 * \brief Posts the semaphore.
+	 */
+
+	void post()
+	{
+		{
+			const std::lock_guard<std::mutex> lockGuard {mutex_};
+			++value_;
+		}
+		conditionVariable_.notify_one();
+	}
+
+	/**
+	 * \brief Waits for the semaphore.
+	 */
+
+	void wait()
+	{
+		std::unique_lock<std::mutex> uniqueLock {mutex_};
+		conditionVariable_.wait(uniqueLock,
+				[this]()
+				{
+					return value_ != 0;
+				});
+		--value_;
+	}
+
+private:
+
+	/// condition variable used to wait for the semaphore
+	std::condition_variable conditionVariable_;
+
+	/// mutex protecting \a value_
+	std::mutex mutex_;
+
+	/// value of the semaphore
+	size_t value_;
+};
+
+/// mailbox in which every post and fetch locks a mutex and signals a condition variable
+class LockedMailbox
+{
+public:
+
+	/**
+	 * \brief Fetches message, waits while mailbox is empty.
+	 *
+	 * \return fetched message
+	 */
+
+	Message fetch()
+	{
+		std::unique_lock<std::mutex> uniqueLock {mutex_};
+		notEmpty_.wait(uniqueLock,
+				[this]()
+				{
+					return count_ != 0;
+				});
+		const auto message = messages_[(head_ + mailboxCapacity - count_) % mailboxCapacity];
+		--count_;
+		uniqueLock.unlock();
+		notFull_.notify_one();
+		return message;
+	}
+
+	/**
+	 * \brief Posts message, waits while mailbox is full.
+	 *
+	 * \param [in] message is the message which will be posted
+	 */
+
+	void post(const Message message)
+	{
+		std::unique_lock<std::mutex> uniqueLock {mutex_};
+		notFull_.wait(uniqueLock,
+				[this]()
+				{
+					return count_ != mailboxCapacity;
+				});
+		messages_[head_] = message;
+		head_ = (head_ + 1) % mailboxCapacity;
+		++count_;
+		uniqueLock.unlock();
+		notEmpty_.notify_one();
+	}
+
+private:
+
+	/// storage for messages
+	Message messages_[mailboxCapacity];
+
+	/// condition variable signaled when mailbox is not empty
+	std::condition_variable notEmpty_;
+
+	/// condition variable signaled when mailbox is not full
+	std::condition_variable notFull_;
+
+	/// mutex protecting the mailbox
+	std::mutex mutex_;
+
+	/// index of next posted message
+	size_t head_;
+
+	/// number of messages in mailbox
+	size_t count_;
+};
+
+/// mailbox based on SpscRingBuffer, which uses a semaphore only when consumer sleeps
+class SpscMailbox
+{
+public:
+
+	/**
+	 * \brief Fetches message, waits while mailbox is empty.
+	 *
+	 * \return fetched message
+	 */
+
+	Message fetch()
+	{
+		Message message;
+		while (ringBuffer_.pop(message) == false)
+		{
+			consumerSleeps_ = true;
+			// re-check after announcing the sleep, a message posted before that would be missed otherwise
+			if (ringBuffer_.pop(message) == true)
+			{
+				consumerSleeps_ = false;
+				return message;
+			}
+
+			semaphore_.wait();
+		}
+
+		return message;
+	}
+
+	/**
+	 * \brief Posts message, spins while mailbox is full.
+	 *
+	 * \param [in] message is the message which will be posted
+	 */
+
+	void post(const Message message)
+	{
+		while (ringBuffer_.push(message) == false)
+			std::this_thread::yield();
+
+		if (consumerSleeps_.exchange(false) == true)
+			semaphore_.post();
+	}
+
+private:
+
+	/// ring buffer with messages
+	SpscRingBuffer<Message, mailboxCapacity> ringBuffer_;
+
+	/// semaphore used to wake the consumer
+	Semaphore semaphore_;
+
+	/// true if consumer sleeps (or is about to sleep) on \a semaphore_
+	std::atomic<bool> consumerSleeps_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of messages in "burst" mode
+constexpr size_t burstMessages {2000000};
+
+/// number of messages in "paced" mode
+constexpr size_t pacedMessages {100000};
+
+/// interval between messages in "paced" mode
+constexpr std::chrono::microseconds pacedInterval {5};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \return current time point, nanoseconds
+ */
+
+Message now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * \brief Runs benchmark of one mailbox.
+ *
+ * \tparam Mailbox is the type of mailbox
+ *
+ * \param [in] name is the name of mailbox
+ */
+
+template<typename Mailbox>
+void runBenchmark(const char* const name)
+{
+	{
+		Mailbox mailbox {};
+		const auto start = std::chrono::steady_clock::now();
+		std::thread consumer {[&mailbox]()
+				{
+					for (size_t i {}; i < burstMessages; ++i)
+						mailbox.fetch();
+				}};
+		for (size_t i {}; i < burstMessages; ++i)
+			mailbox.post(i);
+		consumer.join();
+		const std::chrono::duration<double> duration {std::chrono::steady_clock::now() - start};
+		printf("%-8s burst: %12.0f messages/s\n", name, burstMessages / duration.count());
+	}
+
+	{
+		Mailbox mailbox {};
+		std::vector<uint32_t> latencies;
+		latencies.reserve(pacedMessages);
+		std::thread consumer {[&mailbox, &latencies]()
+				{
+					for (size_t i {}; i < pacedMessages; ++i)
+					{
+						const auto message = mailbox.fetch();
+						latencies.push_back(now() - message);
+					}
+				}};
+		auto next = std::chrono::steady_clock::now();
+		for (size_t i {}; i < pacedMessages; ++i)
+		{
+			next += pacedInterval;
+			while (std::chrono::steady_clock::now() < next);
+			mailbox.post(now());
+		}
+		consumer.join();
+
+		std::sort(latencies.begin(), latencies.end());
+		uint64_t sum {};
+		for (const auto latency : latencies)
+			sum += latency;
+		const auto percentile = [&latencies](const size_t permille)
+				{
+					return latencies[(latencies.size() - 1) * permille / 1000];
+				};
+		printf("%-8s paced: average %8.1f ns, p50 %8u ns, p99 %8u ns, p99.9 %8u ns, max %10u ns\n", name,
+				static_cast<double>(sum) / latencies.size(), percentile(500), percentile(990), percentile(999),
+				latencies.back());
+	}
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	runBenchmark<LockedMailbox>("locked");
+	runBenchmark<SpscMailbox>("spsc");
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,271 @@
+/**
+ * \file
+ * \brief Benchmark of capture tap of Ethernet driver
+ *
+ * The same pseudo-random mix of frames (ARP, MQTT over TCP, UDP datagrams and full-size TCP segments) is passed
+ * through PacketCaptureFilter and PacketCaptureRing exactly like in capturePacket(), with various filters and snap
+ * lengths. The cost per frame is the cost added by the tap to lowLevelInput() and lowLevelOutput() (without masking of
+ * interrupts and reading of timestamp). Optionally the contents of the ring after the last run are saved as a pcap
+ * file, which allows to verify the format with Wireshark or tcpdump.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "PacketCaptureFilter.hpp"
+#include "PacketCaptureRing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// ring buffer with captured frames, same as in the application
+using CaptureRing = PacketCaptureRing<16 * 1024>;
+
+/// single frame of workload
+struct Frame
+{
+	/// contents of frame (including MAC header)
+	std::vector<uint8_t> data;
+
+	/// direction of frame
+	PacketDirection direction;
+};
+
+/// configuration of tap
+struct TapConfiguration
+{
+	/// name of configuration
+	const char* name;
+
+	/// filter which selects captured frames
+	PacketCaptureFilter filter;
+
+	/// max number of captured bytes of each frame
+	size_t snapLength;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of frames in workload
+constexpr size_t framesCount {1000};
+
+/// number of passes over workload in each run
+constexpr size_t passesCount {1000};
+
+/// bitmask with both directions
+constexpr uint8_t bothDirections {static_cast<uint8_t>(PacketDirection::receive) |
+		static_cast<uint8_t>(PacketDirection::transmit)};
+
+/// TCP port of packet capture server
+constexpr uint16_t capturePort {2002};
+
+/// all configurations of tap
+const TapConfiguration tapConfigurations[]
+{
+		{"reject all", {0, 0, capturePort, 0, 0}, 134},
+		{"port 9999", {0, 9999, capturePort, 0, bothDirections}, 134},
+		{"ARP only", {0x0806, 0, capturePort, 0, bothDirections}, 134},
+		{"MQTT only", {0, 1883, capturePort, 6, bothDirections}, 134},
+		{"all, snap 64", {0, 0, capturePort, 0, bothDirections}, 64},
+		{"all, snap 134", {0, 0, capturePort, 0, bothDirections}, 134},
+		{"all, snap 256", {0, 0, capturePort, 0, bothDirections}, 256},
+};
+
+/// ring buffer with captured frames
+CaptureRing captureRing;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Makes IPv4 frame with TCP or UDP header.
+ *
+ * \param [in] length is the length of frame, bytes
+ * \param [in] protocol is the IPv4 protocol, 6 for TCP or 17 for UDP
+ * \param [in] sourcePort is the source port
+ * \param [in] destinationPort is the destination port
+ *
+ * \return frame with Ethernet, IPv4 and TCP or UDP headers, the rest is filled with pattern
+ */
+
+std::vector<uint8_t> makeIpv4Frame(const size_t length, const uint8_t protocol, const uint16_t sourcePort,
+		const uint16_t destinationPort)
+{
+	std::vector<uint8_t> frame(length);
+	for (size_t i {}; i < length; ++i)
+		frame[i] = i;
+
+	frame[12] = 0x08;
+	frame[13] = 0x00;
+	frame[14] = 0x45;
+	frame[16] = (length - 14) >> 8;
+	frame[17] = length - 14;
+	frame[20] = 0x40;	// don't fragment
+	frame[21] = 0;
+	frame[23] = protocol;
+	frame[34] = sourcePort >> 8;
+	frame[35] = sourcePort;
+	frame[36] = destinationPort >> 8;
+	frame[37] = destinationPort;
+	return frame;
+}
+
+/**
+ * \brief Generates pseudo-random workload.
+ *
+ * \return vector with frames
+ */
+
+std::vector<Frame> generateWorkload()
+{
+	std::mt19937 generator {1};
+	std::uniform_int_distribution<size_t> typeDistribution {0, 99};
+	std::uniform_int_distribution<size_t> mqttDistribution {60, 200};
+	std::uniform_int_distribution<size_t> udpDistribution {60, 1000};
+	std::uniform_int_distribution<uint16_t> portDistribution {49152, 65535};
+
+	std::vector<Frame> workload;
+	workload.reserve(framesCount);
+	while (workload.size() < framesCount)
+	{
+		const auto type = typeDistribution(generator);
+		const auto direction = type % 2 == 0 ? PacketDirection::receive : PacketDirection::transmit;
+		const auto port = portDistribution(generator);
+		if (type < 5)
+		{
+			std::vector<uint8_t> frame(42);
+			frame[12] = 0x08;
+			frame[13] = 0x06;
+			workload.push_back({std::move(frame), direction});
+		}
+		else if (type < 40)
+			workload.push_back({makeIpv4Frame(mqttDistribution(generator), 6, port, 1883), direction});
+		else if (type < 60)
+			workload.push_back({makeIpv4Frame(udpDistribution(generator), 17, port, 7), direction});
+		else
+			workload.push_back({makeIpv4Frame(1514, 6, 5001, port), direction});
+	}
+
+	return workload;
+}
+
+/**
+ * \brief Saves contents of capture ring as pcap file.
+ *
+ * \param [in] path is the path of pcap file
+ * \param [in] snapLength is the max number of captured bytes of each frame
+ *
+ * \return true if file was saved, false otherwise
+ */
+
+bool savePcapFile(const char* const path, const size_t snapLength)
+{
+	const auto file = fopen(path, "wb");
+	if (file == nullptr)
+		return false;
+
+	const CaptureRing::FileHeader header {0xa1b2c3d4, 2, 4, {}, {}, static_cast<uint32_t>(snapLength), 1};
+	auto success = fwrite(&header, sizeof(header), 1, file) == 1;
+
+	uint8_t buffer[sizeof(CaptureRing::RecordHeader) + 1514];
+	auto position = captureRing.getTail();
+	size_t size;
+	while (success == true && (size = captureRing.read(position, buffer, sizeof(buffer))) != 0)
+		success = fwrite(buffer, size, 1, file) == 1;
+
+	return fclose(file) == 0 && success == true;
+}
+
+/**
+ * \brief Runs workload through the tap and measures the average cost per frame.
+ *
+ * \param [in] workload is a reference to workload
+ * \param [in] configuration is a reference to configuration of tap
+ */
+
+void runWorkload(const std::vector<Frame>& workload, const TapConfiguration& configuration)
+{
+	size_t captured {};
+	size_t capturedBytes {};
+	uint32_t timestamp {};
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t pass {}; pass < passesCount; ++pass)
+		for (const auto& frame : workload)
+		{
+			++timestamp;
+			if (configuration.filter.matches(frame.data.data(), frame.data.size(), frame.direction) == false)
+				continue;
+
+			const CaptureRing::RecordHeader header
+			{
+					timestamp / 1000000,
+					timestamp % 1000000,
+					static_cast<uint32_t>(std::min(frame.data.size(), configuration.snapLength)),
+					static_cast<uint32_t>(frame.data.size()),
+			};
+			captureRing.write(header, frame.data.data());
+			++captured;
+			capturedBytes += header.capturedLength;
+		}
+	const auto end = std::chrono::steady_clock::now();
+
+	const auto frames = passesCount * workload.size();
+	const auto duration = std::chrono::duration<double, std::nano>(end - start).count();
+	printf("%-14s %10.1f %10.1f %12zu %12zu\n", configuration.name, duration / frames,
+			captured != 0 ? duration / captured : 0.0, captured, capturedBytes);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main(const int argc, char** const argv)
+{
+	if (argc > 2)
+	{
+		fprintf(stderr, "Usage: %s [pcap file]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	const auto workload = generateWorkload();
+
+	printf("%-14s %10s %10s %12s %12s\n", "[ns]", "per frame", "per capture", "captured", "bytes");
+	for (const auto& configuration : tapConfigurations)
+		runWorkload(workload, configuration);
+
+	printf("\noverwritten records: %zu\n", captureRing.getOverwrittenCount());
+
+	if (argc == 2)
+	{
+		if (savePcapFile(argv[1], tapConfigurations[std::size(tapConfigurations) - 1].snapLength) == false)
+		{
+			fprintf(stderr, "Could not save pcap file %s\n", argv[1]);
+			return EXIT_FAILURE;
+		}
+
+		printf("contents of capture ring saved to %s\n", argv[1]);
+	}
+
+	return EXIT_SUCCESS;
+}
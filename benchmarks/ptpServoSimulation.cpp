@@ -0,0 +1,261 @@
+/**
+ * \file
+ * \brief Simulation of synchronization of PTP clock with PtpServo
+ *
+ * Master clock is the reference time, local clock starts at 0 (like PTP clock of Ethernet MAC after boot), has constant
+ * or slowly changing frequency error and is read with resolution of 20 ns (like PTP clock with nominal addend). Each
+ * exchange of messages is simulated exactly like in the PTP slave - master sends Sync at its sync interval, the slave
+ * answers with Delay_Req 100 us after reception of Sync and corrects local clock with the result of
+ * PtpServo::update() when Delay_Resp arrives. Path delay is 10 us in both directions plus random queueing delay with
+ * exponential distribution. For each scenario time until the clock converges (offset below the limit of the scenario
+ * in all following exchanges), RMS and max offset in the second half of simulated time, number of steps and final
+ * frequency adjustment are printed. The simulation fails if the clock doesn't converge or if offset exceeds the limit.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "PtpServo.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// scenario of simulation, times in nanoseconds
+struct Scenario
+{
+	/// name of scenario
+	const char* name;
+
+	/// interval between Sync messages
+	int64_t syncInterval;
+
+	/// frequency error of local clock at the beginning, parts per billion
+	double frequencyError;
+
+	/// change of frequency error of local clock in each second, parts per billion
+	double wander;
+
+	/// mean of random queueing delay
+	double jitter;
+
+	/// max absolute offset of converged clock
+	int64_t limit;
+};
+
+/// simulated local clock
+class SimulatedClock
+{
+public:
+
+	/**
+	 * \brief SimulatedClock's constructor
+	 *
+	 * \param [in] reference is the reference time at which the clock starts from 0
+	 * \param [in] frequencyError is the initial frequency error, parts per billion
+	 */
+
+	SimulatedClock(const int64_t reference, const double frequencyError) :
+			adjustment_{},
+			fraction_{},
+			frequencyError_{frequencyError},
+			local_{},
+			reference_{reference}
+	{
+
+	}
+
+	/**
+	 * \brief Advances the clock to given reference time.
+	 *
+	 * \param [in] reference is the reference time, must not be lower than in previous call
+	 * \param [in] wander is the change of frequency error in each second, parts per billion
+	 */
+
+	void advance(const int64_t reference, const double wander)
+	{
+		const auto elapsed = reference - reference_;
+		reference_ = reference;
+		frequencyError_ += wander * elapsed / 1e9;
+		fraction_ += elapsed * (frequencyError_ + adjustment_) / 1e9;
+		const auto whole = static_cast<int64_t>(fraction_);
+		fraction_ -= whole;
+		local_ += elapsed + whole;
+	}
+
+	/**
+	 * \return current time of the clock, with resolution of 20 ns
+	 */
+
+	int64_t read() const
+	{
+		return local_ - local_ % 20;
+	}
+
+	/**
+	 * \return current offset of the clock from reference time
+	 */
+
+	int64_t getOffset() const
+	{
+		return local_ - reference_;
+	}
+
+	/**
+	 * \param [in] adjustment is the new frequency adjustment, parts per billion
+	 */
+
+	void setFrequency(const int32_t adjustment)
+	{
+		adjustment_ = adjustment;
+	}
+
+	/**
+	 * \param [in] offset is the offset which is subtracted from the time of the clock
+	 */
+
+	void step(const int64_t offset)
+	{
+		local_ -= offset;
+	}
+
+private:
+
+	/// frequency adjustment, parts per billion
+	double adjustment_;
+
+	/// fractional nanoseconds of the time of the clock
+	double fraction_;
+
+	/// frequency error, parts per billion
+	double frequencyError_;
+
+	/// time of the clock, nanoseconds
+	int64_t local_;
+
+	/// reference time of the last advance(), nanoseconds
+	int64_t reference_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// reference time at the beginning of simulation (TAI in 2026), nanoseconds
+constexpr int64_t startTime {1790000000LL * 1000000000};
+
+/// simulated time of each scenario, nanoseconds
+constexpr int64_t simulatedTime {600LL * 1000000000};
+
+/// path delay without queueing, nanoseconds
+constexpr int64_t pathDelay {10000};
+
+/// time from reception of Sync to transmission of Delay_Req, nanoseconds
+constexpr int64_t responseTime {100000};
+
+/// all scenarios
+const Scenario scenarios[]
+{
+		{"1 s, +20 ppm", 1000000000, 20000, 0, 100, 1000},
+		{"1 s, -100 ppm", 1000000000, -100000, 0, 100, 1000},
+		{"125 ms, +20 ppm", 125000000, 20000, 0, 100, 1000},
+		{"1 s, wander", 1000000000, 20000, 20, 100, 1000},
+		{"1 s, 2 us jitter", 1000000000, 20000, 0, 2000, 20000},
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Simulates one scenario and prints the results.
+ *
+ * \param [in] scenario is a reference to simulated scenario
+ *
+ * \return true if the clock converged and its offset didn't exceed the limit afterwards, false otherwise
+ */
+
+bool simulate(const Scenario& scenario)
+{
+	std::mt19937 generator {1};
+	std::exponential_distribution<double> queueingDistribution {1 / scenario.jitter};
+	const auto delay = [&]()
+			{
+				return pathDelay + static_cast<int64_t>(queueingDistribution(generator));
+			};
+
+	SimulatedClock clock {startTime, scenario.frequencyError};
+	PtpServo servo {100000, 500000};
+	std::vector<int64_t> offsets;
+	int64_t convergedAt {-1};
+
+	for (auto t1 = startTime; t1 < startTime + simulatedTime; t1 += scenario.syncInterval)
+	{
+		const auto syncReceived = t1 + delay();
+		clock.advance(syncReceived, scenario.wander);
+		const auto t2 = clock.read();
+		const auto offset = clock.getOffset();
+		offsets.push_back(offset);
+		if (std::llabs(offset) > scenario.limit)
+			convergedAt = -1;
+		else if (convergedAt < 0)
+			convergedAt = t1 - startTime;
+
+		const auto delayRequestSent = syncReceived + responseTime;
+		clock.advance(delayRequestSent, scenario.wander);
+		const auto t3 = clock.read();
+		const auto t4 = delayRequestSent + delay();
+
+		clock.advance(t4 + delay(), scenario.wander);
+		const auto correction = servo.update(t1, t2, t3, t4);
+		if (correction.step != 0)
+			clock.step(correction.step);
+		clock.setFrequency(correction.frequency);
+	}
+
+	double sumOfSquares {};
+	int64_t max {};
+	for (auto it = offsets.begin() + offsets.size() / 2; it != offsets.end(); ++it)
+	{
+		sumOfSquares += static_cast<double>(*it) * *it;
+		max = std::max<int64_t>(max, std::llabs(*it));
+	}
+
+	const auto converged = convergedAt >= 0 && convergedAt < simulatedTime / 2;
+	printf("%-18s %10.1f %8.1f %8lld %6lu %10ld %6s\n", scenario.name, convergedAt / 1e9,
+			std::sqrt(sumOfSquares / (offsets.size() - offsets.size() / 2)), static_cast<long long>(max),
+			static_cast<unsigned long>(servo.getSteps()), static_cast<long>(servo.getFrequency()),
+			converged == true ? "OK" : "FAIL");
+	return converged;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	printf("%-18s %10s %8s %8s %6s %10s %6s\n", "scenario", "conv. [s]", "rms [ns]", "max [ns]", "steps", "freq [ppb]",
+			"result");
+	bool success {true};
+	for (const auto& scenario : scenarios)
+		success &= simulate(scenario);
+
+	return success == true ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,369 @@
+/**
+ * \file
+ * \brief Simulation of report-by-exception telemetry with thousands of data points
+ *
+ * TelemetryEngine is driven by a simulated clock with the same tick as the main loop of the application (50 ms), which
+ * starts shortly before wrap-around of 32-bit time. Each data point is a simulated signal - slow sine with noise
+ * (analog input), setpoint changing at random times or constant value - with random sample period and the same
+ * deadband, min and max interval as data points of the application. Updates selected in each tick are encoded as
+ * MQTT PUBLISH packets into one buffer (like one TCP write of the application) and committed. The simulation verifies
+ * that no data point is published more often than its min interval allows or less often than its max interval requires
+ * and that each change larger than deadband is published at most min interval (plus one tick) after it was sampled. For
+ * each number of data points it prints the rate of samples and publishes, batches per second, their average size in
+ * packets and bytes and the cost of a sample (including the simulated source) on the host.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "TelemetryEngine.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// type of simulated signal
+enum class SignalType : uint8_t
+{
+	/// slow sine with noise
+	analog,
+	/// setpoint changing at random times
+	setpoint,
+	/// constant value
+	constant,
+};
+
+/// simulated signal, along with state of its verification
+struct Signal
+{
+	/// generator of noise and changes of setpoint
+	std::minstd_rand generator;
+
+	/// type of signal
+	SignalType type;
+
+	/// period of sine or mean interval between changes of setpoint, milliseconds
+	uint32_t period;
+
+	/// current value of setpoint
+	int32_t setpoint;
+
+	/// time of the next change of setpoint, milliseconds of simulated time
+	uint64_t nextChange;
+
+	/// the last published value, valid only if \a published is true
+	int32_t publishedValue;
+
+	/// simulated time of the last publish, milliseconds, valid only if \a published is true
+	uint64_t publishedTime;
+
+	/// simulated time at which the change larger than deadband was sampled, valid only if \a changed is true
+	uint64_t changedTime;
+
+	/// true if the value was published at least once, false otherwise
+	bool published;
+
+	/// true if sampled value differs from published value by at least deadband, false otherwise
+	bool changed;
+};
+
+/// simulated data point
+struct SimulatedPoint
+{
+	/// data point registered in TelemetryEngine
+	TelemetryPoint point;
+
+	/// simulated signal
+	Signal signal;
+};
+
+/// results of simulation
+struct Results
+{
+	/// number of samples
+	uint64_t samples;
+
+	/// number of published updates
+	uint64_t publishes;
+
+	/// number of ticks with at least one update
+	uint64_t batches;
+
+	/// number of encoded bytes
+	uint64_t bytes;
+
+	/// number of violations of min interval, max interval or latency of change
+	uint64_t violations;
+};
+
+/// telemetry engine used in simulation
+using Engine = TelemetryEngine<16384>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// tick of simulated clock (period of the main loop of the application), milliseconds
+constexpr uint32_t tick {50};
+
+/// simulated time of each run, milliseconds
+constexpr uint64_t simulatedDuration {10 * 60 * 1000};
+
+/// value of 32-bit clock at the beginning of simulation, milliseconds
+constexpr uint32_t startTime {UINT32_MAX - 60 * 1000};
+
+/// prefix of topics, same length as in the application
+constexpr char topicPrefix[] {"distortos/0.7.0/ST,32F746GDISCOVERY/telemetry/"};
+
+/// current simulated time, milliseconds since the beginning of simulation
+uint64_t simulatedTime;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Samples simulated data point.
+ *
+ * \param [in] argument is a pointer to SimulatedPoint
+ *
+ * \return current value of simulated signal
+ */
+
+int32_t sampleSignal(const void* const argument)
+{
+	auto& simulatedPoint = *static_cast<SimulatedPoint*>(const_cast<void*>(argument));
+	auto& signal = simulatedPoint.signal;
+	int32_t value {};
+	if (signal.type == SignalType::analog)
+	{
+		const auto phase = 2 * M_PI * (simulatedTime % signal.period) / signal.period;
+		value = signal.setpoint + static_cast<int32_t>(1000 * std::sin(phase)) +
+				static_cast<int32_t>(signal.generator() % 41) - 20;
+	}
+	else if (signal.type == SignalType::setpoint)
+	{
+		while (simulatedTime >= signal.nextChange)
+		{
+			signal.setpoint = signal.generator() % 100;
+			signal.nextChange += 1 + signal.generator() % (2 * signal.period);
+		}
+		value = signal.setpoint;
+	}
+	else
+		value = signal.setpoint;
+
+	const auto change = std::llabs(int64_t{value} - signal.publishedValue);
+	const auto changed = signal.published == true && change != 0 && change >= simulatedPoint.point.deadband;
+	if (changed == true && signal.changed == false)
+		signal.changedTime = simulatedTime;
+	signal.changed = changed;
+	return value;
+}
+
+/**
+ * \brief Creates simulated data points.
+ *
+ * \param [in] count is the number of data points
+ *
+ * \return array with \a count simulated data points
+ */
+
+std::unique_ptr<SimulatedPoint[]> makePoints(const size_t count)
+{
+	std::minstd_rand generator {1};
+	std::unique_ptr<SimulatedPoint[]> points {new SimulatedPoint[count] {}};
+	for (size_t i {}; i < count; ++i)
+	{
+		auto& simulatedPoint = points[i];
+		constexpr uint32_t samplePeriods[] {100, 500, 1000, 10000};
+		const auto type = static_cast<SignalType>(generator() % 3);
+		simulatedPoint.point = {"point", sampleSignal, &simulatedPoint, type == SignalType::analog ? 50u : 1u,
+				samplePeriods[generator() % std::size(samplePeriods)], 5000, 300000,
+				static_cast<uint8_t>(type == SignalType::analog ? 2 : 0)};
+		simulatedPoint.signal.generator.seed(i + 1);
+		simulatedPoint.signal.type = type;
+		simulatedPoint.signal.period = 60000 + generator() % 240000;
+		simulatedPoint.signal.setpoint = generator() % 5000;
+	}
+
+	return points;
+}
+
+/**
+ * \brief Simulates telemetry with given number of data points.
+ *
+ * \param [in] count is the number of data points
+ *
+ * \return results of simulation
+ */
+
+Results simulate(const size_t count)
+{
+	const auto points = makePoints(count);
+	const auto engine = std::make_unique<Engine>();
+	simulatedTime = {};
+	for (size_t i {}; i < count; ++i)
+		engine->add(points[i].point, startTime);
+
+	std::vector<TelemetryUpdate> updates(count);
+	std::vector<uint8_t> buffer(count * 128);
+	Results results {};
+	for (; simulatedTime < simulatedDuration; simulatedTime += tick)
+	{
+		const uint32_t now = startTime + simulatedTime;
+		const auto updateCount = engine->sample(now, updates.data(), updates.size());
+		if (updateCount == 0)
+			continue;
+
+		size_t length {};
+		for (size_t i {}; i < updateCount; ++i)
+		{
+			auto& simulatedPoint = points[updates[i].point];
+			auto& signal = simulatedPoint.signal;
+			const auto sincePublished = simulatedTime - signal.publishedTime;
+			if (signal.published == true && (sincePublished < simulatedPoint.point.minInterval ||
+					sincePublished > simulatedPoint.point.maxInterval + tick ||
+					(signal.changed == true && simulatedTime - signal.changedTime >
+					simulatedPoint.point.minInterval + tick)))
+				++results.violations;
+
+			char payload[13];
+			const auto payloadLength = formatTelemetryValue(updates[i].value, simulatedPoint.point.decimals, payload,
+					sizeof(payload));
+			length += encodeMqttPublish(buffer.data() + length, buffer.size() - length, topicPrefix,
+					simulatedPoint.point.topic, payload, payloadLength);
+
+			signal.publishedValue = updates[i].value;
+			signal.publishedTime = simulatedTime;
+			signal.published = true;
+			signal.changed = false;
+		}
+
+		engine->commit(updates.data(), updateCount, now);
+		results.publishes += updateCount;
+		++results.batches;
+		results.bytes += length;
+	}
+
+	// changes which are still waiting must not be older than min interval
+	for (size_t i {}; i < count; ++i)
+		if (points[i].signal.changed == true && simulatedTime - points[i].signal.changedTime >
+				points[i].point.minInterval + tick)
+			++results.violations;
+
+	results.samples = engine->getSamples();
+	return results;
+}
+
+/**
+ * \brief Verifies formatting of values and encoding of packets.
+ *
+ * \return true if all checks passed, false otherwise
+ */
+
+bool verifyEncoding()
+{
+	const struct
+	{
+		int32_t value;
+		uint8_t decimals;
+		const char* expected;
+	} values[]
+	{
+			{0, 0, "0"},
+			{7, 2, "0.07"},
+			{-7, 2, "-0.07"},
+			{2531, 1, "253.1"},
+			{-123456, 3, "-123.456"},
+			{INT32_MIN, 0, "-2147483648"},
+			{INT32_MAX, 9, "2.147483647"},
+	};
+	bool success {true};
+	for (auto& value : values)
+	{
+		char buffer[13];
+		const auto length = formatTelemetryValue(value.value, value.decimals, buffer, sizeof(buffer));
+		if (length != strlen(value.expected) || strcmp(buffer, value.expected) != 0)
+		{
+			printf("formatTelemetryValue(%" PRId32 ", %u) = \"%s\", expected \"%s\"\n", value.value, value.decimals,
+					buffer, value.expected);
+			success = false;
+		}
+	}
+
+	{
+		char buffer[4];
+		if (formatTelemetryValue(-1000, 0, buffer, sizeof(buffer)) != 0)
+		{
+			printf("formatTelemetryValue() didn't detect too small buffer\n");
+			success = false;
+		}
+	}
+
+	const std::string topic (150, 't');
+	uint8_t buffer[256];
+	const auto length = encodeMqttPublish(buffer, sizeof(buffer), "a/", topic.c_str(), "1.5", 3);
+	const uint8_t header[] {0x30, (157 & 0x7f) | 0x80, 1, 0, 152, 'a', '/'};
+	if (length != 160 || memcmp(buffer, header, sizeof(header)) != 0 || memcmp(buffer + 157, "1.5", 3) != 0)
+	{
+		printf("encodeMqttPublish() produced invalid packet\n");
+		success = false;
+	}
+	if (encodeMqttPublish(buffer, length - 1, "a/", topic.c_str(), "1.5", 3) != 0)
+	{
+		printf("encodeMqttPublish() didn't detect too small buffer\n");
+		success = false;
+	}
+
+	return success;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	bool success {verifyEncoding()};
+
+	printf("%8s %12s %12s %10s %10s %10s %10s %12s %10s\n", "points", "samples/s", "publishes/s", "reduction",
+			"batches/s", "packets", "bytes", "ns/sample", "violations");
+	for (const size_t count : {100, 1000, 10000})
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const auto results = simulate(count);
+		const auto end = std::chrono::steady_clock::now();
+		const auto seconds = simulatedDuration / 1000.0;
+		printf("%8zu %12.0f %12.1f %9.1f%% %10.2f %10.1f %10.0f %12.1f %10" PRIu64 "\n", count,
+				results.samples / seconds, results.publishes / seconds,
+				100.0 - 100.0 * results.publishes / results.samples, results.batches / seconds,
+				static_cast<double>(results.publishes) / results.batches,
+				static_cast<double>(results.bytes) / results.batches,
+				static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+				results.samples, results.violations);
+		if (results.violations != 0)
+			success = false;
+	}
+
+	return success == true ? EXIT_SUCCESS : EXIT_FAILURE;
+}
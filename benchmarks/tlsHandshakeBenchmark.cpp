@@ -0,0 +1,477 @@
+/**
+ * \file
+ * \brief Benchmark comparing full TLS handshake with resumed ones
+ *
+ * mbedTLS is built with the same configuration as the application (mbedTLS-configuration.h), client and a stand-in of
+ * TLS broker (server with self-signed certificate, generated at startup) are connected with in-memory pipes. Three
+ * scenarios are measured - "full" (no session is offered), "session ID" (client offers cached session, server keeps
+ * sessions in its cache) and "ticket" (client offers cached session with ticket issued by stateless server). For each
+ * scenario CPU time spent in handshake by the client and by the server is reported, together with peak memory
+ * allocated by the client (which is what must fit in application's mbedTLS arena).
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/platform.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/ssl_cache.h"
+#include "mbedtls/ssl_ticket.h"
+#include "mbedtls/x509_crt.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// side of connection
+enum class Side : uint8_t
+{
+	/// client
+	client,
+	/// server
+	server,
+
+	/// number of sides
+	count
+};
+
+/// header of each allocated block, used to track memory of each side
+struct alignas(std::max_align_t) AllocationHeader
+{
+	/// size of block (without header), bytes
+	size_t size;
+
+	/// side which allocated the block
+	Side side;
+};
+
+/// memory used by one side
+struct MemoryUsage
+{
+	/// currently used memory, bytes
+	size_t current;
+
+	/// high-water mark of \a current, bytes
+	size_t peak;
+};
+
+/// one-directional in-memory pipe
+using Pipe = std::deque<unsigned char>;
+
+/// transport of one side - pipe to which it sends and pipe from which it receives
+struct Transport
+{
+	/// pipe to which data is sent
+	Pipe* output;
+
+	/// pipe from which data is received
+	Pipe* input;
+};
+
+/// results of single handshake
+struct HandshakeResult
+{
+	/// time spent in handshake by each side, nanoseconds
+	uint64_t times[static_cast<size_t>(Side::count)];
+
+	/// peak memory used by client, bytes
+	size_t clientPeak;
+
+	/// true if offered session was resumed, false otherwise
+	bool resumed;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of handshakes in each scenario
+constexpr size_t iterations {100};
+
+/// host name of TLS broker stand-in
+constexpr char hostName[] {"localhost"};
+
+/// side which is currently executed
+Side currentSide;
+
+/// memory used by each side
+MemoryUsage memoryUsages[static_cast<size_t>(Side::count)];
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief calloc() for mbedTLS which tracks memory used by current side.
+ *
+ * \param [in] count is the number of elements
+ * \param [in] size is the size of element, bytes
+ *
+ * \return pointer to allocated and zeroed block, nullptr if allocation failed
+ */
+
+void* trackingCalloc(const size_t count, const size_t size)
+{
+	const auto bytes = count * size;
+	const auto header = static_cast<AllocationHeader*>(calloc(1, sizeof(AllocationHeader) + bytes));
+	if (header == nullptr)
+		return {};
+
+	header->size = bytes;
+	header->side = currentSide;
+	auto& memoryUsage = memoryUsages[static_cast<size_t>(currentSide)];
+	memoryUsage.current += bytes;
+	memoryUsage.peak = std::max(memoryUsage.peak, memoryUsage.current);
+	return header + 1;
+}
+
+/**
+ * \brief free() for mbedTLS which tracks memory used by each side.
+ *
+ * \param [in] pointer is a pointer to block which will be freed, may be nullptr
+ */
+
+void trackingFree(void* const pointer)
+{
+	if (pointer == nullptr)
+		return;
+
+	const auto header = static_cast<AllocationHeader*>(pointer) - 1;
+	memoryUsages[static_cast<size_t>(header->side)].current -= header->size;
+	free(header);
+}
+
+/**
+ * \brief Sends data to output pipe of transport.
+ *
+ * \param [in] context is a pointer to Transport
+ * \param [in] buffer is a pointer to data
+ * \param [in] length is the size of data, bytes
+ *
+ * \return number of sent bytes
+ */
+
+int pipeSend(void* const context, const unsigned char* const buffer, const size_t length)
+{
+	auto& pipe = *static_cast<Transport*>(context)->output;
+	pipe.insert(pipe.end(), buffer, buffer + length);
+	return length;
+}
+
+/**
+ * \brief Receives data from input pipe of transport.
+ *
+ * \param [in] context is a pointer to Transport
+ * \param [out] buffer is a pointer to buffer for data
+ * \param [in] length is the size of buffer, bytes
+ *
+ * \return number of received bytes, MBEDTLS_ERR_SSL_WANT_READ if pipe is empty
+ */
+
+int pipeReceive(void* const context, unsigned char* const buffer, const size_t length)
+{
+	auto& pipe = *static_cast<Transport*>(context)->input;
+	if (pipe.empty() == true)
+		return MBEDTLS_ERR_SSL_WANT_READ;
+
+	const auto received = std::min(length, pipe.size());
+	std::copy_n(pipe.begin(), received, buffer);
+	pipe.erase(pipe.begin(), pipe.begin() + received);
+	return received;
+}
+
+/**
+ * \brief Checks result of mbedTLS function and terminates the benchmark if it failed.
+ *
+ * \param [in] ret is the value returned by mbedTLS function
+ * \param [in] name is the name of function
+ */
+
+void check(const int ret, const char* const name)
+{
+	if (ret >= 0)
+		return;
+
+	fprintf(stderr, "%s failed, ret = -0x%x\n", name, -ret);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * \brief Generates key and self-signed certificate of TLS broker stand-in.
+ *
+ * \param [in] ctrDrbg is a reference to random number generator
+ * \param [out] key is a reference to generated key
+ * \param [out] certificate is a reference to generated certificate
+ */
+
+void generateCertificate(mbedtls_ctr_drbg_context& ctrDrbg, mbedtls_pk_context& key, mbedtls_x509_crt& certificate)
+{
+	check(mbedtls_pk_setup(&key, mbedtls_pk_info_from_type(MBEDTLS_PK_ECKEY)), "mbedtls_pk_setup()");
+	check(mbedtls_ecp_gen_key(MBEDTLS_ECP_DP_SECP256R1, mbedtls_pk_ec(key), mbedtls_ctr_drbg_random, &ctrDrbg),
+			"mbedtls_ecp_gen_key()");
+
+	mbedtls_x509write_cert writer;
+	mbedtls_x509write_crt_init(&writer);
+	mbedtls_mpi serial;
+	mbedtls_mpi_init(&serial);
+	check(mbedtls_mpi_lset(&serial, 1), "mbedtls_mpi_lset()");
+	mbedtls_x509write_crt_set_version(&writer, MBEDTLS_X509_CRT_VERSION_3);
+	check(mbedtls_x509write_crt_set_serial(&writer, &serial), "mbedtls_x509write_crt_set_serial()");
+	check(mbedtls_x509write_crt_set_validity(&writer, "20260101000000", "20460101000000"),
+			"mbedtls_x509write_crt_set_validity()");
+	check(mbedtls_x509write_crt_set_subject_name(&writer, "CN=localhost"), "mbedtls_x509write_crt_set_subject_name()");
+	check(mbedtls_x509write_crt_set_issuer_name(&writer, "CN=localhost"), "mbedtls_x509write_crt_set_issuer_name()");
+	check(mbedtls_x509write_crt_set_basic_constraints(&writer, 1, -1),
+			"mbedtls_x509write_crt_set_basic_constraints()");
+	mbedtls_x509write_crt_set_subject_key(&writer, &key);
+	mbedtls_x509write_crt_set_issuer_key(&writer, &key);
+	mbedtls_x509write_crt_set_md_alg(&writer, MBEDTLS_MD_SHA256);
+
+	unsigned char buffer[2048];
+	const auto length = mbedtls_x509write_crt_der(&writer, buffer, sizeof(buffer), mbedtls_ctr_drbg_random, &ctrDrbg);
+	check(length, "mbedtls_x509write_crt_der()");
+	// certificate is written at the end of the buffer
+	check(mbedtls_x509_crt_parse_der(&certificate, buffer + sizeof(buffer) - length, length),
+			"mbedtls_x509_crt_parse_der()");
+
+	mbedtls_mpi_free(&serial);
+	mbedtls_x509write_crt_free(&writer);
+}
+
+/**
+ * \brief Executes one step of handshake of one side.
+ *
+ * \param [in] side is the side which will be executed
+ * \param [in] context is a reference to TLS context of \a side
+ * \param [in,out] result is a reference to results of handshake, time spent in this step is added to it
+ *
+ * \return true if handshake of \a side is finished, false otherwise
+ */
+
+bool handshakeStep(const Side side, mbedtls_ssl_context& context, HandshakeResult& result)
+{
+	currentSide = side;
+	const auto start = std::chrono::steady_clock::now();
+	const auto ret = mbedtls_ssl_handshake(&context);
+	result.times[static_cast<size_t>(side)] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - start).count();
+	if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+		return false;
+
+	check(ret, side == Side::client ? "client's mbedtls_ssl_handshake()" : "server's mbedtls_ssl_handshake()");
+	return true;
+}
+
+/**
+ * \brief Executes one handshake.
+ *
+ * \param [in] clientConfiguration is a reference to configuration of client
+ * \param [in] serverConfiguration is a reference to configuration of server
+ * \param [in,out] session is a reference to session of client, it is offered to the server if it is valid (non-zero
+ * length of session ID or ticket) and replaced with new session after the handshake
+ *
+ * \return results of handshake
+ */
+
+HandshakeResult handshake(const mbedtls_ssl_config& clientConfiguration, const mbedtls_ssl_config& serverConfiguration,
+		mbedtls_ssl_session& session)
+{
+	HandshakeResult result {};
+	Pipe clientToServer;
+	Pipe serverToClient;
+	Transport clientTransport {&clientToServer, &serverToClient};
+	Transport serverTransport {&serverToClient, &clientToServer};
+
+	currentSide = Side::client;
+	memoryUsages[static_cast<size_t>(Side::client)].peak = memoryUsages[static_cast<size_t>(Side::client)].current;
+	const auto clientBaseline = memoryUsages[static_cast<size_t>(Side::client)].current;
+	mbedtls_ssl_context client;
+	mbedtls_ssl_init(&client);
+	check(mbedtls_ssl_setup(&client, &clientConfiguration), "client's mbedtls_ssl_setup()");
+	check(mbedtls_ssl_set_hostname(&client, hostName), "mbedtls_ssl_set_hostname()");
+	mbedtls_ssl_set_bio(&client, &clientTransport, pipeSend, pipeReceive, {});
+	const auto offered = session.id_len != 0 || session.ticket_len != 0;
+	if (offered == true)
+		check(mbedtls_ssl_set_session(&client, &session), "mbedtls_ssl_set_session()");
+
+	currentSide = Side::server;
+	mbedtls_ssl_context server;
+	mbedtls_ssl_init(&server);
+	check(mbedtls_ssl_setup(&server, &serverConfiguration), "server's mbedtls_ssl_setup()");
+	mbedtls_ssl_set_bio(&server, &serverTransport, pipeSend, pipeReceive, {});
+
+	bool clientDone {};
+	bool serverDone {};
+	while (clientDone == false || serverDone == false)
+	{
+		if (clientDone == false)
+			clientDone = handshakeStep(Side::client, client, result);
+		if (serverDone == false)
+			serverDone = handshakeStep(Side::server, server, result);
+	}
+
+	currentSide = Side::client;
+	mbedtls_ssl_session newSession;
+	mbedtls_ssl_session_init(&newSession);
+	check(mbedtls_ssl_get_session(&client, &newSession), "mbedtls_ssl_get_session()");
+	// resumed session keeps master secret of the offered one, full handshake always derives a new one
+	result.resumed = offered == true && memcmp(newSession.master, session.master, sizeof(session.master)) == 0;
+	mbedtls_ssl_session_free(&session);
+	session = newSession;
+	result.clientPeak = memoryUsages[static_cast<size_t>(Side::client)].peak - clientBaseline;
+
+	mbedtls_ssl_free(&client);
+	currentSide = Side::server;
+	mbedtls_ssl_free(&server);
+	return result;
+}
+
+/**
+ * \brief Runs one scenario of the benchmark and prints its results.
+ *
+ * \param [in] name is the name of scenario
+ * \param [in] clientConfiguration is a reference to configuration of client
+ * \param [in] serverConfiguration is a reference to configuration of server
+ * \param [in] resume selects whether session from previous handshake is offered (true) or not (false)
+ */
+
+void runScenario(const char* const name, const mbedtls_ssl_config& clientConfiguration,
+		const mbedtls_ssl_config& serverConfiguration, const bool resume)
+{
+	currentSide = Side::client;
+	mbedtls_ssl_session session;
+	mbedtls_ssl_session_init(&session);
+	// first handshake is always full, it only provides the session for resumption
+	handshake(clientConfiguration, serverConfiguration, session);
+
+	uint64_t sums[static_cast<size_t>(Side::count)] {};
+	uint64_t maxes[static_cast<size_t>(Side::count)] {};
+	size_t clientPeak {};
+	size_t resumed {};
+	for (size_t i {}; i < iterations; ++i)
+	{
+		if (resume == false)
+		{
+			currentSide = Side::client;
+			mbedtls_ssl_session_free(&session);
+			mbedtls_ssl_session_init(&session);
+		}
+
+		const auto result = handshake(clientConfiguration, serverConfiguration, session);
+		for (size_t side {}; side < static_cast<size_t>(Side::count); ++side)
+		{
+			sums[side] += result.times[side];
+			maxes[side] = std::max(maxes[side], result.times[side]);
+		}
+		clientPeak = std::max(clientPeak, result.clientPeak);
+		resumed += result.resumed;
+	}
+
+	currentSide = Side::client;
+	mbedtls_ssl_session_free(&session);
+
+	const auto client = static_cast<size_t>(Side::client);
+	const auto server = static_cast<size_t>(Side::server);
+	printf("%-10s client: average %8.1f us, max %8.1f us, peak memory %6zu B; "
+			"server: average %8.1f us, max %8.1f us; resumed %zu/%zu\n", name,
+			sums[client] / 1000.0 / iterations, maxes[client] / 1000.0, clientPeak,
+			sums[server] / 1000.0 / iterations, maxes[server] / 1000.0, resumed, iterations);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	check(mbedtls_platform_set_calloc_free(trackingCalloc, trackingFree), "mbedtls_platform_set_calloc_free()");
+
+	// all shared objects are accounted to the server, client's memory includes only per-connection state
+	currentSide = Side::server;
+
+	mbedtls_entropy_context entropy;
+	mbedtls_entropy_init(&entropy);
+	mbedtls_ctr_drbg_context ctrDrbg;
+	mbedtls_ctr_drbg_init(&ctrDrbg);
+	check(mbedtls_ctr_drbg_seed(&ctrDrbg, mbedtls_entropy_func, &entropy, {}, {}), "mbedtls_ctr_drbg_seed()");
+
+	mbedtls_pk_context key;
+	mbedtls_pk_init(&key);
+	mbedtls_x509_crt certificate;
+	mbedtls_x509_crt_init(&certificate);
+	generateCertificate(ctrDrbg, key, certificate);
+
+	mbedtls_ssl_cache_context cache;
+	mbedtls_ssl_cache_init(&cache);
+	mbedtls_ssl_ticket_context ticket;
+	mbedtls_ssl_ticket_init(&ticket);
+	check(mbedtls_ssl_ticket_setup(&ticket, mbedtls_ctr_drbg_random, &ctrDrbg, MBEDTLS_CIPHER_AES_256_GCM, 86400),
+			"mbedtls_ssl_ticket_setup()");
+
+	// configuration of client is the same as in the application, but tickets may be disabled
+	mbedtls_ssl_config clientConfigurations[2];
+	for (auto& clientConfiguration : clientConfigurations)
+	{
+		mbedtls_ssl_config_init(&clientConfiguration);
+		check(mbedtls_ssl_config_defaults(&clientConfiguration, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+				MBEDTLS_SSL_PRESET_DEFAULT), "mbedtls_ssl_config_defaults()");
+		mbedtls_ssl_conf_authmode(&clientConfiguration, MBEDTLS_SSL_VERIFY_REQUIRED);
+		mbedtls_ssl_conf_ca_chain(&clientConfiguration, &certificate, {});
+		mbedtls_ssl_conf_rng(&clientConfiguration, mbedtls_ctr_drbg_random, &ctrDrbg);
+	}
+	auto& clientConfiguration = clientConfigurations[0];
+	auto& clientConfigurationWithoutTickets = clientConfigurations[1];
+	mbedtls_ssl_conf_session_tickets(&clientConfigurationWithoutTickets, MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+
+	// one server uses session cache (session IDs), the other one is stateless (session tickets)
+	mbedtls_ssl_config serverConfigurations[2];
+	for (auto& serverConfiguration : serverConfigurations)
+	{
+		mbedtls_ssl_config_init(&serverConfiguration);
+		check(mbedtls_ssl_config_defaults(&serverConfiguration, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM,
+				MBEDTLS_SSL_PRESET_DEFAULT), "mbedtls_ssl_config_defaults()");
+		mbedtls_ssl_conf_rng(&serverConfiguration, mbedtls_ctr_drbg_random, &ctrDrbg);
+		check(mbedtls_ssl_conf_own_cert(&serverConfiguration, &certificate, &key), "mbedtls_ssl_conf_own_cert()");
+	}
+	auto& cachingServerConfiguration = serverConfigurations[0];
+	auto& ticketServerConfiguration = serverConfigurations[1];
+	mbedtls_ssl_conf_session_cache(&cachingServerConfiguration, &cache, mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
+	mbedtls_ssl_conf_session_tickets_cb(&ticketServerConfiguration, mbedtls_ssl_ticket_write, mbedtls_ssl_ticket_parse,
+			&ticket);
+
+	runScenario("full", clientConfigurationWithoutTickets, cachingServerConfiguration, false);
+	runScenario("session ID", clientConfigurationWithoutTickets, cachingServerConfiguration, true);
+	runScenario("ticket", clientConfiguration, ticketServerConfiguration, true);
+
+	currentSide = Side::server;
+	for (auto& serverConfiguration : serverConfigurations)
+		mbedtls_ssl_config_free(&serverConfiguration);
+	for (auto& clientConfiguration : clientConfigurations)
+		mbedtls_ssl_config_free(&clientConfiguration);
+	mbedtls_ssl_ticket_free(&ticket);
+	mbedtls_ssl_cache_free(&cache);
+	mbedtls_x509_crt_free(&certificate);
+	mbedtls_pk_free(&key);
+	mbedtls_ctr_drbg_free(&ctrDrbg);
+	mbedtls_entropy_free(&entropy);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,279 @@
+/**
+ * \file
+ * \brief Simulation of priority queues of transmitted frames
+ *
+ * Transmit path of Ethernet driver is simulated in virtual time - a bulk TCP transfer keeps a window of full-size
+ * segments in flight, while control frames (ARP replies, pure ACKs, MQTT keep-alives) arrive at random times. Frames
+ * are classified with classifyFrame() and queued in TxScheduler exactly like in transmitWithPriority(), DMA ring has 4
+ * descriptors (one frame each) which are released at the speed of 100 Mbit/s link. Each scenario is simulated once
+ * with all frames in one FIFO queue (equivalent of the driver without priority queues, but with unlimited retries) and
+ * once with priority queues, then percentiles of queueing delays of both classes and bulk throughput are printed. The
+ * cost of classification of a single frame on the host is also measured.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "TxScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// frame waiting for a free DMA descriptor, time in nanoseconds
+struct QueuedFrame
+{
+	/// contents of frame (including MAC header)
+	const std::vector<uint8_t>* frame;
+
+	/// time when the frame was queued
+	uint64_t queued;
+};
+
+/// scenario of simulation
+struct Scenario
+{
+	/// name of scenario
+	const char* name;
+
+	/// mean interval between control frames, nanoseconds
+	uint64_t controlInterval;
+};
+
+/// queues of transmitted frames, same as in the application
+using Scheduler = TxScheduler<QueuedFrame, 16, 8>;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of DMA descriptors, each holds one frame
+constexpr size_t dmaDescriptorsCount {4};
+
+/// max number of bulk segments waiting in queue, lwIP's TCP doesn't send more than its send window
+constexpr size_t bulkWindow {12};
+
+/// simulated time of each scenario, nanoseconds
+constexpr uint64_t simulatedTime {10000000000};
+
+/// time of transmission of one byte at 100 Mbit/s, nanoseconds
+constexpr uint64_t byteTime {80};
+
+/// preamble, start frame delimiter, FCS and inter-frame gap, bytes
+constexpr size_t frameOverhead {24};
+
+/// all scenarios
+const Scenario scenarios[]
+{
+		{"keep-alive", 100000000},
+		{"ACKs", 500000},
+		{"flood", 5000},
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Makes IPv4 frame with TCP header.
+ *
+ * \param [in] length is the length of frame, bytes
+ * \param [in] sourcePort is the source port
+ * \param [in] destinationPort is the destination port
+ *
+ * \return frame with Ethernet, IPv4 and TCP headers, the rest is filled with zeroes
+ */
+
+std::vector<uint8_t> makeTcpFrame(const size_t length, const uint16_t sourcePort, const uint16_t destinationPort)
+{
+	std::vector<uint8_t> frame(std::max(length, size_t{54}));
+	frame[12] = 0x08;
+	frame[13] = 0x00;
+	frame[14] = 0x45;
+	frame[16] = (length - 14) >> 8;
+	frame[17] = length - 14;
+	frame[23] = 6;
+	frame[34] = sourcePort >> 8;
+	frame[35] = sourcePort;
+	frame[36] = destinationPort >> 8;
+	frame[37] = destinationPort;
+	frame[46] = 5 << 4;
+	return frame;
+}
+
+/**
+ * \brief Returns percentile of delays.
+ *
+ * \param [in] delays is a reference to sorted vector with delays
+ * \param [in] percentile is the percentile, [0; 100]
+ *
+ * \return percentile of \a delays, microseconds
+ */
+
+double getPercentile(const std::vector<uint64_t>& delays, const double percentile)
+{
+	if (delays.empty() == true)
+		return {};
+
+	const auto index = std::min(static_cast<size_t>(percentile / 100 * delays.size()), delays.size() - 1);
+	return delays[index] / 1000.0;
+}
+
+/**
+ * \brief Simulates one scenario and prints the results.
+ *
+ * \param [in] scenario is a reference to simulated scenario
+ * \param [in] priority selects whether frames are queued by class (true) or all in one FIFO queue (false)
+ */
+
+void simulate(const Scenario& scenario, const bool priority)
+{
+	const auto bulkFrame = makeTcpFrame(1514, 5001, 50000);
+	const std::vector<uint8_t> controlFrames[]
+	{
+			makeTcpFrame(54, 1883, 50001),	// pure ACK of MQTT connection
+			makeTcpFrame(56, 50001, 1883),	// PINGREQ
+			makeTcpFrame(54, 50000, 5001),	// pure ACK of other connection
+			[]()
+			{
+				std::vector<uint8_t> frame(42);
+				frame[12] = 0x08;
+				frame[13] = 0x06;
+				return frame;
+			}(),
+	};
+
+	std::mt19937 generator {1};
+	std::exponential_distribution<double> controlDistribution {1.0 / scenario.controlInterval};
+	std::uniform_int_distribution<size_t> controlTypeDistribution {0, std::size(controlFrames) - 1};
+
+	Scheduler scheduler;
+	std::vector<uint64_t> delays[static_cast<size_t>(TxClass::count)];
+	std::deque<uint64_t> dmaRing;	// times of release of occupied descriptors
+	size_t bulkPushed {};
+	uint64_t bulkBytes {};
+	size_t controlDropped {};
+	uint64_t now {};
+	auto nextControl = static_cast<uint64_t>(controlDistribution(generator));
+
+	// passes frames to free descriptors, the last descriptor is released after transmission of the last frame
+	const auto drain = [&]()
+			{
+				TxClass txClass;
+				QueuedFrame* queuedFrame;
+				while (dmaRing.size() < dmaDescriptorsCount &&
+						(queuedFrame = scheduler.front(txClass), queuedFrame != nullptr))
+				{
+					const auto start = dmaRing.empty() == true ? now : std::max(now, dmaRing.back());
+					dmaRing.push_back(start + (queuedFrame->frame->size() + frameOverhead) * byteTime);
+					const auto frameClass = classifyFrame(queuedFrame->frame->data(), queuedFrame->frame->size());
+					delays[static_cast<size_t>(frameClass)].push_back(now - queuedFrame->queued);
+					if (frameClass == TxClass::bulk)
+						bulkBytes += queuedFrame->frame->size();
+					scheduler.pop(txClass);
+				}
+			};
+	const auto enqueue = [&](const std::vector<uint8_t>& frame)
+			{
+				const auto txClass = priority == true ? classifyFrame(frame.data(), frame.size()) : TxClass::bulk;
+				const auto ret = scheduler.push(txClass, {&frame, now});
+				drain();
+				return ret;
+			};
+
+	while (now < simulatedTime)
+	{
+		// TCP refills its window as soon as previous segments are passed to DMA
+		while (bulkPushed - delays[static_cast<size_t>(TxClass::bulk)].size() < bulkWindow &&
+				enqueue(bulkFrame) == true)
+			++bulkPushed;
+
+		const auto nextRelease = dmaRing.empty() == true ? UINT64_MAX : dmaRing.front();
+		now = std::min(nextControl, nextRelease);
+		if (now == nextRelease)
+		{
+			dmaRing.pop_front();
+			drain();
+		}
+		if (now == nextControl)
+		{
+			if (enqueue(controlFrames[controlTypeDistribution(generator)]) == false)
+				++controlDropped;
+			nextControl = now + 1 + static_cast<uint64_t>(controlDistribution(generator));
+		}
+	}
+
+	for (auto& classDelays : delays)
+		std::sort(classDelays.begin(), classDelays.end());
+
+	const auto& control = delays[static_cast<size_t>(TxClass::control)];
+	const auto& bulk = delays[static_cast<size_t>(TxClass::bulk)];
+	printf("%-10s %-8s %9.1f %9.1f %9.1f %9.1f %9.1f %9.2f %8zu %8u\n", scenario.name,
+			priority == true ? "priority" : "FIFO", getPercentile(control, 50), getPercentile(control, 99),
+			getPercentile(control, 100), getPercentile(bulk, 50), getPercentile(bulk, 99),
+			bulkBytes * 8.0 / simulatedTime * 1000, controlDropped, scheduler.getStarvationGuardCount());
+}
+
+/**
+ * \brief Measures average time of classification of a single frame.
+ *
+ * \return average time of classification of a single frame, nanoseconds
+ */
+
+double measureClassification()
+{
+	const std::vector<uint8_t> frames[]
+	{
+			makeTcpFrame(1514, 5001, 50000),
+			makeTcpFrame(54, 50000, 5001),
+			makeTcpFrame(100, 50001, 1883),
+	};
+
+	constexpr size_t classificationsCount {10000000};
+	size_t controlCount {};
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i {}; i < classificationsCount; ++i)
+	{
+		const auto& frame = frames[i % std::size(frames)];
+		controlCount += classifyFrame(frame.data(), frame.size()) == TxClass::control;
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	// use the result, so that the compiler can't remove the calls
+	volatile auto result = controlCount;
+	static_cast<void>(result);
+	return std::chrono::duration<double, std::nano>(end - start).count() / classificationsCount;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main()
+{
+	printf("%-10s %-8s %9s %9s %9s %9s %9s %9s %8s %8s\n", "[us]", "queues", "ctrl p50", "ctrl p99", "ctrl max",
+			"bulk p50", "bulk p99", "Mbit/s", "dropped", "guarded");
+	for (const auto& scenario : scenarios)
+		for (const auto priority : {false, true})
+			simulate(scenario, priority);
+
+	printf("\nclassification: %.1f ns per frame\n", measureClassification());
+	return EXIT_SUCCESS;
+}
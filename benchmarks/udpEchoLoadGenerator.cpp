@@ -0,0 +1,209 @@
+/**
+ * \file
+ * \brief Load generator for UDP echo responder of the application
+ *
+ * Sends datagrams to UDP echo responder of the device (`UDP_ECHO` option) at configurable rate and measures round-trip
+ * time of each echoed datagram. Every datagram carries its sequence number and the time at which it was sent, so
+ * late, duplicated and lost datagrams are detected. Percentiles of round-trip time are printed at the end - they can
+ * be compared with per-stage histograms published by the device in "stats/udpEcho/...".
+ *
+ * Usage: udpEchoLoadGenerator <address> [rate [duration [size [port]]]], where "rate" is the number of datagrams per
+ * second (default 100), "duration" is in seconds (default 10), "size" is the size of datagram in bytes (default 64,
+ * at least 16) and "port" is the port of echo responder (default 7).
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// header of each datagram, the rest of datagram is filled with zeroes
+struct DatagramHeader
+{
+	/// sequence number of datagram
+	uint64_t sequence;
+
+	/// time point at which the datagram was sent, nanoseconds
+	uint64_t sent;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// time of waiting for late datagrams after the last one was sent
+constexpr std::chrono::seconds drainTime {1};
+
+/// timeout of single receive operation, so that receiver notices the end of test
+constexpr timeval receiveTimeout {0, 100000};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \return current time point, nanoseconds
+ */
+
+uint64_t now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * \brief Parses optional numeric argument.
+ *
+ * \param [in] argc is the number of arguments
+ * \param [in] argv is an array with arguments
+ * \param [in] index is the index of parsed argument
+ * \param [in] defaultValue is the value used if the argument is not given
+ *
+ * \return value of argument, \a defaultValue if it is not given
+ */
+
+unsigned long parseArgument(const int argc, char** const argv, const int index, const unsigned long defaultValue)
+{
+	return index < argc ? strtoul(argv[index], nullptr, 0) : defaultValue;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int main(const int argc, char** const argv)
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s <address> [rate [duration [size [port]]]]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	const auto rate = parseArgument(argc, argv, 2, 100);
+	const auto duration = parseArgument(argc, argv, 3, 10);
+	const auto size = std::max<size_t>(parseArgument(argc, argv, 4, 64), sizeof(DatagramHeader));
+	const auto port = parseArgument(argc, argv, 5, 7);
+	if (rate == 0 || duration == 0 || size > 1472 || port == 0 || port > UINT16_MAX)
+	{
+		fprintf(stderr, "Invalid arguments\n");
+		return EXIT_FAILURE;
+	}
+
+	sockaddr_in address {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	if (inet_pton(AF_INET, argv[1], &address.sin_addr) != 1)
+	{
+		fprintf(stderr, "Invalid address: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	const auto socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+	if (socket < 0 || connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+			setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &receiveTimeout, sizeof(receiveTimeout)) != 0)
+	{
+		perror("Could not open socket");
+		return EXIT_FAILURE;
+	}
+
+	const size_t count {rate * duration};
+	printf("Sending %zu datagrams of %zu bytes to %s:%lu at %lu datagrams/s\n", count, size, argv[1], port, rate);
+
+	std::vector<uint32_t> roundTripTimes;
+	roundTripTimes.reserve(count);
+	std::vector<bool> received(count);
+	size_t duplicated {};
+	size_t late {};
+	std::atomic<bool> finished {};
+
+	std::thread receiver {[socket, size, &roundTripTimes, &received, &duplicated, &late, &finished]()
+			{
+				std::vector<uint8_t> buffer(size);
+				uint64_t lastSequence {};
+				while (finished == false)
+				{
+					const auto ret = recv(socket, buffer.data(), buffer.size(), 0);
+					if (ret < static_cast<ssize_t>(sizeof(DatagramHeader)))
+						continue;
+
+					DatagramHeader header;
+					memcpy(&header, buffer.data(), sizeof(header));
+					if (header.sequence >= received.size())
+						continue;
+					if (received[header.sequence] == true)
+					{
+						++duplicated;
+						continue;
+					}
+
+					received[header.sequence] = true;
+					if (header.sequence < lastSequence)
+						++late;
+					lastSequence = header.sequence;
+					roundTripTimes.push_back((now() - header.sent) / 1000);
+				}
+			}};
+
+	std::vector<uint8_t> buffer(size);
+	const std::chrono::nanoseconds interval {1000000000 / rate};
+	auto next = std::chrono::steady_clock::now();
+	size_t sendErrors {};
+	for (size_t i {}; i < count; ++i)
+	{
+		next += interval;
+		std::this_thread::sleep_until(next);
+
+		const DatagramHeader header {i, now()};
+		memcpy(buffer.data(), &header, sizeof(header));
+		if (send(socket, buffer.data(), buffer.size(), 0) != static_cast<ssize_t>(buffer.size()))
+			++sendErrors;
+	}
+
+	std::this_thread::sleep_for(drainTime);
+	finished = true;
+	receiver.join();
+	close(socket);
+
+	const auto echoed = roundTripTimes.size();
+	printf("Sent %zu (%zu errors), echoed %zu, lost %zu (%.2f%%), duplicated %zu, out of order %zu\n", count,
+			sendErrors, echoed, count - echoed, 100.0 * (count - echoed) / count, duplicated, late);
+	if (echoed == 0)
+		return EXIT_FAILURE;
+
+	std::sort(roundTripTimes.begin(), roundTripTimes.end());
+	uint64_t sum {};
+	for (const auto roundTripTime : roundTripTimes)
+		sum += roundTripTime;
+	const auto percentile = [&roundTripTimes](const size_t permille)
+			{
+				return roundTripTimes[(roundTripTimes.size() - 1) * permille / 1000];
+			};
+	printf("Round-trip time: average %.1f us, min %u us, p50 %u us, p90 %u us, p99 %u us, p99.9 %u us, max %u us\n",
+			static_cast<double>(sum) / echoed, roundTripTimes.front(), percentile(500), percentile(900),
+			percentile(990), percentile(999), roundTripTimes.back());
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,472 @@
+/**
+ * \file
+ * \brief Definitions related to cache of network state used for fast boot
+ *
+ * The cache is kept in backup SRAM, which retains its contents across resets (and across power cycles, if VBAT is
+ * supplied). It is protected with a magic number, which also identifies its layout, and CRC-32.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "bootCache.hpp"
+
+#include "distortos/chip/CMSIS-proxy.h"
+
+#include "distortos/assert.h"
+#include "distortos/BIND_LOW_LEVEL_INITIALIZER.h"
+
+#include "lwip/acd.h"
+#include "lwip/dhcp.h"
+#include "lwip/dns.h"
+#include "lwip/etharp.h"
+#include "lwip/timeouts.h"
+
+#include <cstddef>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// cache of network state
+struct BootCache
+{
+	/// magic number, bootCacheMagic if cache is valid
+	uint32_t magic;
+
+	/// address from DHCP lease
+	ip4_addr_t address;
+
+	/// netmask from DHCP lease
+	ip4_addr_t netmask;
+
+	/// gateway from DHCP lease
+	ip4_addr_t gateway;
+
+	/// address of MQTT broker
+	ip4_addr_t brokerAddress;
+
+	/// index of MQTT broker in the list of brokers
+	uint32_t brokerIndex;
+
+	/// MAC address of the gateway, valid only if \a gatewayMacValid is true
+	eth_addr gatewayMac;
+
+	/// true if \a gatewayMac is valid, false otherwise
+	bool gatewayMacValid;
+
+	/// CRC-32 of all preceding fields
+	uint32_t crc;
+};
+
+/// state of revalidation of the cache
+struct Revalidation
+{
+	/// address of MQTT broker, either resolved again or the one used for connection
+	ip_addr_t brokerAddress;
+
+	/// index of MQTT broker in the list of brokers
+	size_t brokerIndex;
+
+	/// pointer to network interface, nullptr if revalidation is not in progress
+	netif* networkInterface;
+};
+
+#if FAST_BOOT_PROBE == 1
+
+/// state of probing of cached address
+struct CachedAddressProbe
+{
+	/// address conflict detection of cached address
+	acd conflictDetection;
+
+	/// cache with lease which is probed
+	BootCache bootCache;
+
+	/// true if result of probing is not known yet, false otherwise
+	bool pending;
+};
+
+#endif	// FAST_BOOT_PROBE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// magic number of valid cache, should be changed when layout of BootCache changes
+constexpr uint32_t bootCacheMagic {0x424f4f32};
+
+/// max number of checks of backup regulator during initialization, at least a few ms at max core clock
+constexpr uint32_t backupRegulatorReadyChecks {1000000};
+
+/// delay between start of revalidation and saving the cache, should be long enough for ARP and DNS responses
+constexpr uint32_t revalidationDelay {10000};
+
+/// state of revalidation of the cache
+Revalidation revalidation;
+
+/// true if cached MAC address of the gateway was added as a static ARP entry, false otherwise
+bool gatewayAddressRestored;
+
+#if FAST_BOOT_PROBE == 1
+
+/// state of probing of cached address
+CachedAddressProbe cachedAddressProbe;
+
+#endif	// FAST_BOOT_PROBE == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Low-level initializer for backup SRAM
+ *
+ * Enables access to backup domain, backup regulator (so that backup SRAM retains its contents when only VBAT is
+ * supplied) and clock of backup SRAM. Wait for backup regulator is bounded - if it doesn't become ready (e.g. faulty
+ * VBAT supply), boot continues and the cache is not used (see isBackupRegulatorReady()).
+ *
+ * This function is called before constructors for global and static objects via BIND_LOW_LEVEL_INITIALIZER().
+ */
+
+void backupSramLowLevelInitializer()
+{
+	RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+	PWR->CR1 |= PWR_CR1_DBP;
+	PWR->CSR1 |= PWR_CSR1_BRE;
+	for (uint32_t i {}; i < backupRegulatorReadyChecks && (PWR->CSR1 & PWR_CSR1_BRR) == 0; ++i);
+	RCC->AHB1ENR |= RCC_AHB1ENR_BKPSRAMEN;
+}
+
+BIND_LOW_LEVEL_INITIALIZER(40, backupSramLowLevelInitializer);
+
+/**
+ * \return true if backup regulator is ready and the cache in backup SRAM can be used, false otherwise
+ */
+
+bool isBackupRegulatorReady()
+{
+	return (PWR->CSR1 & PWR_CSR1_BRR) != 0;
+}
+
+/**
+ * \return reference to cache in backup SRAM
+ */
+
+BootCache& getBackupBootCache()
+{
+	return *reinterpret_cast<BootCache*>(BKPSRAM_BASE);
+}
+
+/**
+ * \brief Calculates CRC-32 of the cache.
+ *
+ * \param [in] bootCache is a reference to cache
+ *
+ * \return CRC-32 of all fields of \a bootCache which precede its CRC
+ */
+
+uint32_t calculateCrc(const BootCache& bootCache)
+{
+	const auto data = reinterpret_cast<const uint8_t*>(&bootCache);
+	uint32_t crc {UINT32_MAX};
+	for (size_t i {}; i < offsetof(BootCache, crc); ++i)
+	{
+		crc ^= data[i];
+		for (size_t bit {}; bit < 8; ++bit)
+			crc = (crc >> 1) ^ ((crc & 1) != 0 ? 0xedb88320 : 0);
+	}
+	return ~crc;
+}
+
+/**
+ * \brief Reads the cache from backup SRAM.
+ *
+ * \param [out] bootCache is a reference to variable for read cache
+ *
+ * \return true if backup regulator is ready and cache in backup SRAM is valid, false otherwise
+ */
+
+bool readBootCache(BootCache& bootCache)
+{
+	if (isBackupRegulatorReady() == false)
+		return false;
+
+	memcpy(&bootCache, &getBackupBootCache(), sizeof(bootCache));
+	return bootCache.magic == bootCacheMagic && bootCache.crc == calculateCrc(bootCache);
+}
+
+/**
+ * \brief Sets state of DHCP client which waits for the link to go up.
+ *
+ * lwIP has no API for this, so this function writes private state of DHCP client, which is the only place in the
+ * project which does that. When the link goes up, dhcp_network_changed_link_up() in lwIP 2.1 and 2.2 keeps the client
+ * stopped in DHCP_STATE_OFF state, starts discovery in DHCP_STATE_INIT state and starts INIT-REBOOT in
+ * DHCP_STATE_REBOOTING state (see switchDhcpToRebooting()).
+ *
+ * This must be checked whenever lwIP is updated.
+ *
+ * \param [in] dhcp is a reference to state of DHCP client
+ * \param [in] state is the new state of DHCP client
+ */
+
+void setDhcpState(dhcp& dhcp, const uint8_t state)
+{
+	dhcp.state = state;
+	dhcp.tries = {};
+}
+
+/**
+ * \brief Switches DHCP client to INIT-REBOOT state with cached lease.
+ *
+ * lwIP has no API for INIT-REBOOT with a lease from outside, so this function writes private state of DHCP client (with
+ * setDhcpState()). It depends on internals of dhcp.c in lwIP 2.1 and 2.2:
+ * - when the link goes up in DHCP_STATE_REBOOTING state, dhcp_network_changed_link_up() calls dhcp_reboot(), which
+ * sends DHCPREQUEST for \a offered_ip_addr (without server identifier),
+ * - DHCPACK received in this state is bound directly (dhcp_check() - address conflict detection - is done only in
+ * DHCP_STATE_REQUESTING state), so only the cached address is used without ARP probing, the address from any regular
+ * discovery is still probed,
+ * - DHCPNAK or timeout in this state restarts discovery.
+ *
+ * This must be checked whenever lwIP is updated.
+ *
+ * \param [in] dhcp is a reference to state of DHCP client
+ * \param [in] bootCache is a reference to valid cache with lease
+ */
+
+void switchDhcpToRebooting(dhcp& dhcp, const BootCache& bootCache)
+{
+	ip4_addr_copy(dhcp.offered_ip_addr, bootCache.address);
+	ip4_addr_copy(dhcp.offered_sn_mask, bootCache.netmask);
+	ip4_addr_copy(dhcp.offered_gw_addr, bootCache.gateway);
+	setDhcpState(dhcp, DHCP_STATE_REBOOTING);
+}
+
+#if FAST_BOOT_PROBE == 1
+
+/**
+ * \brief Callback of address conflict detection of cached address
+ *
+ * Releases DHCP client, which was stopped during probing - with INIT-REBOOT with cached lease if the address is not
+ * used by any other host, with regular discovery otherwise.
+ *
+ * \param [in] netif is a pointer to network interface
+ * \param [in] state is the result of address conflict detection
+ */
+
+void cachedAddressProbeCallback(netif* const netif, const acd_callback_enum_t state)
+{
+	if (cachedAddressProbe.pending == false)	// ACD_DECLINE may be followed by ACD_RESTART_CLIENT
+		return;
+
+	cachedAddressProbe.pending = {};
+	// only sets the state, so it may be called from the callback; announcing is not needed, DHCP takes over
+	acd_stop(&cachedAddressProbe.conflictDetection);
+
+	const auto dhcp = netif_dhcp_data(netif);
+	assert(dhcp != nullptr);
+
+	char buffer[IP4ADDR_STRLEN_MAX];
+	const auto address = ip4addr_ntoa_r(&cachedAddressProbe.bootCache.address, buffer, sizeof(buffer));
+	if (state == ACD_IP_OK)
+	{
+		fiprintf(standardOutputStream, "cachedAddressProbeCallback: requesting cached address %s\r\n", address);
+		switchDhcpToRebooting(*dhcp, cachedAddressProbe.bootCache);
+	}
+	else
+	{
+		fiprintf(standardOutputStream, "cachedAddressProbeCallback: cached address %s is used, starting discovery\r\n",
+				address);
+		setDhcpState(*dhcp, DHCP_STATE_INIT);
+	}
+
+	dhcp_network_changed_link_up(netif);
+}
+
+#endif	// FAST_BOOT_PROBE == 1
+
+/**
+ * \brief lwIP's DNS found callback used during revalidation
+ *
+ * \param [in] address is a pointer to resolved address, nullptr if host name could not be resolved
+ */
+
+void revalidationDnsFoundCallback(const char*, const ip_addr_t* const address, void*)
+{
+	if (address != nullptr && revalidation.networkInterface != nullptr)
+		revalidation.brokerAddress = *address;
+}
+
+/**
+ * \brief lwIP's timeout handler which finishes revalidation and saves the cache.
+ */
+
+void revalidationTimeoutHandler(void*)
+{
+	assert(revalidation.networkInterface != nullptr);
+	auto& netif = *revalidation.networkInterface;
+
+	BootCache bootCache {};
+	bootCache.magic = bootCacheMagic;
+	ip4_addr_copy(bootCache.address, *netif_ip4_addr(&netif));
+	ip4_addr_copy(bootCache.netmask, *netif_ip4_netmask(&netif));
+	ip4_addr_copy(bootCache.gateway, *netif_ip4_gw(&netif));
+	ip4_addr_copy(bootCache.brokerAddress, *ip_2_ip4(&revalidation.brokerAddress));
+	bootCache.brokerIndex = revalidation.brokerIndex;
+
+	{
+		eth_addr* gatewayMac;
+		const ip4_addr_t* gatewayAddress;
+		if (etharp_find_addr(&netif, netif_ip4_gw(&netif), &gatewayMac, &gatewayAddress) >= 0)
+		{
+			bootCache.gatewayMac = *gatewayMac;
+			bootCache.gatewayMacValid = true;
+		}
+	}
+
+	revalidation = {};
+	if (isBackupRegulatorReady() == false)
+	{
+		fiprintf(standardOutputStream, "revalidationTimeoutHandler: backup regulator not ready, cache not saved\r\n");
+		return;
+	}
+
+	bootCache.crc = calculateCrc(bootCache);
+	memcpy(&getBackupBootCache(), &bootCache, sizeof(bootCache));
+
+	char addressBuffer[IP4ADDR_STRLEN_MAX];
+	char brokerAddressBuffer[IP4ADDR_STRLEN_MAX];
+	fiprintf(standardOutputStream, "revalidationTimeoutHandler: saved lease %s, broker %s, gateway MAC %s\r\n",
+			ip4addr_ntoa_r(&bootCache.address, addressBuffer, sizeof(addressBuffer)),
+			ip4addr_ntoa_r(&bootCache.brokerAddress, brokerAddressBuffer, sizeof(brokerAddressBuffer)),
+			bootCache.gatewayMacValid == true ? "known" : "unknown");
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool getCachedBrokerAddress(ip_addr_t& address, size_t& index)
+{
+	BootCache bootCache;
+	if (readBootCache(bootCache) == false)
+		return false;
+
+	ip_addr_copy_from_ip4(address, bootCache.brokerAddress);
+	index = bootCache.brokerIndex;
+	return true;
+}
+
+void restoreCachedGatewayAddress(netif& netif)
+{
+	BootCache bootCache;
+	if (gatewayAddressRestored == true || readBootCache(bootCache) == false || bootCache.gatewayMacValid == false ||
+			ip4_addr_cmp(&bootCache.gateway, netif_ip4_gw(&netif)) == 0)
+		return;
+
+	const auto ret = etharp_add_static_entry(&bootCache.gateway, &bootCache.gatewayMac);
+	if (ret != ERR_OK)
+	{
+		fiprintf(standardOutputStream, "restoreCachedGatewayAddress: etharp_add_static_entry() failed, ret = %d\r\n",
+				ret);
+		return;
+	}
+
+	gatewayAddressRestored = true;
+}
+
+void revalidateBootCache(netif& netif, const char* const brokerHostName, const size_t brokerIndex,
+		const ip_addr_t& brokerAddress)
+{
+	if (revalidation.networkInterface != nullptr)	// revalidation already in progress?
+		return;
+
+	revalidation = {brokerAddress, brokerIndex, &netif};
+
+	// replace static ARP entry with a regular one, learned from the response
+	if (gatewayAddressRestored == true)
+	{
+		etharp_remove_static_entry(netif_ip4_gw(&netif));
+		gatewayAddressRestored = {};
+	}
+	etharp_request(&netif, netif_ip4_gw(&netif));
+
+	{
+		ip_addr_t address;
+		const auto ret = dns_gethostbyname(brokerHostName, &address, revalidationDnsFoundCallback, {});
+		if (ret == ERR_OK)
+			revalidation.brokerAddress = address;
+		else if (ret != ERR_INPROGRESS)
+			fiprintf(standardOutputStream, "revalidateBootCache: dns_gethostbyname() failed, ret = %d\r\n", ret);
+	}
+
+	sys_timeout(revalidationDelay, revalidationTimeoutHandler, {});
+}
+
+bool startDhcpWithCachedLease(netif& netif)
+{
+	if (isBackupRegulatorReady() == false)
+	{
+		fiprintf(standardOutputStream, "startDhcpWithCachedLease: backup regulator is not ready, cache disabled\r\n");
+		return false;
+	}
+
+	BootCache bootCache;
+	if (readBootCache(bootCache) == false)
+		return false;
+
+	const auto dhcp = netif_dhcp_data(&netif);
+	assert(dhcp != nullptr);
+	assert(netif_is_link_up(&netif) == 0);
+
+	char buffer[IP4ADDR_STRLEN_MAX];
+
+#if FAST_BOOT_PROBE == 1
+
+	{
+		const auto ret = acd_add(&netif, &cachedAddressProbe.conflictDetection, cachedAddressProbeCallback);
+		assert(ret == ERR_OK);
+	}
+
+	// DHCP client stays stopped until the result of probing is known, see startCachedAddressProbe()
+	cachedAddressProbe.bootCache = bootCache;
+	cachedAddressProbe.pending = true;
+	setDhcpState(*dhcp, DHCP_STATE_OFF);
+
+	fiprintf(standardOutputStream, "startDhcpWithCachedLease: cached address %s will be probed\r\n",
+			ip4addr_ntoa_r(&bootCache.address, buffer, sizeof(buffer)));
+
+#else	// FAST_BOOT_PROBE != 1
+
+	switchDhcpToRebooting(*dhcp, bootCache);
+
+	fiprintf(standardOutputStream, "startDhcpWithCachedLease: requesting cached address %s\r\n",
+			ip4addr_ntoa_r(&bootCache.address, buffer, sizeof(buffer)));
+
+#endif	// FAST_BOOT_PROBE != 1
+
+	return true;
+}
+
+#if FAST_BOOT_PROBE == 1
+
+void startCachedAddressProbe(netif& netif)
+{
+	if (cachedAddressProbe.pending == false)
+		return;
+
+	// probing interrupted by loss of the link is started again from the beginning
+	const auto ret = acd_start(&netif, &cachedAddressProbe.conflictDetection, cachedAddressProbe.bootCache.address);
+	assert(ret == ERR_OK);
+}
+
+#endif	// FAST_BOOT_PROBE == 1
@@ -0,0 +1,99 @@
+/**
+ * \file
+ * \brief Declarations related to cache of network state used for fast boot
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BOOTCACHE_HPP_
+#define BOOTCACHE_HPP_
+
+#include "lwip/ip_addr.h"
+
+struct netif;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Gets cached address of MQTT broker.
+ *
+ * \param [out] address is a reference to variable for cached address
+ * \param [out] index is a reference to variable for index of MQTT broker in the list of brokers
+ *
+ * \return true if cache is valid and \a address and \a index were written, false otherwise
+ */
+
+bool getCachedBrokerAddress(ip_addr_t& address, size_t& index);
+
+/**
+ * \brief Restores cached MAC address of the gateway as a static ARP entry.
+ *
+ * Should be called from status callback of network interface, when it gets its address. The entry is added only if
+ * the gateway is the same as in the cache. It is replaced with a regular entry when the cache is revalidated.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] netif is a reference to network interface
+ */
+
+void restoreCachedGatewayAddress(netif& netif);
+
+/**
+ * \brief Revalidates the cache in background and saves it.
+ *
+ * Should be called once connection with MQTT broker is established, when it is known that current network state is
+ * valid. The gateway is asked for its MAC address with ARP request and broker's host name is resolved with DNS again.
+ * After a few seconds current DHCP lease, gateway's MAC address and broker's address are saved in the cache.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] netif is a reference to network interface
+ * \param [in] brokerHostName is the host name of MQTT broker, must stay valid until the cache is saved
+ * \param [in] brokerIndex is the index of MQTT broker in the list of brokers
+ * \param [in] brokerAddress is the address of MQTT broker which was used for connection
+ */
+
+void revalidateBootCache(netif& netif, const char* brokerHostName, size_t brokerIndex, const ip_addr_t& brokerAddress);
+
+/**
+ * \brief Starts DHCP client in INIT-REBOOT state with cached lease.
+ *
+ * Instead of the full DISCOVER - OFFER - REQUEST - ACK exchange, the client will request cached address directly as
+ * soon as the link is up. If the server doesn't respond or the request is rejected, lwIP falls back to discovery.
+ *
+ * With FAST_BOOT_PROBE the client stays stopped until cached address is probed with ARP (see
+ * startCachedAddressProbe()) - it is requested only if no other host uses it, otherwise regular discovery is started.
+ *
+ * \warning lwIP core must be locked when this function is called. It must be called right after dhcp_start(), while
+ * the link is still down.
+ *
+ * \param [in] netif is a reference to network interface
+ *
+ * \return true if cache is valid and DHCP client was switched to INIT-REBOOT state, false otherwise
+ */
+
+bool startDhcpWithCachedLease(netif& netif);
+
+/**
+ * \brief Starts probing of cached address with ARP (address conflict detection, RFC 5227).
+ *
+ * Should be called from link callback of network interface, each time the link goes up. Does nothing if cached address
+ * is not being probed (cache is not valid or result of probing is already known). Probing interrupted by loss of the
+ * link is started again from the beginning.
+ *
+ * \note Available only with FAST_BOOT_PROBE.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] netif is a reference to network interface
+ */
+
+void startCachedAddressProbe(netif& netif);
+
+#endif	// BOOTCACHE_HPP_
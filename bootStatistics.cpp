@@ -0,0 +1,194 @@
+/**
+ * \file
+ * \brief Definitions related to statistics of boot
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "bootStatistics.hpp"
+
+#include "distortos/board/standardOutputStream.h"
+
+#include "distortos/assert.h"
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/TickClock.hpp"
+
+#include <iterator>
+
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// timeline of boot
+struct BootTimeline
+{
+	/// time from boot to each milestone, milliseconds, valid only if corresponding bit in \a recorded is set
+	unsigned long times[static_cast<size_t>(BootMilestone::count)];
+
+	/// bitmask of recorded milestones
+	uint32_t recorded;
+
+	/// true if cached network state was used during boot, false otherwise
+	bool cached;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// short names of milestones, used in payload of timeline and in printed timeline
+const char* const milestoneNames[]
+{
+		"streams",
+		"link",
+		"dhcp",
+		"dns",
+		"mqtt",
+		"publish",
+};
+
+static_assert(std::size(milestoneNames) == static_cast<size_t>(BootMilestone::count),
+		"Number of names doesn't match number of milestones!");
+
+/// timeline of boot
+BootTimeline bootTimeline;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \return copy of timeline of boot
+ */
+
+BootTimeline getBootTimeline()
+{
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+	return bootTimeline;
+}
+
+/**
+ * \brief Records milestone of boot.
+ *
+ * \param [in] milestone is the milestone which was reached
+ * \param [in] cached selects whether cached network state was used during boot (true) or not (false), used only for
+ * BootMilestone::firstPublish
+ *
+ * \return true if milestone was recorded, false if it was already recorded earlier
+ */
+
+bool recordMilestone(const BootMilestone milestone, const bool cached)
+{
+	const auto index = static_cast<size_t>(milestone);
+	assert(index < std::size(bootTimeline.times));
+	const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+			distortos::TickClock::now().time_since_epoch()).count();
+
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+	if ((bootTimeline.recorded & (1 << index)) != 0)
+		return false;
+
+	bootTimeline.times[index] = time;
+	bootTimeline.recorded |= 1 << index;
+	if (milestone == BootMilestone::firstPublish)
+		bootTimeline.cached = cached;
+	return true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| BootStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int BootStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize, char* const payload,
+		const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	const auto timeline = getBootTimeline();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, index == 0 ? "boot/summary" : "boot/timeline");
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	if (index == 0)
+	{
+		const auto ret = sniprintf(payload, payloadSize, "firstPublish=%lu cached=%d",
+				timeline.times[static_cast<size_t>(BootMilestone::firstPublish)], timeline.cached);
+		if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+			return -1;
+
+		return ret;
+	}
+
+	size_t length {};
+	for (size_t milestone {}; milestone < std::size(timeline.times); ++milestone)
+	{
+		if ((timeline.recorded & (1 << milestone)) == 0)
+			continue;
+
+		const auto ret = sniprintf(payload + length, payloadSize - length, "%s%s=%lu", length == 0 ? "" : " ",
+				milestoneNames[milestone], timeline.times[milestone]);
+		if (ret < 0 || static_cast<size_t>(ret) >= payloadSize - length)
+			return -1;
+		length += ret;
+	}
+
+	return length;
+}
+
+size_t BootStatisticsSource::getCount() const
+{
+	const auto timeline = getBootTimeline();
+	return (timeline.recorded & (1 << static_cast<size_t>(BootMilestone::firstPublish))) != 0 ? 2 : 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void printBootTimeline()
+{
+	const auto timeline = getBootTimeline();
+	fiprintf(standardOutputStream, "Boot timeline%s:\r\n",
+			timeline.cached == true ? " (with cached network state)" : "");
+	unsigned long previousTime {};
+	for (size_t milestone {}; milestone < std::size(timeline.times); ++milestone)
+	{
+		if ((timeline.recorded & (1 << milestone)) == 0)
+		{
+			fiprintf(standardOutputStream, "  %-8s not reached\r\n", milestoneNames[milestone]);
+			continue;
+		}
+
+		const auto time = timeline.times[milestone];
+		fiprintf(standardOutputStream, "  %-8s %6lu ms (%+ld ms)\r\n", milestoneNames[milestone], time,
+				static_cast<long>(time - previousTime));
+		previousTime = time;
+	}
+}
+
+void recordBootMilestone(const BootMilestone milestone)
+{
+	recordMilestone(milestone, {});
+}
+
+void recordFirstPublish(const bool cached)
+{
+	if (recordMilestone(BootMilestone::firstPublish, cached) == false)
+		return;
+
+	printBootTimeline();
+}
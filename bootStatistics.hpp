@@ -0,0 +1,113 @@
+/**
+ * \file
+ * \brief Declarations related to statistics of boot
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BOOTSTATISTICS_HPP_
+#define BOOTSTATISTICS_HPP_
+
+#include "StatisticsSource.hpp"
+
+#include <cstdint>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// milestone of boot, in the order in which they are usually reached
+enum class BootMilestone : uint8_t
+{
+	/// standard streams were initialized
+	streamsUp,
+	/// PHY reported that the link is up
+	phyLink,
+	/// network interface got its address (from DHCP server or from cached lease)
+	dhcpBound,
+	/// address of MQTT broker is known (resolved with DNS or taken from cache)
+	dnsResolved,
+	/// connection with MQTT broker was accepted
+	mqttAccepted,
+	/// first message was published successfully
+	firstPublish,
+
+	/// number of milestones
+	count
+};
+
+/**
+ * \brief Source of statistics of boot.
+ *
+ * Summary is published in "stats/boot/summary" topic, timeline is published in "stats/boot/timeline" topic.
+ */
+
+class BootStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats summary or timeline of boot.
+	 *
+	 * Payload of summary has following format: "firstPublish=<first publish> cached=<cached>", where "first publish"
+	 * is the time from boot to first successful publish in milliseconds and "cached" is 1 if cached network state was
+	 * used during boot, 0 otherwise. Payload of timeline has following format: "streams=<time> link=<time> dhcp=<time>
+	 * dns=<time> mqtt=<time> publish=<time>", where each time is the time from boot to the milestone in milliseconds,
+	 * milestones which were not reached are omitted.
+	 *
+	 * \param [in] index is the index of entry, 0 - summary, 1 - timeline
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return 2 if first publish was already recorded, 0 otherwise
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Prints timeline of boot to standard output stream.
+ */
+
+void printBootTimeline();
+
+/**
+ * \brief Records milestone of boot.
+ *
+ * Only the first call for given milestone has any effect, all subsequent calls are ignored. This function may be
+ * called from any thread.
+ *
+ * \param [in] milestone is the milestone which was reached
+ */
+
+void recordBootMilestone(BootMilestone milestone);
+
+/**
+ * \brief Records first successful publish after boot.
+ *
+ * Only the first call has any effect, all subsequent calls are ignored. BootMilestone::firstPublish is recorded and
+ * the whole timeline of boot is printed to standard output stream.
+ *
+ * \param [in] cached selects whether cached network state was used during boot (true) or not (false)
+ */
+
+void recordFirstPublish(bool cached);
+
+#endif	// BOOTSTATISTICS_HPP_
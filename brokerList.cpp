@@ -0,0 +1,348 @@
+/**
+ * \file
+ * \brief Definitions related to list of MQTT brokers
+ *
+ * Addresses of brokers are resolved with lwIP's DNS client and cached. Each cached address is refreshed periodically.
+ * lwIP's DNS client keeps its own table of recent answers and honours TTLs received from DNS server, so refresh
+ * generates network traffic only when TTL of the answer has already expired - this way the cache effectively follows
+ * TTLs, while addresses are never removed from it.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "brokerList.hpp"
+
+#include "distortos/board/standardOutputStream.h"
+
+#include "distortos/assert.h"
+#include "distortos/Semaphore.hpp"
+
+#include "lwip/dns.h"
+#include "lwip/tcpip.h"
+#include "lwip/timeouts.h"
+
+#include <algorithm>
+
+#include <cinttypes>
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// state of single MQTT broker
+struct BrokerState
+{
+	/// cached address of broker, valid only if \a resolved is true
+	ip_addr_t address;
+
+	/// value of sys_now() at which address should be resolved again
+	uint32_t refreshTime;
+
+	/// value of sys_now() before which broker is not selected, unless all brokers are blocked
+	uint32_t blockedUntil;
+
+	/// smoothed time of establishing connection, milliseconds, 0 if there was no successful connection yet
+	uint32_t latency;
+
+	/// number of successful connections
+	uint16_t connections;
+
+	/// number of failed connections
+	uint16_t failures;
+
+	/// number of consecutive failed connections
+	uint8_t consecutiveFailures;
+
+	/// true if \a address is valid, false otherwise
+	bool resolved;
+
+	/// true if resolution is in progress, false otherwise
+	bool resolving;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// max number of brokers
+constexpr size_t maxBrokerCount {4};
+
+/// period of refreshing cached addresses, milliseconds
+constexpr uint32_t refreshPeriod {60000};
+
+/// delay before retrying failed resolution, milliseconds
+constexpr uint32_t resolutionRetryDelay {5000};
+
+/// period of timer which starts resolutions, milliseconds
+constexpr uint32_t resolverPeriod {1000};
+
+/// penalty added to score for each consecutive failure, milliseconds
+constexpr uint32_t failurePenalty {5000};
+
+/// time for which broker is blocked after first failure, milliseconds, doubled with each consecutive failure
+constexpr uint32_t initialBlockTime {1000};
+
+/// max time for which broker is blocked after failure, milliseconds
+constexpr uint32_t maxBlockTime {60000};
+
+/// semaphore posted when any address is resolved
+distortos::Semaphore brokerResolvedSemaphore {0, 1};
+
+/// states of brokers
+BrokerState brokerStates[maxBrokerCount];
+
+/// pointer to array with endpoints of brokers
+const BrokerEndpoint* brokerEndpoints;
+
+/// number of elements in brokerEndpoints array
+size_t brokerCount;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \param [in] brokerState is a reference to state of broker
+ *
+ * \return health score of broker, lower is better
+ */
+
+uint32_t getScore(const BrokerState& brokerState)
+{
+	return brokerState.latency + brokerState.consecutiveFailures * failurePenalty;
+}
+
+/**
+ * \brief Handles result of resolution of broker's host name.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] index is the index of broker
+ * \param [in] address is a pointer to resolved address, nullptr if host name could not be resolved
+ */
+
+void handleResolution(const size_t index, const ip_addr_t* const address)
+{
+	auto& brokerState = brokerStates[index];
+	brokerState.resolving = {};
+
+	if (address == nullptr)
+	{
+		fiprintf(standardOutputStream, "handleResolution: resolution of %s failed\r\n",
+				brokerEndpoints[index].hostName);
+		brokerState.refreshTime = sys_now() + resolutionRetryDelay;
+		return;
+	}
+
+	if (brokerState.resolved == false || ip_addr_cmp(&brokerState.address, address) == 0)
+	{
+		char buffer[IPADDR_STRLEN_MAX];
+		fiprintf(standardOutputStream, "handleResolution: %s is %s\r\n", brokerEndpoints[index].hostName,
+				ipaddr_ntoa_r(address, buffer, sizeof(buffer)));
+	}
+
+	brokerState.address = *address;
+	brokerState.resolved = true;
+	brokerState.refreshTime = sys_now() + refreshPeriod;
+	brokerResolvedSemaphore.post();
+}
+
+/**
+ * \brief lwIP's DNS found callback
+ *
+ * \param [in] address is a pointer to resolved address, nullptr if host name could not be resolved
+ * \param [in] argument is a argument which was passed to dns_gethostbyname(), must be index of broker!
+ */
+
+void resolverDnsFoundCallback(const char*, const ip_addr_t* const address, void* const argument)
+{
+	handleResolution(reinterpret_cast<size_t>(argument), address);
+}
+
+/**
+ * \brief Starts resolution of broker's host name.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] index is the index of broker
+ */
+
+void resolve(const size_t index)
+{
+	brokerStates[index].resolving = true;
+
+	ip_addr_t address;
+	const auto ret = dns_gethostbyname(brokerEndpoints[index].hostName, &address, resolverDnsFoundCallback,
+			reinterpret_cast<void*>(index));
+	if (ret == ERR_OK)
+		handleResolution(index, &address);
+	else if (ret != ERR_INPROGRESS)
+	{
+		fiprintf(standardOutputStream, "resolve: dns_gethostbyname() failed, ret = %d\r\n", ret);
+		handleResolution(index, {});
+	}
+}
+
+/**
+ * \brief lwIP's timeout handler which starts resolutions of all addresses which should be refreshed.
+ */
+
+void resolverTimeoutHandler(void*)
+{
+	const auto now = sys_now();
+	for (size_t i {}; i < brokerCount; ++i)
+		if (brokerStates[i].resolving == false && static_cast<int32_t>(now - brokerStates[i].refreshTime) >= 0)
+			resolve(i);
+
+	sys_timeout(resolverPeriod, resolverTimeoutHandler, {});
+}
+
+/**
+ * \brief Selects the healthiest broker with cached address.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \return index of selected broker, brokerCount if no broker has cached address
+ */
+
+size_t selectHealthiestBroker()
+{
+	const auto now = sys_now();
+	size_t selected {brokerCount};
+	bool selectedBlocked {};
+	for (size_t i {}; i < brokerCount; ++i)
+	{
+		const auto& brokerState = brokerStates[i];
+		if (brokerState.resolved == false)
+			continue;
+
+		const auto blocked = static_cast<int32_t>(now - brokerState.blockedUntil) < 0;
+		if (selected == brokerCount || (selectedBlocked == true && blocked == false) ||
+				(selectedBlocked == blocked && getScore(brokerState) < getScore(brokerStates[selected])))
+		{
+			selected = i;
+			selectedBlocked = blocked;
+		}
+	}
+
+	return selected;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| BrokerStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int BrokerStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize, char* const payload,
+		const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	LOCK_TCPIP_CORE();
+	const auto brokerState = brokerStates[index];
+	UNLOCK_TCPIP_CORE();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "broker/%s", brokerEndpoints[index].hostName);
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	char buffer[IPADDR_STRLEN_MAX];
+	const auto ret = sniprintf(payload, payloadSize,
+			"address=%s latency=%" PRIu32 " score=%" PRIu32 " connections=%u failures=%u",
+			brokerState.resolved == true ? ipaddr_ntoa_r(&brokerState.address, buffer, sizeof(buffer)) : "none",
+			brokerState.latency, getScore(brokerState), brokerState.connections, brokerState.failures);
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t BrokerStatisticsSource::getCount() const
+{
+	return brokerCount;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void reportBrokerConnection(const size_t index, const bool success, const uint32_t latency)
+{
+	assert(index < brokerCount);
+
+	LOCK_TCPIP_CORE();
+	auto& brokerState = brokerStates[index];
+	if (success == true)
+	{
+		// exponentially weighted moving average, weight of new sample is 1/4
+		brokerState.latency = brokerState.latency == 0 ? std::max(latency, uint32_t{1}) :
+				(3 * brokerState.latency + latency) / 4;
+		++brokerState.connections;
+		brokerState.consecutiveFailures = {};
+		brokerState.blockedUntil = sys_now();
+	}
+	else
+	{
+		const auto blockTime = std::min(initialBlockTime << std::min(brokerState.consecutiveFailures, uint8_t{16}),
+				maxBlockTime);
+		++brokerState.failures;
+		if (brokerState.consecutiveFailures < UINT8_MAX)
+			++brokerState.consecutiveFailures;
+		brokerState.blockedUntil = sys_now() + blockTime;
+	}
+	UNLOCK_TCPIP_CORE();
+}
+
+size_t selectBroker(ip_addr_t& address)
+{
+	while (1)
+	{
+		LOCK_TCPIP_CORE();
+		const auto index = selectHealthiestBroker();
+		if (index != brokerCount)
+			address = brokerStates[index].address;
+		UNLOCK_TCPIP_CORE();
+
+		if (index != brokerCount)
+			return index;
+
+		const auto ret = brokerResolvedSemaphore.wait();
+		assert(ret == 0);
+	}
+}
+
+void setCachedBrokerAddress(const size_t index, const ip_addr_t& address)
+{
+	assert(index < maxBrokerCount);
+
+	LOCK_TCPIP_CORE();
+	brokerStates[index].address = address;
+	brokerStates[index].resolved = true;
+	UNLOCK_TCPIP_CORE();
+}
+
+void startBrokerResolver(const BrokerEndpoint* const endpoints, const size_t count)
+{
+	assert(endpoints != nullptr && count != 0 && count <= maxBrokerCount);
+
+	LOCK_TCPIP_CORE();
+	assert(brokerEndpoints == nullptr);
+	brokerEndpoints = endpoints;
+	brokerCount = count;
+	const auto now = sys_now();
+	for (size_t i {}; i < brokerCount; ++i)
+		brokerStates[i].refreshTime = now;
+	resolverTimeoutHandler({});
+	UNLOCK_TCPIP_CORE();
+}
@@ -0,0 +1,129 @@
+/**
+ * \file
+ * \brief Declarations related to list of MQTT brokers
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BROKERLIST_HPP_
+#define BROKERLIST_HPP_
+
+#include "StatisticsSource.hpp"
+
+#include "lwip/ip_addr.h"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// endpoint of MQTT broker
+struct BrokerEndpoint
+{
+	/// host name of MQTT broker
+	const char* hostName;
+
+	/// TCP port of MQTT broker
+	uint16_t port;
+};
+
+/**
+ * \brief Source of statistics of MQTT brokers.
+ *
+ * Statistics of each broker are published in "stats/broker/<host name>" topic.
+ */
+
+class BrokerStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats statistics of one broker.
+	 *
+	 * Payload has following format: "address=<address> latency=<latency> score=<score> connections=<connections>
+	 * failures=<failures>", where "address" is the cached address of the broker ("none" if it was never resolved),
+	 * "latency" is the smoothed time of establishing connection in milliseconds (0 if there was no successful
+	 * connection yet), "score" is the health score (lower is better), "connections" is the number of successful
+	 * connections and "failures" is the number of failed connections.
+	 *
+	 * \param [in] index is the index of broker, [0; getCount())
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of brokers
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Reports result of connecting to MQTT broker, updating its health score.
+ *
+ * Successful connection updates smoothed latency of the broker and clears its failures. Failed connection increases
+ * the score of the broker and excludes it from selection for a time which grows exponentially with each consecutive
+ * failure.
+ *
+ * \param [in] index is the index of broker, which was returned by selectBroker()
+ * \param [in] success selects whether connection was accepted (true) or not (false)
+ * \param [in] latency is the time of establishing connection, milliseconds, ignored if \a success is false
+ */
+
+void reportBrokerConnection(size_t index, bool success, uint32_t latency);
+
+/**
+ * \brief Selects the healthiest MQTT broker.
+ *
+ * Brokers which failed recently are skipped, unless all of them did. From the remaining ones, the broker with the
+ * lowest score (smoothed latency plus a penalty for each consecutive failure) is selected, with ties resolved by the
+ * order of the list. Cached addresses are used, so this function blocks only until the first address is known.
+ *
+ * \param [out] address is a reference to variable for cached address of selected broker
+ *
+ * \return index of selected broker
+ */
+
+size_t selectBroker(ip_addr_t& address);
+
+/**
+ * \brief Sets cached address of MQTT broker, which was obtained from other source than DNS.
+ *
+ * Should be called before startBrokerResolver(). The address is used immediately and refreshed in background.
+ *
+ * \param [in] index is the index of broker
+ * \param [in] address is the cached address of broker
+ */
+
+void setCachedBrokerAddress(size_t index, const ip_addr_t& address);
+
+/**
+ * \brief Starts asynchronous resolution of addresses of MQTT brokers.
+ *
+ * All host names are resolved with lwIP's DNS client in background. Resolved addresses are cached and refreshed
+ * periodically, failed resolutions are retried. When refresh fails, previously resolved address is still used.
+ *
+ * Should be called once network interface has its address.
+ *
+ * \param [in] endpoints is a pointer to array with endpoints of brokers, in the order of preference, must stay valid
+ * for the whole runtime of the application
+ * \param [in] count is the number of elements in \a endpoints array
+ */
+
+void startBrokerResolver(const BrokerEndpoint* endpoints, size_t count);
+
+#endif	// BROKERLIST_HPP_
@@ -0,0 +1,273 @@
+/**
+ * \file
+ * \brief Definitions related to accounting of CPU usage of threads
+ *
+ * distortos has no hook for context switches, so CPU usage is sampled - on every tick a software timer checks which
+ * thread was interrupted and the samples are accumulated in a ring of 1 second windows. Threads are recognized by
+ * addresses of their objects, registered by the threads themselves, except for idle thread, which is the only one with
+ * priority 0. This is a statistical estimate - threads which always finish their work before the next tick (e.g. the
+ * ones woken by tick) are underestimated - but it requires no changes in the scheduler and costs one short interrupt
+ * per tick.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cpuUsage.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/StaticSoftwareTimer.hpp"
+#include "distortos/Thread.hpp"
+#include "distortos/ThisThread.hpp"
+#include "distortos/TickClock.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// samples of CPU usage collected in one window
+struct CpuUsageWindow
+{
+	/// number of samples in which each accounted thread was running
+	uint16_t samples[static_cast<size_t>(CpuUsageThread::count)];
+
+	/// number of all samples
+	uint16_t total;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of windows of CPU usage samples, covers default duration of iperf run (10 seconds) with a large margin
+constexpr size_t windowCount {32};
+
+/// number of samples (ticks) in one window of CPU usage samples
+constexpr uint16_t samplesPerWindow
+{
+		std::chrono::duration_cast<distortos::TickClock::duration>(std::chrono::seconds{1}).count()
+};
+
+/// names of accounted threads, used in topics
+const char* const threadNames[]
+{
+		"idle",
+		"main",
+		"ethernetInput",
+		"tcpip",
+		"other",
+};
+
+static_assert(std::size(threadNames) == static_cast<size_t>(CpuUsageThread::count));
+
+/// registered threads, nullptr if the thread was not registered, entries for idle and other threads are not used
+const distortos::Thread* registeredThreads[static_cast<size_t>(CpuUsageThread::count)];
+
+/// number of all samples in which each accounted thread was running, written by sampleCpuUsage()
+uint32_t sampleCounts[static_cast<size_t>(CpuUsageThread::count)];
+
+/// ring of windows of CPU usage samples, written by sampleCpuUsage()
+CpuUsageWindow windows[windowCount];
+
+/// index of current (incomplete) window in windows
+size_t windowIndex;
+
+/// number of complete windows in windows
+size_t completeWindows;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Identifies accounted thread.
+ *
+ * \param [in] thread is a reference to identified thread
+ *
+ * \return accounted thread which matches \a thread
+ */
+
+CpuUsageThread identifyThread(const distortos::Thread& thread)
+{
+	if (thread.getEffectivePriority() == 0)
+		return CpuUsageThread::idle;
+
+	for (size_t i {}; i < std::size(registeredThreads); ++i)
+		if (registeredThreads[i] == &thread)
+			return static_cast<CpuUsageThread>(i);
+
+	return CpuUsageThread::other;
+}
+
+/**
+ * \brief Samples CPU usage.
+ *
+ * Called on every tick by software timer created in startCpuUsageSampling(), in interrupt context - the current thread
+ * is the one which was interrupted.
+ */
+
+void sampleCpuUsage()
+{
+	const auto thread = static_cast<size_t>(identifyThread(distortos::ThisThread::get()));
+	++sampleCounts[thread];
+	auto& window = windows[windowIndex];
+	++window.samples[thread];
+	++window.total;
+
+	if (window.total < samplesPerWindow)
+		return;
+
+	windowIndex = (windowIndex + 1) % windowCount;
+	windows[windowIndex] = {};
+	completeWindows = std::min(completeWindows + 1, windowCount - 1);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| CpuUsageMetricsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MetricFamily CpuUsageMetricsSource::getFamily(const size_t index) const
+{
+	assert(index < getCount());
+
+	constexpr size_t threadCount {static_cast<size_t>(CpuUsageThread::count)};
+	if (index == 0)
+		return {"cpu_usage_percent", "Percentage of CPU time used by thread in the last second.", "thread", threadCount,
+				MetricType::gauge};
+
+	return {"cpu_samples_total", "Number of ticks in which thread was running.", "thread", threadCount,
+			MetricType::counter};
+}
+
+MetricSeries CpuUsageMetricsSource::getSeries(const size_t family, const size_t index) const
+{
+	assert(family < getCount() && index < static_cast<size_t>(CpuUsageThread::count));
+
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+
+	if (family == 0)
+	{
+		const auto samples = completeWindows != 0 ?
+				windows[(windowIndex + windowCount - 1) % windowCount].samples[index] : 0;
+		return makeMetricSeries(threadNames[index], samples * 100 / samplesPerWindow);
+	}
+
+	return makeMetricSeries(threadNames[index], sampleCounts[index]);
+}
+
+size_t CpuUsageMetricsSource::getCount() const
+{
+	return 2;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| CpuUsageStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int CpuUsageStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize,
+		char* const payload, const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	uint32_t last {};
+	uint32_t sum {};
+	uint32_t min {};
+	uint32_t max {};
+	size_t count;
+
+	{
+		const distortos::InterruptMaskingLock interruptMaskingLock;
+
+		count = completeWindows;
+		for (size_t i {1}; i <= count; ++i)
+		{
+			const auto& window = windows[(windowIndex + windowCount - i) % windowCount];
+			const uint32_t samples {window.samples[index]};
+			if (i == 1)
+				last = min = samples;
+			sum += samples;
+			min = std::min(min, samples);
+			max = std::max(max, samples);
+		}
+	}
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "cpu/%s", threadNames[index]);
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto average = count != 0 ? sum / count : 0;
+	const auto ret = sniprintf(payload, payloadSize, "last=%lu%% average=%lu%% min=%lu%% max=%lu%%",
+			static_cast<unsigned long>(last * 100 / samplesPerWindow),
+			static_cast<unsigned long>(average * 100 / samplesPerWindow),
+			static_cast<unsigned long>(min * 100 / samplesPerWindow),
+			static_cast<unsigned long>(max * 100 / samplesPerWindow));
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t CpuUsageStatisticsSource::getCount() const
+{
+	return static_cast<size_t>(CpuUsageThread::count);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+uint8_t getCpuLoad(const uint32_t duration)
+{
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+
+	const auto count = std::min<size_t>((duration + 999) / 1000, completeWindows);
+	uint32_t idle {windows[windowIndex].samples[static_cast<size_t>(CpuUsageThread::idle)]};
+	uint32_t total {windows[windowIndex].total};
+	for (size_t i {1}; i <= count; ++i)
+	{
+		const auto& window = windows[(windowIndex + windowCount - i) % windowCount];
+		idle += window.samples[static_cast<size_t>(CpuUsageThread::idle)];
+		total += window.total;
+	}
+
+	return total != 0 ? (total - idle) * 100 / total : 0;
+}
+
+const distortos::Thread* getRegisteredThread(const CpuUsageThread thread)
+{
+	assert(thread != CpuUsageThread::idle && thread < CpuUsageThread::other);
+
+	return registeredThreads[static_cast<size_t>(thread)];
+}
+
+void registerCpuUsageThread(const CpuUsageThread thread)
+{
+	assert(thread != CpuUsageThread::idle && thread < CpuUsageThread::other);
+
+	registeredThreads[static_cast<size_t>(thread)] = &distortos::ThisThread::get();
+}
+
+void startCpuUsageSampling()
+{
+	// software timer which samples CPU usage on every tick
+	static auto sampler = distortos::makeStaticSoftwareTimer(sampleCpuUsage);
+
+	const auto ret = sampler.start(distortos::TickClock::duration{1}, distortos::TickClock::duration{1});
+	assert(ret == 0);
+}
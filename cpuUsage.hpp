@@ -0,0 +1,164 @@
+/**
+ * \file
+ * \brief Declarations related to accounting of CPU usage of threads
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CPUUSAGE_HPP_
+#define CPUUSAGE_HPP_
+
+#include "MetricsSource.hpp"
+#include "StatisticsSource.hpp"
+
+#include <cstdint>
+
+namespace distortos
+{
+
+class Thread;
+
+}	// namespace distortos
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// thread (or group of threads) for which CPU usage is accounted
+enum class CpuUsageThread : uint8_t
+{
+	/// idle thread
+	idle,
+	/// main thread
+	main,
+	/// Ethernet input thread
+	ethernetInput,
+	/// lwIP's tcpip thread
+	tcpip,
+	/// all threads which were not registered with registerCpuUsageThread()
+	other,
+
+	/// number of accounted threads
+	count
+};
+
+/**
+ * \brief Source of metrics of CPU usage.
+ *
+ * Families: "cpu_usage_percent" (gauge, percentage of CPU time used by the thread in the last complete 1 second
+ * window) and "cpu_samples_total" (counter, number of ticks in which the thread was running), both with "thread" label.
+ */
+
+class CpuUsageMetricsSource : public MetricsSource
+{
+public:
+
+	/**
+	 * \param [in] index is the index of family, [0; getCount())
+	 *
+	 * \return description of selected family
+	 */
+
+	MetricFamily getFamily(size_t index) const override;
+
+	/**
+	 * \param [in] family is the index of family, [0; getCount())
+	 * \param [in] index is the index of thread, [0; MetricFamily::seriesCount)
+	 *
+	 * \return selected series of selected family
+	 */
+
+	MetricSeries getSeries(size_t family, size_t index) const override;
+
+	/**
+	 * \return number of metric families
+	 */
+
+	size_t getCount() const override;
+};
+
+/**
+ * \brief Source of statistics of CPU usage.
+ *
+ * CPU usage of each thread is published in "stats/cpu/idle", "stats/cpu/main", "stats/cpu/ethernetInput",
+ * "stats/cpu/tcpip" and "stats/cpu/other" topics.
+ */
+
+class CpuUsageStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats CPU usage of one thread.
+	 *
+	 * Payload has following format: "last=<last>% average=<average>% min=<min>% max=<max>%", where "last" is the
+	 * percentage of CPU time used by the thread in the last complete 1 second window and the rest is calculated from
+	 * all complete windows in the ring (up to 31 seconds).
+	 *
+	 * \param [in] index is the index of thread, [0; getCount())
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of accounted threads
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Calculates CPU load during a period which has just finished.
+ *
+ * \param [in] duration is the duration of period, milliseconds, only the last 31 seconds are taken into account
+ *
+ * \return percentage of CPU time spent outside of idle thread during the period, [0; 100]
+ */
+
+uint8_t getCpuLoad(uint32_t duration);
+
+/**
+ * \brief Gets registered thread.
+ *
+ * \param [in] thread selects accounted thread, must not be CpuUsageThread::idle or CpuUsageThread::other
+ *
+ * \return pointer to thread registered with registerCpuUsageThread(), nullptr if it was not registered yet
+ */
+
+const distortos::Thread* getRegisteredThread(CpuUsageThread thread);
+
+/**
+ * \brief Registers current thread for accounting of CPU usage.
+ *
+ * \warning This function must be called by the registered thread itself. Idle thread is recognized automatically and
+ * must not be registered.
+ *
+ * \param [in] thread selects which accounted thread is the current thread
+ */
+
+void registerCpuUsageThread(CpuUsageThread thread);
+
+/**
+ * \brief Starts sampling of CPU usage.
+ *
+ * \warning This function may be called only once, from thread context.
+ */
+
+void startCpuUsageSampling();
+
+#endif	// CPUUSAGE_HPP_
@@ -0,0 +1,36 @@
+/**
+ * \file
+ * \brief Low-level initializer of cycle counter
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cycleCounter.hpp"
+
+#include "distortos/BIND_LOW_LEVEL_INITIALIZER.h"
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Low-level initializer for cycle counter
+ *
+ * This function is called before constructors for global and static objects via BIND_LOW_LEVEL_INITIALIZER().
+ */
+
+void cycleCounterLowLevelInitializer()
+{
+	enableCycleCounter();
+}
+
+BIND_LOW_LEVEL_INITIALIZER(50, cycleCounterLowLevelInitializer);
+
+}	// namespace
@@ -0,0 +1,79 @@
+/**
+ * \file
+ * \brief Functions related to high-resolution cycle counter
+ *
+ * On target the counter is the DWT cycle counter (incremented on every cycle of the core), on the host it is the
+ * steady clock with nanosecond resolution. In both cases the counter is 32-bit and wraps around, so it should be used
+ * only for measuring durations shorter than its period, by subtracting two values.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CYCLECOUNTER_HPP_
+#define CYCLECOUNTER_HPP_
+
+#ifdef __arm__
+
+#include "distortos/chip/clocks.hpp"
+#include "distortos/chip/CMSIS-proxy.h"
+
+#else	// !def __arm__
+
+#include <chrono>
+
+#endif	// !def __arm__
+
+#include <cstdint>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Enables cycle counter.
+ *
+ * Must be called once before the counter is used. On the host this function does nothing.
+ */
+
+inline void enableCycleCounter()
+{
+#ifdef __arm__
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->LAR = 0xc5acce55;	// unlock access to DWT registers, required on Cortex-M7
+	DWT->CYCCNT = {};
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif	// def __arm__
+}
+
+/**
+ * \return current value of cycle counter
+ */
+
+inline uint32_t getCycleCount()
+{
+#ifdef __arm__
+	return DWT->CYCCNT;
+#else	// !def __arm__
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif	// !def __arm__
+}
+
+/**
+ * \return frequency of cycle counter, Hz
+ */
+
+constexpr uint32_t getCycleCounterFrequency()
+{
+#ifdef __arm__
+	return distortos::chip::ahbFrequency;
+#else	// !def __arm__
+	return 1000000000;
+#endif	// !def __arm__
+}
+
+#endif	// CYCLECOUNTER_HPP_
@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \brief copyFromDmaBuffers() and copyToDmaBuffers() header
+ *
+ * Copy loops of Ethernet driver are templates, so that they can be used both with descriptors of STM32 HAL and pbufs of
+ * lwIP and with their host equivalents in benchmarks. Descriptors must have Status, Buffer1Addr and
+ * Buffer2NextDescAddr members (chained mode), pbufs must have next, payload and len members.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef DMAFRAMECOPY_HPP_
+#define DMAFRAMECOPY_HPP_
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * \brief Copies received frame from chain of DMA buffers to pbuf chain.
+ *
+ * \tparam BufferSize is the size of each DMA buffer, bytes
+ * \tparam Descriptor is the type of DMA descriptor
+ * \tparam Pbuf is the type of pbuf
+ *
+ * \param [in] descriptor is a pointer to first descriptor of received frame
+ * \param [in] pbufChain is a pointer to pbuf chain with total length equal to length of received frame, may be nullptr
+ */
+
+template<size_t BufferSize, typename Descriptor, typename Pbuf>
+void copyFromDmaBuffers(const Descriptor* descriptor, Pbuf* const pbufChain)
+{
+	auto buffer = reinterpret_cast<const uint8_t*>(descriptor->Buffer1Addr);
+	size_t bufferOffset {};
+
+	for (auto pbuf = pbufChain; pbuf != nullptr; pbuf = pbuf->next)
+	{
+		size_t bytesLeft {pbuf->len};
+		size_t payloadOffset {};
+
+		while (bytesLeft + bufferOffset > BufferSize)
+		{
+			const auto chunk = BufferSize - bufferOffset;
+			memcpy(static_cast<uint8_t*>(pbuf->payload) + payloadOffset, buffer + bufferOffset, chunk);
+
+			// advance to next descriptor
+			descriptor = reinterpret_cast<const Descriptor*>(descriptor->Buffer2NextDescAddr);
+			buffer = reinterpret_cast<const uint8_t*>(descriptor->Buffer1Addr);
+			bufferOffset = {};
+			bytesLeft -= chunk;
+			payloadOffset += chunk;
+		}
+
+		memcpy(static_cast<uint8_t*>(pbuf->payload) + payloadOffset, buffer + bufferOffset, bytesLeft);
+		bufferOffset += bytesLeft;
+	}
+}
+
+/**
+ * \brief Copies frame from pbuf chain to chain of DMA buffers.
+ *
+ * \tparam BufferSize is the size of each DMA buffer, bytes
+ * \tparam OwnBit is the bit in Status of descriptor which is set when the descriptor is owned by DMA
+ * \tparam Descriptor is the type of DMA descriptor
+ * \tparam Pbuf is the type of pbuf
+ *
+ * \param [in] descriptor is a pointer to first descriptor which will be used for transmitted frame
+ * \param [in] pbufChain is a pointer to pbuf chain with transmitted frame, its total length must not be 0
+ *
+ * \return length of frame copied to DMA buffers, bytes, 0 if one of required descriptors is still owned by DMA
+ */
+
+template<size_t BufferSize, uint32_t OwnBit, typename Descriptor, typename Pbuf>
+size_t copyToDmaBuffers(const Descriptor* descriptor, const Pbuf* const pbufChain)
+{
+	auto buffer = reinterpret_cast<uint8_t*>(descriptor->Buffer1Addr);
+	size_t frameLength {};
+	size_t bufferOffset {};
+
+	for (auto pbuf = pbufChain; pbuf != nullptr; pbuf = pbuf->next)
+	{
+		if ((descriptor->Status & OwnBit) != 0)	// buffer unavailable?
+			return {};
+
+		size_t bytesLeft {pbuf->len};
+		size_t payloadOffset {};
+
+		while (bytesLeft + bufferOffset > BufferSize)
+		{
+			const auto chunk = BufferSize - bufferOffset;
+			memcpy(buffer + bufferOffset, static_cast<const uint8_t*>(pbuf->payload) + payloadOffset, chunk);
+
+			// advance to next descriptor
+			descriptor = reinterpret_cast<const Descriptor*>(descriptor->Buffer2NextDescAddr);
+
+			if ((descriptor->Status & OwnBit) != 0)	// buffer unavailable?
+				return {};
+
+			buffer = reinterpret_cast<uint8_t*>(descriptor->Buffer1Addr);
+			bufferOffset = {};
+			bytesLeft -= chunk;
+			payloadOffset += chunk;
+			frameLength += chunk;
+		}
+
+		memcpy(buffer + bufferOffset, static_cast<const uint8_t*>(pbuf->payload) + payloadOffset, bytesLeft);
+		bufferOffset += bytesLeft;
+		frameLength += bytesLeft;
+	}
+
+	return frameLength;
+}
+
+#endif	// DMAFRAMECOPY_HPP_
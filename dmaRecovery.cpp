@@ -0,0 +1,127 @@
+/**
+ * \file
+ * \brief Definitions related to recovery of Ethernet DMA
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "dmaRecovery.hpp"
+
+#include "cycleCounter.hpp"
+
+#include "distortos/assert.h"
+
+#include "lwip/tcpip.h"
+
+#include <algorithm>
+
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// statistics of recoveries of Ethernet DMA
+struct DmaRecoveryStatistics
+{
+	/// numbers of recoveries caused by each fault
+	uint32_t recoveries[static_cast<size_t>(DmaFault::count)];
+
+	/// duration of the last recovery, cycles of cycle counter
+	uint32_t last;
+
+	/// duration of the longest recovery, cycles of cycle counter
+	uint32_t max;
+
+	/// number of failed recoveries
+	uint32_t failed;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// statistics of recoveries of Ethernet DMA
+DmaRecoveryStatistics dmaRecoveryStatistics;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Converts cycles of cycle counter to microseconds.
+ *
+ * \param [in] cycles is the number of cycles of cycle counter
+ *
+ * \return \a cycles converted to microseconds
+ */
+
+unsigned long cyclesToMicroseconds(const uint32_t cycles)
+{
+	return static_cast<uint64_t>(cycles) * 1000000 / getCycleCounterFrequency();
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| DmaRecoveryStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int DmaRecoveryStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize,
+		char* const payload, const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	LOCK_TCPIP_CORE();
+	const auto statistics = dmaRecoveryStatistics;
+	UNLOCK_TCPIP_CORE();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "dma");
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto& recoveries = statistics.recoveries;
+	const auto fatalBusError = recoveries[static_cast<size_t>(DmaFault::fatalBusError)];
+	const auto rxStall = recoveries[static_cast<size_t>(DmaFault::rxStall)];
+	const auto txStall = recoveries[static_cast<size_t>(DmaFault::txStall)];
+	const auto ret = sniprintf(payload, payloadSize,
+			"recoveries=%lu fatalBusError=%lu rxStall=%lu txStall=%lu last=%lu max=%lu failed=%lu",
+			static_cast<unsigned long>(fatalBusError + rxStall + txStall), static_cast<unsigned long>(fatalBusError),
+			static_cast<unsigned long>(rxStall), static_cast<unsigned long>(txStall),
+			cyclesToMicroseconds(statistics.last), cyclesToMicroseconds(statistics.max),
+			static_cast<unsigned long>(statistics.failed));
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t DmaRecoveryStatisticsSource::getCount() const
+{
+	return 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void recordDmaRecovery(const DmaFault fault, const uint32_t duration)
+{
+	++dmaRecoveryStatistics.recoveries[static_cast<size_t>(fault)];
+	dmaRecoveryStatistics.last = duration;
+	dmaRecoveryStatistics.max = std::max(dmaRecoveryStatistics.max, duration);
+}
+
+void recordDmaRecoveryFailure()
+{
+	++dmaRecoveryStatistics.failed;
+}
@@ -0,0 +1,83 @@
+/**
+ * \file
+ * \brief Declarations related to recovery of Ethernet DMA
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef DMARECOVERY_HPP_
+#define DMARECOVERY_HPP_
+
+#include "DmaWatchdog.hpp"
+#include "StatisticsSource.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Source of statistics of recoveries of Ethernet DMA.
+ *
+ * Statistics are published in "stats/dma" topic.
+ */
+
+class DmaRecoveryStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats statistics of recoveries of Ethernet DMA.
+	 *
+	 * Payload has following format: "recoveries=<recoveries> fatalBusError=<fatalBusError> rxStall=<rxStall>
+	 * txStall=<txStall> last=<last> max=<max> failed=<failed>", where "recoveries" is the number of all recoveries,
+	 * "fatalBusError", "rxStall" and "txStall" are the numbers of recoveries caused by each fault, "last" is the
+	 * duration of the last recovery and "max" is the duration of the longest one, both in microseconds, and "failed" is
+	 * the number of recoveries which failed because software reset of MAC and DMA didn't complete.
+	 *
+	 * \param [in] index is the index of entry, must be 0
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of entries - 1
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Records recovery of Ethernet DMA.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] fault is the fault which caused recovery
+ * \param [in] duration is the duration of recovery, cycles of cycle counter
+ */
+
+void recordDmaRecovery(DmaFault fault, uint32_t duration);
+
+/**
+ * \brief Records failed recovery of Ethernet DMA.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ */
+
+void recordDmaRecoveryFailure();
+
+#endif	// DMARECOVERY_HPP_
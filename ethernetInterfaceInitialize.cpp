@@ -11,6 +11,17 @@
 
 #include "ethernetInterfaceInitialize.hpp"
 
+#include "cpuUsage.hpp"
+#include "cycleCounter.hpp"
+#include "dmaFrameCopy.hpp"
+#include "dmaRecovery.hpp"
+#include "packetCapture.hpp"
+#include "ptpClock.hpp"
+#include "publishTrace.hpp"
+#include "SpscRingBuffer.hpp"
+#include "txPriority.hpp"
+#include "udpEcho.hpp"
+
 #include "stm32f7xx_hal.h"
 
 #include "distortos/chip/PinInitializer.hpp"
@@ -18,12 +29,20 @@
 
 #include "distortos/BIND_LOW_LEVEL_INITIALIZER.h"
 #include "distortos/DynamicThread.hpp"
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/Mutex.hpp"
+#include "distortos/StaticThread.hpp"
+#include "distortos/TickClock.hpp"
 
 #include "estd/ScopeGuard.hpp"
 
+#include "lwip/tcpip.h"
+
 #include "netif/etharp.h"
 
-#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
 
 namespace
 {
@@ -47,12 +66,112 @@ uint8_t rxBuffers[ETH_RXBUFNB][ETH_RX_BUF_SIZE] __attribute__ ((aligned(4)));
 /// Ethernet transmit buffers
 uint8_t txBuffers[ETH_TXBUFNB][ETH_TX_BUF_SIZE] __attribute__ ((aligned(4)));
 
-/// semaphore for communication between "Ethernet RX transfer completed" interrupt callback and Ethernet input thread
+/// period of polling PHY while the link is down
+constexpr std::chrono::milliseconds phyPollPeriodLinkDown {50};
+
+/// period of polling PHY while the link is up
+constexpr std::chrono::seconds phyPollPeriodLinkUp {1};
+
+/// period of checking health of Ethernet DMA
+constexpr std::chrono::milliseconds dmaCheckPeriod {100};
+
+#if SPSC_INPUT == 1
+
+/// delay before retrying scheduling of processing of received frames when mailbox of tcpip thread was full
+constexpr std::chrono::milliseconds receivedFramesRetryDelay {1};
+
+#endif	// SPSC_INPUT == 1
+
+/// max duration of software reset of MAC and DMA, it takes a few cycles of MAC clocks if PHY provides them
+constexpr std::chrono::milliseconds ethernetResetTimeout {2};
+
+/// registers of MAC and DMA which are preserved across software reset, in the order of restoring
+__IO uint32_t ETH_TypeDef::* const preservedRegisters[]
+{
+		&ETH_TypeDef::MACMIIAR,
+		&ETH_TypeDef::MACFFR,
+		&ETH_TypeDef::MACHTHR,
+		&ETH_TypeDef::MACHTLR,
+		&ETH_TypeDef::MACFCR,
+		&ETH_TypeDef::MACVLANTR,
+		&ETH_TypeDef::MACIMR,
+		&ETH_TypeDef::MACA0HR,
+		&ETH_TypeDef::MACA0LR,
+		&ETH_TypeDef::MACCR,
+		&ETH_TypeDef::DMABMR,
+		&ETH_TypeDef::DMAOMR,
+		&ETH_TypeDef::DMAIER,
+};
+
+/// semaphore for communication between interrupt callbacks of Ethernet DMA and Ethernet input thread
 distortos::Semaphore ethernetInputSemaphore {1};
 
 /// handle of Ethernet interface
 ETH_HandleTypeDef ethernetHandle;
 
+#if SPSC_INPUT == 1
+
+/// mutex which serializes access to ethernetHandle by lowLevelInput() and transmitFrame(), which with SPSC_INPUT are
+/// executed concurrently by Ethernet input thread (without lwIP core lock) and tcpip thread
+distortos::Mutex ethernetHandleMutex {distortos::Mutex::Protocol::priorityInheritance};
+
+#endif	// SPSC_INPUT == 1
+
+/// watchdog of Ethernet DMA, ring is stalled if it looks stalled in 2 consecutive checks
+DmaWatchdog<2> dmaWatchdog;
+
+/// true if fatal bus error was reported by "abnormal interrupt" and DMA must be recovered, false otherwise
+std::atomic<bool> fatalBusError;
+
+/// values of preservedRegisters saved before software reset, kept until a reset completes
+uint32_t preservedValues[std::size(preservedRegisters)];
+
+/// true if software reset of MAC and DMA didn't complete, so preservedValues must be restored after the next one
+bool ethernetResetPending;
+
+#if PTP_TIMESTAMPS == 1
+
+/// time of PTP clock saved before software reset, kept until a reset completes
+uint64_t preservedPtpTime;
+
+#endif	// PTP_TIMESTAMPS == 1
+
+/// number of frames passed to Ethernet DMA, may wrap around
+uint32_t transmittedFrames;
+
+#if SPSC_INPUT == 1
+
+/// received frames passed from Ethernet input thread to tcpip thread, capacity matches default PBUF_POOL_SIZE
+SpscRingBuffer<pbuf*, 16> receivedFrames;
+
+/// true if processing of receivedFrames is scheduled in tcpip thread, false otherwise
+std::atomic<bool> receivedFramesProcessingScheduled;
+
+/// preallocated message used to schedule processing of receivedFrames in tcpip thread
+tcpip_callback_msg* receivedFramesProcessingMessage;
+
+#endif	// SPSC_INPUT == 1
+
+#if TX_PRIORITY == 1
+
+/// true if "Ethernet TX transfer completed" interrupt occurred since queued frames were last transmitted
+std::atomic<bool> txCompleted;
+
+#endif	// TX_PRIORITY == 1
+
+#if PTP_TIMESTAMPS == 1
+
+/// bit in Status of enhanced receive descriptor which is set when the timestamp of the frame is valid
+constexpr uint32_t rxTimestampValid {1 << 7};
+
+/// descriptor of the last frame which requested capture of transmit timestamp, nullptr if there's no such frame
+ETH_DMADescTypeDef* timestampedTxDescriptor;
+
+/// transmit timestamp of the last frame which requested it, 0 if it is not available
+uint64_t transmitTimestamp;
+
+#endif	// PTP_TIMESTAMPS == 1
+
 /// pin initializers for ETH
 const distortos::chip::PinInitializer ethPinInitializers[]
 {
@@ -190,10 +309,55 @@ void ethLowLevelInitializer()
 	NVIC_EnableIRQ(ETH_IRQn);
 
 	RCC->AHB1ENR |= RCC_AHB1ENR_ETHMACRXEN | RCC_AHB1ENR_ETHMACTXEN | RCC_AHB1ENR_ETHMACEN;
+#if PTP_TIMESTAMPS == 1
+	RCC->AHB1ENR |= RCC_AHB1ENR_ETHMACPTPEN;
+#endif	// PTP_TIMESTAMPS == 1
 }
 
 BIND_LOW_LEVEL_INITIALIZER(60, ethLowLevelInitializer);
 
+#if SPSC_INPUT == 1
+
+/**
+ * \brief Locks ethernetHandleMutex.
+ *
+ * \return scope guard which unlocks ethernetHandleMutex
+ */
+
+auto lockEthernetHandle()
+{
+	{
+		const auto ret = ethernetHandleMutex.lock();
+		assert(ret == 0);
+	}
+
+	return estd::makeScopeGuard(
+			[]()
+			{
+				const auto ret = ethernetHandleMutex.unlock();
+				assert(ret == 0);
+			});
+}
+
+#else	// SPSC_INPUT != 1
+
+/**
+ * \brief Does nothing - without SPSC_INPUT all accesses to ethernetHandle are serialized by lwIP core lock.
+ *
+ * \return scope guard which does nothing
+ */
+
+auto lockEthernetHandle()
+{
+	return estd::makeScopeGuard(
+			[]()
+			{
+
+			});
+}
+
+#endif	// SPSC_INPUT != 1
+
 /**
  * \brief Low-lever Ethernet input function
  *
@@ -204,43 +368,28 @@ BIND_LOW_LEVEL_INITIALIZER(60, ethLowLevelInitializer);
 
 pbuf* lowLevelInput()
 {
+	const auto unlockScopeGuard = lockEthernetHandle();
+
 	if (HAL_ETH_GetReceivedFrame_IT(&ethernetHandle) != HAL_OK)
 		return nullptr;
 
 	const auto length = ethernetHandle.RxFrameInfos.length;
+#if PACKET_CAPTURE == 1
+	capturePacket(reinterpret_cast<const uint8_t*>(ethernetHandle.RxFrameInfos.buffer), length,
+			PacketDirection::receive);
+#endif	// PACKET_CAPTURE == 1
 	pbuf* pbufChain {};
 	if (length > 0)
 		pbufChain = pbuf_alloc(PBUF_RAW, length, PBUF_POOL);
 
-	{
-		auto buffer = reinterpret_cast<uint8_t*>(ethernetHandle.RxFrameInfos.buffer);
-		size_t bufferOffset {};
-		auto dmaRxDescriptor = ethernetHandle.RxFrameInfos.FSRxDesc;
-
-		for (auto pbuf = pbufChain; pbuf != nullptr; pbuf = pbuf->next)
-		{
-			size_t bytesLeft {pbuf->len};
-			size_t payloadOffset {};
-
-			while (bytesLeft + bufferOffset > ETH_RX_BUF_SIZE)
-			{
-				const auto chunk = ETH_RX_BUF_SIZE - bufferOffset;
-				memcpy(static_cast<uint8_t*>(pbuf->payload) + payloadOffset,
-						static_cast<const uint8_t*>(buffer) + bufferOffset, chunk);
-
-				// advance to next descriptor
-				dmaRxDescriptor = reinterpret_cast<ETH_DMADescTypeDef*>(dmaRxDescriptor->Buffer2NextDescAddr);
-				buffer = reinterpret_cast<uint8_t*>(dmaRxDescriptor->Buffer1Addr);
-				bufferOffset = {};
-				bytesLeft -= chunk;
-				payloadOffset += chunk;
-			}
-
-			memcpy(static_cast<uint8_t*>(pbuf->payload) + payloadOffset,
-					static_cast<const uint8_t*>(buffer) + bufferOffset, bytesLeft);
-			bufferOffset += bytesLeft;
-		}
-	}
+	copyFromDmaBuffers<ETH_RX_BUF_SIZE>(ethernetHandle.RxFrameInfos.FSRxDesc, pbufChain);
+#if PTP_TIMESTAMPS == 1
+	// timestamp is written only to the last descriptor of the frame
+	const auto lastDmaRxDescriptor = ethernetHandle.RxFrameInfos.LSRxDesc;
+	if (pbufChain != nullptr)
+		pbufChain->timestamp = (lastDmaRxDescriptor->Status & rxTimestampValid) != 0 ?
+				makePtpTime(lastDmaRxDescriptor->TimeStampHigh, lastDmaRxDescriptor->TimeStampLow) : 0;
+#endif	// PTP_TIMESTAMPS == 1
 
 	// release descriptors to DMA, go back to first descriptor
 	auto dmaRxDescriptor = ethernetHandle.RxFrameInfos.FSRxDesc;
@@ -263,24 +412,39 @@ pbuf* lowLevelInput()
 	return pbufChain;
 }
 
+#if PTP_TIMESTAMPS == 1
+
 /**
- * \brief Low-lever Ethernet output function
+ * \brief Reads transmit timestamp of the last frame which requested it, if the frame was already transmitted.
  *
- * This function should do the actual transmission of the packet. The packet is contained in the pbuf that is passed to
- * the function. This pbuf might be chained.
- *
- * \note Returning ERR_MEM here if a DMA queue of your MAC is full can lead to strange results. You might consider
- * waiting for space in the DMA queue to become available since the stack doesn't retry to send a packet dropped because
- * of memory failure (except for the TCP timers).
+ * Must be called before the descriptor of that frame is reused.
+ */
+
+void readTransmitTimestamp()
+{
+	const auto dmaTxDescriptor = timestampedTxDescriptor;
+	if (dmaTxDescriptor == nullptr || (dmaTxDescriptor->Status & ETH_DMATXDESC_OWN) != 0)
+		return;
+
+	timestampedTxDescriptor = {};
+	if ((dmaTxDescriptor->Status & ETH_DMATXDESC_TTSS) != 0)
+		transmitTimestamp = makePtpTime(dmaTxDescriptor->TimeStampHigh, dmaTxDescriptor->TimeStampLow);
+}
+
+#endif	// PTP_TIMESTAMPS == 1
+
+/**
+ * \brief Passes frame to Ethernet DMA.
  *
- * \param [in] netif is the lwIP network interface structure for this Ethernet interface
- * \param [in] pbuf is the MAC packet to send (e.g. IP packet including MAC addresses and type)
+ * \param [in] frame is a reference to transmitted frame (including MAC header), might be chained
  *
- * \return ERR_OK if the packet could be sent, an err_t value if the packet couldn't be sent
+ * \return ERR_OK if frame was passed to Ethernet DMA, ERR_MEM if there was no free DMA descriptor, ERR_IF if
+ * HAL_ETH_TransmitFrame() failed
  */
 
-err_t lowLevelOutput(netif*, pbuf* pbuf)
+err_t transmitFrame(const pbuf& frame)
 {
+	const auto unlockScopeGuard = lockEthernetHandle();
 	const auto scopeGuard = estd::makeScopeGuard(
 			[]()
 			{
@@ -292,49 +456,268 @@ err_t lowLevelOutput(netif*, pbuf* pbuf)
 				}
 			});
 
-	auto buffer = reinterpret_cast<uint8_t*>(ethernetHandle.TxDesc->Buffer1Addr);
-	auto dmaTxDescriptor = ethernetHandle.TxDesc;
-	size_t frameLength {};
-	size_t bufferOffset {};
+#if PTP_TIMESTAMPS == 1
+	readTransmitTimestamp();
+	const auto dmaTxDescriptor = ethernetHandle.TxDesc;
+#endif	// PTP_TIMESTAMPS == 1
+	const auto frameLength = copyToDmaBuffers<ETH_TX_BUF_SIZE, ETH_DMATXDESC_OWN>(ethernetHandle.TxDesc, &frame);
+	if (frameLength == 0)
+		return ERR_MEM;
 
-	for (; pbuf != nullptr; pbuf = pbuf->next)
+#if PTP_TIMESTAMPS == 1
+	if (frame.timestamp == ptpTransmitTimestampRequest)
 	{
-		if ((dmaTxDescriptor->Status & ETH_DMATXDESC_OWN) != 0)	// buffer unavailable?
-			return ERR_USE;
+		dmaTxDescriptor->Status |= ETH_DMATXDESC_TTSE;
+		timestampedTxDescriptor = dmaTxDescriptor;
+		transmitTimestamp = {};
+	}
+	else
+		dmaTxDescriptor->Status &= ~ETH_DMATXDESC_TTSE;
+#endif	// PTP_TIMESTAMPS == 1
 
-		size_t bytesLeft {pbuf->len};
-		size_t payloadOffset {};
+#if PACKET_CAPTURE == 1
+	capturePacket(reinterpret_cast<const uint8_t*>(ethernetHandle.TxDesc->Buffer1Addr), frameLength,
+			PacketDirection::transmit);
+#endif	// PACKET_CAPTURE == 1
+	if (HAL_ETH_TransmitFrame(&ethernetHandle, frameLength) != HAL_OK)
+		return ERR_IF;
 
-		while (bytesLeft + bufferOffset > ETH_TX_BUF_SIZE)
-		{
-			const auto chunk = ETH_TX_BUF_SIZE - bufferOffset;
-			memcpy(static_cast<uint8_t*>(buffer) + bufferOffset,
-					static_cast<const uint8_t*>(pbuf->payload) + payloadOffset, chunk);
+	++transmittedFrames;
+	recordPublishTransmit(frame);
+
+	return ERR_OK;
+}
+
+#if TX_PRIORITY == 1
+
+/**
+ * \brief Enables "Ethernet TX transfer completed" interrupt, which wakes Ethernet input thread to transmit queued
+ * frames.
+ *
+ * All transmit descriptors have "interrupt on completion" bit set, so TS flag is set after each frame. The flag is
+ * cleared only when the interrupt is handled, so if a descriptor was released before the interrupt was enabled, the
+ * interrupt is triggered immediately.
+ */
+
+void enableTxCompletedInterrupt()
+{
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+	__HAL_ETH_DMA_ENABLE_IT(&ethernetHandle, ETH_DMA_IT_T);
+}
+
+#endif	// TX_PRIORITY == 1
+
+/**
+ * \brief Low-lever Ethernet output function
+ *
+ * This function should do the actual transmission of the packet. The packet is contained in the pbuf that is passed to
+ * the function. This pbuf might be chained.
+ *
+ * \note Returning ERR_MEM here if a DMA queue of your MAC is full can lead to strange results. You might consider
+ * waiting for space in the DMA queue to become available since the stack doesn't retry to send a packet dropped because
+ * of memory failure (except for the TCP timers).
+ *
+ * With TX_PRIORITY, frames which don't fit in DMA descriptors are queued by class instead of being dropped, see
+ * transmitWithPriority().
+ *
+ * \param [in] netif is the lwIP network interface structure for this Ethernet interface
+ * \param [in] pbuf is the MAC packet to send (e.g. IP packet including MAC addresses and type)
+ *
+ * \return ERR_OK if the packet could be sent, an err_t value if the packet couldn't be sent
+ */
+
+err_t lowLevelOutput(netif*, pbuf* const pbuf)
+{
+#if TX_PRIORITY == 1
+	const auto ret = transmitWithPriority(*pbuf, transmitFrame);
+	if (ret != ERR_INPROGRESS)
+		return ret;
+
+	enableTxCompletedInterrupt();
+	return ERR_OK;
+#else	// TX_PRIORITY != 1
+	const auto ret = transmitFrame(*pbuf);
+	return ret != ERR_MEM ? ret : ERR_USE;
+#endif	// TX_PRIORITY != 1
+}
+
+/**
+ * \brief Initializes lists of DMA descriptors and gives all receive descriptors to DMA.
+ */
+
+void initializeDmaDescriptorLists()
+{
+	/// \todo error handling?
+	HAL_ETH_DMARxDescListInit(&ethernetHandle, dmaRxDscriptors, &rxBuffers[0][0], ETH_RXBUFNB);
+	/// \todo error handling?
+	HAL_ETH_DMATxDescListInit(&ethernetHandle, dmaTxDescriptors, &txBuffers[0][0], ETH_TXBUFNB);
+#if TX_PRIORITY == 1
+	for (auto& dmaTxDescriptor : dmaTxDescriptors)
+		dmaTxDescriptor.Status |= ETH_DMATXDESC_IC;
+#endif	// TX_PRIORITY == 1
+}
 
-			// advance to next descriptor
-			dmaTxDescriptor = reinterpret_cast<ETH_DMADescTypeDef*>(dmaTxDescriptor->Buffer2NextDescAddr);
+/**
+ * \brief Resets MAC and DMA with software reset, preserving their configuration.
+ *
+ * After fatal bus error DMA doesn't access the bus until software reset. The reset also clears all registers of MAC and
+ * DMA, so their configuration (set by HAL_ETH_Init(), HAL_ETH_ConfigMAC() and this driver) is saved before the reset
+ * and restored after it. MAC and DMA must be stopped.
+ *
+ * Reset completes after a few cycles of MAC clocks, which are provided by PHY, so without them it never completes. Wait
+ * is bounded by ethernetResetTimeout and registers saved before the reset which didn't complete are restored after the
+ * next one.
+ *
+ * \return true if reset completed, false otherwise
+ */
 
-			if ((dmaTxDescriptor->Status & ETH_DMATXDESC_OWN) != 0)	// buffer unavailable?
-				return ERR_USE;
+bool resetEthernet()
+{
+	const auto instance = ethernetHandle.Instance;
+	if (ethernetResetPending == false)
+	{
+#if PTP_TIMESTAMPS == 1
+		// PTP clock is also reset, its time is restored with the error of the duration of the reset
+		preservedPtpTime = getPtpTime();
+#endif	// PTP_TIMESTAMPS == 1
+		std::transform(std::begin(preservedRegisters), std::end(preservedRegisters), preservedValues,
+				[instance](__IO uint32_t ETH_TypeDef::* const preservedRegister) -> uint32_t
+				{
+					return instance->*preservedRegister;
+				});
+	}
 
-			buffer = reinterpret_cast<uint8_t*>(dmaTxDescriptor->Buffer1Addr);
-			bufferOffset = {};
-			bytesLeft -= chunk;
-			payloadOffset += chunk;
-			frameLength += chunk;
+	instance->DMABMR |= ETH_DMABMR_SR;
+	const auto deadline = distortos::TickClock::now() + ethernetResetTimeout;
+	while ((instance->DMABMR & ETH_DMABMR_SR) != 0)
+		if (distortos::TickClock::now() >= deadline)
+		{
+			ethernetResetPending = true;
+			return false;
 		}
 
-		memcpy(static_cast<uint8_t*>(buffer) + bufferOffset, static_cast<const uint8_t*>(pbuf->payload) + payloadOffset,
-				bytesLeft);
-		bufferOffset += bytesLeft;
-		frameLength += bytesLeft;
+	ethernetResetPending = false;
+	for (size_t i {}; i < std::size(preservedRegisters); ++i)
+		instance->*preservedRegisters[i] = preservedValues[i];
+
+#if PTP_TIMESTAMPS == 1
+	initializePtpClock(preservedPtpTime);
+#endif	// PTP_TIMESTAMPS == 1
+	return true;
+}
+
+/**
+ * \brief Recovers Ethernet DMA.
+ *
+ * MAC and DMA are stopped, lists of descriptors are initialized from scratch and both are started again, so netif and
+ * all connections stay up - only frames which were in the rings are lost. After fatal bus error MAC and DMA are also
+ * reset with resetEthernet(). The whole recovery takes a few milliseconds, most of it in HAL_ETH_Stop() and
+ * HAL_ETH_Start(), which wait 1 ms after writes to some registers. If the reset doesn't complete, MAC and DMA are left
+ * stopped and the failure is reported to dmaWatchdog, which requests recovery again in its next check.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] fault is the fault which caused recovery
+ */
+
+void recoverDma(const DmaFault fault)
+{
+	const auto start = getCycleCount();
+
+	HAL_ETH_Stop(&ethernetHandle);
+	if ((fault == DmaFault::fatalBusError || ethernetResetPending == true) && resetEthernet() == false)
+	{
+		recordDmaRecoveryFailure();
+		dmaWatchdog.reportFailedRecovery(fault);
+		return;
 	}
 
-	HAL_ETH_TransmitFrame(&ethernetHandle, frameLength);
+	ethernetHandle.RxFrameInfos = {};
+	initializeDmaDescriptorLists();
+#if PTP_TIMESTAMPS == 1
+	timestampedTxDescriptor = {};
+#endif	// PTP_TIMESTAMPS == 1
+	HAL_ETH_Start(&ethernetHandle);
 
-	return ERR_OK;
+	recordDmaRecovery(fault, getCycleCount() - start);
+	dmaWatchdog.reset();
+
+#if TX_PRIORITY == 1
+	if (transmitQueuedFrames(transmitFrame) == false)
+		enableTxCompletedInterrupt();
+#endif	// TX_PRIORITY == 1
+}
+
+/**
+ * \brief Checks health of descriptor rings of Ethernet DMA and recovers it if any ring is stalled.
+ */
+
+void checkDma()
+{
+	LOCK_TCPIP_CORE();
+	const auto unlockScopeGuard = estd::makeScopeGuard(
+			[]()
+			{
+				UNLOCK_TCPIP_CORE();
+			});
+
+	const auto rxStuck = isRxRingStuck<ETH_DMARXDESC_OWN>(dmaRxDscriptors, ethernetHandle.RxDesc);
+	const auto txBusy = isTxRingBusy<ETH_DMATXDESC_OWN>(dmaTxDescriptors);
+	DmaFault fault;
+	if (dmaWatchdog.check(rxStuck, txBusy, transmittedFrames, fault) == true)
+		recoverDma(fault);
+}
+
+#if SPSC_INPUT == 1
+
+/**
+ * \brief Processes received frames.
+ *
+ * Executed in tcpip thread, passes all frames from receivedFrames to ethernet_input().
+ *
+ * \param [in] argument is a pointer to the lwIP network interface structure for this Ethernet interface
+ */
+
+void processReceivedFrames(void* const argument)
+{
+	const auto netif = static_cast<struct netif*>(argument);
+
+	// must be cleared before popping the frames, so that a frame pushed after the last pop() is not missed
+	receivedFramesProcessingScheduled = false;
+
+	pbuf* pbuf;
+	while (receivedFrames.pop(pbuf) == true)
+		if (ethernet_input(pbuf, netif) != ERR_OK)
+			pbuf_free(pbuf);
+}
+
+/**
+ * \brief Schedules processing of received frames in tcpip thread.
+ *
+ * Message is posted to the mailbox of tcpip thread only if receivedFrames is not empty and processing is not already
+ * scheduled, so there is at most one message per burst of frames.
+ *
+ * \return true if processing is scheduled or not needed, false if mailbox of tcpip thread is full and scheduling must
+ * be retried
+ */
+
+bool scheduleReceivedFramesProcessing()
+{
+	if (receivedFrames.empty() == true)
+		return true;
+
+	if (receivedFramesProcessingScheduled.exchange(true) == true)	// already scheduled?
+		return true;
+
+	if (tcpip_callbackmsg_trycallback(receivedFramesProcessingMessage) == ERR_OK)
+		return true;
+
+	receivedFramesProcessingScheduled = false;
+	return false;
 }
 
+#endif	// SPSC_INPUT == 1
+
 /**
  * \brief Ethernet input thread
  *
@@ -347,9 +730,99 @@ err_t lowLevelOutput(netif*, pbuf* pbuf)
 
 void ethernetInterfaceInput(netif& netif)
 {
+	registerCpuUsageThread(CpuUsageThread::ethernetInput);
+
+	auto nextPhyPoll = distortos::TickClock::now();
+	auto nextDmaCheck = nextPhyPoll;
+#if SPSC_INPUT == 1
+	auto nextReceivedFramesRetry = distortos::TickClock::time_point::max();
+#endif	// SPSC_INPUT == 1
 	while (1)
 	{
-		const auto tryWaitForRet = ethernetInputSemaphore.tryWaitFor(std::chrono::seconds{1});
+#if SPSC_INPUT == 1
+		const auto deadline = std::min({nextPhyPoll, nextDmaCheck, nextReceivedFramesRetry});
+#else	// SPSC_INPUT != 1
+		const auto deadline = std::min(nextPhyPoll, nextDmaCheck);
+#endif	// SPSC_INPUT != 1
+		const auto tryWaitUntilRet = ethernetInputSemaphore.tryWaitUntil(deadline);
+
+		if (tryWaitUntilRet == 0)
+		{
+#if UDP_ECHO == 1
+			recordEthernetInputWakeup();
+#endif	// UDP_ECHO == 1
+
+#if SPSC_INPUT == 1
+			pbuf* pbuf;
+			while (pbuf = lowLevelInput(), pbuf != nullptr)
+			{
+				if (receivedFrames.full() == true)	// tcpip thread is too slow, drop the frame
+				{
+					pbuf_free(pbuf);
+					continue;
+				}
+
+#if UDP_ECHO == 1
+				// must be recorded before pushing, as the frame may be freed by tcpip thread right after that
+				recordEthernetFrame(*pbuf);
+#endif	// UDP_ECHO == 1
+				const auto ret = receivedFrames.push(pbuf);
+				assert(ret == true);	// this thread is the only producer, so there's still space
+			}
+#else	// SPSC_INPUT != 1
+			LOCK_TCPIP_CORE();
+			const auto unlockScopeGuard = estd::makeScopeGuard(
+					[]()
+					{
+						UNLOCK_TCPIP_CORE();
+					});
+
+			pbuf* pbuf;
+			while (pbuf = lowLevelInput(), pbuf != nullptr)
+			{
+#if UDP_ECHO == 1
+				recordEthernetFrame(*pbuf);
+#endif	// UDP_ECHO == 1
+				if (netif.input(pbuf, &netif) != ERR_OK)
+					pbuf_free(pbuf);
+			}
+#endif	// SPSC_INPUT != 1
+		}
+		else
+			assert(tryWaitUntilRet == ETIMEDOUT);
+
+#if SPSC_INPUT == 1
+		// done in every iteration, so if mailbox of tcpip thread was full, frames wait only for a short retry delay
+		nextReceivedFramesRetry = scheduleReceivedFramesProcessing() == true ? distortos::TickClock::time_point::max() :
+				distortos::TickClock::now() + receivedFramesRetryDelay;
+#endif	// SPSC_INPUT == 1
+
+#if TX_PRIORITY == 1
+		if (txCompleted.exchange(false) == true)
+		{
+			LOCK_TCPIP_CORE();
+			if (transmitQueuedFrames(transmitFrame) == false)
+				enableTxCompletedInterrupt();
+			UNLOCK_TCPIP_CORE();
+		}
+#endif	// TX_PRIORITY == 1
+
+		if (fatalBusError.exchange(false) == true)
+		{
+			LOCK_TCPIP_CORE();
+			recoverDma(DmaFault::fatalBusError);
+			UNLOCK_TCPIP_CORE();
+		}
+
+		if (distortos::TickClock::now() >= nextDmaCheck)
+		{
+			checkDma();
+			nextDmaCheck = distortos::TickClock::now() + dmaCheckPeriod;
+		}
+
+		// PHY is polled on a deadline, so that continuous reception doesn't starve it
+		if (distortos::TickClock::now() < nextPhyPoll)
+			continue;
 
 		LOCK_TCPIP_CORE();
 		const auto unlockScopeGuard = estd::makeScopeGuard(
@@ -358,49 +831,42 @@ void ethernetInterfaceInput(netif& netif)
 					UNLOCK_TCPIP_CORE();
 				});
 
-		if (tryWaitForRet == 0)
+		uint32_t basicStatus;
 		{
-			pbuf* pbuf;
-			while (pbuf = lowLevelInput(), pbuf != nullptr)
-				if (netif.input(pbuf, &netif) != ERR_OK)
-					pbuf_free(pbuf);
+			const auto ret = HAL_ETH_ReadPHYRegister(&ethernetHandle, PHY_BSR, &basicStatus);
+			assert(ret == HAL_OK);
 		}
-		else if (tryWaitForRet == ETIMEDOUT)
+		constexpr uint32_t linkMask {PHY_LINKED_STATUS | PHY_AUTONEGO_COMPLETE};
+		const auto linkStatus = (basicStatus & linkMask) == linkMask;
+		const auto previousLinkStatus = netif_is_link_up(&netif) != 0;
+		if (linkStatus != previousLinkStatus)
 		{
-			uint32_t basicStatus;
-			{
-				const auto ret = HAL_ETH_ReadPHYRegister(&ethernetHandle, PHY_BSR, &basicStatus);
-				assert(ret == HAL_OK);
-			}
-			constexpr uint32_t linkMask {PHY_LINKED_STATUS | PHY_AUTONEGO_COMPLETE};
-			const auto linkStatus = (basicStatus & linkMask) == linkMask;
-			const auto previousLinkStatus = netif_is_link_up(&netif) != 0;
-			if (linkStatus != previousLinkStatus)
+			if (linkStatus == true)
 			{
-				if (linkStatus == true)
+				uint32_t phySpecialControlStatus;
 				{
-					uint32_t phySpecialControlStatus;
-					{
-						const auto ret = HAL_ETH_ReadPHYRegister(&ethernetHandle, PHY_SR, &phySpecialControlStatus);
-						assert(ret == HAL_OK);
-					}
-
-					ethernetHandle.Init.Speed = (phySpecialControlStatus & PHY_SPEED_STATUS) == 0 ?
-							ETH_SPEED_100M : ETH_SPEED_10M;
-					ethernetHandle.Init.DuplexMode = (phySpecialControlStatus & PHY_DUPLEX_STATUS) != 0 ?
-							ETH_MODE_FULLDUPLEX : ETH_MODE_HALFDUPLEX;
+					const auto ret = HAL_ETH_ReadPHYRegister(&ethernetHandle, PHY_SR, &phySpecialControlStatus);
+					assert(ret == HAL_OK);
+				}
 
-					{
-						const auto ret = HAL_ETH_ConfigMAC(&ethernetHandle, nullptr);
-						assert(ret == HAL_OK);
-					}
+				ethernetHandle.Init.Speed = (phySpecialControlStatus & PHY_SPEED_STATUS) == 0 ?
+						ETH_SPEED_100M : ETH_SPEED_10M;
+				ethernetHandle.Init.DuplexMode = (phySpecialControlStatus & PHY_DUPLEX_STATUS) != 0 ?
+						ETH_MODE_FULLDUPLEX : ETH_MODE_HALFDUPLEX;
 
-					netif_set_link_up(&netif);
+				{
+					const auto ret = HAL_ETH_ConfigMAC(&ethernetHandle, nullptr);
+					assert(ret == HAL_OK);
 				}
-				else
-					netif_set_link_down(&netif);
+
+				netif_set_link_up(&netif);
 			}
+			else
+				netif_set_link_down(&netif);
 		}
+
+		// poll often while waiting for the link, so that its appearance is noticed quickly during boot
+		nextPhyPoll = distortos::TickClock::now() + (linkStatus == true ? phyPollPeriodLinkUp : phyPollPeriodLinkDown);
 	}
 }
 
@@ -442,6 +908,10 @@ err_t ethernetInterfaceInitialize(netif* const netif)
 
 	netif->mtu = 1500;	// set netif maximum transfer unit
 	netif->flags |= NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP;	// accept broadcast address and ARP traffic
+#if SOFTWARE_CHECKSUM != 1
+	// checksums are generated and checked by MAC, so lwIP doesn't have to do that for this interface
+	NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_DISABLE_ALL);
+#endif	// SOFTWARE_CHECKSUM != 1
 
 	ethernetHandle.Instance = ETH;
 	ethernetHandle.Init.MACAddr = netif->hwaddr;
@@ -450,11 +920,23 @@ err_t ethernetInterfaceInitialize(netif* const netif)
 	ethernetHandle.Init.DuplexMode = ETH_MODE_FULLDUPLEX;
 	ethernetHandle.Init.MediaInterface = ETH_MEDIA_INTERFACE_RMII;
 	ethernetHandle.Init.RxMode = ETH_RXINTERRUPT_MODE;
+#if SOFTWARE_CHECKSUM == 1
+	ethernetHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_SOFTWARE;
+#else	// SOFTWARE_CHECKSUM != 1
 	ethernetHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_HARDWARE;
+#endif	// SOFTWARE_CHECKSUM != 1
 	ethernetHandle.Init.PhyAddress = 0;
 
 	HAL_ETH_Init(&ethernetHandle);	/// \todo error handling?
 
+#if PTP_TIMESTAMPS == 1
+	// timestamps are written to descriptors only in enhanced format
+	ethernetHandle.Instance->DMABMR |= ETH_DMABMR_EDE;
+	// PTP messages are sent to multicast addresses and lwIP's IGMP is disabled, so all multicast frames are passed
+	ethernetHandle.Instance->MACFFR |= ETH_MACFFR_PAM;
+	initializePtpClock({});
+#endif	// PTP_TIMESTAMPS == 1
+
 	{
 		constexpr uint16_t autoNegotiationAdvertisementRegister {4};
 		constexpr uint16_t advertise100BaseTxFullDuplex {1 << 8};
@@ -488,10 +970,14 @@ err_t ethernetInterfaceInitialize(netif* const netif)
 		}
 	}
 
-	/// \todo error handling?
-	HAL_ETH_DMARxDescListInit(&ethernetHandle, dmaRxDscriptors, &rxBuffers[0][0], ETH_RXBUFNB);
-	/// \todo error handling?
-	HAL_ETH_DMATxDescListInit(&ethernetHandle, dmaTxDescriptors, &txBuffers[0][0], ETH_TXBUFNB);
+	initializeDmaDescriptorLists();
+	// fatal bus error is reported by "abnormal interrupt", which is not enabled by HAL
+	__HAL_ETH_DMA_ENABLE_IT(&ethernetHandle, ETH_DMA_IT_AIS | ETH_DMA_IT_FBE);
+
+#if SPSC_INPUT == 1
+	receivedFramesProcessingMessage = tcpip_callbackmsg_new(processReceivedFrames, netif);
+	assert(receivedFramesProcessingMessage != nullptr);
+#endif	// SPSC_INPUT == 1
 
 #ifndef LWIP_DEBUG
 	constexpr size_t stackSize {1024};
@@ -499,8 +985,14 @@ err_t ethernetInterfaceInitialize(netif* const netif)
 	constexpr size_t stackSize {2048};
 #endif	// def LWIP_DEBUG
 
+#if STATIC_ALLOCATION == 1
+	// create and start the thread that handles Ethernet input, its stack is allocated statically
+	static auto ethernetInputThread = distortos::makeAndStartStaticThread<stackSize>(1, ethernetInterfaceInput,
+			std::ref(*netif));
+#else	// STATIC_ALLOCATION != 1
 	// create, start and detach the thread that handles Ethernet input
 	distortos::makeAndStartDynamicThread({stackSize, 1}, ethernetInterfaceInput, std::ref(*netif)).detach();
+#endif	// STATIC_ALLOCATION != 1
 
 	/// \todo error handling?
 	HAL_ETH_Start(&ethernetHandle);
@@ -508,6 +1000,18 @@ err_t ethernetInterfaceInitialize(netif* const netif)
 	return ERR_OK;
 }
 
+#if PTP_TIMESTAMPS == 1
+
+uint64_t getTransmitTimestamp()
+{
+	readTransmitTimestamp();
+	const auto timestamp = transmitTimestamp;
+	transmitTimestamp = {};
+	return timestamp;
+}
+
+#endif	// PTP_TIMESTAMPS == 1
+
 /**
  * \brief "Ethernet RX transfer completed" interrupt callback
  *
@@ -516,5 +1020,43 @@ err_t ethernetInterfaceInitialize(netif* const netif)
 
 void HAL_ETH_RxCpltCallback(ETH_HandleTypeDef*)
 {
+#if UDP_ECHO == 1
+	recordEthernetRxInterrupt();
+#endif	// UDP_ECHO == 1
+	ethernetInputSemaphore.post();
+}
+
+/**
+ * \brief "Ethernet DMA error" interrupt callback
+ *
+ * If the error is a fatal bus error, clears its flag and posts the semaphore to wake Ethernet input thread, which
+ * recovers DMA.
+ */
+
+void HAL_ETH_ErrorCallback(ETH_HandleTypeDef*)
+{
+	if ((ethernetHandle.Instance->DMASR & ETH_DMASR_FBES) == 0)
+		return;
+
+	ethernetHandle.Instance->DMASR = ETH_DMASR_FBES;
+	fatalBusError = true;
 	ethernetInputSemaphore.post();
 }
+
+#if TX_PRIORITY == 1
+
+/**
+ * \brief "Ethernet TX transfer completed" interrupt callback
+ *
+ * Disables the interrupt (it is enabled again only if some frames still wait for a free DMA descriptor) and posts the
+ * semaphore to wake Ethernet input thread.
+ */
+
+void HAL_ETH_TxCpltCallback(ETH_HandleTypeDef*)
+{
+	__HAL_ETH_DMA_DISABLE_IT(&ethernetHandle, ETH_DMA_IT_T);
+	txCompleted = true;
+	ethernetInputSemaphore.post();
+}
+
+#endif	// TX_PRIORITY == 1
@@ -14,6 +14,8 @@
 
 #include "lwip/err.h"
 
+#include <cstdint>
+
 struct netif;
 
 /*---------------------------------------------------------------------------------------------------------------------+
@@ -33,4 +35,20 @@ struct netif;
 
 err_t ethernetInterfaceInitialize(netif* netif);
 
+/**
+ * \brief Returns transmit timestamp of the last frame which requested it.
+ *
+ * Frame requests capture of its transmit timestamp when pbuf::timestamp of its first pbuf is equal to
+ * ptpTransmitTimestampRequest. Only the timestamp of the last such frame is kept and it can be read only once.
+ *
+ * \note Available only with PTP_TIMESTAMPS.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \return hardware timestamp of transmission of the last frame which requested it (time of PTP clock, nanoseconds), 0
+ * if the frame was not transmitted yet, its timestamp was not captured or was already read
+ */
+
+uint64_t getTransmitTimestamp();
+
 #endif	// ETHERNETINTERFACEINITIALIZE_HPP_
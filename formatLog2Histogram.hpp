@@ -0,0 +1,70 @@
+/**
+ * \file
+ * \brief formatLog2Histogram() header
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FORMATLOG2HISTOGRAM_HPP_
+#define FORMATLOG2HISTOGRAM_HPP_
+
+#include "Log2Histogram.hpp"
+
+#include <cstdio>
+
+/**
+ * \brief Formats histogram in compact form.
+ *
+ * Histogram is formatted as "count=<count> max=<max> mean=<mean> hist=<first>:<bucket>,<bucket>,...", where only
+ * buckets from the first non-empty one (with index <first>) to the last non-empty one are listed.
+ *
+ * \tparam BucketCount is the number of buckets of histogram
+ *
+ * \param [in] histogram is a reference to formatted histogram
+ * \param [out] buffer is a buffer for formatted histogram
+ * \param [in] size is the size of \a buffer, bytes
+ *
+ * \return length of formatted histogram (without terminating null character) on success, negative value if the
+ * histogram did not fit in \a buffer
+ */
+
+template<size_t BucketCount>
+int formatLog2Histogram(const Log2Histogram<BucketCount>& histogram, char* const buffer, const size_t size)
+{
+	const auto count = histogram.getCount();
+	size_t length {};
+
+	{
+		const auto ret = sniprintf(buffer, size, "count=%lu max=%lu mean=%lu hist=", static_cast<unsigned long>(count),
+				static_cast<unsigned long>(histogram.getMax()),
+				static_cast<unsigned long>(count != 0 ? histogram.getSum() / count : 0));
+		if (ret < 0 || static_cast<size_t>(ret) >= size)
+			return -1;
+		length += ret;
+	}
+
+	size_t first {};
+	while (first < histogram.getBucketCount() - 1 && histogram.getBucket(first) == 0)
+		++first;
+	auto last = histogram.getBucketCount() - 1;
+	while (last > first && histogram.getBucket(last) == 0)
+		--last;
+
+	for (auto index = first; index <= last; ++index)
+	{
+		const auto bucket = static_cast<unsigned long>(histogram.getBucket(index));
+		const auto ret = index == first ? sniprintf(buffer + length, size - length, "%zu:%lu", index, bucket) :
+				sniprintf(buffer + length, size - length, ",%lu", bucket);
+		if (ret < 0 || static_cast<size_t>(ret) >= size - length)
+			return -1;
+		length += ret;
+	}
+
+	return length;
+}
+
+#endif	// FORMATLOG2HISTOGRAM_HPP_
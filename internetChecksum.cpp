@@ -0,0 +1,144 @@
+/**
+ * \file
+ * \brief internetChecksum() and internetChecksumCopy() definitions
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "internetChecksum.h"
+
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Loads word from memory and optionally stores it at destination.
+ *
+ * \tparam T is the type of word
+ * \tparam Copy selects whether the word is also stored at \a destination
+ *
+ * \param [in] destination is a pointer to destination, not accessed if \a Copy is false
+ * \param [in] source is a pointer to source
+ *
+ * \return loaded word
+ */
+
+template<typename T, bool Copy>
+inline __attribute__ ((always_inline)) T transfer(uint8_t* const destination, const uint8_t* const source)
+{
+	T word;
+	memcpy(&word, source, sizeof(word));
+	if (Copy == true)
+		memcpy(destination, &word, sizeof(word));
+	return word;
+}
+
+/**
+ * \brief Computes one's complement sum of data and optionally copies it.
+ *
+ * The data is summed as 16-bit words in memory order, like in lwip_standard_chksum(). If data starts at odd address,
+ * its first byte is summed as the second byte of 16-bit word and the sum is swapped at the end. Then (at most) one
+ * 16-bit word is summed, so that the main loop reads 32-bit words from aligned addresses. 32-bit words are equivalent
+ * to pairs of 16-bit words, as 2^16 is congruent to 1 modulo 2^16 - 1, and carries out of the lower 32 bits collect in
+ * the upper half of 64-bit accumulator.
+ *
+ * \tparam Copy selects whether the data is also copied to \a destination
+ *
+ * \param [out] destination is a pointer to destination buffer, not accessed if \a Copy is false
+ * \param [in] source is a pointer to summed data
+ * \param [in] length is the length of \a source, bytes
+ *
+ * \return one's complement sum of \a source folded to 16 bits (not complemented), in network byte order
+ */
+
+template<bool Copy>
+uint16_t checksum(uint8_t* destination, const uint8_t* source, size_t length)
+{
+	uint64_t sum {};
+	const auto odd = (reinterpret_cast<uintptr_t>(source) & 1) != 0 && length != 0;
+	if (odd == true)
+	{
+		uint16_t word {};
+		reinterpret_cast<uint8_t*>(&word)[1] = transfer<uint8_t, Copy>(destination++, source++);
+		sum += word;
+		--length;
+	}
+	if ((reinterpret_cast<uintptr_t>(source) & 2) != 0 && length >= 2)
+	{
+		sum += transfer<uint16_t, Copy>(destination, source);
+		destination += 2;
+		source += 2;
+		length -= 2;
+	}
+
+	while (length >= 32)
+	{
+		sum += uint64_t{transfer<uint32_t, Copy>(destination, source)} +
+				transfer<uint32_t, Copy>(destination + 4, source + 4) +
+				transfer<uint32_t, Copy>(destination + 8, source + 8) +
+				transfer<uint32_t, Copy>(destination + 12, source + 12) +
+				transfer<uint32_t, Copy>(destination + 16, source + 16) +
+				transfer<uint32_t, Copy>(destination + 20, source + 20) +
+				transfer<uint32_t, Copy>(destination + 24, source + 24) +
+				transfer<uint32_t, Copy>(destination + 28, source + 28);
+		destination += 32;
+		source += 32;
+		length -= 32;
+	}
+	while (length >= 4)
+	{
+		sum += transfer<uint32_t, Copy>(destination, source);
+		destination += 4;
+		source += 4;
+		length -= 4;
+	}
+	if (length >= 2)
+	{
+		sum += transfer<uint16_t, Copy>(destination, source);
+		destination += 2;
+		source += 2;
+		length -= 2;
+	}
+	if (length != 0)
+	{
+		uint16_t word {};
+		reinterpret_cast<uint8_t*>(&word)[0] = transfer<uint8_t, Copy>(destination, source);
+		sum += word;
+	}
+
+	sum = (sum & UINT32_MAX) + (sum >> 32);
+	while ((sum >> 16) != 0)
+		sum = (sum & UINT16_MAX) + (sum >> 16);
+
+	if (odd == true)
+		sum = ((sum & UINT8_MAX) << 8) | (sum >> 8);
+
+	return static_cast<uint16_t>(sum);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+uint16_t internetChecksum(const void* const data, const int length)
+{
+	// destination is not accessed, it only needs to be valid for pointer arithmetic
+	const auto source = static_cast<const uint8_t*>(data);
+	return checksum<false>(const_cast<uint8_t*>(source), source, length);
+}
+
+uint16_t internetChecksumCopy(void* const destination, const void* const source, const uint16_t length)
+{
+	return checksum<true>(static_cast<uint8_t*>(destination), static_cast<const uint8_t*>(source), length);
+}
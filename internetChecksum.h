@@ -0,0 +1,57 @@
+/**
+ * \file
+ * \brief Declarations of optimized internet checksum, used by lwIP as LWIP_CHKSUM and LWIP_CHKSUM_COPY
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef INTERNETCHECKSUM_H_
+#define INTERNETCHECKSUM_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	/* def __cplusplus */
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Computes one's complement sum of data, the same as lwip_standard_chksum().
+ *
+ * Data is summed as 32-bit words in 64-bit accumulator (which on Cortex-M7 compiles to pairs of ADDS and ADC), with
+ * loop unrolled to 32 bytes. Any alignment of data is supported, only the head and the tail are summed in smaller
+ * units.
+ *
+ * \param [in] data is a pointer to summed data
+ * \param [in] length is the length of \a data, bytes
+ *
+ * \return one's complement sum of \a data folded to 16 bits (not complemented), in network byte order
+ */
+
+uint16_t internetChecksum(const void* data, int length);
+
+/**
+ * \brief Copies data and computes its one's complement sum in the same pass, the same as lwip_chksum_copy().
+ *
+ * \param [out] destination is a pointer to destination buffer
+ * \param [in] source is a pointer to copied data
+ * \param [in] length is the length of \a source, bytes
+ *
+ * \return one's complement sum of \a source folded to 16 bits (not complemented), in network byte order
+ */
+
+uint16_t internetChecksumCopy(void* destination, const void* source, uint16_t length);
+
+#ifdef __cplusplus
+}	/* extern "C" */
+#endif	/* def __cplusplus */
+
+#endif	/* INTERNETCHECKSUM_H_ */
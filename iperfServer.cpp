@@ -0,0 +1,163 @@
+/**
+ * \file
+ * \brief Definitions related to lwiperf throughput benchmark
+ *
+ * lwiperf reports only finished runs, so CPU load during the run is taken from windows of CPU usage samples (see
+ * cpuUsage.hpp) which cover its duration.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "iperfServer.hpp"
+
+#include "cpuUsage.hpp"
+
+#include "distortos/board/standardOutputStream.h"
+
+#include "distortos/assert.h"
+
+#include "lwip/apps/lwiperf.h"
+#include "lwip/tcpip.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// result of one run of lwiperf
+struct IperfRun
+{
+	/// bandwidth, kbit/s
+	uint32_t bandwidth;
+
+	/// number of transferred bytes
+	uint32_t bytes;
+
+	/// duration, milliseconds
+	uint32_t duration;
+
+	/// percentage of CPU time spent outside of idle thread
+	uint8_t load;
+
+	/// type of lwiperf report
+	uint8_t result;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// handle of lwiperf server, nullptr if the server is not running
+void* iperfHandle;
+
+/// number of finished runs
+uint32_t iperfRuns;
+
+/// result of the last finished run
+IperfRun lastIperfRun;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief lwiperf report callback
+ *
+ * Called in tcpip thread when a run is finished.
+ *
+ * \param [in] reportType is the type of report
+ * \param [in] remoteAddress is a pointer to address of remote side
+ * \param [in] remotePort is the port of remote side
+ * \param [in] bytesTransferred is the number of transferred bytes
+ * \param [in] msDuration is the duration of run, milliseconds
+ * \param [in] bandwidthKbitpsec is the bandwidth, kbit/s
+ */
+
+void iperfReportCallback(void*, const lwiperf_report_type reportType, const ip_addr_t*, u16_t,
+		const ip_addr_t* const remoteAddress, const u16_t remotePort, const u32_t bytesTransferred,
+		const u32_t msDuration, const u32_t bandwidthKbitpsec)
+{
+	lastIperfRun = {bandwidthKbitpsec, bytesTransferred, msDuration, getCpuLoad(msDuration),
+			static_cast<uint8_t>(reportType)};
+	++iperfRuns;
+
+	char buffer[IPADDR_STRLEN_MAX];
+	fiprintf(standardOutputStream, "iperfReportCallback: type = %d, remote = %s:%" PRIu16 ", bytes = %" PRIu32
+			", duration = %" PRIu32 " ms, bandwidth = %" PRIu32 " kbit/s, load = %" PRIu8 "%%\r\n", reportType,
+			ipaddr_ntoa_r(remoteAddress, buffer, sizeof(buffer)), remotePort, bytesTransferred, msDuration,
+			bandwidthKbitpsec, lastIperfRun.load);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| IperfStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int IperfStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize, char* const payload,
+		const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	LOCK_TCPIP_CORE();
+	const auto enabled = iperfHandle != nullptr;
+	const auto runs = iperfRuns;
+	const auto run = lastIperfRun;
+	UNLOCK_TCPIP_CORE();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "iperf/summary");
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto ret = sniprintf(payload, payloadSize, "enabled=%d runs=%" PRIu32 " result=%" PRIu8 " bandwidth=%" PRIu32
+			" bytes=%" PRIu32 " duration=%" PRIu32 " load=%" PRIu8 "%%", enabled, runs, run.result, run.bandwidth,
+			run.bytes, run.duration, run.load);
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t IperfStatisticsSource::getCount() const
+{
+	return 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void setIperfServerEnabled(const bool enabled)
+{
+	if ((iperfHandle != nullptr) == enabled)
+		return;
+
+	if (enabled == false)
+	{
+		lwiperf_abort(iperfHandle);
+		iperfHandle = {};
+		fiprintf(standardOutputStream, "setIperfServerEnabled: lwiperf server stopped\r\n");
+		return;
+	}
+
+	iperfHandle = lwiperf_start_tcp_server_default(iperfReportCallback, {});
+	if (iperfHandle == nullptr)
+	{
+		fiprintf(standardOutputStream, "setIperfServerEnabled: lwiperf_start_tcp_server_default() failed\r\n");
+		return;
+	}
+
+	fiprintf(standardOutputStream, "setIperfServerEnabled: lwiperf server listening on port %d\r\n",
+			LWIPERF_TCP_PORT_DEFAULT);
+}
@@ -0,0 +1,77 @@
+/**
+ * \file
+ * \brief Declarations related to lwiperf throughput benchmark
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IPERFSERVER_HPP_
+#define IPERFSERVER_HPP_
+
+#include "StatisticsSource.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Source of statistics of lwiperf throughput benchmark.
+ *
+ * Summary is published in "stats/iperf/summary" topic.
+ */
+
+class IperfStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats summary of lwiperf throughput benchmark.
+	 *
+	 * Payload has following format: "enabled=<enabled> runs=<runs> result=<result> bandwidth=<bandwidth>
+	 * bytes=<bytes> duration=<duration> load=<load>%", where "enabled" is 1 if the server is running (0 otherwise),
+	 * "runs" is the number of finished runs and the rest describes the last run - "result" is its lwiperf report type
+	 * (0 - finished, 2, 3 or 4 - aborted locally, 5 - aborted by remote side), "bandwidth" is in kbit/s,
+	 * "duration" is in milliseconds and "load" is the percentage of CPU time spent outside of idle thread during the
+	 * run.
+	 *
+	 * \param [in] index is the index of entry, must be 0
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return 1
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Starts or stops lwiperf server.
+ *
+ * When started, lwiperf TCP server listens on default iperf port (5001). Each finished run is reported with CPU load
+ * during the run. Stopping the server aborts the run which is in progress.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] enabled selects whether lwiperf server should be started (true) or stopped (false)
+ */
+
+void setIperfServerEnabled(bool enabled);
+
+#endif	// IPERFSERVER_HPP_
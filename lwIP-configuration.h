@@ -12,7 +12,11 @@
 #ifndef LWIP_CONFIGURATION_H_
 #define LWIP_CONFIGURATION_H_
 
+#ifndef _GNU_SOURCE
 #define _GNU_SOURCE
+#endif	/* ndef _GNU_SOURCE */
+
+#include "internetChecksum.h"
 
 #include "distortos/board/standardOutputStream.h"
 
@@ -29,69 +33,122 @@ extern "C"
 {
 #endif	/* def __cplusplus */
 
+#if TCPIP_CORE_LOCK_PROFILER == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/** call site of LOCK_TCPIP_CORE() */
+struct TcpipCoreLockSite
+{
+	/** name of file with call site */
+	const char* file;
+
+	/** line of call site */
+	int line;
+
+	/** index of call site in table of profiler increased by 1, 0 if call site is not registered yet */
+	unsigned int index;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Locks lwIP core mutex and records time of waiting for it.
+ *
+ * \param [in,out] site is a pointer to call site of LOCK_TCPIP_CORE()
+ */
+
+void tcpipCoreLockProfilerLock(struct TcpipCoreLockSite* site);
+
+/**
+ * \brief Records time of holding lwIP core mutex and unlocks it.
+ */
+
+void tcpipCoreLockProfilerUnlock(void);
+
+#endif	/* TCPIP_CORE_LOCK_PROFILER == 1 */
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | global defines
 +---------------------------------------------------------------------------------------------------------------------*/
 
+/**
+ * ALTCP_MBEDTLS_AUTHMODE: mbedTLS authentication mode of TLS clients. Certificate of broker must be valid, otherwise
+ * the handshake fails.
+ */
+
+#define ALTCP_MBEDTLS_AUTHMODE					MBEDTLS_SSL_VERIFY_REQUIRED
+
+/**
+ * ALTCP_MBEDTLS_PLATFORM_ALLOC==1: Replace mbedTLS allocator with lwIP's heap. Disabled, as mbedTLS uses its own static
+ * arena (see mqttTls.cpp).
+ */
+
+#define ALTCP_MBEDTLS_PLATFORM_ALLOC			0
+
 /**
  * CHECKSUM_CHECK_ICMP==1: Check checksums in software for incoming ICMP packets.
  */
 
-#define CHECKSUM_CHECK_ICMP						0
+#define CHECKSUM_CHECK_ICMP						1
 
 /**
  * CHECKSUM_CHECK_ICMP6==1: Check checksums in software for incoming ICMPv6 packets.
  */
 
-#define CHECKSUM_CHECK_ICMP6					0
+#define CHECKSUM_CHECK_ICMP6					1
 
 /**
  * CHECKSUM_CHECK_IP==1: Check checksums in software for incoming IP packets.
  */
 
-#define CHECKSUM_CHECK_IP						0
+#define CHECKSUM_CHECK_IP						1
 
 /**
  * CHECKSUM_CHECK_TCP==1: Check checksums in software for incoming TCP packets.
  */
 
-#define CHECKSUM_CHECK_TCP						0
+#define CHECKSUM_CHECK_TCP						1
 
 /**
  * CHECKSUM_CHECK_UDP==1: Check checksums in software for incoming UDP packets.
  */
 
-#define CHECKSUM_CHECK_UDP						0
+#define CHECKSUM_CHECK_UDP						1
 
 /**
  * CHECKSUM_GEN_ICMP==1: Generate checksums in software for outgoing ICMP packets.
  */
 
-#define CHECKSUM_GEN_ICMP						0
+#define CHECKSUM_GEN_ICMP						1
 
 /**
  * CHECKSUM_GEN_ICMP6==1: Generate checksums in software for outgoing ICMP6 packets.
  */
 
-#define CHECKSUM_GEN_ICMP6						0
+#define CHECKSUM_GEN_ICMP6						1
 
 /**
  * CHECKSUM_GEN_IP==1: Generate checksums in software for outgoing IP packets.
  */
 
-#define CHECKSUM_GEN_IP							0
+#define CHECKSUM_GEN_IP							1
 
 /**
  * CHECKSUM_GEN_TCP==1: Generate checksums in software for outgoing TCP packets.
  */
 
-#define CHECKSUM_GEN_TCP						0
+#define CHECKSUM_GEN_TCP						1
 
 /**
  * CHECKSUM_GEN_UDP==1: Generate checksums in software for outgoing UDP packets.
  */
 
-#define CHECKSUM_GEN_UDP						0
+#define CHECKSUM_GEN_UDP						1
 
 /**
  * DEFAULT_ACCEPTMBOX_SIZE: The mailbox size for the incoming connections.
@@ -141,6 +198,94 @@ extern "C"
 
 #define DEFAULT_UDP_RECVMBOX_SIZE				16
 
+/**
+ * ETHARP_SUPPORT_STATIC_ENTRIES==1: enable code to support static ARP table entries (using etharp_add_static_entry /
+ * etharp_remove_static_entry).
+ *
+ * Cached MAC address of the gateway is restored as a static entry when FAST_BOOT is enabled.
+ */
+
+#define ETHARP_SUPPORT_STATIC_ENTRIES			(FAST_BOOT == 1)
+
+/**
+ * HTTPD_MAX_WRITE_LEN(pcb): maximum number of bytes enqueued by httpd at once.
+ *
+ * httpd allocates its send buffer (with mem_malloc()) for dynamically read files with this size, so it is limited to
+ * single segment - metrics are rendered directly into this buffer.
+ */
+
+#define HTTPD_MAX_WRITE_LEN(pcb)				TCP_MSS
+
+#if TCPIP_CORE_LOCK_PROFILER == 1
+
+/**
+ * \brief Locks lwIP core mutex, profiled replacement of lwIP's default implementation.
+ *
+ * Each call site has its own static TcpipCoreLockSite object, so times of waiting and holding can be recorded
+ * separately for each call site.
+ */
+
+#define LOCK_TCPIP_CORE()						do { \
+		static struct TcpipCoreLockSite tcpipCoreLockSite = {__FILE__, __LINE__, 0}; \
+		tcpipCoreLockProfilerLock(&tcpipCoreLockSite); \
+} while (0)
+
+/**
+ * \brief Unlocks lwIP core mutex, profiled replacement of lwIP's default implementation.
+ */
+
+#define UNLOCK_TCPIP_CORE()						tcpipCoreLockProfilerUnlock()
+
+#endif	/* TCPIP_CORE_LOCK_PROFILER == 1 */
+
+/**
+ * LWIP_ALTCP==1: enable the altcp API. altcp is an abstraction layer that prevents applications linking against the
+ * tcp.h functions but provides the same functionality.
+ */
+
+#define LWIP_ALTCP								(MQTT_TLS == 1)
+
+/**
+ * LWIP_ALTCP_TLS==1: enable TLS support for altcp API.
+ */
+
+#define LWIP_ALTCP_TLS							(MQTT_TLS == 1)
+
+/**
+ * LWIP_ALTCP_TLS_MBEDTLS==1: use mbedTLS for TLS support for altcp API.
+ */
+
+#define LWIP_ALTCP_TLS_MBEDTLS					(MQTT_TLS == 1)
+
+/**
+ * LWIP_CHECKSUM_CTRL_PER_NETIF==1: Checksum generation/check can be enabled/disabled per netif. Ethernet interface
+ * disables all of them when checksums are offloaded to MAC (SOFTWARE_CHECKSUM is disabled), other interfaces (e.g.
+ * loopback) always use software checksums.
+ */
+
+#define LWIP_CHECKSUM_CTRL_PER_NETIF			1
+
+/**
+ * LWIP_CHECKSUM_ON_COPY==1: Calculate checksum when copying data from application buffers to pbufs. Useful only when
+ * TCP checksums are generated in software.
+ */
+
+#define LWIP_CHECKSUM_ON_COPY					(SOFTWARE_CHECKSUM == 1)
+
+/**
+ * LWIP_CHKSUM: Function which computes one's complement sum of data - optimized implementation from
+ * internetChecksum.cpp.
+ */
+
+#define LWIP_CHKSUM								internetChecksum
+
+/**
+ * LWIP_CHKSUM_COPY: Function which copies data and computes its one's complement sum in the same pass - optimized
+ * implementation from internetChecksum.cpp.
+ */
+
+#define LWIP_CHKSUM_COPY(destination, source, length)	internetChecksumCopy(destination, source, length)
+
 /**
  * LWIP_COMPAT_SOCKETS==1: Enable BSD-style sockets functions names through defines. LWIP_COMPAT_SOCKETS==2: Same as ==1
  * but correctly named functions are created. While this helps code completion, it might conflict with existing
@@ -170,6 +315,29 @@ extern "C"
 
 #define LWIP_DNS								1
 
+/**
+ * LWIP_HTTPD_CUSTOM_FILES==1: add support for additional "custom" files which are not in the file system.
+ *
+ * Metrics in Prometheus text format are served as a custom file when PROMETHEUS_METRICS is enabled.
+ */
+
+#define LWIP_HTTPD_CUSTOM_FILES					(PROMETHEUS_METRICS == 1)
+
+/**
+ * LWIP_HTTPD_DYNAMIC_FILE_READ==1: support reading files in chunks instead of having them in memory as a whole.
+ */
+
+#define LWIP_HTTPD_DYNAMIC_FILE_READ			(PROMETHEUS_METRICS == 1)
+
+/**
+ * LWIP_HTTPD_SUPPORT_V09==1: support HTTP/0.9 clients.
+ *
+ * Disabled, as HTTP/0.9 responses are made by searching for the end of HTTP header in file's data, which custom files
+ * with dynamic read don't have.
+ */
+
+#define LWIP_HTTPD_SUPPORT_V09					0
+
 /**
  * LWIP_NETIF_API==1: Support netif api (in netifapi.c)
  */
@@ -190,6 +358,24 @@ extern "C"
 
 #define LWIP_NETIF_STATUS_CALLBACK				1
 
+#if PTP_TIMESTAMPS == 1
+
+/**
+ * LWIP_PBUF_CUSTOM_DATA: Store private data on pbufs. Hardware timestamp of frame (time of PTP clock in nanoseconds) is
+ * set by Ethernet driver in the first pbuf of each received frame, ptpTransmitTimestampRequest in the first pbuf of
+ * transmitted frame requests capture of its transmit timestamp.
+ */
+
+#define LWIP_PBUF_CUSTOM_DATA					uint64_t timestamp;
+
+/**
+ * LWIP_PBUF_CUSTOM_DATA_INIT: Initialize private data on pbufs.
+ */
+
+#define LWIP_PBUF_CUSTOM_DATA_INIT(p)			(p)->timestamp = 0
+
+#endif	/* PTP_TIMESTAMPS == 1 */
+
 #ifndef NDEBUG
 
 /**
@@ -231,6 +417,14 @@ extern "C"
 
 #define LWIP_RAND()								rand()
 
+/**
+ * LWIP_STATS==1: Enable statistics collection in lwip_stats.
+ *
+ * Statistics of memory pools and heap are published periodically by the application.
+ */
+
+#define LWIP_STATS								1
+
 /**
  * MEM_SIZE: the size of the heap memory.
  *
@@ -239,14 +433,55 @@ extern "C"
 
 #define MEM_SIZE								(10 * 1024)
 
+#if MEMORY_POOLS == 1
+
+/**
+ * MEM_USE_POOLS==1: Use an alternative to malloc() by allocating from a set of memory pools of various sizes.
+ *
+ * When mem_malloc is called, an element of the smallest pool that can provide the length needed is returned. The pools
+ * are defined in lwippools.h.
+ */
+
+#define MEM_USE_POOLS							1
+
+/**
+ * MEM_USE_POOLS_TRY_BIGGER_POOL==1: if one malloc-pool bucket is empty, try the next bigger pool.
+ */
+
+#define MEM_USE_POOLS_TRY_BIGGER_POOL			1
+
+#endif	/* MEMORY_POOLS == 1 */
+
 /**
  * MEMP_NUM_SYS_TIMEOUT: the number of simultaneously active timeouts.
  *
  * The default number of timeouts is calculated here for all enabled modules. The formula expects settings to be either
  * '0' or '1'.
+ *
+ * Additional timeouts are used by MQTT client, resolver of MQTT brokers and revalidation of boot cache.
+ */
+
+#define MEMP_NUM_SYS_TIMEOUT					(LWIP_NUM_SYS_TIMEOUT_INTERNAL + 2 + (FAST_BOOT == 1))
+
+/**
+ * MEMP_NUM_UDP_PCB: the number of UDP protocol control blocks. One per active UDP "connection".
+ *
+ * lwIP's default (4) is kept for DHCP, DNS and spares. PTP slave uses 2 more PCBs (event and general port) and UDP echo
+ * responder uses 1.
+ */
+
+#define MEMP_NUM_UDP_PCB						(4 + 2 * (PTP_TIMESTAMPS == 1) + (UDP_ECHO == 1))
+
+#if MEMORY_POOLS == 1
+
+/**
+ * MEMP_USE_CUSTOM_POOLS==1: whether to include a user file lwippools.h that defines additional pools beyond the
+ * "standard" ones required by lwIP.
  */
 
-#define MEMP_NUM_SYS_TIMEOUT					(LWIP_NUM_SYS_TIMEOUT_INTERNAL + 1)
+#define MEMP_USE_CUSTOM_POOLS					1
+
+#endif	/* MEMORY_POOLS == 1 */
 
 /**
  * SO_REUSE==1: Enable SO_REUSEADDR option.
@@ -0,0 +1,36 @@
+/**
+ * \file
+ * \brief Definitions of lwIP memory pools used by mem_malloc() when MEMORY_POOLS option is enabled
+ *
+ * \warning
+ * This file is included multiple times by lwIP (via lwip/priv/memp_std.h) with different definitions of
+ * LWIP_MALLOC_MEMPOOL(), so it must not have an include guard.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#if MEM_USE_POOLS == 1
+
+/*
+ * Sizes of pools are tuned to the traffic of the application:
+ * - 128 bytes - ARP packets, small pbufs allocated by the stack, MQTT publishes with short payloads;
+ * - 256 bytes - DNS queries, DHCP client's state;
+ * - 640 bytes - DHCP messages, MQTT client (mqtt_client_t);
+ * - 1568 bytes - TCP segments with full MSS (TCP_OVERSIZE makes tcp_write() allocate whole segment).
+ *
+ * Numbers of elements should be verified with statistics of pools published by the application (".../stats/memory/...",
+ * "max" field is the high-water mark).
+ */
+
+LWIP_MALLOC_MEMPOOL_START
+LWIP_MALLOC_MEMPOOL(16, 128)
+LWIP_MALLOC_MEMPOOL(8, 256)
+LWIP_MALLOC_MEMPOOL(4, 640)
+LWIP_MALLOC_MEMPOOL(6, 1568)
+LWIP_MALLOC_MEMPOOL_END
+
+#endif	/* MEM_USE_POOLS == 1 */
@@ -9,7 +9,29 @@
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include "bootCache.hpp"
+#include "bootStatistics.hpp"
+#include "brokerList.hpp"
+#include "cpuUsage.hpp"
+#include "cycleCounter.hpp"
+#include "dmaRecovery.hpp"
 #include "ethernetInterfaceInitialize.hpp"
+#include "iperfServer.hpp"
+#include "memoryStatistics.hpp"
+#include "metricsServer.hpp"
+#include "mqttMetrics.hpp"
+#include "mqttTopics.hpp"
+#include "mqttTls.hpp"
+#include "networkMetrics.hpp"
+#include "packetCapture.hpp"
+#include "ptpSlave.hpp"
+#include "publishTrace.hpp"
+#include "stackUsage.hpp"
+#include "tcpipCoreLockProfiler.hpp"
+#include "telemetry.hpp"
+#include "tlsfMalloc.hpp"
+#include "txPriority.hpp"
+#include "udpEcho.hpp"
 
 #include "distortos/board/buttons.hpp"
 #include "distortos/board/initializeStreams.hpp"
@@ -20,25 +42,38 @@
 #include "distortos/chip/uniqueDeviceId.hpp"
 
 #include "distortos/assert.h"
-#include "distortos/distortosVersion.h"
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/Semaphore.hpp"
 #include "distortos/ThisThread.hpp"
+#include "distortos/TickClock.hpp"
 
 #include "estd/ScopeGuard.hpp"
 
 #include "lwip/apps/mqtt.h"
+#include "lwip/apps/mqtt_priv.h"
 
 #include "lwip/dhcp.h"
-#include "lwip/netdb.h"
 #include "lwip/tcpip.h"
 
-#include <optional>
+#include <algorithm>
+
+#include <cstring>
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | local defines
 +---------------------------------------------------------------------------------------------------------------------*/
 
-/// common prefix of all topics used by this application
-#define TOPIC_PREFIX	"distortos/" DISTORTOS_VERSION_STRING "/" DISTORTOS_BOARD
+#if MQTT_TLS == 1
+
+/// TCP port of MQTT brokers
+#define MQTT_BROKER_PORT	MQTT_TLS_PORT
+
+#else	// MQTT_TLS != 1
+
+/// TCP port of MQTT brokers
+#define MQTT_BROKER_PORT	MQTT_PORT
+
+#endif	// MQTT_TLS != 1
 
 /// MQTT message published to ONLINE_TOPIC as client's "will" when connection is lost
 #define OFFLINE_MESSAGE	"0"
@@ -46,21 +81,21 @@
 /// MQTT message published to ONLINE_TOPIC when connected to MQTT broker
 #define ONLINE_MESSAGE	"1"
 
-/// MQTT "online" topic - ONLINE_MESSAGE is published when connected to MQTT broker and OFFLINE_MESSAGE as client's
-// "will" when connection is lost
-#define ONLINE_TOPIC	TOPIC_PREFIX "/online"
+#if BUTTONS_QOS1 == 1
+
+/// QoS of messages with state of buttons, PUBACK of each message is traced (see publishTrace.hpp)
+#define BUTTONS_QOS				1
 
-/// prefix for topic used for publishing requested state of LEDs
-#define LEDS_TOPIC_PREFIX		TOPIC_PREFIX "/leds"
+#else	// BUTTONS_QOS1 != 1
 
-/// suffix for topic used for publishing requested state of LEDs
-#define LEDS_TOPIC_SUFFIX		"/state"
+/// QoS of messages with state of buttons, acknowledgement of TCP segment with each message is traced (see
+/// publishTrace.hpp)
+#define BUTTONS_QOS				0
 
-/// prefix for topic used for publishing state of buttons
-#define BUTTONS_TOPIC_PREFIX	TOPIC_PREFIX "/buttons"
+#endif	// BUTTONS_QOS1 != 1
 
-/// suffix for topic used for publishing state of buttons
-#define BUTTONS_TOPIC_SUFFIX	"/state"
+/// max length of payload of LEDS_TOPIC - two 32-bit hexadecimal numbers separated with ':'
+#define LEDS_PAYLOAD_MAX_LENGTH	(8 + 1 + 8)
 
 namespace
 {
@@ -69,8 +104,34 @@ namespace
 | local types
 +---------------------------------------------------------------------------------------------------------------------*/
 
-/// type alias for data used for LED message
-using LedMessage = std::optional<size_t>;
+/// target of incoming MQTT message
+enum class MessageTarget : uint8_t
+{
+	/// message is ignored
+	none,
+	/// message controls lwiperf server
+	iperf,
+	/// message controls LED
+	led,
+	/// message controls all LEDs at once
+	leds,
+};
+
+/// incoming MQTT message
+struct IncomingMessage
+{
+	/// index of LED, valid only if \a target is MessageTarget::led
+	size_t led;
+
+	/// target of message
+	MessageTarget target;
+
+	/// number of bytes in \a payload, valid only if \a target is MessageTarget::leds
+	uint8_t length;
+
+	/// null-terminated payload, valid only if \a target is MessageTarget::leds
+	char payload[LEDS_PAYLOAD_MAX_LENGTH + 1];
+};
 
 /// collection of data used by lwIP's MQTT client
 struct MqttClient
@@ -81,6 +142,9 @@ struct MqttClient
 	/// pointer to lwIP's MQTT client struct
 	mqtt_client_t* client;
 
+	/// semaphore posted when connecting is finished
+	distortos::Semaphore connectedSemaphore {0};
+
 	/// MQTT client's status
 	mqtt_connection_status_t status;
 
@@ -88,6 +152,211 @@ struct MqttClient
 	bool connecting;
 };
 
+/// state of periodic publishing of statistics
+struct StatisticsPublisher
+{
+	/// time point at which next round of publishing will be started
+	distortos::TickClock::time_point nextRound;
+
+	/// index of currently published source in statisticsSources
+	size_t source;
+
+	/// index of currently published entry of current source
+	size_t entry;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// delay before retrying failed connection with MQTT broker
+constexpr std::chrono::seconds retryDelay {1};
+
+/// period of publishing statistics
+constexpr std::chrono::seconds statisticsPeriod {60};
+
+/// semaphore posted when network interface gets its address
+distortos::Semaphore addressAssignedSemaphore {0, 1};
+
+/// topics to which the application subscribes after connecting to MQTT broker
+const char* const subscribedTopics[]
+{
+		LEDS_TOPIC_PREFIX "/+" LEDS_TOPIC_SUFFIX,
+		LEDS_TOPIC,
+		IPERF_TOPIC,
+};
+
+/// bitmask with all LEDs selected, bit N is LED N
+constexpr uint32_t allLedsMask {(UINT32_C(1) << std::size(distortos::board::leds)) - 1};
+
+/// bitmask of LEDs changed by messages on their separate topics, which are replaced with retained state of all LEDs,
+/// accessed only with lwIP core locked
+uint32_t ledsChangedSeparately;
+
+/// true if state of all LEDs should be published as retained message of LEDS_TOPIC, accessed only with lwIP core locked
+bool ledsStatePending;
+
+/// endpoints of MQTT brokers, in the order of preference
+const BrokerEndpoint brokerEndpoints[]
+{
+		{"broker.hivemq.com", MQTT_BROKER_PORT},
+		{"test.mosquitto.org", MQTT_BROKER_PORT},
+		{"broker.emqx.io", MQTT_BROKER_PORT},
+};
+
+/// source of statistics of boot
+const BootStatisticsSource bootStatisticsSource {};
+
+/// source of statistics of MQTT brokers
+const BrokerStatisticsSource brokerStatisticsSource {};
+
+/// source of statistics of CPU usage
+const CpuUsageStatisticsSource cpuUsageStatisticsSource {};
+
+/// source of statistics of recoveries of Ethernet DMA
+const DmaRecoveryStatisticsSource dmaRecoveryStatisticsSource {};
+
+/// source of statistics of lwiperf throughput benchmark
+const IperfStatisticsSource iperfStatisticsSource {};
+
+/// source of lwIP's memory statistics
+const MemoryStatisticsSource memoryStatisticsSource {};
+
+/// source of statistics of publish latency
+const PublishTraceStatisticsSource publishTraceStatisticsSource {};
+
+/// source of statistics of stack usage
+const StackUsageStatisticsSource stackUsageStatisticsSource {};
+
+#if TLSF_MALLOC == 1
+
+/// source of heap statistics
+const HeapStatisticsSource heapStatisticsSource {};
+
+#endif	// TLSF_MALLOC == 1
+
+#if TCPIP_CORE_LOCK_PROFILER == 1
+
+/// source of statistics of lwIP core mutex
+const TcpipCoreLockStatisticsSource tcpipCoreLockStatisticsSource {};
+
+#endif	// TCPIP_CORE_LOCK_PROFILER == 1
+
+#if MQTT_TLS == 1
+
+/// source of statistics of TLS transport
+const TlsStatisticsSource tlsStatisticsSource {};
+
+#endif	// MQTT_TLS == 1
+
+#if UDP_ECHO == 1
+
+/// source of statistics of UDP echo responder
+const UdpEchoStatisticsSource udpEchoStatisticsSource {};
+
+#endif	// UDP_ECHO == 1
+
+#if PACKET_CAPTURE == 1
+
+/// source of statistics of packet capture
+const PacketCaptureStatisticsSource packetCaptureStatisticsSource {};
+
+#endif	// PACKET_CAPTURE == 1
+
+#if PTP_TIMESTAMPS == 1
+
+/// source of statistics of PTP slave
+const PtpStatisticsSource ptpStatisticsSource {};
+
+#endif	// PTP_TIMESTAMPS == 1
+
+#if TX_PRIORITY == 1
+
+/// source of statistics of priority queues of transmitted frames
+const TxPriorityStatisticsSource txPriorityStatisticsSource {};
+
+#endif	// TX_PRIORITY == 1
+
+#if TELEMETRY == 1
+
+/// source of statistics of telemetry
+const TelemetryStatisticsSource telemetryStatisticsSource {};
+
+#endif	// TELEMETRY == 1
+
+#if PROMETHEUS_METRICS == 1
+
+/// source of metrics of CPU usage
+const CpuUsageMetricsSource cpuUsageMetricsSource {};
+
+/// source of metrics of lwIP's memory pools and heap
+const MemoryMetricsSource memoryMetricsSource {};
+
+/// source of metrics of MQTT client
+const MqttMetricsSource mqttMetricsSource {};
+
+/// source of metrics of default network interface
+const NetworkMetricsSource networkMetricsSource {};
+
+/// source of metrics of publish latency
+const PublishTraceMetricsSource publishTraceMetricsSource {};
+
+/// all sources of metrics served by HTTP server
+const MetricsSource* const metricsSources[]
+{
+		&cpuUsageMetricsSource,
+		&memoryMetricsSource,
+		&mqttMetricsSource,
+		&networkMetricsSource,
+		&publishTraceMetricsSource,
+};
+
+#endif	// PROMETHEUS_METRICS == 1
+
+#if STATIC_ALLOCATION == 1
+
+/// statically allocated lwIP's MQTT client struct
+mqtt_client_t staticMqttClient;
+
+#endif	// STATIC_ALLOCATION == 1
+
+/// all sources of statistics published periodically by the application
+const StatisticsSource* const statisticsSources[]
+{
+		&bootStatisticsSource,
+		&brokerStatisticsSource,
+		&cpuUsageStatisticsSource,
+		&dmaRecoveryStatisticsSource,
+		&iperfStatisticsSource,
+		&memoryStatisticsSource,
+		&publishTraceStatisticsSource,
+		&stackUsageStatisticsSource,
+#if TLSF_MALLOC == 1
+		&heapStatisticsSource,
+#endif	// TLSF_MALLOC == 1
+#if TCPIP_CORE_LOCK_PROFILER == 1
+		&tcpipCoreLockStatisticsSource,
+#endif	// TCPIP_CORE_LOCK_PROFILER == 1
+#if MQTT_TLS == 1
+		&tlsStatisticsSource,
+#endif	// MQTT_TLS == 1
+#if UDP_ECHO == 1
+		&udpEchoStatisticsSource,
+#endif	// UDP_ECHO == 1
+#if PACKET_CAPTURE == 1
+		&packetCaptureStatisticsSource,
+#endif	// PACKET_CAPTURE == 1
+#if PTP_TIMESTAMPS == 1
+		&ptpStatisticsSource,
+#endif	// PTP_TIMESTAMPS == 1
+#if TX_PRIORITY == 1
+		&txPriorityStatisticsSource,
+#endif	// TX_PRIORITY == 1
+#if TELEMETRY == 1
+		&telemetryStatisticsSource,
+#endif	// TELEMETRY == 1
+};
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
@@ -109,14 +378,82 @@ void mqttClientConnectionCallback(mqtt_client_t* const client, void* const argum
 
 	fiprintf(standardOutputStream, "mqttClientConnectionCallback: status = %d\r\n", status);
 
+	if (status == MQTT_CONNECT_ACCEPTED)
+		recordBootMilestone(BootMilestone::mqttAccepted);
+
 	mqttClient.status = status;
-	mqttClient.connecting = {};
+	if (mqttClient.connecting == true)
+	{
+		recordMqttConnection(status == MQTT_CONNECT_ACCEPTED);
+		mqttClient.connecting = {};
+		mqttClient.connectedSemaphore.post();
+	}
+	else
+		recordMqttDisconnection();
+}
+
+/**
+ * \brief Parses hexadecimal number.
+ *
+ * Unlike strtoul() or "%x" conversion of siscanf(), only hexadecimal digits are accepted - no whitespace, sign or "0x"
+ * prefix.
+ *
+ * \param [in] begin is a pointer to first character of number
+ * \param [in] end is a pointer to one past the last character of number
+ * \param [out] value is a reference to variable for parsed number
+ *
+ * \return true if [begin; end) has from 1 to 8 hexadecimal digits and nothing else, false otherwise
+ */
+
+bool parseHexadecimal(const char* begin, const char* const end, uint32_t& value)
+{
+	if (begin == end || end - begin > 8)
+		return false;
+
+	value = {};
+	for (; begin != end; ++begin)
+	{
+		const auto character = *begin;
+		uint32_t digit;
+		if (character >= '0' && character <= '9')
+			digit = character - '0';
+		else if (character >= 'a' && character <= 'f')
+			digit = character - 'a' + 10;
+		else if (character >= 'A' && character <= 'F')
+			digit = character - 'A' + 10;
+		else
+			return false;
+
+		value = value << 4 | digit;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Sets state of selected LEDs at once.
+ *
+ * LEDs may be connected to different GPIO ports, so they cannot be set with one write, but they are all set with
+ * interrupts masked, so no other code (including context switch) can run between changes of their states.
+ *
+ * \param [in] mask is a bitmask of LEDs which should be set, bit N is LED N
+ * \param [in] values is a bitmask with new states of LEDs selected by \a mask
+ */
+
+void setLeds(const uint32_t mask, const uint32_t values)
+{
+	static_assert(std::size(distortos::board::leds) < 32, "Mask of LEDS_TOPIC must have a bit for each LED!");
+
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+	for (size_t i {}; i < std::size(distortos::board::leds); ++i)
+		if ((mask & 1u << i) != 0)
+			distortos::board::leds[i].set((values & 1u << i) != 0);
 }
 
 /**
  * \brief lwIP's MQTT incoming data callback
  *
- * \param [in] argument is a argument which was passed to mqtt_set_inpub_callback(), must be LedMessage!
+ * \param [in] argument is a argument which was passed to mqtt_set_inpub_callback(), must be IncomingMessage!
  * \param [in] data is a pointer to incoming data
  * \param [in] length is the length of \a data
  * \param [in] flags are flags associated with \a data
@@ -125,17 +462,48 @@ void mqttClientConnectionCallback(mqtt_client_t* const client, void* const argum
 void mqttIncomingDataCallback(void* const argument, const u8_t* const data, const u16_t length, const u8_t flags)
 {
 	assert(argument != nullptr);
-	auto& ledMessage = *static_cast<LedMessage*>(argument);
+	auto& incomingMessage = *static_cast<IncomingMessage*>(argument);
 
 	fiprintf(standardOutputStream, "mqttIncomingDataCallback: length = %" PRIu16 ", flags = %" PRIu8 "\r\n",
 			length, flags);
 
-	if (ledMessage.has_value() == false)
+	if (incomingMessage.target == MessageTarget::none)
 	{
 		fiprintf(standardOutputStream, "mqttIncomingDataCallback: ignoring\r\n");
 		return;
 	}
 
+	if (incomingMessage.target == MessageTarget::leds)
+	{
+		// payload may be split into several fragments, its total length was already verified
+		assert(incomingMessage.length + length <= LEDS_PAYLOAD_MAX_LENGTH);
+		memcpy(incomingMessage.payload + incomingMessage.length, data, length);
+		incomingMessage.length += length;
+		if ((flags & MQTT_DATA_FLAG_LAST) == 0)
+			return;
+
+		incomingMessage.payload[incomingMessage.length] = {};
+		const auto end = incomingMessage.payload + incomingMessage.length;
+		const auto separator = std::find(incomingMessage.payload, end, ':');
+		uint32_t mask;
+		uint32_t values;
+		if (separator == end || parseHexadecimal(incomingMessage.payload, separator, mask) == false ||
+				parseHexadecimal(separator + 1, end, values) == false || (mask & ~allLedsMask) != 0 ||
+				(values & ~allLedsMask) != 0)
+		{
+			fiprintf(standardOutputStream, "mqttIncomingDataCallback: invalid data, got \"%s\", expected "
+					"\"<mask>:<values>\" with bits [0; %zu), ignoring\r\n", incomingMessage.payload,
+					std::size(distortos::board::leds));
+			return;
+		}
+
+		setLeds(mask, values);
+		// state of all LEDs is retained only if this message did not select all of them
+		if (mask != allLedsMask)
+			ledsStatePending = true;
+		return;
+	}
+
 	assert(length == 1);
 	assert((flags & MQTT_DATA_FLAG_LAST) != 0);
 
@@ -146,13 +514,20 @@ void mqttIncomingDataCallback(void* const argument, const u8_t* const data, cons
 				return;
 	}
 
-	distortos::board::leds[*ledMessage].set(*data == '1');
+	if (incomingMessage.target == MessageTarget::iperf)
+		setIperfServerEnabled(*data == '1');
+	else
+	{
+		distortos::board::leds[incomingMessage.led].set(*data == '1');
+		ledsChangedSeparately |= UINT32_C(1) << incomingMessage.led;
+		ledsStatePending = true;
+	}
 }
 
 /**
  * \brief lwIP's MQTT incoming publish callback
  *
- * \param [in] argument is a argument which was passed to mqtt_set_inpub_callback(), must be LedMessage!
+ * \param [in] argument is a argument which was passed to mqtt_set_inpub_callback(), must be IncomingMessage!
  * \param [in] topic is the topic of incoming publish
  * \param [in] totalLength is the total length of incoming data
  */
@@ -160,12 +535,31 @@ void mqttIncomingDataCallback(void* const argument, const u8_t* const data, cons
 void mqttIncomingPublishCallback(void* const argument, const char* const topic, const u32_t totalLength)
 {
 	assert(argument != nullptr);
-	auto& ledMessage = *static_cast<LedMessage*>(argument);
-	ledMessage.reset();
+	auto& incomingMessage = *static_cast<IncomingMessage*>(argument);
+	incomingMessage = {};
 
 	fiprintf(standardOutputStream, "mqttIncomingPublishCallback: topic = \"%s\", total length = %" PRIu32 "\r\n",
 			topic, totalLength);
 
+	if (totalLength == 0)
+	{
+		fiprintf(standardOutputStream, "mqttIncomingPublishCallback: retained message was cleared, ignoring\r\n");
+		return;
+	}
+
+	if (strcmp(topic, LEDS_TOPIC) == 0)
+	{
+		if (totalLength < 3 || totalLength > LEDS_PAYLOAD_MAX_LENGTH)
+		{
+			fiprintf(standardOutputStream, "mqttIncomingPublishCallback: invalid total length, got %" PRIu32
+					", expected [3; %d], ignoring\r\n", totalLength, LEDS_PAYLOAD_MAX_LENGTH);
+			return;
+		}
+
+		incomingMessage.target = MessageTarget::leds;
+		return;
+	}
+
 	if (totalLength != 1)
 	{
 		fiprintf(standardOutputStream,
@@ -174,6 +568,12 @@ void mqttIncomingPublishCallback(void* const argument, const char* const topic,
 		return;
 	}
 
+	if (strcmp(topic, IPERF_TOPIC) == 0)
+	{
+		incomingMessage.target = MessageTarget::iperf;
+		return;
+	}
+
 	size_t i;
 	const auto ret = siscanf(topic, LEDS_TOPIC_PREFIX "/%zu" LEDS_TOPIC_SUFFIX, &i);
 	if (ret != 1)
@@ -189,19 +589,148 @@ void mqttIncomingPublishCallback(void* const argument, const char* const topic,
 		return;
 	}
 
-	ledMessage = i;
+	incomingMessage = {i, MessageTarget::led};
 }
 
 /**
  * \brief lwIP's MQTT request callback
  *
- * \param [in] argument is a argument which was passed to mqtt_publish(), must be MqttClient!
+ * \param [in] argument is a argument which was passed to mqtt_publish() or mqtt_subscribe(), must be the key of trace
+ * of published message (returned by startPublishTrace()) or nullptr!
  * \param [in] error is the result of MQTT request
  */
 
-void mqttRequestCallback(void*, const err_t error)
+void mqttRequestCallback(void* const argument, const err_t error)
 {
 	fiprintf(standardOutputStream, "mqttRequestCallback: error = %d\r\n", error);
+	recordMqttRequest(error);
+	recordPublishAck(argument, error);
+}
+
+/**
+ * \brief Publishes state of all LEDs as retained message of LEDS_TOPIC, if needed.
+ *
+ * Retained message of LEDS_TOPIC is the only retained state of LEDs. Once LEDs are changed by a message which doesn't
+ * set all of them (on topic of separate LED or on LEDS_TOPIC with some bits of mask cleared), their state is published
+ * in LEDS_TOPIC and retained messages on topics of changed LEDs are cleared (replaced with empty retained messages), so
+ * a stale message of separate LED cannot overwrite newer state after reconnection. The order in which retained messages
+ * are delivered after subscription doesn't matter - the message published here is received after them.
+ *
+ * If publishing fails, it is retried in next call.
+ *
+ * \param [in] client is a reference to MQTT client
+ */
+
+void publishLedsState(mqtt_client_t& client)
+{
+	LOCK_TCPIP_CORE();
+	const auto unlockScopeGuard = estd::makeScopeGuard([]()
+			{
+				UNLOCK_TCPIP_CORE();
+			});
+
+	while (ledsChangedSeparately != 0)
+	{
+		static_assert(std::size(distortos::board::leds) < 10);
+		const auto i = __builtin_ctz(ledsChangedSeparately);
+		char topic[std::size(LEDS_TOPIC_PREFIX "/?" LEDS_TOPIC_SUFFIX)];
+		{
+			const auto ret = sniprintf(topic, std::size(topic), LEDS_TOPIC_PREFIX "/%d" LEDS_TOPIC_SUFFIX, i);
+			assert(ret > 0 && static_cast<size_t>(ret) < std::size(topic));
+		}
+
+		const auto ret = mqtt_publish(&client, topic, "", 0, {}, 1, mqttRequestCallback, {});
+		recordMqttPublish(ret);
+		if (ret != ERR_OK)
+		{
+			if (ret != ERR_MEM)	// output buffer of MQTT client is full, try again later
+				fiprintf(standardOutputStream, "publishLedsState: mqtt_publish() failed, ret = %d\r\n", ret);
+			return;
+		}
+
+		ledsChangedSeparately &= ~(UINT32_C(1) << i);
+	}
+
+	if (ledsStatePending == false)
+		return;
+
+	uint32_t values {};
+	for (size_t i {}; i < std::size(distortos::board::leds); ++i)
+		if (distortos::board::leds[i].get() == true)
+			values |= UINT32_C(1) << i;
+
+	char payload[LEDS_PAYLOAD_MAX_LENGTH + 1];
+	const auto length = sniprintf(payload, std::size(payload), "%" PRIx32 ":%" PRIx32, allLedsMask, values);
+	assert(length > 0 && static_cast<size_t>(length) < std::size(payload));
+	const auto ret = mqtt_publish(&client, LEDS_TOPIC, payload, length, {}, 1, mqttRequestCallback, {});
+	recordMqttPublish(ret);
+	if (ret != ERR_OK)
+	{
+		if (ret != ERR_MEM)	// output buffer of MQTT client is full, try again later
+			fiprintf(standardOutputStream, "publishLedsState: mqtt_publish() failed, ret = %d\r\n", ret);
+		return;
+	}
+
+	ledsStatePending = {};
+}
+
+/**
+ * \brief Publishes statistics.
+ *
+ * Single call publishes at most one entry of statistics, so the main loop of the application is not blocked and output
+ * buffer of MQTT client is not overflowed. New round of publishing all entries of all sources is started every
+ * statisticsPeriod. Statistics are published without request callback, so they don't flood the debug output. If
+ * TCPIP_CORE_LOCK_PROFILER is enabled, full statistics of lwIP core mutex are also printed at the end of each round.
+ *
+ * \param [in] mqttClient is a reference to MqttClient used for publishing
+ * \param [in,out] statisticsPublisher is a reference to state of publishing
+ */
+
+void publishStatistics(MqttClient& mqttClient, StatisticsPublisher& statisticsPublisher)
+{
+	const auto now = distortos::TickClock::now();
+	if (now < statisticsPublisher.nextRound)
+		return;
+
+	while (statisticsPublisher.source < std::size(statisticsSources) &&
+			statisticsPublisher.entry >= statisticsSources[statisticsPublisher.source]->getCount())
+	{
+		++statisticsPublisher.source;
+		statisticsPublisher.entry = {};
+	}
+
+	if (statisticsPublisher.source >= std::size(statisticsSources))	// round finished?
+	{
+#if TCPIP_CORE_LOCK_PROFILER == 1
+		printTcpipCoreLockStatistics();
+#endif	// TCPIP_CORE_LOCK_PROFILER == 1
+		statisticsPublisher = {now + statisticsPeriod};
+		return;
+	}
+
+	constexpr size_t prefixLength {std::size(STATISTICS_TOPIC_PREFIX) - 1};
+	char topic[128] {STATISTICS_TOPIC_PREFIX};
+	char payload[128];
+	const auto payloadLength = statisticsSources[statisticsPublisher.source]->format(statisticsPublisher.entry,
+			topic + prefixLength, std::size(topic) - prefixLength, payload, std::size(payload));
+	if (payloadLength < 0)
+	{
+		fiprintf(standardOutputStream, "publishStatistics: could not format entry %zu of source %zu, ignoring\r\n",
+				statisticsPublisher.entry, statisticsPublisher.source);
+		++statisticsPublisher.entry;
+		return;
+	}
+
+	LOCK_TCPIP_CORE();
+	const auto ret = mqtt_publish(mqttClient.client, topic, payload, payloadLength, {}, {}, {}, {});
+	recordMqttPublish(ret);
+	UNLOCK_TCPIP_CORE();
+	if (ret == ERR_MEM)	// output buffer of MQTT client is full, try again later
+		return;
+	if (ret != ERR_OK)
+		fiprintf(standardOutputStream, "publishStatistics: mqtt_publish() failed, ret = %d\r\n", ret);
+
+	++statisticsPublisher.entry;
 }
 
 /**
@@ -214,6 +743,15 @@ void netifLinkCallback(netif* const netif)
 {
 	fiprintf(standardOutputStream, "netifLinkCallback: netif = %c%c%" PRIu8 ", link = %s\r\n",
 			netif->name[0], netif->name[1], netif->num, netif_is_link_up(netif) != 0 ? "up" : "down");
+
+	if (netif_is_link_up(netif) == 0)
+		return;
+
+	recordBootMilestone(BootMilestone::phyLink);
+
+#if FAST_BOOT == 1 && FAST_BOOT_PROBE == 1
+	startCachedAddressProbe(*netif);
+#endif	// FAST_BOOT == 1 && FAST_BOOT_PROBE == 1
 }
 
 /**
@@ -233,6 +771,10 @@ void netifStatusCallback(netif* const netif)
 	if (linkUp == false || statusUp == false)
 		return;
 
+#if FAST_BOOT == 1
+	restoreCachedGatewayAddress(*netif);
+#endif	// FAST_BOOT == 1
+
 	char buffer[IP4ADDR_STRLEN_MAX];
 	fiprintf(standardOutputStream, "  ip4 = %s\r\n",
 			ip4addr_ntoa_r(netif_ip4_addr(netif), buffer, sizeof(buffer)));
@@ -240,8 +782,26 @@ void netifStatusCallback(netif* const netif)
 			ip4addr_ntoa_r(netif_ip4_gw(netif), buffer, sizeof(buffer)));
 	fiprintf(standardOutputStream, "  netmask = %s\r\n",
 			ip4addr_ntoa_r(netif_ip4_netmask(netif), buffer, sizeof(buffer)));
+
+	if (ip4_addr_isany_val(*netif_ip4_addr(netif)) != 0)
+		return;
+
+	recordBootMilestone(BootMilestone::dhcpBound);
+	addressAssignedSemaphore.post();
+}
+
+/**
+ * \brief Initialization callback of tcpip thread
+ *
+ * Called in tcpip thread, registers it for accounting of CPU usage.
+ */
+
+void tcpipInitializationCallback(void*)
+{
+	registerCpuUsageThread(CpuUsageThread::tcpip);
 }
 
+
 }	// namespace
 
 /*---------------------------------------------------------------------------------------------------------------------+
@@ -257,12 +817,23 @@ void netifStatusCallback(netif* const netif)
 int main()
 {
 	distortos::board::initializeStreams();
+	recordBootMilestone(BootMilestone::streamsUp);
 
 	fiprintf(standardOutputStream, "Started %s board\r\n", DISTORTOS_BOARD);
 
-	tcpip_init({}, {});
+	startCpuUsageSampling();
+	registerCpuUsageThread(CpuUsageThread::main);
+
+#if TELEMETRY == 1
+	startTelemetry();
+#endif	// TELEMETRY == 1
+
+	tcpip_init(tcpipInitializationCallback, {});
 
 	netif networkInterface {};
+	ip_addr_t ip;
+	size_t broker {};
+	bool cached {};
 
 	{
 		LOCK_TCPIP_CORE();
@@ -287,35 +858,43 @@ int main()
 			const auto ret = dhcp_start(&networkInterface);
 			assert(ret == ERR_OK);
 		}
-	}
 
-	ip_addr_t ip;
-	{
-		int ret;
-		struct addrinfo* addressInformation;
-		while (ret = lwip_getaddrinfo("broker.hivemq.com", nullptr, nullptr, &addressInformation), ret != 0)
-		{
-			fiprintf(standardOutputStream, "lwip_getaddrinfo() failed, ret = %d\r\n", ret);
-			distortos::ThisThread::sleepFor(std::chrono::seconds{5});
-		}
+#if LWIPERF == 1
+		setIperfServerEnabled(true);
+#endif	// LWIPERF == 1
 
-		assert(addressInformation != nullptr && addressInformation->ai_family == AF_INET);
-		assert(addressInformation->ai_addr != nullptr && addressInformation->ai_addr->sa_family == AF_INET);
-		const auto internetAddress = reinterpret_cast<const sockaddr_in*>(addressInformation->ai_addr);
-		inet_addr_to_ip4addr(&ip, &internetAddress->sin_addr);
-		char buffer[IP4ADDR_STRLEN_MAX];
-		fiprintf(standardOutputStream, "%s is %s\r\n", addressInformation->ai_canonname,
-				ip4addr_ntoa_r(&ip, buffer, sizeof(buffer)));
+#if PROMETHEUS_METRICS == 1
+		startMetricsServer(metricsSources, std::size(metricsSources));
+#endif	// PROMETHEUS_METRICS == 1
+
+#if UDP_ECHO == 1
+		startUdpEcho();
+#endif	// UDP_ECHO == 1
 
-		lwip_freeaddrinfo(addressInformation);
+#if PACKET_CAPTURE == 1
+		startPacketCaptureServer();
+#endif	// PACKET_CAPTURE == 1
+
+#if PTP_TIMESTAMPS == 1
+		startPtpSlave(networkInterface);
+#endif	// PTP_TIMESTAMPS == 1
+
+#if FAST_BOOT == 1
+		cached = startDhcpWithCachedLease(networkInterface) == true && getCachedBrokerAddress(ip, broker) == true &&
+				broker < std::size(brokerEndpoints);
+#endif	// FAST_BOOT == 1
 	}
 
 	MqttClient mqttClient {};
 
+#if STATIC_ALLOCATION == 1
+	mqttClient.client = &staticMqttClient;
+#else	// STATIC_ALLOCATION != 1
 	LOCK_TCPIP_CORE();
 	mqttClient.client = mqtt_client_new();
 	assert(mqttClient.client != nullptr);
 	UNLOCK_TCPIP_CORE();
+#endif	// STATIC_ALLOCATION != 1
 
 	char clientId[sizeof(DISTORTOS_BOARD "-123456781234567812345678")];
 	{
@@ -336,48 +915,106 @@ int main()
 	mqttClient.connectionInfo.will_qos = {};
 	mqttClient.connectionInfo.will_retain = {};
 #if LWIP_ALTCP && LWIP_ALTCP_TLS
-	mqttClient.connectionInfo.tls_config = {};
+	LOCK_TCPIP_CORE();
+	mqttClient.connectionInfo.tls_config = createMqttTlsConfiguration();
+	UNLOCK_TCPIP_CORE();
 #endif
 
+	// wait for DHCP (or cached lease) - PHY auto-negotiation, DHCP and setup of MQTT client above run concurrently
+	{
+		const auto ret = addressAssignedSemaphore.wait();
+		assert(ret == 0);
+	}
+
+	if (cached == true)
+	{
+		char buffer[IP4ADDR_STRLEN_MAX];
+		fiprintf(standardOutputStream, "Using cached address of %s: %s\r\n", brokerEndpoints[broker].hostName,
+				ip4addr_ntoa_r(&ip, buffer, sizeof(buffer)));
+		setCachedBrokerAddress(broker, ip);
+	}
+
+	startBrokerResolver(brokerEndpoints, std::size(brokerEndpoints));
+
+#if STATIC_ALLOCATION == 1 && TLSF_MALLOC == 1
+	// initialization is finished, from now on all allocations from the heap are counted
+	sealHeap();
+#endif	// STATIC_ALLOCATION == 1 && TLSF_MALLOC == 1
+
 	while (1)
 	{
+		// cached addresses are used, so this doesn't block once any broker was resolved
+		broker = selectBroker(ip);
+		recordBootMilestone(BootMilestone::dnsResolved);
+
 		mqttClient.connecting = true;
 
+		const auto connectionStart = distortos::TickClock::now();
 		{
 			LOCK_TCPIP_CORE();
-			const auto ret = mqtt_client_connect(mqttClient.client, &ip, MQTT_PORT, mqttClientConnectionCallback,
-					&mqttClient, &mqttClient.connectionInfo);
+			const auto ret = mqtt_client_connect(mqttClient.client, &ip, brokerEndpoints[broker].port,
+					mqttClientConnectionCallback, &mqttClient, &mqttClient.connectionInfo);
+#if MQTT_TLS == 1
+			// handshake starts when TCP connection is established, so there's still time to offer cached session
+			if (ret == ERR_OK)
+				prepareMqttTlsConnection(*mqttClient.client->conn, brokerEndpoints[broker].hostName, broker);
+#endif	// MQTT_TLS == 1
 			UNLOCK_TCPIP_CORE();
 			if (ret != ERR_OK)
 			{
 				fiprintf(standardOutputStream, "mqtt_client_connect() failed, ret = %d\r\n", ret);
-				distortos::ThisThread::sleepFor(std::chrono::seconds{5});
+				reportBrokerConnection(broker, false, {});
+				distortos::ThisThread::sleepFor(retryDelay);
 				continue;
 			}
 		}
 
-		while (mqttClient.connecting == true)
+		fiprintf(standardOutputStream, "Connecting to MQTT broker %s...\r\n", brokerEndpoints[broker].hostName);
 		{
-			fiprintf(standardOutputStream, "Connecting to MQTT broker...\r\n");
-			distortos::ThisThread::sleepFor(std::chrono::seconds{5});
+			// lwIP's MQTT client always calls the callback, either with result or after timeout
+			const auto ret = mqttClient.connectedSemaphore.wait();
+			assert(ret == 0);
 		}
 
-		LedMessage ledMessage {};
+		{
+			const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(distortos::TickClock::now() -
+					connectionStart).count();
+			reportBrokerConnection(broker, mqttClient.status == MQTT_CONNECT_ACCEPTED, latency);
+		}
+
+#if MQTT_TLS == 1
+		if (mqttClient.status == MQTT_CONNECT_ACCEPTED)
+		{
+			LOCK_TCPIP_CORE();
+			if (mqttClient.client->conn != nullptr)	// connection could have been closed in the meantime
+				saveMqttTlsSession(*mqttClient.client->conn, broker);
+			UNLOCK_TCPIP_CORE();
+		}
+#endif	// MQTT_TLS == 1
+
+		IncomingMessage incomingMessage {};
 		LOCK_TCPIP_CORE();
-		mqtt_set_inpub_callback(mqttClient.client, mqttIncomingPublishCallback, mqttIncomingDataCallback, &ledMessage);
+		mqtt_set_inpub_callback(mqttClient.client, mqttIncomingPublishCallback, mqttIncomingDataCallback,
+				&incomingMessage);
 		UNLOCK_TCPIP_CORE();
 
 		bool onlinePublished = {};
-		bool subscribed = {};
+		size_t subscribed = {};
 		bool buttonStates[DISTORTOS_BOARD_BUTTONS_COUNT] {};
 		bool buttonsPublished = {};
+		StatisticsPublisher statisticsPublisher {};
+#if TELEMETRY == 1
+		// values published before reconnection could have been lost, so all of them are published again
+		resetTelemetry();
+#endif	// TELEMETRY == 1
 		while (mqttClient.status == MQTT_CONNECT_ACCEPTED)
 		{
 			if (onlinePublished == false)
 			{
 				LOCK_TCPIP_CORE();
 				const auto ret = mqtt_publish(mqttClient.client, ONLINE_TOPIC, ONLINE_MESSAGE, strlen(ONLINE_MESSAGE),
-						{}, {}, mqttRequestCallback, &mqttClient);
+						{}, {}, mqttRequestCallback, {});
+				recordMqttPublish(ret);
 				UNLOCK_TCPIP_CORE();
 				if (ret != ERR_OK)
 				{
@@ -386,13 +1023,20 @@ int main()
 				}
 
 				onlinePublished = true;
+				recordFirstPublish(cached);
+
+#if FAST_BOOT == 1
+				LOCK_TCPIP_CORE();
+				revalidateBootCache(networkInterface, brokerEndpoints[broker].hostName, broker, ip);
+				UNLOCK_TCPIP_CORE();
+#endif	// FAST_BOOT == 1
 			}
 
-			if (subscribed == false)
+			if (subscribed < std::size(subscribedTopics))
 			{
 				LOCK_TCPIP_CORE();
-				const auto ret = mqtt_subscribe(mqttClient.client, LEDS_TOPIC_PREFIX "/+" LEDS_TOPIC_SUFFIX, {},
-						mqttRequestCallback, &mqttClient);
+				const auto ret = mqtt_subscribe(mqttClient.client, subscribedTopics[subscribed], {},
+						mqttRequestCallback, {});
 				UNLOCK_TCPIP_CORE();
 				if (ret != ERR_OK)
 				{
@@ -400,13 +1044,14 @@ int main()
 					continue;
 				}
 
-				subscribed = true;
+				++subscribed;
 			}
 
 			bool publishFailed = {};
 			for (size_t i {}; i < std::size(distortos::board::buttons) && publishFailed == false; ++i)
 			{
 				const auto state = distortos::board::buttons[i].get();
+				const auto sampled = getCycleCount();
 				if (buttonStates[i] != state || buttonsPublished == false)
 				{
 					static_assert(std::size(distortos::board::buttons) < 10);
@@ -418,8 +1063,12 @@ int main()
 					}
 					const auto message = state == false ? '0' : '1';
 					LOCK_TCPIP_CORE();
-					const auto ret = mqtt_publish(mqttClient.client, topic, &message, 1, {}, {}, mqttRequestCallback,
-							&mqttClient);
+					const auto trace = startPublishTrace(sampled);
+					const auto ret = mqtt_publish(mqttClient.client, topic, &message, 1, BUTTONS_QOS, {},
+							mqttRequestCallback, trace);
+					if (ret != ERR_OK)
+						cancelPublishTrace(trace);
+					recordMqttPublish(ret);
 					UNLOCK_TCPIP_CORE();
 					if (ret != ERR_OK)
 					{
@@ -437,11 +1086,20 @@ int main()
 
 			buttonsPublished = true;
 
+#if TELEMETRY == 1
+			publishTelemetry(*mqttClient.client);
+#endif	// TELEMETRY == 1
+
+			publishLedsState(*mqttClient.client);
+			publishStatistics(mqttClient, statisticsPublisher);
+
 			distortos::ThisThread::sleepFor(std::chrono::milliseconds{50});
 		}
 
 		LOCK_TCPIP_CORE();
 		mqtt_disconnect(mqttClient.client);
 		UNLOCK_TCPIP_CORE();
+
+		distortos::ThisThread::sleepFor(retryDelay);
 	}
 }
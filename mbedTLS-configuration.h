@@ -0,0 +1,136 @@
+/**
+ * \file
+ * \brief mbedTLS configuration
+ *
+ * Minimal configuration of mbedTLS 2.x for TLS 1.2 client with ECDHE key exchange, AES-GCM, session resumption (with
+ * session IDs and session tickets) and all memory allocated from a static arena. This file is used when building the
+ * application with `MQTT_TLS` option and also by host benchmarks (`MBEDTLS_CONFIGURATION_BENCHMARK` is defined then),
+ * which additionally need the server side and generation of certificates.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef MBEDTLS_CONFIGURATION_H_
+#define MBEDTLS_CONFIGURATION_H_
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| system support
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * MBEDTLS_PLATFORM_C & MBEDTLS_PLATFORM_MEMORY: allow replacing calloc() and free() at runtime, used by the static
+ * arena (MBEDTLS_MEMORY_BUFFER_ALLOC_C) and by host benchmarks which track memory of client and server separately.
+ */
+
+#define MBEDTLS_PLATFORM_C
+#define MBEDTLS_PLATFORM_MEMORY
+
+/**
+ * MBEDTLS_MEMORY_BUFFER_ALLOC_C: allocator which uses a static buffer, MBEDTLS_MEMORY_DEBUG enables its statistics
+ * (current and peak usage).
+ */
+
+#define MBEDTLS_MEMORY_BUFFER_ALLOC_C
+#define MBEDTLS_MEMORY_DEBUG
+
+#ifdef __arm__
+
+/**
+ * MBEDTLS_NO_PLATFORM_ENTROPY & MBEDTLS_ENTROPY_HARDWARE_ALT: there's no /dev/urandom, mbedtls_hardware_poll() uses
+ * chip's RNG instead.
+ */
+
+#define MBEDTLS_NO_PLATFORM_ENTROPY
+#define MBEDTLS_ENTROPY_HARDWARE_ALT
+
+#else	/* !def __arm__ */
+
+/**
+ * MBEDTLS_HAVE_TIME & MBEDTLS_HAVE_TIME_DATE: time is available on the host, server side of benchmarks needs it for
+ * session cache and session tickets.
+ */
+
+#define MBEDTLS_HAVE_TIME
+#define MBEDTLS_HAVE_TIME_DATE
+
+#endif	/* !def __arm__ */
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| cryptographic primitives
++---------------------------------------------------------------------------------------------------------------------*/
+
+#define MBEDTLS_AES_C
+#define MBEDTLS_AES_ROM_TABLES
+#define MBEDTLS_ASN1_PARSE_C
+#define MBEDTLS_ASN1_WRITE_C
+#define MBEDTLS_BIGNUM_C
+#define MBEDTLS_CIPHER_C
+#define MBEDTLS_CTR_DRBG_C
+#define MBEDTLS_ECDH_C
+#define MBEDTLS_ECDSA_C
+#define MBEDTLS_ECP_C
+#define MBEDTLS_ECP_DP_SECP256R1_ENABLED
+#define MBEDTLS_ECP_DP_SECP384R1_ENABLED
+#define MBEDTLS_ECP_NIST_OPTIM
+#define MBEDTLS_ENTROPY_C
+#define MBEDTLS_GCM_C
+#define MBEDTLS_MD_C
+#define MBEDTLS_OID_C
+#define MBEDTLS_PKCS1_V15
+#define MBEDTLS_PKCS1_V21
+#define MBEDTLS_RSA_C
+#define MBEDTLS_SHA256_C
+#define MBEDTLS_SHA512_C
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| certificates
++---------------------------------------------------------------------------------------------------------------------*/
+
+#define MBEDTLS_BASE64_C
+#define MBEDTLS_PEM_PARSE_C
+#define MBEDTLS_PK_C
+#define MBEDTLS_PK_PARSE_C
+#define MBEDTLS_X509_CRT_PARSE_C
+#define MBEDTLS_X509_USE_C
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| TLS
++---------------------------------------------------------------------------------------------------------------------*/
+
+#define MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED
+#define MBEDTLS_KEY_EXCHANGE_ECDHE_RSA_ENABLED
+#define MBEDTLS_SSL_CLI_C
+#define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+#define MBEDTLS_SSL_PROTO_TLS1_2
+#define MBEDTLS_SSL_SERVER_NAME_INDICATION
+#define MBEDTLS_SSL_SESSION_TICKETS
+#define MBEDTLS_SSL_TLS_C
+
+/** size of input buffer, brokers usually ignore max fragment length extension, so it must fit the largest record */
+#define MBEDTLS_SSL_IN_CONTENT_LEN				16384
+
+/** size of output buffer, MQTT messages published by the application are small */
+#define MBEDTLS_SSL_OUT_CONTENT_LEN				4096
+
+#ifdef MBEDTLS_CONFIGURATION_BENCHMARK
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| additional modules used only by host benchmarks
++---------------------------------------------------------------------------------------------------------------------*/
+
+#define MBEDTLS_PK_WRITE_C
+#define MBEDTLS_SSL_CACHE_C
+#define MBEDTLS_SSL_SRV_C
+#define MBEDTLS_SSL_TICKET_C
+#define MBEDTLS_X509_CREATE_C
+#define MBEDTLS_X509_CRT_WRITE_C
+
+#endif	/* def MBEDTLS_CONFIGURATION_BENCHMARK */
+
+#include "mbedtls/check_config.h"
+
+#endif	/* MBEDTLS_CONFIGURATION_H_ */
@@ -0,0 +1,103 @@
+#
+# file: memoryBudget.cmake
+#
+# author: Copyright (C) 2026 agent agent@local
+#
+# This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+# distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Script which generates memory budget report of linked application - usage of RAM by statically allocated objects,
+# grouped into categories, and size of the heap.
+#
+# Usage: cmake -DNM=<nm> -DELF=<elf> -DOUTPUT=<report> [-DLARGEST_COUNT=<count>] -P memoryBudget.cmake
+#
+# `NM` - path to nm program
+# `ELF` - path to linked application
+# `OUTPUT` - path to generated report
+# `LARGEST_COUNT` - number of largest objects listed in the report, default - 20
+#
+
+if(NOT NM OR NOT ELF OR NOT OUTPUT)
+	message(FATAL_ERROR "NM, ELF and OUTPUT must be defined!")
+endif()
+if(NOT LARGEST_COUNT)
+	set(LARGEST_COUNT 20)
+endif()
+
+execute_process(COMMAND ${NM} --print-size --size-sort --reverse-sort --radix=d --demangle ${ELF}
+		OUTPUT_VARIABLE symbols
+		RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "${NM} failed with ${result}")
+endif()
+
+execute_process(COMMAND ${NM} --radix=d ${ELF}
+		OUTPUT_VARIABLE allSymbols
+		RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "${NM} failed with ${result}")
+endif()
+
+# categories of objects - name and regular expression matching names of objects, first matching category is used
+set(categories
+		"Ethernet DMA" "^(rxBuffers|txBuffers|dmaRxDscriptors|dmaTxDescriptors)"
+		"lwIP heap & pools" "^(ram_heap|memp_memory_|memp_)"
+		"threads & stacks" "([Tt]hread|[Ss]tack)"
+		"other" ".")
+list(LENGTH categories categoriesLength)
+math(EXPR lastCategory "${categoriesLength} / 2 - 1")
+foreach(category RANGE ${lastCategory})
+	set(categorySize${category} 0)
+endforeach()
+
+set(total 0)
+set(largest "")
+set(largestCount 0)
+string(REPLACE "\n" ";" symbols "${symbols}")
+foreach(symbol IN LISTS symbols)
+	# only objects in RAM - .bss (b, B) and .data (d, D)
+	if(NOT symbol MATCHES "^[0-9]+ ([0-9]+) [bBdD] (.+)$")
+		continue()
+	endif()
+	set(size ${CMAKE_MATCH_1})
+	set(name "${CMAKE_MATCH_2}")
+	# strip leading zeroes
+	math(EXPR size "${size}")
+
+	foreach(category RANGE ${lastCategory})
+		math(EXPR regexIndex "${category} * 2 + 1")
+		list(GET categories ${regexIndex} regex)
+		if(name MATCHES "${regex}")
+			math(EXPR categorySize${category} "${categorySize${category}} + ${size}")
+			break()
+		endif()
+	endforeach()
+	math(EXPR total "${total} + ${size}")
+
+	if(largestCount LESS LARGEST_COUNT)
+		string(APPEND largest "  ${size}\t${name}\n")
+		math(EXPR largestCount "${largestCount} + 1")
+	endif()
+endforeach()
+
+set(heapSize "unknown")
+if(allSymbols MATCHES "([0-9]+) [a-zA-Z] __heap_start\n")
+	set(heapStart ${CMAKE_MATCH_1})
+	if(allSymbols MATCHES "([0-9]+) [a-zA-Z] __heap_end\n")
+		set(heapEnd ${CMAKE_MATCH_1})
+		math(EXPR heapSize "${heapEnd} - ${heapStart}")
+	endif()
+endif()
+
+set(report "Memory budget of ${ELF}\n\nStatically allocated objects in RAM, bytes:\n")
+foreach(category RANGE ${lastCategory})
+	math(EXPR nameIndex "${category} * 2")
+	list(GET categories ${nameIndex} categoryName)
+	string(APPEND report "  ${categorySize${category}}\t${categoryName}\n")
+endforeach()
+string(APPEND report "  ${total}\ttotal\n\nHeap, bytes:\n  ${heapSize}\n\n")
+string(APPEND report "${largestCount} largest objects in RAM, bytes:\n${largest}")
+
+file(WRITE ${OUTPUT} "${report}")
+message(STATUS
+		"Memory budget: ${total} bytes of statically allocated objects, ${heapSize} bytes of heap, see ${OUTPUT}")
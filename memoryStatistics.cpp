@@ -0,0 +1,169 @@
+/**
+ * \file
+ * \brief Definitions related to statistics of lwIP's memory pools and heap
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "memoryStatistics.hpp"
+
+#include "distortos/assert.h"
+
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+#include "lwip/tcpip.h"
+
+#include <iterator>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// descriptions of metric families, series count is filled in MemoryMetricsSource::getFamily()
+const MetricFamily memoryMetricFamilies[]
+{
+		{"lwip_memory_used", "Number of used elements (pool) or bytes (heap).", "pool", {}, MetricType::gauge},
+		{"lwip_memory_max_used", "High-water mark of used elements (pool) or bytes (heap).", "pool", {},
+				MetricType::gauge},
+		{"lwip_memory_available", "Total number of elements (pool) or bytes (heap).", "pool", {}, MetricType::gauge},
+		{"lwip_memory_errors_total", "Number of failed allocations.", "pool", {}, MetricType::counter},
+};
+
+/// names of lwIP's memory pools, in the same order as in memp_t
+const char* const memoryPoolNames[]
+{
+#define LWIP_MEMPOOL(name, number, size, description)	description,
+#include "lwip/priv/memp_std.h"
+};
+
+static_assert(std::size(memoryPoolNames) == MEMP_MAX, "Number of names doesn't match number of memory pools!");
+
+/// number of lwIP's heaps with statistics
+constexpr size_t heapCount {MEM_STATS != 0 ? 1 : 0};
+
+/// number of lwIP's memory pools with statistics
+constexpr size_t memoryPoolCount {MEMP_STATS != 0 ? MEMP_MAX : 0};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+#if LWIP_STATS != 0
+
+/**
+ * \brief Converts lwIP's statistics of memory to MemoryStatistics.
+ *
+ * \param [in] name is the name of pool or heap
+ * \param [in] statistics is a reference to lwIP's statistics of memory
+ *
+ * \return \a statistics converted to MemoryStatistics
+ */
+
+MemoryStatistics makeMemoryStatistics(const char* const name, const stats_mem& statistics)
+{
+	return {name, statistics.used, statistics.max, statistics.avail, statistics.err};
+}
+
+#endif	// LWIP_STATS != 0
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| MemoryMetricsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MetricFamily MemoryMetricsSource::getFamily(const size_t index) const
+{
+	assert(index < getCount());
+
+	auto family = memoryMetricFamilies[index];
+	family.seriesCount = getMemoryStatisticsCount();
+	return family;
+}
+
+MetricSeries MemoryMetricsSource::getSeries(const size_t family, const size_t index) const
+{
+	assert(family < getCount());
+
+	const auto statistics = getMemoryStatistics(index);
+	const size_t values[]
+	{
+			statistics.used,
+			statistics.max,
+			statistics.available,
+			statistics.errors,
+	};
+	static_assert(std::size(values) == std::size(memoryMetricFamilies));
+	return makeMetricSeries(statistics.name, values[family]);
+}
+
+size_t MemoryMetricsSource::getCount() const
+{
+	return std::size(memoryMetricFamilies);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| MemoryStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int MemoryStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize, char* const payload,
+		const size_t payloadSize) const
+{
+	// statistics are updated by tcpip thread, so lwIP core is locked to copy them consistently
+	LOCK_TCPIP_CORE();
+	const auto statistics = getMemoryStatistics(index);
+	UNLOCK_TCPIP_CORE();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "memory/%s", statistics.name);
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto ret = sniprintf(payload, payloadSize, "used=%zu max=%zu available=%zu errors=%zu", statistics.used,
+			statistics.max, statistics.available, statistics.errors);
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t MemoryStatisticsSource::getCount() const
+{
+	return getMemoryStatisticsCount();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+size_t getMemoryStatisticsCount()
+{
+	return heapCount + memoryPoolCount;
+}
+
+MemoryStatistics getMemoryStatistics(size_t index)
+{
+	assert(index < getMemoryStatisticsCount());
+
+#if MEM_STATS != 0
+	if (index == 0)
+		return makeMemoryStatistics("HEAP", lwip_stats.mem);
+
+	--index;
+#endif	// MEM_STATS != 0
+
+#if MEMP_STATS != 0
+	assert(lwip_stats.memp[index] != nullptr);
+	return makeMemoryStatistics(memoryPoolNames[index], *lwip_stats.memp[index]);
+#else	// MEMP_STATS == 0
+	return {};
+#endif	// MEMP_STATS == 0
+}
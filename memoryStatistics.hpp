@@ -0,0 +1,130 @@
+/**
+ * \file
+ * \brief Declarations related to statistics of lwIP's memory pools and heap
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef MEMORYSTATISTICS_HPP_
+#define MEMORYSTATISTICS_HPP_
+
+#include "MetricsSource.hpp"
+#include "StatisticsSource.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// statistics of single lwIP memory pool or heap
+struct MemoryStatistics
+{
+	/// name of pool or heap
+	const char* name;
+
+	/// number of currently used elements (pool) or bytes (heap)
+	size_t used;
+
+	/// high-water mark of used elements (pool) or bytes (heap)
+	size_t max;
+
+	/// total number of elements (pool) or bytes (heap)
+	size_t available;
+
+	/// number of failed allocations
+	size_t errors;
+};
+
+/**
+ * \brief Source of metrics of lwIP's memory pools and heap.
+ *
+ * Families: "lwip_memory_used", "lwip_memory_max_used", "lwip_memory_available" (gauges) and "lwip_memory_errors_total"
+ * (counter), all with "pool" label. Values have the same meaning as in MemoryStatistics.
+ */
+
+class MemoryMetricsSource : public MetricsSource
+{
+public:
+
+	/**
+	 * \param [in] index is the index of family, [0; getCount())
+	 *
+	 * \return description of selected family
+	 */
+
+	MetricFamily getFamily(size_t index) const override;
+
+	/**
+	 * \param [in] family is the index of family, [0; getCount())
+	 * \param [in] index is the index of pool or heap, [0; MetricFamily::seriesCount)
+	 *
+	 * \return selected series of selected family
+	 */
+
+	MetricSeries getSeries(size_t family, size_t index) const override;
+
+	/**
+	 * \return number of metric families
+	 */
+
+	size_t getCount() const override;
+};
+
+/// source of lwIP's memory statistics, published in "stats/memory/<name>" topics
+class MemoryStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats statistics of one pool or heap.
+	 *
+	 * Payload has following format: "used=<used> max=<max> available=<available> errors=<errors>".
+	 *
+	 * \param [in] index is the index of pool or heap, [0; getCount())
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of lwIP's memory pools and heaps with statistics
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \return number of lwIP's memory pools and heaps with statistics
+ */
+
+size_t getMemoryStatisticsCount();
+
+/**
+ * \brief Gets statistics of one lwIP's memory pool or heap.
+ *
+ * Heap (if lwIP is configured to use it) is the first entry, it is followed by all memory pools, in the same order as
+ * in memp_t.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] index is the index of pool or heap, [0; getMemoryStatisticsCount())
+ *
+ * \return statistics of selected pool or heap
+ */
+
+MemoryStatistics getMemoryStatistics(size_t index);
+
+#endif	// MEMORYSTATISTICS_HPP_
@@ -0,0 +1,385 @@
+/**
+ * \file
+ * \brief Definitions related to HTTP server with metrics in Prometheus text format
+ *
+ * Metrics are served by lwIP's httpd as a custom file with dynamic read (LWIP_HTTPD_CUSTOM_FILES and
+ * LWIP_HTTPD_DYNAMIC_FILE_READ). The response is never rendered as a whole - each call of fs_read_custom() renders
+ * only as many lines as fit in httpd's send buffer (limited to TCP_MSS with HTTPD_MAX_WRITE_LEN()), so the only
+ * additional memory is a small state of rendering with a single line of text. The response uses HTTP/1.0 without
+ * "Content-Length" header, so its end is marked by closing the connection, which is done by httpd when
+ * fs_read_custom() returns FS_READ_EOF. All functions are executed in tcpip thread, so metrics are read with lwIP core
+ * locked.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "metricsServer.hpp"
+
+#include "MetricsSource.hpp"
+
+#include "distortos/assert.h"
+
+#include "lwip/apps/fs.h"
+#include "lwip/apps/httpd.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// step of rendering of metrics
+enum class RenderStep : uint8_t
+{
+	/// HTTP header
+	header,
+	/// "# HELP" line of family
+	help,
+	/// "# TYPE" line of family
+	type,
+	/// series of family
+	series,
+};
+
+/// state of rendering of metrics for one HTTP connection
+struct MetricsRenderer
+{
+	/// currently rendered series, buckets of histogram are cumulative
+	MetricSeries series;
+
+	/// currently rendered family
+	MetricFamily family;
+
+	/// rendered line of text
+	char line[160];
+
+	/// index of current source in metricsSources
+	size_t source;
+
+	/// index of current family of current source
+	size_t familyIndex;
+
+	/// index of current series of current family
+	size_t seriesIndex;
+
+	/// length of rendered line
+	size_t lineLength;
+
+	/// number of characters of rendered line which were already passed to httpd
+	size_t lineOffset;
+
+	/// index of line of current series, histograms are rendered in multiple lines
+	uint8_t seriesLine;
+
+	/// current step of rendering
+	RenderStep step;
+
+	/// true if renderer is used by a connection, false otherwise
+	bool used;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// HTTP header of response with metrics
+constexpr char httpHeader[]
+{
+		"HTTP/1.0 200 OK\r\n"
+		"Content-Type: text/plain; version=0.0.4\r\n"
+		"Connection: close\r\n"
+		"\r\n"
+};
+
+/// path at which metrics are served
+constexpr char metricsPath[] {"/metrics"};
+
+/// names of types of metric families, in the same order as in MetricType
+const char* const metricTypeNames[]
+{
+		"counter",
+		"gauge",
+		"histogram",
+};
+
+/// states of rendering, their number limits the number of concurrent requests for metrics
+MetricsRenderer metricsRenderers[2];
+
+/// array with pointers to all sources of metrics
+const MetricsSource* const* metricsSources;
+
+/// number of elements in metricsSources
+size_t metricsSourcesCount;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Formats unsigned integer.
+ *
+ * newlib's integer-only printf() functions may not support 64-bit integers, so the conversion is done manually.
+ *
+ * \param [in] value is the formatted value
+ * \param [out] buffer is a buffer for formatted value, its size must be at least 21 bytes
+ * \param [in] size is the size of \a buffer, bytes
+ *
+ * \return pointer to formatted value in \a buffer
+ */
+
+const char* formatUnsigned(uint64_t value, char* const buffer, const size_t size)
+{
+	assert(size >= 21);
+
+	auto pointer = buffer + size;
+	*--pointer = '\0';
+	do
+	{
+		*--pointer = '0' + value % 10;
+		value /= 10;
+	} while (value != 0);
+
+	return pointer;
+}
+
+/**
+ * \brief Formats one sample of metric.
+ *
+ * \param [out] buffer is a buffer for formatted sample
+ * \param [in] size is the size of \a buffer, bytes
+ * \param [in] family is a reference to family of sample
+ * \param [in] suffix is the suffix appended to name of family (e.g. "_bucket"), empty string if not used
+ * \param [in] labelValue is the value of label, ignored if family has no label
+ * \param [in] le is the upper bound of bucket of histogram, nullptr if not used
+ * \param [in] value is the value of sample
+ *
+ * \return length of formatted sample (without terminating null character) on success, negative value or value greater
+ * or equal to \a size if the sample did not fit in \a buffer
+ */
+
+int formatSample(char* const buffer, const size_t size, const MetricFamily& family, const char* const suffix,
+		const char* const labelValue, const char* const le, const uint64_t value)
+{
+	char labels[64] {};
+	size_t labelsLength {};
+	if (family.label != nullptr)
+	{
+		const auto ret = sniprintf(labels, sizeof(labels), "%s=\"%s\"", family.label, labelValue);
+		if (ret < 0 || static_cast<size_t>(ret) >= sizeof(labels))
+			return -1;
+		labelsLength = ret;
+	}
+	if (le != nullptr)
+	{
+		const auto ret = sniprintf(labels + labelsLength, sizeof(labels) - labelsLength, "%sle=\"%s\"",
+				labelsLength != 0 ? "," : "", le);
+		if (ret < 0 || static_cast<size_t>(ret) >= sizeof(labels) - labelsLength)
+			return -1;
+		labelsLength += ret;
+	}
+
+	char valueBuffer[21];
+	const auto formattedValue = formatUnsigned(value, valueBuffer, sizeof(valueBuffer));
+	if (labelsLength == 0)
+		return sniprintf(buffer, size, "%s%s %s\n", family.name, suffix, formattedValue);
+
+	return sniprintf(buffer, size, "%s%s{%s} %s\n", family.name, suffix, labels, formattedValue);
+}
+
+/**
+ * \brief Renders next line of current series.
+ *
+ * Counters and gauges are rendered in a single line. Histograms are rendered in multiple lines - all buckets (the last
+ * one with "+Inf" upper bound), sum and count.
+ *
+ * \param [in,out] renderer is a reference to state of rendering
+ *
+ * \return length of rendered line (without terminating null character) on success, negative value or value greater or
+ * equal to the size of MetricsRenderer::line if the line did not fit
+ */
+
+int renderSeriesLine(MetricsRenderer& renderer)
+{
+	const auto& family = renderer.family;
+	const auto& series = renderer.series;
+	if (family.type != MetricType::histogram)
+	{
+		++renderer.seriesIndex;
+		return formatSample(renderer.line, sizeof(renderer.line), family, "", series.labelValue, {}, series.value);
+	}
+
+	const size_t line {renderer.seriesLine++};
+	const size_t bucketCount {series.bucketCount};
+	if (line < bucketCount)
+	{
+		// bucket i of Log2Histogram counts values in [2^(i - 1); 2^i) range, values are integers
+		char leBuffer[21];
+		const auto le = line + 1 < bucketCount ?
+				formatUnsigned((uint64_t{1} << line) - 1, leBuffer, sizeof(leBuffer)) : "+Inf";
+		return formatSample(renderer.line, sizeof(renderer.line), family, "_bucket", series.labelValue, le,
+				series.buckets[line]);
+	}
+	if (line == bucketCount)
+		return formatSample(renderer.line, sizeof(renderer.line), family, "_sum", series.labelValue, {},
+				series.value);
+
+	renderer.seriesLine = {};
+	++renderer.seriesIndex;
+	return formatSample(renderer.line, sizeof(renderer.line), family, "_count", series.labelValue, {},
+			series.buckets[bucketCount - 1]);
+}
+
+/**
+ * \brief Renders next line of response.
+ *
+ * Lines which don't fit in MetricsRenderer::line are skipped.
+ *
+ * \param [in,out] renderer is a reference to state of rendering
+ *
+ * \return length of rendered line (without terminating null character), 0 if there are no more lines
+ */
+
+size_t renderLine(MetricsRenderer& renderer)
+{
+	while (1)
+	{
+		int ret;
+		if (renderer.step == RenderStep::header)
+		{
+			ret = sniprintf(renderer.line, sizeof(renderer.line), "%s", httpHeader);
+			renderer.step = RenderStep::help;
+		}
+		else if (renderer.step == RenderStep::help)
+		{
+			while (renderer.source < metricsSourcesCount &&
+					renderer.familyIndex >= metricsSources[renderer.source]->getCount())
+			{
+				++renderer.source;
+				renderer.familyIndex = {};
+			}
+
+			if (renderer.source >= metricsSourcesCount)
+				return 0;
+
+			renderer.family = metricsSources[renderer.source]->getFamily(renderer.familyIndex);
+			renderer.seriesIndex = {};
+			renderer.seriesLine = {};
+			ret = sniprintf(renderer.line, sizeof(renderer.line), "# HELP %s %s\n", renderer.family.name,
+					renderer.family.help);
+			renderer.step = RenderStep::type;
+		}
+		else if (renderer.step == RenderStep::type)
+		{
+			ret = sniprintf(renderer.line, sizeof(renderer.line), "# TYPE %s %s\n", renderer.family.name,
+					metricTypeNames[static_cast<size_t>(renderer.family.type)]);
+			renderer.step = RenderStep::series;
+		}
+		else
+		{
+			if (renderer.seriesIndex >= renderer.family.seriesCount)
+			{
+				++renderer.familyIndex;
+				renderer.step = RenderStep::help;
+				continue;
+			}
+
+			if (renderer.seriesLine == 0)
+			{
+				auto& series = renderer.series;
+				series = metricsSources[renderer.source]->getSeries(renderer.familyIndex, renderer.seriesIndex);
+				assert(renderer.family.type != MetricType::histogram || series.bucketCount != 0);
+				for (size_t i {1}; i < series.bucketCount; ++i)
+					series.buckets[i] += series.buckets[i - 1];
+			}
+
+			ret = renderSeriesLine(renderer);
+		}
+
+		if (ret > 0 && static_cast<size_t>(ret) < sizeof(renderer.line))
+			return ret;
+	}
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void fs_close_custom(fs_file* const file)
+{
+	static_cast<MetricsRenderer*>(file->pextension)->used = {};
+}
+
+int fs_open_custom(fs_file* const file, const char* const name)
+{
+	if (strcmp(name, metricsPath) != 0)
+		return 0;
+
+	const auto renderer = std::find_if(std::begin(metricsRenderers), std::end(metricsRenderers),
+			[](const MetricsRenderer& renderer)
+			{
+				return renderer.used == false;
+			});
+	if (renderer == std::end(metricsRenderers))	// all renderers are busy, httpd will respond with 404
+		return 0;
+
+	*renderer = {};
+	renderer->used = true;
+
+	*file = {};
+	// length of response is not known, its end is signalled by fs_read_custom()
+	file->len = INT_MAX;
+	file->pextension = renderer;
+	file->flags = FS_FILE_FLAGS_HEADER_INCLUDED;
+	return 1;
+}
+
+int fs_read_custom(fs_file* const file, char* const buffer, const int count)
+{
+	auto& renderer = *static_cast<MetricsRenderer*>(file->pextension);
+
+	size_t length {};
+	while (length < static_cast<size_t>(count))
+	{
+		if (renderer.lineOffset == renderer.lineLength)
+		{
+			renderer.lineLength = renderLine(renderer);
+			renderer.lineOffset = {};
+			if (renderer.lineLength == 0)
+				break;
+		}
+
+		const auto chunk = std::min(count - length, renderer.lineLength - renderer.lineOffset);
+		memcpy(buffer + length, renderer.line + renderer.lineOffset, chunk);
+		renderer.lineOffset += chunk;
+		length += chunk;
+	}
+
+	if (length == 0)
+		return FS_READ_EOF;
+
+	file->index += length;
+	return length;
+}
+
+void startMetricsServer(const MetricsSource* const* const sources, const size_t count)
+{
+	assert(metricsSources == nullptr);
+
+	metricsSources = sources;
+	metricsSourcesCount = count;
+	httpd_init();
+}
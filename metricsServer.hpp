@@ -0,0 +1,38 @@
+/**
+ * \file
+ * \brief Declarations related to HTTP server with metrics in Prometheus text format
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef METRICSSERVER_HPP_
+#define METRICSSERVER_HPP_
+
+#include <cstddef>
+
+class MetricsSource;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Starts HTTP server with metrics.
+ *
+ * lwIP's httpd listens on port 80 and serves metrics from all sources in Prometheus text format at "/metrics", all
+ * other paths are served from httpd's built-in file system.
+ *
+ * \warning lwIP core must be locked when this function is called. It may be called only once.
+ *
+ * \param [in] sources is an array with pointers to all sources of metrics, must remain valid while the server is
+ * running
+ * \param [in] count is the number of elements in \a sources
+ */
+
+void startMetricsServer(const MetricsSource* const* sources, size_t count);
+
+#endif	// METRICSSERVER_HPP_
@@ -0,0 +1,123 @@
+/**
+ * \file
+ * \brief Definitions related to metrics of MQTT client
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "mqttMetrics.hpp"
+
+#include "distortos/assert.h"
+
+#include <iterator>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// counters of MQTT client
+struct MqttCounters
+{
+	/// number of successful and failed calls of mqtt_publish()
+	uint32_t publishes[2];
+
+	/// number of successful and failed MQTT requests
+	uint32_t requests[2];
+
+	/// number of accepted and failed connections
+	uint32_t connections[2];
+
+	/// number of lost connections
+	uint32_t disconnections;
+
+	/// true if connected to MQTT broker, false otherwise
+	bool connected;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// descriptions of metric families
+const MetricFamily mqttMetricFamilies[]
+{
+		{"mqtt_publishes_total", "Number of calls of mqtt_publish(), by result.", "result", 2, MetricType::counter},
+		{"mqtt_requests_total", "Number of completed MQTT requests, by result.", "result", 2, MetricType::counter},
+		{"mqtt_connections_total", "Number of connections with MQTT broker, by result.", "result", 2,
+				MetricType::counter},
+		{"mqtt_disconnections_total", "Number of lost connections with MQTT broker.", {}, 1, MetricType::counter},
+		{"mqtt_connected", "1 if connected to MQTT broker, 0 otherwise.", {}, 1, MetricType::gauge},
+};
+
+/// counters of MQTT client
+MqttCounters mqttCounters;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| MqttMetricsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MetricFamily MqttMetricsSource::getFamily(const size_t index) const
+{
+	assert(index < getCount());
+
+	return mqttMetricFamilies[index];
+}
+
+MetricSeries MqttMetricsSource::getSeries(const size_t family, const size_t index) const
+{
+	assert(family < getCount() && index < mqttMetricFamilies[family].seriesCount);
+
+	if (family == 0)
+		return makeMetricSeries(index == 0 ? "ok" : "failed", mqttCounters.publishes[index]);
+	if (family == 1)
+		return makeMetricSeries(index == 0 ? "ok" : "failed", mqttCounters.requests[index]);
+	if (family == 2)
+		return makeMetricSeries(index == 0 ? "accepted" : "failed", mqttCounters.connections[index]);
+	if (family == 3)
+		return makeMetricSeries({}, mqttCounters.disconnections);
+
+	return makeMetricSeries({}, mqttCounters.connected);
+}
+
+size_t MqttMetricsSource::getCount() const
+{
+	return std::size(mqttMetricFamilies);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void recordMqttConnection(const bool accepted)
+{
+	++mqttCounters.connections[accepted == true ? 0 : 1];
+	mqttCounters.connected = accepted;
+}
+
+void recordMqttDisconnection()
+{
+	if (mqttCounters.connected == false)
+		return;
+
+	++mqttCounters.disconnections;
+	mqttCounters.connected = {};
+}
+
+void recordMqttPublish(const err_t error)
+{
+	++mqttCounters.publishes[error == ERR_OK ? 0 : 1];
+}
+
+void recordMqttRequest(const err_t error)
+{
+	++mqttCounters.requests[error == ERR_OK ? 0 : 1];
+}
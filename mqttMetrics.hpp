@@ -0,0 +1,103 @@
+/**
+ * \file
+ * \brief Declarations related to metrics of MQTT client
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef MQTTMETRICS_HPP_
+#define MQTTMETRICS_HPP_
+
+#include "MetricsSource.hpp"
+
+#include "lwip/err.h"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Source of metrics of MQTT client.
+ *
+ * Families: "mqtt_publishes_total" (counter with "result" label - "ok" or "failed" - for calls of mqtt_publish()),
+ * "mqtt_requests_total" (counter with "result" label for requests completed by the broker or timed out - publishes with
+ * request callback and subscriptions), "mqtt_connections_total" (counter with "result" label - "accepted" or "failed"),
+ * "mqtt_disconnections_total" (counter of lost connections) and "mqtt_connected" (gauge, 1 if connected, 0
+ * otherwise).
+ */
+
+class MqttMetricsSource : public MetricsSource
+{
+public:
+
+	/**
+	 * \param [in] index is the index of family, [0; getCount())
+	 *
+	 * \return description of selected family
+	 */
+
+	MetricFamily getFamily(size_t index) const override;
+
+	/**
+	 * \param [in] family is the index of family, [0; getCount())
+	 * \param [in] index is the index of series, [0; MetricFamily::seriesCount)
+	 *
+	 * \return selected series of selected family
+	 */
+
+	MetricSeries getSeries(size_t family, size_t index) const override;
+
+	/**
+	 * \return number of metric families
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Records result of connecting to MQTT broker.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] accepted selects whether connection was accepted (true) or not (false)
+ */
+
+void recordMqttConnection(bool accepted);
+
+/**
+ * \brief Records loss of connection with MQTT broker.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ */
+
+void recordMqttDisconnection();
+
+/**
+ * \brief Records result of mqtt_publish().
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] error is the value returned by mqtt_publish()
+ */
+
+void recordMqttPublish(err_t error);
+
+/**
+ * \brief Records completion of MQTT request.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] error is the result of MQTT request, passed to MQTT request callback
+ */
+
+void recordMqttRequest(err_t error);
+
+#endif	// MQTTMETRICS_HPP_
@@ -0,0 +1,249 @@
+/**
+ * \file
+ * \brief Definitions related to TLS transport of MQTT client
+ *
+ * All memory used by mbedTLS is allocated from a static arena, so TLS cannot exhaust heap used by the rest of the
+ * application and its peak usage is easy to observe. Session of the last established connection is kept in RAM and
+ * offered to the broker on reconnect - if the broker accepts it (with session ID or session ticket), the expensive part
+ * of the handshake (ECDHE key exchange and verification of certificate chain) is skipped.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "mqttTls.hpp"
+
+#include "distortos/board/standardOutputStream.h"
+
+#include "distortos/chip/CMSIS-proxy.h"
+
+#include "distortos/assert.h"
+
+#include "lwip/altcp_tls.h"
+#include "lwip/tcpip.h"
+
+#include "mbedtls/entropy.h"
+#include "mbedtls/memory_buffer_alloc.h"
+#include "mbedtls/ssl.h"
+
+#include <algorithm>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+/// CA certificate(s) in PEM format used to verify MQTT brokers, defined in generated mqttTlsCaCertificate.cpp
+extern const char mqttTlsCaCertificate[];
+
+/// size of mqttTlsCaCertificate, including terminating null character
+extern const size_t mqttTlsCaCertificateSize;
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// cached TLS session
+struct CachedSession
+{
+	/// saved session, valid only if \a valid is true
+	mbedtls_ssl_session session;
+
+	/// index of MQTT broker with which \a session was established
+	size_t broker;
+
+	/// true if \a session was offered in current connection, false otherwise
+	bool offered;
+
+	/// true if \a session is valid, false otherwise
+	bool valid;
+};
+
+/// statistics of TLS transport
+struct TlsStatistics
+{
+	/// number of successful handshakes
+	uint32_t handshakes;
+
+	/// number of handshakes in which cached session was resumed
+	uint32_t resumed;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of mbedTLS arena, bytes
+constexpr size_t arenaSize {48 * 1024};
+
+/// mbedTLS arena
+uint8_t arena[arenaSize] __attribute__ ((aligned(8)));
+
+/// cached TLS session
+CachedSession cachedSession;
+
+/// statistics of TLS transport
+TlsStatistics tlsStatistics;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| TlsStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int TlsStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize, char* const payload,
+		const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	LOCK_TCPIP_CORE();
+	const auto statistics = tlsStatistics;
+	size_t used;
+	size_t max;
+	{
+		size_t blocks;
+		mbedtls_memory_buffer_alloc_cur_get(&used, &blocks);
+		mbedtls_memory_buffer_alloc_max_get(&max, &blocks);
+	}
+	UNLOCK_TCPIP_CORE();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "tls/summary");
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto ret = sniprintf(payload, payloadSize,
+			"handshakes=%" PRIu32 " resumed=%" PRIu32 " arenaUsed=%zu arenaMax=%zu arenaSize=%zu",
+			statistics.handshakes, statistics.resumed, used, max, arenaSize);
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t TlsStatisticsSource::getCount() const
+{
+	return 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+altcp_tls_config* createMqttTlsConfiguration()
+{
+	// RNG is the source of entropy for mbedTLS
+	RCC->AHB2ENR |= RCC_AHB2ENR_RNGEN;
+	RNG->CR |= RNG_CR_RNGEN;
+
+	mbedtls_memory_buffer_alloc_init(arena, sizeof(arena));
+	mbedtls_ssl_session_init(&cachedSession.session);
+
+	assert(mqttTlsCaCertificateSize > 1);
+	const auto configuration = altcp_tls_create_config_client(reinterpret_cast<const uint8_t*>(mqttTlsCaCertificate),
+			mqttTlsCaCertificateSize);
+	assert(configuration != nullptr);
+	return configuration;
+}
+
+/**
+ * \brief Entropy source for mbedTLS.
+ *
+ * Reads random numbers from chip's RNG.
+ *
+ * \param [out] output is a buffer for random data
+ * \param [in] length is the size of \a output, bytes
+ * \param [out] outputLength is a reference to variable for number of bytes written to \a output
+ *
+ * \return 0 on success, MBEDTLS_ERR_ENTROPY_SOURCE_FAILED if RNG reported seed or clock error
+ */
+
+extern "C" int mbedtls_hardware_poll(void*, unsigned char* const output, const size_t length,
+		size_t* const outputLength)
+{
+	size_t written {};
+	while (written < length)
+	{
+		uint32_t status;
+		while (status = RNG->SR, (status & (RNG_SR_DRDY | RNG_SR_SECS | RNG_SR_CECS)) == 0);
+
+		if ((status & (RNG_SR_SECS | RNG_SR_CECS)) != 0)
+		{
+			*outputLength = written;
+			return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+		}
+
+		const uint32_t value {RNG->DR};
+		const auto chunk = std::min(length - written, sizeof(value));
+		memcpy(output + written, &value, chunk);
+		written += chunk;
+	}
+
+	*outputLength = written;
+	return 0;
+}
+
+void prepareMqttTlsConnection(altcp_pcb& connection, const char* const hostName, const size_t broker)
+{
+	const auto context = static_cast<mbedtls_ssl_context*>(altcp_tls_context(&connection));
+	assert(context != nullptr);
+
+	{
+		const auto ret = mbedtls_ssl_set_hostname(context, hostName);
+		assert(ret == 0);
+	}
+
+	cachedSession.offered = cachedSession.valid == true && cachedSession.broker == broker;
+	if (cachedSession.offered == false)
+		return;
+
+	const auto ret = mbedtls_ssl_set_session(context, &cachedSession.session);
+	if (ret != 0)
+	{
+		fiprintf(standardOutputStream, "prepareMqttTlsConnection: mbedtls_ssl_set_session() failed, ret = -0x%x\r\n",
+				-ret);
+		cachedSession.offered = {};
+	}
+}
+
+void saveMqttTlsSession(altcp_pcb& connection, const size_t broker)
+{
+	const auto context = static_cast<mbedtls_ssl_context*>(altcp_tls_context(&connection));
+	assert(context != nullptr);
+
+	mbedtls_ssl_session session;
+	mbedtls_ssl_session_init(&session);
+	{
+		const auto ret = mbedtls_ssl_get_session(context, &session);
+		if (ret != 0)
+		{
+			fiprintf(standardOutputStream, "saveMqttTlsSession: mbedtls_ssl_get_session() failed, ret = -0x%x\r\n",
+					-ret);
+			mbedtls_ssl_session_free(&session);
+			return;
+		}
+	}
+
+	// resumed session keeps master secret of the offered one, full handshake always derives a new one
+	const auto resumed = cachedSession.offered == true &&
+			memcmp(session.master, cachedSession.session.master, sizeof(session.master)) == 0;
+	++tlsStatistics.handshakes;
+	if (resumed == true)
+		++tlsStatistics.resumed;
+
+	fiprintf(standardOutputStream, "saveMqttTlsSession: %s handshake with %s\r\n", resumed == true ? "resumed" : "full",
+			mbedtls_ssl_get_ciphersuite(context));
+
+	// ownership of data allocated by session (e.g. ticket) is transferred to cached session
+	mbedtls_ssl_session_free(&cachedSession.session);
+	cachedSession.session = session;
+	cachedSession.broker = broker;
+	cachedSession.offered = {};
+	cachedSession.valid = true;
+}
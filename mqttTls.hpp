@@ -0,0 +1,105 @@
+/**
+ * \file
+ * \brief Declarations related to TLS transport of MQTT client
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef MQTTTLS_HPP_
+#define MQTTTLS_HPP_
+
+#include "StatisticsSource.hpp"
+
+struct altcp_pcb;
+struct altcp_tls_config;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Source of statistics of TLS transport.
+ *
+ * Summary is published in "stats/tls/summary" topic.
+ */
+
+class TlsStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats summary of TLS transport.
+	 *
+	 * Payload has following format: "handshakes=<handshakes> resumed=<resumed> arenaUsed=<used> arenaMax=<max>
+	 * arenaSize=<size>", where "handshakes" is the number of all successful handshakes, "resumed" is the number of
+	 * handshakes in which cached session was resumed, and the rest is the current usage, high-water mark and size of
+	 * mbedTLS arena in bytes.
+	 *
+	 * \param [in] index is the index of entry, must be 0
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return 1
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Creates TLS configuration of MQTT client.
+ *
+ * mbedTLS is switched to its static arena, then client configuration is created with CA certificate embedded during
+ * build (`MQTT_TLS_CA_CERTIFICATE`), which is required to verify MQTT brokers.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \return pointer to created TLS configuration
+ */
+
+altcp_tls_config* createMqttTlsConfiguration();
+
+/**
+ * \brief Prepares TLS connection to MQTT broker, before its handshake starts.
+ *
+ * Host name of the broker is set (for SNI and for verification of certificate). If a session with the same broker was
+ * saved earlier, it is offered to the broker, so the handshake may be abbreviated (no key exchange and no certificate
+ * verification).
+ *
+ * \warning lwIP core must be locked when this function is called. It must be called right after mqtt_client_connect().
+ *
+ * \param [in] connection is a reference to TLS connection of MQTT client
+ * \param [in] hostName is the host name of MQTT broker
+ * \param [in] broker is the index of MQTT broker
+ */
+
+void prepareMqttTlsConnection(altcp_pcb& connection, const char* hostName, size_t broker);
+
+/**
+ * \brief Saves session of established TLS connection to MQTT broker, so that it can be resumed after reconnect.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] connection is a reference to TLS connection of MQTT client, its handshake must be finished
+ * \param [in] broker is the index of MQTT broker
+ */
+
+void saveMqttTlsSession(altcp_pcb& connection, size_t broker);
+
+#endif	// MQTTTLS_HPP_
@@ -0,0 +1,52 @@
+/**
+ * \file
+ * \brief MQTT topics used by the application
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef MQTTTOPICS_HPP_
+#define MQTTTOPICS_HPP_
+
+#include "distortos/distortosVersion.h"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global defines
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// common prefix of all topics used by this application
+#define TOPIC_PREFIX	"distortos/" DISTORTOS_VERSION_STRING "/" DISTORTOS_BOARD
+
+/// MQTT "online" topic - ONLINE_MESSAGE is published when connected to MQTT broker and OFFLINE_MESSAGE as client's
+// "will" when connection is lost
+#define ONLINE_TOPIC	TOPIC_PREFIX "/online"
+
+/// topic used for publishing requested state of lwiperf server
+#define IPERF_TOPIC				TOPIC_PREFIX "/iperf/state"
+
+/// prefix for topic used for publishing requested state of LEDs
+#define LEDS_TOPIC_PREFIX		TOPIC_PREFIX "/leds"
+
+/// suffix for topic used for publishing requested state of LEDs
+#define LEDS_TOPIC_SUFFIX		"/state"
+
+/// topic used for publishing requested state of all LEDs at once - "<mask>:<values>", both hexadecimal, bit N is LED N
+#define LEDS_TOPIC				LEDS_TOPIC_PREFIX LEDS_TOPIC_SUFFIX
+
+/// prefix for topic used for publishing state of buttons
+#define BUTTONS_TOPIC_PREFIX	TOPIC_PREFIX "/buttons"
+
+/// suffix for topic used for publishing state of buttons
+#define BUTTONS_TOPIC_SUFFIX	"/state"
+
+/// prefix for topics used for publishing statistics
+#define STATISTICS_TOPIC_PREFIX	TOPIC_PREFIX "/stats/"
+
+/// prefix for topics used for publishing telemetry
+#define TELEMETRY_TOPIC_PREFIX	TOPIC_PREFIX "/telemetry/"
+
+#endif	// MQTTTOPICS_HPP_
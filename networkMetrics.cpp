@@ -0,0 +1,116 @@
+/**
+ * \file
+ * \brief Definitions related to metrics of network interface
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "networkMetrics.hpp"
+
+#include "distortos/assert.h"
+
+#include "lwip/netif.h"
+#include "lwip/stats.h"
+
+#include <iterator>
+
+namespace
+{
+
+#if LINK_STATS != 0
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// counter of lwIP's link-level statistics
+struct LinkCounter
+{
+	/// name of event, used as value of label
+	const char* event;
+
+	/// pointer to member of stats_proto with the counter
+	STAT_COUNTER stats_proto::* counter;
+};
+
+#endif	// LINK_STATS != 0
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+#if LINK_STATS != 0
+
+/// all counters of lwIP's link-level statistics
+const LinkCounter linkCounters[]
+{
+		{"xmit", &stats_proto::xmit},
+		{"recv", &stats_proto::recv},
+		{"fw", &stats_proto::fw},
+		{"drop", &stats_proto::drop},
+		{"chkerr", &stats_proto::chkerr},
+		{"lenerr", &stats_proto::lenerr},
+		{"memerr", &stats_proto::memerr},
+		{"rterr", &stats_proto::rterr},
+		{"proterr", &stats_proto::proterr},
+		{"opterr", &stats_proto::opterr},
+		{"err", &stats_proto::err},
+};
+
+/// number of counters of lwIP's link-level statistics
+constexpr size_t linkCounterCount {std::size(linkCounters)};
+
+#else	// LINK_STATS == 0
+
+/// number of counters of lwIP's link-level statistics
+constexpr size_t linkCounterCount {};
+
+#endif	// LINK_STATS == 0
+
+/// descriptions of metric families
+const MetricFamily networkMetricFamilies[]
+{
+		{"netif_up", "1 if network interface is up, 0 otherwise.", {}, 1, MetricType::gauge},
+		{"netif_link_up", "1 if network interface has link, 0 otherwise.", {}, 1, MetricType::gauge},
+		{"lwip_link_packets_total", "Number of link-level packets, by event.", "event", linkCounterCount,
+				MetricType::counter},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| NetworkMetricsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MetricFamily NetworkMetricsSource::getFamily(const size_t index) const
+{
+	assert(index < getCount());
+
+	return networkMetricFamilies[index];
+}
+
+MetricSeries NetworkMetricsSource::getSeries(const size_t family, const size_t index) const
+{
+	assert(family < getCount());
+
+	if (family == 0)
+		return makeMetricSeries({}, netif_default != nullptr && netif_is_up(netif_default) != 0);
+	if (family == 1)
+		return makeMetricSeries({}, netif_default != nullptr && netif_is_link_up(netif_default) != 0);
+
+#if LINK_STATS != 0
+	assert(index < linkCounterCount);
+	return makeMetricSeries(linkCounters[index].event, lwip_stats.link.*linkCounters[index].counter);
+#else	// LINK_STATS == 0
+	return {};
+#endif	// LINK_STATS == 0
+}
+
+size_t NetworkMetricsSource::getCount() const
+{
+	return std::size(networkMetricFamilies);
+}
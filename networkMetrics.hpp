@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \brief Declarations related to metrics of network interface
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef NETWORKMETRICS_HPP_
+#define NETWORKMETRICS_HPP_
+
+#include "MetricsSource.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Source of metrics of default network interface.
+ *
+ * Families: "netif_up" and "netif_link_up" (gauges, 1 if the interface is up or has link, 0 otherwise) and
+ * "lwip_link_packets_total" (counter with "event" label, lwIP's link-level statistics - "xmit", "recv", "drop", ...).
+ */
+
+class NetworkMetricsSource : public MetricsSource
+{
+public:
+
+	/**
+	 * \param [in] index is the index of family, [0; getCount())
+	 *
+	 * \return description of selected family
+	 */
+
+	MetricFamily getFamily(size_t index) const override;
+
+	/**
+	 * \param [in] family is the index of family, [0; getCount())
+	 * \param [in] index is the index of series, [0; MetricFamily::seriesCount)
+	 *
+	 * \return selected series of selected family
+	 */
+
+	MetricSeries getSeries(size_t family, size_t index) const override;
+
+	/**
+	 * \return number of metric families
+	 */
+
+	size_t getCount() const override;
+};
+
+#endif	// NETWORKMETRICS_HPP_
@@ -0,0 +1,397 @@
+/**
+ * \file
+ * \brief Definitions related to capture of Ethernet frames with streaming in pcap format
+ *
+ * Ethernet driver passes each received and transmitted frame straight from DMA buffers to capturePacket(), which
+ * evaluates the filter and copies at most snap length bytes of selected frames to capture ring. Records in capture ring
+ * already have the format of pcap records, so the server just sends them to the client from tcpip thread - from "sent"
+ * callback while the client keeps up and from "poll" callback (every 500 ms) otherwise. Capture ring is written by two
+ * threads and read by tcpip thread, so all accesses are done with masked interrupts - they are short, as the copy is
+ * limited by snap length. Timestamps are based on cycle counter extended to 64 bits, which is resynchronized with tick
+ * clock when there was no captured frame for more than half of cycle counter's period.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "packetCapture.hpp"
+
+#include "cycleCounter.hpp"
+#include "PacketCaptureRing.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/InterruptMaskingLock.hpp"
+#include "distortos/TickClock.hpp"
+
+#include "stm32f7xx_hal.h"
+
+#include "lwip/tcp.h"
+
+#include <algorithm>
+
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// ring buffer with captured frames
+using CaptureRing = PacketCaptureRing<16 * 1024>;
+
+/// state of packet capture
+struct PacketCapture
+{
+	/// filter which selects captured frames
+	PacketCaptureFilter filter;
+
+	/// value of tick clock at the last timestamp
+	distortos::TickClock::time_point lastTickTime;
+
+	/// number of cycles of cycle counter since the start of capture, extended to 64 bits
+	uint64_t cycles;
+
+	/// value of cycle counter at the last timestamp
+	uint32_t lastCycleCount;
+
+	/// max number of captured bytes of each frame
+	size_t snapLength;
+
+	/// number of frames written to capture ring
+	uint32_t captured;
+
+	/// number of frames rejected by the filter
+	uint32_t rejected;
+
+	/// number of frames sent to clients
+	uint32_t streamed;
+};
+
+/// state of client of packet capture server
+struct PacketCaptureClient
+{
+	/// position of next record in capture ring
+	size_t position;
+
+	/// PCB of connection with client, nullptr if there is no client
+	tcp_pcb* pcb;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// TCP port of packet capture server
+constexpr uint16_t capturePort {2002};
+
+/// interval of polling of connection with client, multiples of 500 ms
+constexpr uint8_t pollInterval {1};
+
+/// ring buffer with captured frames
+CaptureRing captureRing;
+
+/// state of packet capture, by default all frames are captured with the size of Ethernet, IPv4 and TCP headers
+PacketCapture packetCapture {{0, 0, 0, 0, static_cast<uint8_t>(PacketDirection::receive) |
+		static_cast<uint8_t>(PacketDirection::transmit)}, {}, {}, {}, 14 + 60 + 60};
+
+/// client of packet capture server
+PacketCaptureClient packetCaptureClient;
+
+/// buffer for one record read from capture ring, used only in tcpip thread
+uint8_t recordBuffer[sizeof(CaptureRing::RecordHeader) + maxPacketCaptureSnapLength];
+
+static_assert(maxPacketCaptureSnapLength <= ETH_RX_BUF_SIZE && maxPacketCaptureSnapLength <= ETH_TX_BUF_SIZE,
+		"Captured bytes of frame must fit in the first buffer of DMA descriptor!");
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Closes connection with client of packet capture server.
+ *
+ * \param [in] pcb is a pointer to PCB of connection with client
+ */
+
+void closePacketCaptureClient(tcp_pcb* const pcb)
+{
+	tcp_arg(pcb, {});
+	tcp_err(pcb, {});
+	tcp_poll(pcb, {}, {});
+	tcp_recv(pcb, {});
+	tcp_sent(pcb, {});
+	if (tcp_close(pcb) != ERR_OK)
+		tcp_abort(pcb);
+	packetCaptureClient = {};
+}
+
+/**
+ * \brief Gets timestamp of captured frame.
+ *
+ * \warning This function must be called with masked interrupts.
+ *
+ * \return timestamp of captured frame, microseconds
+ */
+
+uint64_t getPacketTimestamp()
+{
+	const auto now = distortos::TickClock::now();
+	const auto cycleCount = getCycleCount();
+	constexpr std::chrono::seconds cycleCounterHalfPeriod {(uint64_t{1} << 31) / getCycleCounterFrequency()};
+	if (now - packetCapture.lastTickTime < cycleCounterHalfPeriod)
+		packetCapture.cycles += cycleCount - packetCapture.lastCycleCount;
+	else	// cycle counter could have wrapped around more than once, resynchronize with tick clock
+		packetCapture.cycles = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count() *
+				(getCycleCounterFrequency() / 1000000);
+	packetCapture.lastTickTime = now;
+	packetCapture.lastCycleCount = cycleCount;
+	return packetCapture.cycles / (getCycleCounterFrequency() / 1000000);
+}
+
+/**
+ * \brief Sends as many records from capture ring to client as possible.
+ *
+ * \param [in] pcb is a pointer to PCB of connection with client
+ */
+
+void sendPacketCaptureRecords(tcp_pcb* const pcb)
+{
+	size_t streamed {};
+	while (1)
+	{
+		auto position = packetCaptureClient.position;
+		size_t size;
+		{
+			const distortos::InterruptMaskingLock interruptMaskingLock;
+			size = captureRing.read(position, recordBuffer, sizeof(recordBuffer));
+		}
+
+		if (size == 0 || size > tcp_sndbuf(pcb))
+			break;
+		if (tcp_write(pcb, recordBuffer, size, TCP_WRITE_FLAG_COPY) != ERR_OK)
+			break;
+
+		packetCaptureClient.position = position;
+		++streamed;
+	}
+
+	if (streamed == 0)
+		return;
+
+	tcp_output(pcb);
+
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+	packetCapture.streamed += streamed;
+}
+
+/**
+ * \brief lwIP's TCP error callback of client of packet capture server
+ *
+ * Connection is already closed, PCB is freed.
+ */
+
+void packetCaptureErrorCallback(void*, err_t)
+{
+	packetCaptureClient = {};
+}
+
+/**
+ * \brief lwIP's TCP poll callback of client of packet capture server
+ *
+ * \param [in] pcb is a pointer to PCB of connection with client
+ *
+ * \return ERR_OK
+ */
+
+err_t packetCapturePollCallback(void*, tcp_pcb* const pcb)
+{
+	sendPacketCaptureRecords(pcb);
+	return ERR_OK;
+}
+
+/**
+ * \brief lwIP's TCP receive callback of client of packet capture server
+ *
+ * All received data is ignored, connection is closed when client closes it.
+ *
+ * \param [in] pcb is a pointer to PCB of connection with client
+ * \param [in] pbuf is a pointer to received data, nullptr if client closed the connection
+ *
+ * \return ERR_OK
+ */
+
+err_t packetCaptureReceiveCallback(void*, tcp_pcb* const pcb, pbuf* const pbuf, err_t)
+{
+	if (pbuf == nullptr)
+	{
+		closePacketCaptureClient(pcb);
+		return ERR_OK;
+	}
+
+	tcp_recved(pcb, pbuf->tot_len);
+	pbuf_free(pbuf);
+	return ERR_OK;
+}
+
+/**
+ * \brief lwIP's TCP sent callback of client of packet capture server
+ *
+ * \param [in] pcb is a pointer to PCB of connection with client
+ *
+ * \return ERR_OK
+ */
+
+err_t packetCaptureSentCallback(void*, tcp_pcb* const pcb, u16_t)
+{
+	sendPacketCaptureRecords(pcb);
+	return ERR_OK;
+}
+
+/**
+ * \brief lwIP's TCP accept callback of packet capture server
+ *
+ * \param [in] pcb is a pointer to PCB of new connection
+ * \param [in] error is the result of accepting
+ *
+ * \return ERR_OK if connection was accepted, ERR_ABRT if it was aborted
+ */
+
+err_t packetCaptureAcceptCallback(void*, tcp_pcb* const pcb, const err_t error)
+{
+	if (error != ERR_OK || pcb == nullptr)
+		return ERR_VAL;
+
+	if (packetCaptureClient.pcb != nullptr)	// only one client is served at a time
+	{
+		tcp_abort(pcb);
+		return ERR_ABRT;
+	}
+
+	CaptureRing::FileHeader header {0xa1b2c3d4, 2, 4, {}, {}, {}, 1};
+	{
+		const distortos::InterruptMaskingLock interruptMaskingLock;
+		header.snapLength = packetCapture.snapLength;
+		packetCaptureClient = {captureRing.getTail(), pcb};
+	}
+
+	if (tcp_write(pcb, &header, sizeof(header), TCP_WRITE_FLAG_COPY) != ERR_OK)
+	{
+		packetCaptureClient = {};
+		tcp_abort(pcb);
+		return ERR_ABRT;
+	}
+
+	tcp_err(pcb, packetCaptureErrorCallback);
+	tcp_poll(pcb, packetCapturePollCallback, pollInterval);
+	tcp_recv(pcb, packetCaptureReceiveCallback);
+	tcp_sent(pcb, packetCaptureSentCallback);
+	sendPacketCaptureRecords(pcb);
+	tcp_output(pcb);
+	return ERR_OK;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| PacketCaptureStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int PacketCaptureStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize,
+		char* const payload, const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	uint32_t captured;
+	uint32_t rejected;
+	size_t overwritten;
+	uint32_t streamed;
+	{
+		const distortos::InterruptMaskingLock interruptMaskingLock;
+		captured = packetCapture.captured;
+		rejected = packetCapture.rejected;
+		overwritten = captureRing.getOverwrittenCount();
+		streamed = packetCapture.streamed;
+	}
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "capture");
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto ret = sniprintf(payload, payloadSize, "captured=%lu rejected=%lu overwritten=%lu streamed=%lu",
+			static_cast<unsigned long>(captured), static_cast<unsigned long>(rejected),
+			static_cast<unsigned long>(overwritten), static_cast<unsigned long>(streamed));
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t PacketCaptureStatisticsSource::getCount() const
+{
+	return 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void capturePacket(const uint8_t* const frame, const size_t length, const PacketDirection direction)
+{
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+
+	if (packetCapture.filter.matches(frame, length, direction) == false)
+	{
+		++packetCapture.rejected;
+		return;
+	}
+
+	const auto timestamp = getPacketTimestamp();
+	const CaptureRing::RecordHeader header
+	{
+			static_cast<uint32_t>(timestamp / 1000000),
+			static_cast<uint32_t>(timestamp % 1000000),
+			static_cast<uint32_t>(std::min(length, packetCapture.snapLength)),
+			static_cast<uint32_t>(length),
+	};
+	captureRing.write(header, frame);
+	++packetCapture.captured;
+}
+
+void configurePacketCapture(const PacketCaptureFilter& filter, const size_t snapLength)
+{
+	assert(snapLength >= 14 && snapLength <= maxPacketCaptureSnapLength);
+
+	auto adjustedFilter = filter;
+	adjustedFilter.excludedPort = capturePort;
+
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+	packetCapture.filter = adjustedFilter;
+	packetCapture.snapLength = snapLength;
+}
+
+void startPacketCaptureServer()
+{
+	{
+		const distortos::InterruptMaskingLock interruptMaskingLock;
+		packetCapture.filter.excludedPort = capturePort;
+	}
+
+	const auto listeningPcb = tcp_new_ip_type(IPADDR_TYPE_ANY);
+	assert(listeningPcb != nullptr);
+
+	{
+		const auto ret = tcp_bind(listeningPcb, IP_ANY_TYPE, capturePort);
+		assert(ret == ERR_OK);
+	}
+
+	const auto pcb = tcp_listen(listeningPcb);
+	assert(pcb != nullptr);
+	tcp_accept(pcb, packetCaptureAcceptCallback);
+}
@@ -0,0 +1,107 @@
+/**
+ * \file
+ * \brief Declarations related to capture of Ethernet frames with streaming in pcap format
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PACKETCAPTURE_HPP_
+#define PACKETCAPTURE_HPP_
+
+#include "PacketCaptureFilter.hpp"
+#include "StatisticsSource.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// max number of captured bytes of each frame
+constexpr size_t maxPacketCaptureSnapLength {256};
+
+/**
+ * \brief Source of statistics of packet capture.
+ *
+ * Statistics are published in "stats/capture" topic.
+ */
+
+class PacketCaptureStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats statistics of packet capture.
+	 *
+	 * Payload has following format: "captured=<captured> rejected=<rejected> overwritten=<overwritten>
+	 * streamed=<streamed>", where "captured" is the number of frames written to capture ring, "rejected" is the number
+	 * of frames rejected by the filter, "overwritten" is the number of captured frames which were overwritten in
+	 * capture ring by newer frames and "streamed" is the number of frames sent to clients.
+	 *
+	 * \param [in] index is the index of entry, must be 0
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of entries - 1
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Captures frame if it is selected by the filter.
+ *
+ * Captured bytes of frame are copied, along with its timestamp, to capture ring. When capture ring is full, the oldest
+ * frames are overwritten.
+ *
+ * \warning This function may be called only from thread context - Ethernet input thread for received frames and tcpip
+ * thread for transmitted frames.
+ *
+ * \param [in] frame is a pointer to frame (including MAC header), first min(\a length, snap length) bytes must be
+ * contiguous
+ * \param [in] length is the length of frame, bytes
+ * \param [in] direction is the direction of frame
+ */
+
+void capturePacket(const uint8_t* frame, size_t length, PacketDirection direction);
+
+/**
+ * \brief Configures packet capture.
+ *
+ * Frames which are already in capture ring are not affected. Frames of the stream with captured frames are never
+ * captured, regardless of PacketCaptureFilter::excludedPort.
+ *
+ * \param [in] filter is a reference to filter which selects captured frames
+ * \param [in] snapLength is the max number of captured bytes of each frame, [14; maxPacketCaptureSnapLength]
+ */
+
+void configurePacketCapture(const PacketCaptureFilter& filter, size_t snapLength);
+
+/**
+ * \brief Starts server which streams captured frames in pcap format on TCP port 2002.
+ *
+ * Client receives pcap file header, all frames which are currently in capture ring and then all newly captured frames,
+ * until it closes the connection. Only one client is served at a time. The stream can be opened directly in Wireshark,
+ * e.g. with `nc <address> 2002 | wireshark -k -i -`.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ */
+
+void startPacketCaptureServer();
+
+#endif	// PACKETCAPTURE_HPP_
@@ -0,0 +1,122 @@
+/**
+ * \file
+ * \brief Definitions related to PTP clock of Ethernet MAC
+ *
+ * PTP clock is driven by HCLK and uses fine correction method - addend register is added to a 32-bit accumulator on
+ * each cycle of HCLK and each overflow of the accumulator increments the time by the value of subsecond increment
+ * register. Nominal addend makes the accumulator overflow at 50 MHz, so the time increases in steps of 20 ns and
+ * frequency can be adjusted with resolution of ~1 ppb. Subseconds use digital rollover (at 999999999 ns), so values of
+ * registers and timestamps in DMA descriptors are directly seconds and nanoseconds.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "ptpClock.hpp"
+
+#include "stm32f7xx_hal.h"
+
+#include "distortos/chip/clocks.hpp"
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// number of nanoseconds in one second
+constexpr uint32_t nanosecondsPerSecond {1000000000};
+
+/// increment of time on each overflow of accumulator, nanoseconds
+constexpr uint32_t subsecondIncrement {20};
+
+/// nominal frequency of overflows of accumulator, Hz
+constexpr uint32_t updateFrequency {nanosecondsPerSecond / subsecondIncrement};
+
+static_assert(updateFrequency < distortos::chip::ahbFrequency, "Frequency of HCLK is too low for PTP clock!");
+
+/// nominal value of addend register
+constexpr uint32_t nominalAddend {static_cast<uint32_t>((uint64_t{updateFrequency} << 32) /
+		distortos::chip::ahbFrequency)};
+
+/// current frequency adjustment, parts per billion
+int32_t frequencyAdjustment;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Sets bit in PTPTSCR register which starts an update and waits until the update is finished.
+ *
+ * \param [in] bit is the bit which starts the update
+ */
+
+void startPtpUpdate(const uint32_t bit)
+{
+	ETH->PTPTSCR |= bit;
+	while ((ETH->PTPTSCR & bit) != 0);
+}
+
+/**
+ * \brief Writes addend register with the value matching current frequency adjustment.
+ */
+
+void writeAddend()
+{
+	ETH->PTPTSAR = nominalAddend + static_cast<int64_t>(nominalAddend) * frequencyAdjustment / nanosecondsPerSecond;
+	startPtpUpdate(ETH_PTPTSCR_TSARU);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+uint64_t getPtpTime()
+{
+	uint32_t seconds;
+	uint32_t nanoseconds;
+	// seconds may be incremented between the reads, read again until they are consistent
+	do
+	{
+		seconds = ETH->PTPTSHR;
+		nanoseconds = ETH->PTPTSLR;
+	} while (seconds != ETH->PTPTSHR);
+
+	return makePtpTime(seconds, nanoseconds);
+}
+
+void initializePtpClock(const uint64_t time)
+{
+	ETH->MACIMR |= ETH_MACIMR_TSTIM;	// time stamp trigger interrupt is not used
+	ETH->PTPTSCR = ETH_PTPTSCR_TSE | ETH_PTPTSCR_TSSARFE | ETH_PTPTSCR_TSSSR;
+	ETH->PTPSSIR = subsecondIncrement;
+	writeAddend();
+	ETH->PTPTSCR |= ETH_PTPTSCR_TSFCU;
+
+	ETH->PTPTSHUR = time / nanosecondsPerSecond;
+	ETH->PTPTSLUR = time % nanosecondsPerSecond;
+	startPtpUpdate(ETH_PTPTSCR_TSSTI);
+}
+
+void setPtpClockFrequency(const int32_t frequency)
+{
+	frequencyAdjustment = frequency;
+	writeAddend();
+}
+
+void stepPtpClock(const int64_t offset)
+{
+	// update registers hold magnitude and sign of the value which is added to the time
+	const auto subtract = offset > 0;
+	const uint64_t magnitude = subtract == true ? offset : -offset;
+	ETH->PTPTSHUR = magnitude / nanosecondsPerSecond;
+	ETH->PTPTSLUR = (subtract == true ? ETH_PTPTSLUR_TSUPNS : 0) | magnitude % nanosecondsPerSecond;
+	startPtpUpdate(ETH_PTPTSCR_TSSTU);
+}
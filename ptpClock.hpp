@@ -0,0 +1,81 @@
+/**
+ * \file
+ * \brief Declarations related to PTP clock of Ethernet MAC
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PTPCLOCK_HPP_
+#define PTPCLOCK_HPP_
+
+#include <cstdint>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// value of pbuf::timestamp of transmitted frame which requests capture of its transmit timestamp
+constexpr uint64_t ptpTransmitTimestampRequest {UINT64_MAX};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Converts time from the format of PTP registers and DMA descriptors to nanoseconds.
+ *
+ * \param [in] seconds is the seconds part of time
+ * \param [in] nanoseconds is the subseconds part of time, nanoseconds (PTP clock uses digital rollover)
+ *
+ * \return time in nanoseconds
+ */
+
+constexpr uint64_t makePtpTime(const uint32_t seconds, const uint32_t nanoseconds)
+{
+	return uint64_t{seconds} * 1000000000 + (nanoseconds & 0x7fffffff);
+}
+
+/**
+ * \return current time of PTP clock, nanoseconds
+ */
+
+uint64_t getPtpTime();
+
+/**
+ * \brief Initializes and starts PTP clock of Ethernet MAC.
+ *
+ * Time stamping is enabled for all received frames and for transmitted frames which request it. Current frequency
+ * adjustment (see setPtpClockFrequency()) is preserved.
+ *
+ * \warning Ethernet MAC must be initialized and lwIP core must be locked when this function is called.
+ *
+ * \param [in] time is the initial time of PTP clock, nanoseconds
+ */
+
+void initializePtpClock(uint64_t time);
+
+/**
+ * \brief Sets frequency adjustment of PTP clock.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] frequency is the frequency adjustment, parts per billion, positive values make the clock faster
+ */
+
+void setPtpClockFrequency(int32_t frequency);
+
+/**
+ * \brief Steps PTP clock.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] offset is the offset which is subtracted from current time of PTP clock, nanoseconds
+ */
+
+void stepPtpClock(int64_t offset);
+
+#endif	// PTPCLOCK_HPP_
@@ -0,0 +1,417 @@
+/**
+ * \file
+ * \brief Definitions related to PTP slave
+ *
+ * Minimal slave of PTP version 2 (IEEE 1588-2008) over UDP/IPv4 with end-to-end delay mechanism, which synchronizes
+ * PTP clock of Ethernet MAC with master. There is no best master clock algorithm - the slave follows the first master
+ * whose Sync it receives in domain 0 and switches to another master only when the current one is silent for more than
+ * 8 seconds; Announce messages are ignored. Both one-step and two-step masters are supported. Each Sync (or its
+ * Follow_Up) is answered with Delay_Req, so the rate of exchanges is set by master's sync interval. Messages are sent
+ * to 224.0.1.129 without joining the group (lwIP's IGMP is disabled), so switches with IGMP snooping must be
+ * configured to forward this group. Hardware timestamps of Sync and Delay_Req are taken from pbufs (see
+ * LWIP_PBUF_CUSTOM_DATA in lwIP-configuration.h) and from getTransmitTimestamp().
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "ptpSlave.hpp"
+
+#include "ethernetInterfaceInitialize.hpp"
+#include "ptpClock.hpp"
+#include "PtpServo.hpp"
+
+#include "distortos/assert.h"
+
+#include "lwip/netif.h"
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
+#include "lwip/udp.h"
+
+#include <algorithm>
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// type of PTP message
+enum class PtpMessageType : uint8_t
+{
+	/// Sync, event message
+	sync = 0x0,
+	/// Delay_Req, event message
+	delayRequest = 0x1,
+	/// Follow_Up, general message
+	followUp = 0x8,
+	/// Delay_Resp, general message
+	delayResponse = 0x9,
+};
+
+/// identity of PTP port - clock identity and port number
+using PtpPortIdentity = uint8_t[10];
+
+/// state of PTP slave
+struct PtpSlave
+{
+	/// identity of master
+	PtpPortIdentity master;
+
+	/// identity of this port
+	PtpPortIdentity port;
+
+	/// PCB bound to port of event messages
+	udp_pcb* eventPcb;
+
+	/// time of transmission of Sync of the current exchange, master's time, nanoseconds
+	int64_t t1;
+
+	/// time of reception of Sync of the current exchange, local time, nanoseconds
+	int64_t t2;
+
+	/// value of sys_now() at reception of the last Sync from master, milliseconds
+	uint32_t lastSync;
+
+	/// number of completed exchanges
+	uint32_t exchanges;
+
+	/// number of exchanges discarded because of missing hardware timestamp
+	uint32_t missing;
+
+	/// sequence ID of the last Sync from master
+	uint16_t syncSequenceId;
+
+	/// sequence ID of the last Delay_Req
+	uint16_t delayRequestSequenceId;
+
+	/// true if master was selected, false otherwise
+	bool masterSelected;
+
+	/// true if Sync of the current exchange waits for Follow_Up, false otherwise
+	bool followUpPending;
+
+	/// true if Delay_Req of the current exchange waits for Delay_Resp, false otherwise
+	bool delayResponsePending;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// UDP port of event messages
+constexpr uint16_t eventPort {319};
+
+/// UDP port of general messages
+constexpr uint16_t generalPort {320};
+
+/// PTP domain
+constexpr uint8_t domain {};
+
+/// multicast address of all PTP messages except peer delay mechanism
+const ip_addr_t ptpPrimaryAddress = IPADDR4_INIT_BYTES(224, 0, 1, 129);
+
+/// size of common header of PTP messages, bytes
+constexpr size_t headerSize {34};
+
+/// size of Sync, Delay_Req and Follow_Up messages, bytes
+constexpr size_t timestampMessageSize {44};
+
+/// size of Delay_Resp message, bytes
+constexpr size_t delayResponseSize {54};
+
+/// offset of sourcePortIdentity in common header
+constexpr size_t sourcePortIdentityOffset {20};
+
+/// flag of two-step clock in the first byte of flagField
+constexpr uint8_t twoStepFlag {0x02};
+
+/// time after which silent master is replaced by another one, milliseconds
+constexpr uint32_t masterTimeout {8000};
+
+/// max offset which is corrected with frequency adjustment, nanoseconds
+constexpr int64_t stepThreshold {100000};
+
+/// max absolute value of frequency adjustment, parts per billion
+constexpr int32_t maxFrequency {500000};
+
+/// state of PTP slave
+PtpSlave ptpSlave;
+
+/// servo of PTP clock
+PtpServo ptpServo {stepThreshold, maxFrequency};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Reads big-endian unsigned integer.
+ *
+ * \param [in] buffer is a pointer to the first byte of integer
+ * \param [in] size is the size of integer, bytes, [1; 8]
+ *
+ * \return value of integer
+ */
+
+uint64_t readBigEndian(const uint8_t* const buffer, const size_t size)
+{
+	uint64_t value {};
+	for (size_t i {}; i < size; ++i)
+		value = value << 8 | buffer[i];
+	return value;
+}
+
+/**
+ * \brief Reads correctionField of PTP message.
+ *
+ * \param [in] message is a pointer to PTP message
+ *
+ * \return value of correctionField, nanoseconds
+ */
+
+int64_t readCorrection(const uint8_t* const message)
+{
+	// correctionField is in nanoseconds multiplied by 2^16
+	return static_cast<int64_t>(readBigEndian(message + 8, 8)) / 65536;
+}
+
+/**
+ * \brief Reads timestamp which follows common header of PTP message.
+ *
+ * \param [in] message is a pointer to PTP message
+ *
+ * \return value of timestamp, nanoseconds
+ */
+
+int64_t readTimestamp(const uint8_t* const message)
+{
+	return readBigEndian(message + headerSize, 6) * 1000000000 + readBigEndian(message + headerSize + 6, 4);
+}
+
+/**
+ * \brief Sends Delay_Req to master.
+ *
+ * Transmit timestamp of the frame is captured by Ethernet MAC and read when Delay_Resp is received.
+ */
+
+void sendDelayRequest()
+{
+	const auto pbuf = pbuf_alloc(PBUF_TRANSPORT, timestampMessageSize, PBUF_RAM);
+	if (pbuf == nullptr)
+		return;
+
+	// originTimestamp is left 0, master uses only the sequence ID and port identity
+	const auto message = static_cast<uint8_t*>(pbuf->payload);
+	memset(message, 0, timestampMessageSize);
+	message[0] = static_cast<uint8_t>(PtpMessageType::delayRequest);
+	message[1] = 2;	// versionPTP
+	message[3] = timestampMessageSize;
+	message[4] = domain;
+	memcpy(message + sourcePortIdentityOffset, ptpSlave.port, sizeof(ptpSlave.port));
+	++ptpSlave.delayRequestSequenceId;
+	message[30] = ptpSlave.delayRequestSequenceId >> 8;
+	message[31] = ptpSlave.delayRequestSequenceId;
+	message[32] = 1;	// controlField of Delay_Req
+	message[33] = 0x7f;	// logMessageInterval
+
+	pbuf->timestamp = ptpTransmitTimestampRequest;
+	ptpSlave.delayResponsePending = udp_sendto(ptpSlave.eventPcb, pbuf, &ptpPrimaryAddress, eventPort) == ERR_OK;
+	pbuf_free(pbuf);
+}
+
+/**
+ * \brief Handles Sync.
+ *
+ * \param [in] message is a pointer to Sync message
+ * \param [in] timestamp is the hardware timestamp of reception of Sync, local time, nanoseconds
+ */
+
+void handleSync(const uint8_t* const message, const uint64_t timestamp)
+{
+	const auto source = message + sourcePortIdentityOffset;
+	const auto now = sys_now();
+	if (ptpSlave.masterSelected == false || (memcmp(source, ptpSlave.master, sizeof(ptpSlave.master)) != 0 &&
+			now - ptpSlave.lastSync > masterTimeout))
+	{
+		memcpy(ptpSlave.master, source, sizeof(ptpSlave.master));
+		ptpSlave.masterSelected = true;
+		ptpServo.reset();
+	}
+	else if (memcmp(source, ptpSlave.master, sizeof(ptpSlave.master)) != 0)
+		return;
+
+	ptpSlave.lastSync = now;
+	ptpSlave.followUpPending = {};
+	if (timestamp == 0)
+	{
+		++ptpSlave.missing;
+		return;
+	}
+
+	ptpSlave.syncSequenceId = readBigEndian(message + 30, 2);
+	ptpSlave.t2 = timestamp;
+	ptpSlave.t1 = readCorrection(message);
+	if ((message[6] & twoStepFlag) != 0)
+	{
+		ptpSlave.followUpPending = true;
+		return;
+	}
+
+	ptpSlave.t1 += readTimestamp(message);
+	sendDelayRequest();
+}
+
+/**
+ * \brief Handles Follow_Up.
+ *
+ * \param [in] message is a pointer to Follow_Up message
+ */
+
+void handleFollowUp(const uint8_t* const message)
+{
+	if (ptpSlave.followUpPending == false ||
+			memcmp(message + sourcePortIdentityOffset, ptpSlave.master, sizeof(ptpSlave.master)) != 0 ||
+			readBigEndian(message + 30, 2) != ptpSlave.syncSequenceId)
+		return;
+
+	ptpSlave.followUpPending = {};
+	ptpSlave.t1 += readTimestamp(message) + readCorrection(message);
+	sendDelayRequest();
+}
+
+/**
+ * \brief Handles Delay_Resp and corrects PTP clock.
+ *
+ * \param [in] message is a pointer to Delay_Resp message
+ */
+
+void handleDelayResponse(const uint8_t* const message)
+{
+	if (ptpSlave.delayResponsePending == false ||
+			memcmp(message + sourcePortIdentityOffset, ptpSlave.master, sizeof(ptpSlave.master)) != 0 ||
+			memcmp(message + headerSize + 10, ptpSlave.port, sizeof(ptpSlave.port)) != 0 ||
+			readBigEndian(message + 30, 2) != ptpSlave.delayRequestSequenceId)
+		return;
+
+	ptpSlave.delayResponsePending = {};
+	const auto t3 = getTransmitTimestamp();
+	if (t3 == 0)
+	{
+		++ptpSlave.missing;
+		return;
+	}
+
+	const auto t4 = readTimestamp(message) - readCorrection(message);
+	const auto correction = ptpServo.update(ptpSlave.t1, ptpSlave.t2, t3, t4);
+	if (correction.step != 0)
+		stepPtpClock(correction.step);
+	setPtpClockFrequency(correction.frequency);
+	++ptpSlave.exchanges;
+}
+
+/**
+ * \brief UDP receive callback of PTP slave
+ *
+ * \param [in] pbuf is a pointer to received datagram
+ */
+
+void ptpReceiveCallback(void*, udp_pcb*, pbuf* const pbuf, const ip_addr_t*, u16_t)
+{
+	uint8_t buffer[delayResponseSize];
+	const auto length = pbuf_copy_partial(pbuf, buffer, sizeof(buffer), 0);
+	const auto timestamp = pbuf->timestamp;
+	pbuf_free(pbuf);
+
+	if (length < timestampMessageSize || (buffer[1] & 0xf) != 2 || buffer[4] != domain)
+		return;
+
+	const auto messageType = static_cast<PtpMessageType>(buffer[0] & 0xf);
+	if (messageType == PtpMessageType::sync)
+		handleSync(buffer, timestamp);
+	else if (messageType == PtpMessageType::followUp)
+		handleFollowUp(buffer);
+	else if (messageType == PtpMessageType::delayResponse && length >= delayResponseSize)
+		handleDelayResponse(buffer);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| PtpStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int PtpStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize, char* const payload,
+		const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	LOCK_TCPIP_CORE();
+	const auto time = getPtpTime();
+	const auto synchronized = ptpServo.isSynchronized();
+	const auto offset = ptpServo.getOffset();
+	const auto delay = ptpServo.getDelay();
+	const auto frequency = ptpServo.getFrequency();
+	const auto steps = ptpServo.getSteps();
+	const auto exchanges = ptpSlave.exchanges;
+	const auto missing = ptpSlave.missing;
+	UNLOCK_TCPIP_CORE();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "ptp");
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto ret = sniprintf(payload, payloadSize, "time=%lu.%09lu synchronized=%u offset=%ld delay=%ld "
+			"frequency=%ld steps=%lu exchanges=%lu missing=%lu", static_cast<unsigned long>(time / 1000000000),
+			static_cast<unsigned long>(time % 1000000000), synchronized, static_cast<long>(offset),
+			static_cast<long>(delay), static_cast<long>(frequency), static_cast<unsigned long>(steps),
+			static_cast<unsigned long>(exchanges), static_cast<unsigned long>(missing));
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t PtpStatisticsSource::getCount() const
+{
+	return 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void startPtpSlave(const netif& netif)
+{
+	// clock identity is EUI-64 made from MAC address, port number is 1
+	auto& port = ptpSlave.port;
+	std::copy_n(netif.hwaddr, 3, port);
+	port[3] = 0xff;
+	port[4] = 0xfe;
+	std::copy_n(netif.hwaddr + 3, 3, port + 5);
+	port[9] = 1;
+
+	for (const auto udpPort : {eventPort, generalPort})
+	{
+		const auto pcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+		assert(pcb != nullptr);
+
+		{
+			const auto ret = udp_bind(pcb, IP_ANY_TYPE, udpPort);
+			assert(ret == ERR_OK);
+		}
+
+		udp_recv(pcb, ptpReceiveCallback, {});
+		if (udpPort == eventPort)
+			ptpSlave.eventPcb = pcb;
+	}
+}
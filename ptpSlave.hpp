@@ -0,0 +1,78 @@
+/**
+ * \file
+ * \brief Declarations related to PTP slave
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PTPSLAVE_HPP_
+#define PTPSLAVE_HPP_
+
+#include "StatisticsSource.hpp"
+
+struct netif;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Source of statistics of PTP slave.
+ *
+ * Statistics are published in "stats/ptp" topic.
+ */
+
+class PtpStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats statistics of PTP slave.
+	 *
+	 * Payload has following format: "time=<time> synchronized=<synchronized> offset=<offset> delay=<delay>
+	 * frequency=<frequency> steps=<steps> exchanges=<exchanges> missing=<missing>", where "time" is the current time of
+	 * PTP clock in seconds (with 9 digits after decimal point), "synchronized" is "1" if the clock is synchronized with
+	 * master, "0" otherwise, "offset" is the offset from master in the last exchange and "delay" is the smoothed mean
+	 * path delay, both in nanoseconds, "frequency" is the frequency adjustment of the clock in ppb, "steps" is the
+	 * number of steps of the clock, "exchanges" is the number of completed exchanges of messages with master and
+	 * "missing" is the number of exchanges which were discarded because of missing hardware timestamp.
+	 *
+	 * \param [in] index is the index of entry, must be 0
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of entries - 1
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Starts PTP slave on UDP ports 319 and 320.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] netif is a reference to the lwIP network interface structure of Ethernet interface, its MAC address is
+ * used to make identity of the clock
+ */
+
+void startPtpSlave(const netif& netif);
+
+#endif	// PTPSLAVE_HPP_
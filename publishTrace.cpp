@@ -0,0 +1,314 @@
+/**
+ * \file
+ * \brief Definitions related to tracing of latency of publishing button states
+ *
+ * Each traced message gets a record in a small trace buffer, keyed by a sequence number which is passed to MQTT request
+ * callback as its argument. The record collects values of cycle counter at trace points along the publish path -
+ * sampling of state in main(), mqtt_publish() (called right after lwIP core is locked), transmission of the first TCP
+ * segment with data to MQTT broker in lowLevelOutput() and acknowledgement in MQTT request callback. Once the message
+ * is acknowledged, latencies of all stages are added to per-stage windows with latencies of last messages, from which
+ * percentiles are calculated. Records of messages which are never acknowledged (e.g. when connection is lost) are
+ * simply overwritten. All trace points are executed with lwIP core locked, so no additional locking is needed.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "publishTrace.hpp"
+
+#include "cycleCounter.hpp"
+
+#include "distortos/assert.h"
+
+#include "lwip/apps/mqtt.h"
+#include "lwip/prot/ethernet.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/tcp.h"
+#include "lwip/tcpip.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// stage of publish path
+enum class Stage : uint8_t
+{
+	/// from sampling of state to mqtt_publish()
+	enqueue,
+	/// from mqtt_publish() to transmission of TCP segment
+	transmit,
+	/// from transmission of TCP segment to acknowledgement
+	ack,
+	/// from sampling of state to acknowledgement
+	total,
+
+	/// number of stages
+	count
+};
+
+/// record of traced message
+struct TraceRecord
+{
+	/// key of traced message, 0 if record is not used
+	uint32_t key;
+
+	/// value of cycle counter at which the published state was sampled
+	uint32_t sampled;
+
+	/// value of cycle counter at which mqtt_publish() was called
+	uint32_t enqueued;
+
+	/// value of cycle counter at which TCP segment with message was transmitted, valid only if \a transmitted is true
+	uint32_t transmittedAt;
+
+	/// true if TCP segment with message was transmitted, false otherwise
+	bool transmitted;
+};
+
+/// latencies of last messages in one stage
+struct StageLatencies
+{
+	/// latencies of last messages, microseconds
+	uint32_t latencies[64];
+
+	/// histogram of latencies of all messages, microseconds
+	Log2Histogram<24> histogram;
+
+	/// number of all recorded latencies
+	uint32_t count;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// names of stages, used in topics
+const char* const stageNames[]
+{
+		"enqueue",
+		"transmit",
+		"ack",
+		"total",
+};
+
+static_assert(std::size(stageNames) == static_cast<size_t>(Stage::count));
+
+/// trace buffer
+TraceRecord traceBuffer[8];
+
+/// latencies of all stages
+StageLatencies stageLatencies[static_cast<size_t>(Stage::count)];
+
+/// key of next traced message
+uint32_t nextKey {1};
+
+/// number of records which wait for transmission of TCP segment
+size_t waitingForTransmit;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Adds latency to one stage.
+ *
+ * \param [in] stage is the stage to which latency will be added
+ * \param [in] cycles is the latency, cycles of cycle counter
+ */
+
+void addLatency(const Stage stage, const uint32_t cycles)
+{
+	auto& latencies = stageLatencies[static_cast<size_t>(stage)];
+	const uint32_t latency = uint64_t{cycles} * 1000000 / getCycleCounterFrequency();
+	latencies.latencies[latencies.count % std::size(latencies.latencies)] = latency;
+	latencies.histogram.add(latency);
+	++latencies.count;
+}
+
+/**
+ * \brief Finds record of traced message.
+ *
+ * \param [in] trace is the key of traced message
+ *
+ * \return pointer to record of traced message, nullptr if it is not in trace buffer
+ */
+
+TraceRecord* findRecord(void* const trace)
+{
+	const auto key = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(trace));
+	if (key == 0)
+		return {};
+
+	auto& record = traceBuffer[key % std::size(traceBuffer)];
+	return record.key == key ? &record : nullptr;
+}
+
+/**
+ * \brief Releases record of traced message.
+ *
+ * \param [in] record is a reference to released record
+ */
+
+void releaseRecord(TraceRecord& record)
+{
+	if (record.key != 0 && record.transmitted == false)
+		--waitingForTransmit;
+	record.key = {};
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| PublishTraceMetricsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MetricFamily PublishTraceMetricsSource::getFamily(const size_t index) const
+{
+	assert(index < getCount());
+
+	return {"mqtt_publish_latency_microseconds", "Latency of publishing state of buttons, by stage.", "stage",
+			static_cast<size_t>(Stage::count), MetricType::histogram};
+}
+
+MetricSeries PublishTraceMetricsSource::getSeries(const size_t family, const size_t index) const
+{
+	assert(family < getCount() && index < static_cast<size_t>(Stage::count));
+
+	return makeMetricSeries(stageNames[index], stageLatencies[index].histogram);
+}
+
+size_t PublishTraceMetricsSource::getCount() const
+{
+	return 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| PublishTraceStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int PublishTraceStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize,
+		char* const payload, const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	LOCK_TCPIP_CORE();
+	auto latencies = stageLatencies[index];
+	UNLOCK_TCPIP_CORE();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "trace/%s", stageNames[index]);
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto size = std::min<size_t>(latencies.count, std::size(latencies.latencies));
+	std::sort(latencies.latencies, latencies.latencies + size);
+	const auto percentile = [&latencies, size](const size_t percent) -> unsigned long
+			{
+				return size != 0 ? latencies.latencies[(size - 1) * percent / 100] : 0;
+			};
+
+	const auto ret = sniprintf(payload, payloadSize, "count=%lu p50=%lu p90=%lu p99=%lu max=%lu",
+			static_cast<unsigned long>(latencies.count), percentile(50), percentile(90), percentile(99),
+			percentile(100));
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t PublishTraceStatisticsSource::getCount() const
+{
+	return static_cast<size_t>(Stage::count);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void cancelPublishTrace(void* const trace)
+{
+	const auto record = findRecord(trace);
+	if (record != nullptr)
+		releaseRecord(*record);
+}
+
+void recordPublishAck(void* const trace, const err_t error)
+{
+	const auto now = getCycleCount();
+	const auto record = findRecord(trace);
+	if (record == nullptr)
+		return;
+
+	const auto copy = *record;
+	releaseRecord(*record);
+	if (error != ERR_OK)
+		return;
+
+	addLatency(Stage::enqueue, copy.enqueued - copy.sampled);
+	// segment could have been sent in a way which was not recognized (e.g. retransmission after a reconnect)
+	if (copy.transmitted == true)
+	{
+		addLatency(Stage::transmit, copy.transmittedAt - copy.enqueued);
+		addLatency(Stage::ack, now - copy.transmittedAt);
+	}
+	addLatency(Stage::total, now - copy.sampled);
+}
+
+void recordPublishTransmit(const pbuf& frame)
+{
+	if (waitingForTransmit == 0)
+		return;
+
+	constexpr size_t minLength {SIZEOF_ETH_HDR + IP_HLEN + TCP_HLEN};
+	if (frame.len < minLength)
+		return;
+
+	const auto ethernetHeader = static_cast<const eth_hdr*>(frame.payload);
+	if (ethernetHeader->type != PP_HTONS(ETHTYPE_IP))
+		return;
+
+	const auto ipHeader = reinterpret_cast<const ip_hdr*>(static_cast<const uint8_t*>(frame.payload) +
+			SIZEOF_ETH_HDR);
+	if (IPH_PROTO(ipHeader) != IP_PROTO_TCP || SIZEOF_ETH_HDR + IPH_HL_BYTES(ipHeader) + TCP_HLEN > frame.len)
+		return;
+
+	const auto tcpHeader = reinterpret_cast<const tcp_hdr*>(reinterpret_cast<const uint8_t*>(ipHeader) +
+			IPH_HL_BYTES(ipHeader));
+	if (tcpHeader->dest != PP_HTONS(MQTT_PORT) && tcpHeader->dest != PP_HTONS(MQTT_TLS_PORT))
+		return;
+	if (lwip_ntohs(IPH_LEN(ipHeader)) <= IPH_HL_BYTES(ipHeader) + TCPH_HDRLEN_BYTES(tcpHeader))	// no data?
+		return;
+
+	const auto now = getCycleCount();
+	for (auto& record : traceBuffer)
+		if (record.key != 0 && record.transmitted == false)
+		{
+			record.transmittedAt = now;
+			record.transmitted = true;
+		}
+	waitingForTransmit = {};
+}
+
+void* startPublishTrace(const uint32_t sampled)
+{
+	const auto key = nextKey;
+	nextKey = nextKey + 1 != 0 ? nextKey + 1 : 1;
+
+	auto& record = traceBuffer[key % std::size(traceBuffer)];
+	releaseRecord(record);
+	record = {key, sampled, getCycleCount(), {}, {}};
+	++waitingForTransmit;
+	return reinterpret_cast<void*>(static_cast<uintptr_t>(key));
+}
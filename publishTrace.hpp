@@ -0,0 +1,156 @@
+/**
+ * \file
+ * \brief Declarations related to tracing of latency of publishing button states
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PUBLISHTRACE_HPP_
+#define PUBLISHTRACE_HPP_
+
+#include "MetricsSource.hpp"
+#include "StatisticsSource.hpp"
+
+#include "lwip/err.h"
+
+#include <cstdint>
+
+struct pbuf;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Source of metrics of publish latency.
+ *
+ * Family "mqtt_publish_latency_microseconds" (histogram with "stage" label - "enqueue", "transmit", "ack" or "total")
+ * has latencies of all traced messages.
+ */
+
+class PublishTraceMetricsSource : public MetricsSource
+{
+public:
+
+	/**
+	 * \param [in] index is the index of family, must be 0
+	 *
+	 * \return description of selected family
+	 */
+
+	MetricFamily getFamily(size_t index) const override;
+
+	/**
+	 * \param [in] family is the index of family, must be 0
+	 * \param [in] index is the index of stage, [0; MetricFamily::seriesCount)
+	 *
+	 * \return selected series of selected family
+	 */
+
+	MetricSeries getSeries(size_t family, size_t index) const override;
+
+	/**
+	 * \return 1
+	 */
+
+	size_t getCount() const override;
+};
+
+/**
+ * \brief Source of statistics of publish latency.
+ *
+ * Percentiles of each stage are published in "stats/trace/enqueue", "stats/trace/transmit", "stats/trace/ack" and
+ * "stats/trace/total" topics.
+ */
+
+class PublishTraceStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats percentiles of latency of one stage.
+	 *
+	 * Payload has following format: "count=<count> p50=<p50> p90=<p90> p99=<p99> max=<max>", where "count" is the
+	 * number of all traced messages and the rest is calculated from latencies of the last 64 messages, in
+	 * microseconds.
+	 *
+	 * \param [in] index is the index of stage, [0; getCount())
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of stages
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Cancels trace of message which could not be published.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] trace is the value returned by startPublishTrace()
+ */
+
+void cancelPublishTrace(void* trace);
+
+/**
+ * \brief Records acknowledgement of traced message.
+ *
+ * Should be called from MQTT request callback of traced message. For QoS 0 lwIP's MQTT client calls it when TCP
+ * segment with the message is acknowledged, for QoS > 0 - when the broker acknowledges the message (PUBACK or PUBCOMP).
+ * Acknowledgements of messages which are no longer in trace buffer (or were not traced at all) are ignored.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] trace is the value returned by startPublishTrace(), passed to MQTT request callback as its argument
+ * \param [in] error is the result of MQTT request
+ */
+
+void recordPublishAck(void* trace, err_t error);
+
+/**
+ * \brief Records transmission of frame.
+ *
+ * If the frame is a TCP segment with data sent to MQTT broker, all traced messages which wait for transmission are
+ * marked as transmitted.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] frame is a reference to transmitted frame (including MAC header)
+ */
+
+void recordPublishTransmit(const pbuf& frame);
+
+/**
+ * \brief Starts trace of message which is about to be published.
+ *
+ * Trace record is stored in fixed-size trace buffer, overwriting the oldest record if the buffer is full.
+ *
+ * \warning lwIP core must be locked when this function is called. It must be called right before mqtt_publish().
+ *
+ * \param [in] sampled is the value of cycle counter at which the published state was sampled
+ *
+ * \return key of trace, which should be passed to MQTT request callback as its argument
+ */
+
+void* startPublishTrace(uint32_t sampled);
+
+#endif	// PUBLISHTRACE_HPP_
@@ -0,0 +1,91 @@
+#
+# file: stackReport.cmake
+#
+# author: Copyright (C) 2026 agent agent@local
+#
+# This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+# distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Script which generates stack sizing report from stack usage captured in the field - messages published by the
+# application in `stats/stack/<thread>` topics, e.g. saved with `mosquitto_sub -t "distortos/+/+/stats/stack/#" -v`.
+# For each thread the largest high-water mark from all messages (possibly from many devices and many runs) is used to
+# suggest tighter size of stack.
+#
+# Usage: cmake -DINPUT=<captured messages> -DOUTPUT=<report> [-DMARGIN=<margin>] -P stackReport.cmake
+#
+# `INPUT` - path to file with captured messages, one message per line, payload after the first space
+# `OUTPUT` - path to generated report
+# `MARGIN` - margin added to the largest high-water mark, percent, default - 25
+#
+
+if(NOT INPUT OR NOT OUTPUT)
+	message(FATAL_ERROR "INPUT and OUTPUT must be defined!")
+endif()
+if(NOT MARGIN)
+	set(MARGIN 25)
+endif()
+
+# monitored threads - name and place where the size of its stack is configured
+set(threads
+		"main" "distortos_Scheduler_04_Main_thread_stack_size in distortos configuration"
+		"ethernetInput" "stackSize in ethernetInterfaceInitialize()"
+		"tcpip" "TCPIP_THREAD_STACKSIZE in lwIP-configuration.h")
+list(LENGTH threads threadsLength)
+math(EXPR lastThread "${threadsLength} / 2 - 1")
+foreach(thread RANGE ${lastThread})
+	set(threadSize${thread} 0)
+	set(threadUsed${thread} 0)
+	set(threadMessages${thread} 0)
+endforeach()
+
+file(STRINGS ${INPUT} messages REGEX "/stats/stack/[A-Za-z]+ size=[0-9]+ used=[0-9]+")
+foreach(message IN LISTS messages)
+	if(NOT message MATCHES "/stats/stack/([A-Za-z]+) size=([0-9]+) used=([0-9]+)")
+		continue()
+	endif()
+	set(name "${CMAKE_MATCH_1}")
+	set(size ${CMAKE_MATCH_2})
+	set(used ${CMAKE_MATCH_3})
+
+	foreach(thread RANGE ${lastThread})
+		math(EXPR nameIndex "${thread} * 2")
+		list(GET threads ${nameIndex} threadName)
+		if(name STREQUAL threadName)
+			if(size GREATER threadSize${thread})
+				set(threadSize${thread} ${size})
+			endif()
+			if(used GREATER threadUsed${thread})
+				set(threadUsed${thread} ${used})
+			endif()
+			math(EXPR threadMessages${thread} "${threadMessages${thread}} + 1")
+			break()
+		endif()
+	endforeach()
+endforeach()
+
+set(report "Stack sizing report from ${INPUT}, margin ${MARGIN}%\n\n")
+string(APPEND report "size\tused\tsuggested\tfreed\tthread (messages) - configured by\n")
+set(totalFreed 0)
+foreach(thread RANGE ${lastThread})
+	math(EXPR nameIndex "${thread} * 2")
+	math(EXPR placeIndex "${thread} * 2 + 1")
+	list(GET threads ${nameIndex} threadName)
+	list(GET threads ${placeIndex} threadPlace)
+	if(threadMessages${thread} EQUAL 0)
+		string(APPEND report "-\t-\t-\t\t-\t${threadName} (0) - ${threadPlace}\n")
+		continue()
+	endif()
+
+	# stacks on ARM must be aligned to 8 bytes
+	math(EXPR suggested "(${threadUsed${thread}} * (100 + ${MARGIN}) / 100 + 7) / 8 * 8")
+	math(EXPR freed "${threadSize${thread}} - ${suggested}")
+	if(freed GREATER 0)
+		math(EXPR totalFreed "${totalFreed} + ${freed}")
+	endif()
+	string(APPEND report "${threadSize${thread}}\t${threadUsed${thread}}\t${suggested}\t\t${freed}\t${threadName} "
+			"(${threadMessages${thread}}) - ${threadPlace}\n")
+endforeach()
+string(APPEND report "\nRAM which can be freed: ${totalFreed} bytes\n")
+
+file(WRITE ${OUTPUT} "${report}")
+message(STATUS "Stack sizing: ${totalFreed} bytes of RAM can be freed, see ${OUTPUT}")
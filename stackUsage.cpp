@@ -0,0 +1,89 @@
+/**
+ * \file
+ * \brief Definitions related to monitoring of stack usage of threads
+ *
+ * Threads are the ones registered for accounting of CPU usage (see cpuUsage.hpp). Idle thread is not accessible through
+ * public API of distortos, so its stack is not monitored.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "stackUsage.hpp"
+
+#include "cpuUsage.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/Thread.hpp"
+
+#include <iterator>
+
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// monitored thread
+struct MonitoredThread
+{
+	/// name of thread, used in topic
+	const char* name;
+
+	/// accounted thread
+	CpuUsageThread thread;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// all monitored threads
+const MonitoredThread monitoredThreads[]
+{
+		{"main", CpuUsageThread::main},
+		{"ethernetInput", CpuUsageThread::ethernetInput},
+		{"tcpip", CpuUsageThread::tcpip},
+};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| StackUsageStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int StackUsageStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize,
+		char* const payload, const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	const auto& monitoredThread = monitoredThreads[index];
+	const auto thread = getRegisteredThread(monitoredThread.thread);
+	if (thread == nullptr)
+		return -1;
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "stack/%s", monitoredThread.name);
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto size = thread->getStackSize();
+	const auto used = thread->getStackHighWaterMark();
+	const auto ret = sniprintf(payload, payloadSize, "size=%zu used=%zu margin=%zu", size, used, size - used);
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t StackUsageStatisticsSource::getCount() const
+{
+	return std::size(monitoredThreads);
+}
@@ -0,0 +1,60 @@
+/**
+ * \file
+ * \brief Declarations related to monitoring of stack usage of threads
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef STACKUSAGE_HPP_
+#define STACKUSAGE_HPP_
+
+#include "StatisticsSource.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Source of statistics of stack usage.
+ *
+ * Stack usage of each thread registered with registerCpuUsageThread() is published in "stats/stack/main",
+ * "stats/stack/ethernetInput" and "stats/stack/tcpip" topics. stackReport.cmake generates suggested stack sizes from
+ * captured messages.
+ */
+
+class StackUsageStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats stack usage of one thread.
+	 *
+	 * Stack of the thread is scanned for sentinel value with which distortos fills it during initialization, so the
+	 * time of this function is proportional to the size of stack. Payload has following format: "size=<size>
+	 * used=<used> margin=<margin>", where "size" is the size of stack, "used" is its high-water mark and "margin" is
+	 * the size of stack which was never used, all in bytes.
+	 *
+	 * \param [in] index is the index of thread, [0; getCount())
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted (e.g. the thread was not registered yet)
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of monitored threads
+	 */
+
+	size_t getCount() const override;
+};
+
+#endif	// STACKUSAGE_HPP_
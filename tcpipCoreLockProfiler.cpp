@@ -0,0 +1,216 @@
+/**
+ * \file
+ * \brief Definitions related to profiler of lwIP core mutex
+ *
+ * LOCK_TCPIP_CORE() and UNLOCK_TCPIP_CORE() are replaced in lwIP configuration with calls to functions from this file.
+ * Each call site of LOCK_TCPIP_CORE() is registered on first use, then times of waiting for the mutex and times of
+ * holding it are recorded in its histograms. All state of the profiler is protected by the mutex itself, so recording
+ * doesn't need any additional locking.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "tcpipCoreLockProfiler.hpp"
+
+#include "cycleCounter.hpp"
+#include "formatLog2Histogram.hpp"
+
+#include "distortos/assert.h"
+
+#include "lwip/tcpip.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// max number of call sites with statistics, the last entry is shared by all call sites which didn't fit
+constexpr size_t sitesMax {16};
+
+/// statistics of call sites
+TcpipCoreLockSiteStatistics sites[sitesMax];
+
+/// number of used entries in sites
+size_t sitesCount;
+
+/// statistics of call site which currently holds the mutex, nullptr if mutex is not locked
+TcpipCoreLockSiteStatistics* currentSite;
+
+/// value of cycle counter at which the mutex was locked
+uint32_t lockedAt;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Converts cycles of cycle counter to nanoseconds.
+ *
+ * \param [in] cycles is the number of cycles of cycle counter
+ *
+ * \return \a cycles converted to nanoseconds
+ */
+
+unsigned long cyclesToNanoseconds(const uint64_t cycles)
+{
+	return cycles * 1000000000 / getCycleCounterFrequency();
+}
+
+/**
+ * \brief Prints histogram.
+ *
+ * \param [in] name is the name of histogram
+ * \param [in] histogram is a reference to printed histogram
+ */
+
+void printHistogram(const char* const name, const TcpipCoreLockHistogram& histogram)
+{
+	const auto count = histogram.getCount();
+	fiprintf(standardOutputStream, "  %s: count = %lu, max = %lu ns, mean = %lu ns\r\n", name,
+			static_cast<unsigned long>(count), cyclesToNanoseconds(histogram.getMax()),
+			cyclesToNanoseconds(count != 0 ? histogram.getSum() / count : 0));
+
+	for (size_t index {}; index < histogram.getBucketCount(); ++index)
+	{
+		const auto bucket = histogram.getBucket(index);
+		if (bucket == 0)
+			continue;
+
+		const auto from = index == 0 ? 0 : cyclesToNanoseconds(uint64_t{1} << (index - 1));
+		if (index == histogram.getBucketCount() - 1)
+			fiprintf(standardOutputStream, "    [%lu ns; ...): %lu\r\n", from, static_cast<unsigned long>(bucket));
+		else
+			fiprintf(standardOutputStream, "    [%lu ns; %lu ns): %lu\r\n", from,
+					cyclesToNanoseconds(uint64_t{1} << index), static_cast<unsigned long>(bucket));
+	}
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| TcpipCoreLockStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int TcpipCoreLockStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize,
+		char* const payload, const size_t payloadSize) const
+{
+	if (index == 0)
+	{
+		{
+			const auto ret = sniprintf(topic, topicSize, "lock/summary");
+			if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+				return -1;
+		}
+
+		const auto ret = sniprintf(payload, payloadSize, "sites=%zu frequency=%lu", getTcpipCoreLockSiteCount(),
+				static_cast<unsigned long>(getCycleCounterFrequency()));
+		if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+			return -1;
+
+		return ret;
+	}
+
+	const auto statistics = getTcpipCoreLockSiteStatistics((index - 1) / 2);
+	const auto wait = (index - 1) % 2 == 0;
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "lock/%s:%d/%s", statistics.file, statistics.line,
+				wait == true ? "wait" : "hold");
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	return formatLog2Histogram(wait == true ? statistics.wait : statistics.hold, payload, payloadSize);
+}
+
+size_t TcpipCoreLockStatisticsSource::getCount() const
+{
+	return 1 + getTcpipCoreLockSiteCount() * 2;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+size_t getTcpipCoreLockSiteCount()
+{
+	LOCK_TCPIP_CORE();
+	const auto count = sitesCount;
+	UNLOCK_TCPIP_CORE();
+	return count;
+}
+
+TcpipCoreLockSiteStatistics getTcpipCoreLockSiteStatistics(const size_t index)
+{
+	LOCK_TCPIP_CORE();
+	assert(index < sitesCount);
+	const auto statistics = sites[index];
+	UNLOCK_TCPIP_CORE();
+	return statistics;
+}
+
+void printTcpipCoreLockStatistics()
+{
+	const auto count = getTcpipCoreLockSiteCount();
+	fiprintf(standardOutputStream, "Statistics of lwIP core mutex, %zu call sites:\r\n", count);
+	for (size_t index {}; index < count; ++index)
+	{
+		const auto statistics = getTcpipCoreLockSiteStatistics(index);
+		fiprintf(standardOutputStream, "%s:%d\r\n", statistics.file, statistics.line);
+		printHistogram("wait", statistics.wait);
+		printHistogram("hold", statistics.hold);
+	}
+}
+
+extern "C" void tcpipCoreLockProfilerLock(TcpipCoreLockSite* const site)
+{
+	assert(site != nullptr);
+
+	const auto start = getCycleCount();
+	sys_mutex_lock(&lock_tcpip_core);
+	const auto now = getCycleCount();
+
+	if (site->index == 0)	// call site not registered yet?
+	{
+		if (sitesCount < sitesMax)
+			++sitesCount;
+		site->index = sitesCount;
+		auto& statistics = sites[sitesCount - 1];
+		if (statistics.file == nullptr)
+		{
+			if (site->index == sitesMax)
+			{
+				statistics.file = "other";
+				statistics.line = {};
+			}
+			else
+			{
+				const auto slash = strrchr(site->file, '/');
+				statistics.file = slash != nullptr ? slash + 1 : site->file;
+				statistics.line = site->line;
+			}
+		}
+	}
+
+	currentSite = &sites[site->index - 1];
+	currentSite->wait.add(now - start);
+	lockedAt = now;
+}
+
+extern "C" void tcpipCoreLockProfilerUnlock()
+{
+	const auto now = getCycleCount();
+	assert(currentSite != nullptr);
+	currentSite->hold.add(now - lockedAt);
+	currentSite = {};
+	sys_mutex_unlock(&lock_tcpip_core);
+}
@@ -0,0 +1,110 @@
+/**
+ * \file
+ * \brief Declarations related to profiler of lwIP core mutex
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TCPIPCORELOCKPROFILER_HPP_
+#define TCPIPCORELOCKPROFILER_HPP_
+
+#include "Log2Histogram.hpp"
+#include "StatisticsSource.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// histogram of times of waiting for or holding lwIP core mutex, cycles of cycle counter
+using TcpipCoreLockHistogram = Log2Histogram<24>;
+
+/// statistics of single call site of LOCK_TCPIP_CORE()
+struct TcpipCoreLockSiteStatistics
+{
+	/// name of file with call site (without directories), "other" for all call sites which didn't fit in the table
+	const char* file;
+
+	/// line of call site, 0 for all call sites which didn't fit in the table
+	int line;
+
+	/// histogram of times of waiting for the mutex
+	TcpipCoreLockHistogram wait;
+
+	/// histogram of times of holding the mutex (from locking at this call site to next unlocking)
+	TcpipCoreLockHistogram hold;
+};
+
+/**
+ * \brief Source of statistics of lwIP core mutex.
+ *
+ * Summary is published in "stats/lock/summary" topic, statistics of each call site are published in
+ * "stats/lock/<file>:<line>/wait" and "stats/lock/<file>:<line>/hold" topics.
+ */
+
+class TcpipCoreLockStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats summary or one histogram of one call site.
+	 *
+	 * Payload of summary has following format: "sites=<sites> frequency=<frequency>", where "frequency" is the
+	 * frequency of cycle counter in Hz. Payload of histogram has following format: "count=<count> max=<max>
+	 * mean=<mean> hist=<first>:<bucket>,<bucket>,...", where all times are in cycles of cycle counter and only buckets
+	 * from the first non-empty (with index <first>) to the last non-empty are listed.
+	 *
+	 * \param [in] index is the index of entry, 0 - summary, [1; getCount()) - histograms of call sites
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of entries - summary and two histograms of each registered call site
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \return number of registered call sites of LOCK_TCPIP_CORE()
+ */
+
+size_t getTcpipCoreLockSiteCount();
+
+/**
+ * \brief Gets statistics of one call site of LOCK_TCPIP_CORE().
+ *
+ * Statistics are copied with lwIP core mutex locked, so they are consistent.
+ *
+ * \param [in] index is the index of call site, [0; getTcpipCoreLockSiteCount())
+ *
+ * \return statistics of selected call site
+ */
+
+TcpipCoreLockSiteStatistics getTcpipCoreLockSiteStatistics(size_t index);
+
+/**
+ * \brief Prints statistics of all registered call sites of LOCK_TCPIP_CORE() to standard output stream.
+ *
+ * Unlike TcpipCoreLockStatisticsSource, all non-empty buckets of histograms are printed, with their ranges converted
+ * to nanoseconds.
+ */
+
+void printTcpipCoreLockStatistics();
+
+#endif	// TCPIPCORELOCKPROFILER_HPP_
@@ -0,0 +1,293 @@
+/**
+ * \file
+ * \brief Definitions related to report-by-exception telemetry
+ *
+ * Data points are sampled by TelemetryEngine from the main loop of the application, so the period of the main loop
+ * (50 ms) is the resolution of all schedules. lwIP's MQTT client calls tcp_output() after each mqtt_publish(), so
+ * publishing each selected value separately would send each of them in its own TCP segment. Instead all values
+ * selected in one call to publishTelemetry() are encoded as MQTT PUBLISH packets with QoS 0 (which need no packet ID
+ * and no state in MQTT client) and written directly to the connection of MQTT client with one altcp_write(). This is
+ * done only when output ring buffer of MQTT client is empty, so that the packets are not interleaved with packets
+ * queued there. With TELEMETRY_CBOR all these values are encoded as one CBOR batch (see encodeTelemetryBatch()), so
+ * they are sent in one PUBLISH packet, with payload smaller than the sum of topics and values published separately.
+ *
+ * Data points of the board are measured with ADC1 in single conversions started by software. Internal reference
+ * voltage is converted before each sample and used to compensate readings for actual analog supply voltage, with
+ * factory calibration values from system memory.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "telemetry.hpp"
+
+#include "mqttMetrics.hpp"
+#include "mqttTopics.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/TickClock.hpp"
+
+#include "stm32f7xx_hal.h"
+
+#include "lwip/apps/mqtt.h"
+#include "lwip/apps/mqtt_priv.h"
+
+#include "lwip/altcp.h"
+#include "lwip/tcpip.h"
+
+#include <iterator>
+
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// state of telemetry
+struct Telemetry
+{
+	/// buffer for MQTT PUBLISH packets written in one batch
+	uint8_t buffer[768];
+
+	/// number of published values
+	uint32_t published;
+
+	/// number of TCP writes with published values
+	uint32_t batches;
+
+	/// number of values which could not be written and were left for the next sample
+	uint32_t deferred;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// ADC channel of internal reference voltage
+constexpr uint32_t vrefintChannel {17};
+
+/// ADC channel of temperature sensor
+constexpr uint32_t temperatureChannel {18};
+
+/// address of raw value of internal reference voltage measured at 30 degrees Celsius and VDDA = 3.3 V
+const volatile uint16_t* const vrefintCalibration {reinterpret_cast<const volatile uint16_t*>(0x1ff0f44a)};
+
+/// address of raw value of temperature sensor measured at 30 degrees Celsius and VDDA = 3.3 V
+const volatile uint16_t* const temperatureCalibration30 {reinterpret_cast<const volatile uint16_t*>(0x1ff0f44c)};
+
+/// address of raw value of temperature sensor measured at 110 degrees Celsius and VDDA = 3.3 V
+const volatile uint16_t* const temperatureCalibration110 {reinterpret_cast<const volatile uint16_t*>(0x1ff0f44e)};
+
+/// max number of values published in one batch
+constexpr size_t maxBatchSize {8};
+
+/// engine of telemetry
+TelemetryEngine<16> telemetryEngine;
+
+/// state of telemetry
+Telemetry telemetry;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \return current time of tick clock, milliseconds, wrapped to 32 bits
+ */
+
+uint32_t getTime()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+			distortos::TickClock::now().time_since_epoch()).count();
+}
+
+/**
+ * \brief Converts one channel of ADC1.
+ *
+ * \param [in] channel is the converted channel
+ *
+ * \return raw result of conversion
+ */
+
+uint32_t convert(const uint32_t channel)
+{
+	ADC1->SQR3 = channel;
+	ADC1->CR2 |= ADC_CR2_SWSTART;
+	while ((ADC1->SR & ADC_SR_EOC) == 0);
+	return ADC1->DR;
+}
+
+/**
+ * \brief Samples die temperature.
+ *
+ * \return die temperature, tenths of degree Celsius
+ */
+
+int32_t sampleTemperature(const void*)
+{
+	const auto vrefint = convert(vrefintChannel);
+	const auto raw = convert(temperatureChannel);
+	if (vrefint == 0)
+		return {};
+
+	// raw value scaled to VDDA = 3.3 V, at which calibration values were measured
+	const int32_t scaled = raw * *vrefintCalibration / vrefint;
+	const int32_t calibration30 {*temperatureCalibration30};
+	const int32_t calibration110 {*temperatureCalibration110};
+	return 300 + (scaled - calibration30) * (1100 - 300) / (calibration110 - calibration30);
+}
+
+/**
+ * \brief Samples analog supply voltage.
+ *
+ * \return analog supply voltage, millivolts
+ */
+
+int32_t sampleVdda(const void*)
+{
+	const auto vrefint = convert(vrefintChannel);
+	return vrefint == 0 ? 0 : 3300 * *vrefintCalibration / vrefint;
+}
+
+/// die temperature
+const TelemetryPoint temperaturePoint {"temperature", sampleTemperature, {}, 5, 1000, 5000, 300000, 1};
+
+/// analog supply voltage
+const TelemetryPoint vddaPoint {"vdda", sampleVdda, {}, 20, 1000, 5000, 300000, 3};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| TelemetryStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int TelemetryStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize,
+		char* const payload, const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "telemetry");
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto ret = sniprintf(payload, payloadSize, "points=%zu samples=%lu published=%lu batches=%lu deferred=%lu",
+			telemetryEngine.size(), static_cast<unsigned long>(telemetryEngine.getSamples()),
+			static_cast<unsigned long>(telemetry.published), static_cast<unsigned long>(telemetry.batches),
+			static_cast<unsigned long>(telemetry.deferred));
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t TelemetryStatisticsSource::getCount() const
+{
+	return 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void publishTelemetry(mqtt_client_s& client)
+{
+	const auto now = getTime();
+	TelemetryUpdate updates[maxBatchSize];
+	const auto count = telemetryEngine.sample(now, updates, std::size(updates));
+	if (count == 0)
+		return;
+
+#if TELEMETRY_CBOR == 1
+
+	TelemetrySample samples[maxBatchSize];
+	for (size_t i {}; i < count; ++i)
+		samples[i] = {&telemetryEngine.getPoint(updates[i].point), now, updates[i].value};
+
+	uint8_t payload[sizeof(telemetry.buffer) / 2];
+	CborBufferWriter writer {payload, sizeof(payload)};
+	CborEncoder<CborBufferWriter> encoder {writer};
+	const auto valid = encodeTelemetryBatch(encoder, now, samples, count);
+	const size_t length {valid == true ? encodeMqttPublish(telemetry.buffer, sizeof(telemetry.buffer),
+			TELEMETRY_TOPIC_PREFIX, "batch", payload, writer.getLength()) : 0};
+	const size_t encoded {length != 0 ? count : 0};
+	const size_t packets {1};
+
+#else	// TELEMETRY_CBOR != 1
+
+	size_t length {};
+	size_t encoded {};
+	for (; encoded < count; ++encoded)
+	{
+		const auto& point = telemetryEngine.getPoint(updates[encoded].point);
+		char payload[13];
+		const auto payloadLength = formatTelemetryValue(updates[encoded].value, point.decimals, payload,
+				sizeof(payload));
+		const auto packetLength = encodeMqttPublish(telemetry.buffer + length, sizeof(telemetry.buffer) - length,
+				TELEMETRY_TOPIC_PREFIX, point.topic, payload, payloadLength);
+		if (packetLength == 0)
+			break;
+
+		length += packetLength;
+	}
+	const auto packets = encoded;
+
+#endif	// TELEMETRY_CBOR != 1
+
+	err_t ret {ERR_MEM};
+	LOCK_TCPIP_CORE();
+	if (encoded != 0 && mqtt_client_is_connected(&client) != 0 && client.output.put == client.output.get)
+	{
+		ret = altcp_write(client.conn, telemetry.buffer, length, TCP_WRITE_FLAG_COPY);
+		if (ret == ERR_OK)
+			altcp_output(client.conn);
+	}
+	for (size_t i {}; i < packets; ++i)
+		recordMqttPublish(ret);
+	UNLOCK_TCPIP_CORE();
+
+	if (ret != ERR_OK)
+	{
+		telemetry.deferred += count;
+		return;
+	}
+
+	telemetryEngine.commit(updates, encoded, now);
+	telemetry.published += encoded;
+	++telemetry.batches;
+	telemetry.deferred += count - encoded;
+}
+
+bool registerTelemetryPoint(const TelemetryPoint& point)
+{
+	return telemetryEngine.add(point, getTime());
+}
+
+void resetTelemetry()
+{
+	telemetryEngine.reset(getTime());
+}
+
+void startTelemetry()
+{
+	RCC->APB2ENR |= RCC_APB2ENR_ADC1EN;
+	RCC->APB2ENR;	// read back to make sure that the clock is enabled before ADC is accessed
+
+	// ADC clock is PCLK2 / 4, temperature sensor requires sampling time of at least 10 us - 480 cycles is ~18 us
+	ADC123_COMMON->CCR = ADC_CCR_TSVREFE | ADC_CCR_ADCPRE_0;
+	ADC1->SMPR1 = ADC_SMPR1_SMP17 | ADC_SMPR1_SMP18;
+	ADC1->CR2 = ADC_CR2_ADON;
+
+	for (const auto point : {&temperaturePoint, &vddaPoint})
+	{
+		const auto ret = registerTelemetryPoint(*point);
+		assert(ret == true);
+	}
+}
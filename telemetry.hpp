@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \brief Declarations related to report-by-exception telemetry
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TELEMETRY_HPP_
+#define TELEMETRY_HPP_
+
+#include "StatisticsSource.hpp"
+#include "TelemetryEngine.hpp"
+
+struct mqtt_client_s;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Source of statistics of telemetry.
+ *
+ * Statistics are published in "stats/telemetry" topic.
+ */
+
+class TelemetryStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats statistics of telemetry.
+	 *
+	 * Payload has following format: "points=<points> samples=<samples> published=<published> batches=<batches>
+	 * deferred=<deferred>", where "points" is the number of registered data points, "samples" is the number of samples
+	 * of all data points, "published" is the number of published values, "batches" is the number of TCP writes with
+	 * published values and "deferred" is the number of values which could not be written and were left for the next
+	 * sample.
+	 *
+	 * \param [in] index is the index of entry, must be 0
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of entries - 1
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Publishes telemetry.
+ *
+ * Samples all data points which are due and publishes values selected by TelemetryEngine in TELEMETRY_TOPIC_PREFIX
+ * "<topic>" topics, with QoS 0. All values selected in one call are encoded as MQTT PUBLISH packets into one buffer and
+ * written to the connection of MQTT client at once, so they are sent in one TCP segment instead of one segment per
+ * value. With TELEMETRY_CBOR all these values are instead encoded with encodeTelemetryBatch() as payload of one packet
+ * in TELEMETRY_TOPIC_PREFIX "batch" topic. Values which could not be written (e.g. when packets queued by MQTT client
+ * are waiting for space in send buffer of the connection) are evaluated again in their next sample.
+ *
+ * \warning This function may be called only from main thread, lwIP core must not be locked.
+ *
+ * \param [in] client is a reference to connected MQTT client
+ */
+
+void publishTelemetry(mqtt_client_s& client);
+
+/**
+ * \brief Registers data point of telemetry.
+ *
+ * \warning This function may be called only from main thread.
+ *
+ * \param [in] point is a reference to data point, must stay valid forever
+ *
+ * \return true if data point was registered, false if there's no space for it or it is invalid
+ */
+
+bool registerTelemetryPoint(const TelemetryPoint& point);
+
+/**
+ * \brief Resets telemetry, so that values of all data points are published again.
+ *
+ * Should be called after each connection to MQTT broker.
+ *
+ * \warning This function may be called only from main thread.
+ */
+
+void resetTelemetry();
+
+/**
+ * \brief Starts telemetry with data points of the board.
+ *
+ * Registers die temperature ("temperature", degrees Celsius with 1 decimal, deadband 0.5) and analog supply voltage
+ * ("vdda", volts with 3 decimals, deadband 0.02), both measured with ADC1 and sampled every second, published at most
+ * every 5 seconds and at least every 5 minutes.
+ *
+ * \warning This function may be called only from main thread.
+ */
+
+void startTelemetry();
+
+#endif	// TELEMETRY_HPP_
@@ -0,0 +1,579 @@
+/**
+ * \file
+ * \brief TLSF-based implementation of malloc() & friends
+ *
+ * Newlib's allocator is replaced by Tlsf, which gets the whole heap (from `__heap_start` to `__heap_end`) on first use.
+ * Both reentrant (`_malloc_r()`, ...) and regular (`malloc()`, ...) variants of functions are provided - the latter
+ * ones, together with `operator new`, allow to attribute each allocation to its call site. Call site index and offset
+ * of user's memory are stored in a small prefix placed right before the memory returned to the user.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "tlsfMalloc.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/FATAL_ERROR.h"
+
+#include <malloc.h>
+#include <reent.h>
+
+#include <algorithm>
+#include <new>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+/// beginning of heap, defined in linker script
+extern "C" char __heap_start[];
+
+/// end of heap, defined in linker script
+extern "C" char __heap_end[];
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// prefix placed right before memory returned to the user
+struct AllocationPrefix
+{
+	/// index of call site in callSites
+	uint16_t callSite;
+
+	/// offset of user's memory from the beginning of block, bytes
+	uint16_t offset;
+};
+
+/// RAII lock of newlib's malloc lock
+class MallocLock
+{
+public:
+
+	/**
+	 * \brief MallocLock's constructor
+	 *
+	 * \param [in] reent is a pointer to newlib's reentrancy structure
+	 */
+
+	explicit MallocLock(_reent* const reent) :
+			reent_{reent}
+	{
+		__malloc_lock(reent_);
+	}
+
+	/**
+	 * \brief MallocLock's destructor
+	 */
+
+	~MallocLock()
+	{
+		__malloc_unlock(reent_);
+	}
+
+	MallocLock(const MallocLock&) = delete;
+	MallocLock(MallocLock&&) = delete;
+	const MallocLock& operator=(const MallocLock&) = delete;
+	MallocLock& operator=(MallocLock&&) = delete;
+
+private:
+
+	/// pointer to newlib's reentrancy structure
+	_reent* reent_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// max number of call sites with statistics, the last entry is shared by all call sites which didn't fit
+constexpr size_t callSitesMax {32};
+
+/// max alignment which can be requested with memalign()
+constexpr size_t alignmentMax {UINT16_MAX / 2 + 1};
+
+/// statistics of call sites
+HeapCallSiteStatistics callSites[callSitesMax];
+
+/// number of used entries in callSites
+size_t callSitesCount;
+
+/// storage for Tlsf object
+alignas(Tlsf) uint8_t tlsfStorage[sizeof(Tlsf)];
+
+/// pointer to Tlsf object, nullptr if it was not constructed yet
+Tlsf* tlsf;
+
+/// number of allocations after the heap was sealed
+size_t allocationsAfterSeal;
+
+/// true if the heap was sealed with sealHeap(), false otherwise
+bool heapSealed;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Gets Tlsf object, constructing it on first use.
+ *
+ * \pre Malloc lock is locked.
+ *
+ * \return reference to Tlsf object which manages the heap
+ */
+
+Tlsf& getTlsf()
+{
+	if (tlsf != nullptr)
+		return *tlsf;
+
+	tlsf = new (tlsfStorage) Tlsf;
+	const auto heapStart = (reinterpret_cast<uintptr_t>(__heap_start) + Tlsf::alignment - 1) / Tlsf::alignment *
+			Tlsf::alignment;
+	const auto heapEnd = reinterpret_cast<uintptr_t>(__heap_end);
+	const auto ret = tlsf->addPool(reinterpret_cast<void*>(heapStart), heapEnd - heapStart);
+	if (ret == false)
+		FATAL_ERROR("Could not add heap to TLSF allocator");
+
+	return *tlsf;
+}
+
+/**
+ * \brief Finds call site in callSites, adding it if needed.
+ *
+ * \pre Malloc lock is locked.
+ *
+ * \param [in] address is the address of call site
+ *
+ * \return index of call site in callSites
+ */
+
+size_t findCallSite(const uintptr_t address)
+{
+	for (size_t i {}; i < callSitesCount; ++i)
+		if (callSites[i].address == address)
+			return i;
+
+	if (callSitesCount < callSitesMax - 1)
+	{
+		callSites[callSitesCount].address = address;
+		return callSitesCount++;
+	}
+
+	// shared entry for all other call sites
+	callSitesCount = callSitesMax;
+	return callSitesMax - 1;
+}
+
+/**
+ * \brief Adds allocated block to statistics of call site.
+ *
+ * \pre Malloc lock is locked.
+ *
+ * \param [in] index is the index of call site in callSites
+ * \param [in] size is the size of allocated block, bytes
+ */
+
+void addToCallSite(const size_t index, const size_t size)
+{
+	if (heapSealed == true)
+		++allocationsAfterSeal;
+
+	auto& callSite = callSites[index];
+	++callSite.allocations;
+	++callSite.liveBlocks;
+	callSite.liveSize += size;
+	callSite.maxLiveSize = std::max(callSite.maxLiveSize, callSite.liveSize);
+}
+
+/**
+ * \brief Removes deallocated block from statistics of call site.
+ *
+ * \pre Malloc lock is locked.
+ *
+ * \param [in] index is the index of call site in callSites
+ * \param [in] size is the size of deallocated block, bytes
+ */
+
+void removeFromCallSite(const size_t index, const size_t size)
+{
+	auto& callSite = callSites[index];
+	assert(callSite.liveBlocks != 0 && callSite.liveSize >= size);
+	--callSite.liveBlocks;
+	callSite.liveSize -= size;
+}
+
+/**
+ * \param [in] pointer is a pointer to user's memory
+ *
+ * \return reference to prefix of \a pointer
+ */
+
+AllocationPrefix& getPrefix(void* const pointer)
+{
+	return *(static_cast<AllocationPrefix*>(pointer) - 1);
+}
+
+/**
+ * \brief Allocates memory and attributes it to call site.
+ *
+ * \param [in] reent is a pointer to newlib's reentrancy structure
+ * \param [in] alignment is the requested alignment of memory, must be a power of 2
+ * \param [in] size is the requested size of memory, bytes
+ * \param [in] callSite is the address of call site
+ *
+ * \return pointer to allocated memory, nullptr on failure (errno is set to ENOMEM or EINVAL)
+ */
+
+void* allocate(_reent* const reent, const size_t alignment, const size_t size, const void* const callSite)
+{
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > alignmentMax)
+	{
+		reent->_errno = EINVAL;
+		return {};
+	}
+
+	const auto offset = std::max(alignment, Tlsf::alignment);
+	if (size > SIZE_MAX - offset)
+	{
+		reent->_errno = ENOMEM;
+		return {};
+	}
+
+	const MallocLock mallocLock {reent};
+	auto& tlsf = getTlsf();
+	const auto memory = static_cast<uint8_t*>(alignment > Tlsf::alignment ?
+			tlsf.allocateAligned(alignment, offset + size) : tlsf.allocate(offset + size));
+	if (memory == nullptr)
+	{
+		reent->_errno = ENOMEM;
+		return {};
+	}
+
+	const auto index = findCallSite(reinterpret_cast<uintptr_t>(callSite));
+	addToCallSite(index, Tlsf::getUsableSize(memory));
+	const auto pointer = memory + offset;
+	getPrefix(pointer) = {static_cast<uint16_t>(index), static_cast<uint16_t>(offset)};
+	return pointer;
+}
+
+/**
+ * \brief Deallocates memory.
+ *
+ * \param [in] reent is a pointer to newlib's reentrancy structure
+ * \param [in] pointer is a pointer to memory which will be deallocated, nullptr is ignored
+ */
+
+void deallocate(_reent* const reent, void* const pointer)
+{
+	if (pointer == nullptr)
+		return;
+
+	const auto prefix = getPrefix(pointer);
+	const auto memory = static_cast<uint8_t*>(pointer) - prefix.offset;
+
+	const MallocLock mallocLock {reent};
+	assert(tlsf != nullptr);
+	removeFromCallSite(prefix.callSite, Tlsf::getUsableSize(memory));
+	tlsf->deallocate(memory);
+}
+
+/**
+ * \brief Changes size of memory and attributes it to call site.
+ *
+ * \param [in] reent is a pointer to newlib's reentrancy structure
+ * \param [in] pointer is a pointer to memory which will be resized, nullptr is equivalent to allocate()
+ * \param [in] size is the new size of memory, bytes, 0 is equivalent to deallocate()
+ * \param [in] callSite is the address of call site
+ *
+ * \return pointer to resized memory, nullptr on failure (errno is set to ENOMEM, \a pointer is not modified) or if
+ * \a size is 0
+ */
+
+void* reallocate(_reent* const reent, void* const pointer, const size_t size, const void* const callSite)
+{
+	if (pointer == nullptr)
+		return allocate(reent, Tlsf::alignment, size, callSite);
+
+	if (size == 0)
+	{
+		deallocate(reent, pointer);
+		return {};
+	}
+
+	const auto prefix = getPrefix(pointer);
+	if (size > SIZE_MAX - prefix.offset)
+	{
+		reent->_errno = ENOMEM;
+		return {};
+	}
+
+	const auto memory = static_cast<uint8_t*>(pointer) - prefix.offset;
+
+	// Tlsf::reallocate() preserves only Tlsf::alignment, so block with greater alignment (from memalign()) is moved to
+	// a new block with the same alignment
+	if (prefix.offset > Tlsf::alignment)
+	{
+		const auto newPointer = allocate(reent, prefix.offset, size, callSite);
+		if (newPointer == nullptr)
+			return {};
+
+		memcpy(newPointer, pointer, std::min(Tlsf::getUsableSize(memory) - prefix.offset, size));
+		deallocate(reent, pointer);
+		return newPointer;
+	}
+
+	const MallocLock mallocLock {reent};
+	assert(tlsf != nullptr);
+	const auto oldSize = Tlsf::getUsableSize(memory);
+	// blocks are aligned to Tlsf::alignment, which is also the offset of user's memory in the block
+	const auto newMemory = static_cast<uint8_t*>(tlsf->reallocate(memory, prefix.offset + size));
+	if (newMemory == nullptr)
+	{
+		reent->_errno = ENOMEM;
+		return {};
+	}
+
+	removeFromCallSite(prefix.callSite, oldSize);
+	const auto index = findCallSite(reinterpret_cast<uintptr_t>(callSite));
+	addToCallSite(index, Tlsf::getUsableSize(newMemory));
+	const auto newPointer = newMemory + prefix.offset;
+	getPrefix(newPointer) = {static_cast<uint16_t>(index), prefix.offset};
+	return newPointer;
+}
+
+/**
+ * \brief Allocates zero-initialized memory for an array and attributes it to call site.
+ *
+ * \param [in] reent is a pointer to newlib's reentrancy structure
+ * \param [in] elements is the number of elements
+ * \param [in] size is the size of single element, bytes
+ * \param [in] callSite is the address of call site
+ *
+ * \return pointer to allocated memory, nullptr on failure (errno is set to ENOMEM)
+ */
+
+void* allocateZeroed(_reent* const reent, const size_t elements, const size_t size, const void* const callSite)
+{
+	size_t totalSize;
+	if (__builtin_mul_overflow(elements, size, &totalSize) == true)
+	{
+		reent->_errno = ENOMEM;
+		return {};
+	}
+
+	const auto pointer = allocate(reent, Tlsf::alignment, totalSize, callSite);
+	if (pointer != nullptr)
+		memset(pointer, 0, totalSize);
+	return pointer;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| HeapStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int HeapStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize, char* const payload,
+		const size_t payloadSize) const
+{
+	if (index == 0)
+	{
+		{
+			const auto ret = sniprintf(topic, topicSize, "heap/summary");
+			if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+				return -1;
+		}
+
+		const auto statistics = getHeapStatistics();
+		const auto fragmentation = statistics.freeSize != 0 ?
+				100 - statistics.largestFreeBlockSize * 100 / statistics.freeSize : 0;
+		const auto ret = sniprintf(payload, payloadSize,
+				"used=%zu max=%zu free=%zu largest=%zu fragmentation=%zu%% blocks=%zu failures=%zu late=%zu",
+				statistics.usedSize, statistics.maxUsedSize, statistics.freeSize, statistics.largestFreeBlockSize,
+				fragmentation, statistics.freeBlocks, statistics.failures, getHeapAllocationsAfterSeal());
+		if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+			return -1;
+
+		return ret;
+	}
+
+	const auto statistics = getHeapCallSiteStatistics(index - 1);
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "heap/0x%08" PRIxPTR, statistics.address);
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	const auto ret = sniprintf(payload, payloadSize, "allocations=%zu live=%zu size=%zu max=%zu",
+			statistics.allocations, statistics.liveBlocks, statistics.liveSize, statistics.maxLiveSize);
+	if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+		return -1;
+
+	return ret;
+}
+
+size_t HeapStatisticsSource::getCount() const
+{
+	return 1 + getHeapCallSiteCount();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+size_t getHeapAllocationsAfterSeal()
+{
+	const MallocLock mallocLock {_REENT};
+	return allocationsAfterSeal;
+}
+
+size_t getHeapCallSiteCount()
+{
+	const MallocLock mallocLock {_REENT};
+	return callSitesCount;
+}
+
+HeapCallSiteStatistics getHeapCallSiteStatistics(const size_t index)
+{
+	const MallocLock mallocLock {_REENT};
+	assert(index < callSitesCount);
+	return callSites[index];
+}
+
+Tlsf::Statistics getHeapStatistics()
+{
+	const MallocLock mallocLock {_REENT};
+	return getTlsf().getStatistics();
+}
+
+void sealHeap()
+{
+	const MallocLock mallocLock {_REENT};
+	heapSealed = true;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions' replacements
++---------------------------------------------------------------------------------------------------------------------*/
+
+void* operator new(const size_t size)
+{
+	const auto pointer = allocate(_REENT, Tlsf::alignment, size, __builtin_return_address(0));
+	if (pointer == nullptr)
+		FATAL_ERROR("Out of memory in operator new");
+
+	return pointer;
+}
+
+void* operator new[](const size_t size)
+{
+	const auto pointer = allocate(_REENT, Tlsf::alignment, size, __builtin_return_address(0));
+	if (pointer == nullptr)
+		FATAL_ERROR("Out of memory in operator new[]");
+
+	return pointer;
+}
+
+void* operator new(const size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(_REENT, Tlsf::alignment, size, __builtin_return_address(0));
+}
+
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(_REENT, Tlsf::alignment, size, __builtin_return_address(0));
+}
+
+void operator delete(void* const pointer) noexcept
+{
+	deallocate(_REENT, pointer);
+}
+
+void operator delete[](void* const pointer) noexcept
+{
+	deallocate(_REENT, pointer);
+}
+
+void operator delete(void* const pointer, size_t) noexcept
+{
+	deallocate(_REENT, pointer);
+}
+
+void operator delete[](void* const pointer, size_t) noexcept
+{
+	deallocate(_REENT, pointer);
+}
+
+extern "C"
+{
+
+void* malloc(const size_t size)
+{
+	return allocate(_REENT, Tlsf::alignment, size, __builtin_return_address(0));
+}
+
+void free(void* const pointer)
+{
+	deallocate(_REENT, pointer);
+}
+
+void* calloc(const size_t elements, const size_t size)
+{
+	return allocateZeroed(_REENT, elements, size, __builtin_return_address(0));
+}
+
+void* realloc(void* const pointer, const size_t size)
+{
+	return reallocate(_REENT, pointer, size, __builtin_return_address(0));
+}
+
+void* memalign(const size_t alignment, const size_t size)
+{
+	return allocate(_REENT, alignment, size, __builtin_return_address(0));
+}
+
+void* _malloc_r(_reent* const reent, const size_t size)
+{
+	return allocate(reent, Tlsf::alignment, size, __builtin_return_address(0));
+}
+
+void _free_r(_reent* const reent, void* const pointer)
+{
+	deallocate(reent, pointer);
+}
+
+void* _calloc_r(_reent* const reent, const size_t elements, const size_t size)
+{
+	return allocateZeroed(reent, elements, size, __builtin_return_address(0));
+}
+
+void* _realloc_r(_reent* const reent, void* const pointer, const size_t size)
+{
+	return reallocate(reent, pointer, size, __builtin_return_address(0));
+}
+
+void* _memalign_r(_reent* const reent, const size_t alignment, const size_t size)
+{
+	return allocate(reent, alignment, size, __builtin_return_address(0));
+}
+
+size_t _malloc_usable_size_r(_reent*, void* const pointer)
+{
+	if (pointer == nullptr)
+		return {};
+
+	const auto offset = getPrefix(pointer).offset;
+	return Tlsf::getUsableSize(static_cast<uint8_t*>(pointer) - offset) - offset;
+}
+
+}	// extern "C"
@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \brief Declarations related to TLSF-based implementation of malloc() & friends
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TLSFMALLOC_HPP_
+#define TLSFMALLOC_HPP_
+
+#include "StatisticsSource.hpp"
+#include "Tlsf.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// statistics of allocations from single call site
+struct HeapCallSiteStatistics
+{
+	/// address of call site (return address of malloc(), operator new, ...), 0 for "all other call sites"
+	uintptr_t address;
+
+	/// number of successful allocations
+	size_t allocations;
+
+	/// number of currently allocated blocks
+	size_t liveBlocks;
+
+	/// size of currently allocated blocks, bytes
+	size_t liveSize;
+
+	/// high-water mark of \a liveSize, bytes
+	size_t maxLiveSize;
+};
+
+/**
+ * \brief Source of heap statistics.
+ *
+ * Summary is published in "stats/heap/summary" topic, statistics of each call site are published in
+ * "stats/heap/<address>" topics.
+ */
+
+class HeapStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats summary or statistics of one call site.
+	 *
+	 * Payload of summary has following format: "used=<used> max=<max> free=<free> largest=<largest>
+	 * fragmentation=<fragmentation>% blocks=<blocks> failures=<failures> late=<late>", where "late" is the number of
+	 * allocations after the heap was sealed. Payload of call site has following format:
+	 * "allocations=<allocations> live=<live blocks> size=<live size> max=<max live size>".
+	 *
+	 * \param [in] index is the index of entry, 0 - summary, [1; getCount()) - call sites
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of entries - summary and all call sites
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \return number of allocations (including reallocations) done after the heap was sealed with sealHeap()
+ */
+
+size_t getHeapAllocationsAfterSeal();
+
+/**
+ * \return number of call sites with statistics
+ */
+
+size_t getHeapCallSiteCount();
+
+/**
+ * \brief Gets statistics of one call site.
+ *
+ * \param [in] index is the index of call site, [0; getHeapCallSiteCount())
+ *
+ * \return statistics of selected call site
+ */
+
+HeapCallSiteStatistics getHeapCallSiteStatistics(size_t index);
+
+/**
+ * \return statistics of heap
+ */
+
+Tlsf::Statistics getHeapStatistics();
+
+/**
+ * \brief Seals the heap.
+ *
+ * Should be called when initialization of the application is finished. Allocations are still possible after the heap is
+ * sealed, but they are counted, so the application can verify that it doesn't use the heap during normal operation.
+ */
+
+void sealHeap();
+
+#endif	// TLSFMALLOC_HPP_
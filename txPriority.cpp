@@ -0,0 +1,184 @@
+/**
+ * \file
+ * \brief Definitions related to priority queues of transmitted Ethernet frames
+ *
+ * Ethernet DMA has only a few transmit descriptors, so during a bulk TCP transfer they are all busy most of the time.
+ * Instead of failing, lowLevelOutput() passes frames which don't fit to transmitWithPriority(), which queues them by
+ * class. The queues are drained by Ethernet input thread, woken by "Ethernet TX transfer completed" interrupt, which
+ * is enabled only while some frames are queued. Queueing delay is measured from the call of transmitWithPriority() to
+ * the moment the frame is passed to Ethernet DMA.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "txPriority.hpp"
+
+#include "cycleCounter.hpp"
+#include "formatLog2Histogram.hpp"
+
+#include "distortos/assert.h"
+
+#include "lwip/pbuf.h"
+#include "lwip/tcpip.h"
+
+#include <iterator>
+
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// frame waiting for a free DMA descriptor
+struct QueuedFrame
+{
+	/// referenced frame
+	pbuf* frame;
+
+	/// value of cycle counter when the frame was queued
+	uint32_t queued;
+};
+
+/// statistics of priority queues of transmitted frames
+struct TxPriorityStatistics
+{
+	/// histograms of queueing delays of all classes
+	TxQueueingDelayHistogram delays[static_cast<size_t>(TxClass::count)];
+
+	/// numbers of frames dropped because the queue of their class was full
+	uint32_t dropped[static_cast<size_t>(TxClass::count)];
+
+	/// number of queued frames
+	uint32_t queued;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// names of classes, used in topics
+const char* const classNames[]
+{
+		"control",
+		"bulk",
+};
+
+static_assert(std::size(classNames) == static_cast<size_t>(TxClass::count));
+
+/// queues of transmitted frames, bulk frame is served after 8 control frames in a row
+TxScheduler<QueuedFrame, 16, 8> txScheduler;
+
+/// statistics of priority queues of transmitted frames
+TxPriorityStatistics txPriorityStatistics;
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| TxPriorityStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int TxPriorityStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize,
+		char* const payload, const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	if (index == 0)
+	{
+		LOCK_TCPIP_CORE();
+		const auto queued = txPriorityStatistics.queued;
+		const auto controlDropped = txPriorityStatistics.dropped[static_cast<size_t>(TxClass::control)];
+		const auto bulkDropped = txPriorityStatistics.dropped[static_cast<size_t>(TxClass::bulk)];
+		const auto guarded = txScheduler.getStarvationGuardCount();
+		UNLOCK_TCPIP_CORE();
+
+		{
+			const auto ret = sniprintf(topic, topicSize, "txQueue/summary");
+			if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+				return -1;
+		}
+
+		const auto ret = sniprintf(payload, payloadSize,
+				"queued=%lu controlDropped=%lu bulkDropped=%lu guarded=%lu frequency=%lu",
+				static_cast<unsigned long>(queued), static_cast<unsigned long>(controlDropped),
+				static_cast<unsigned long>(bulkDropped), static_cast<unsigned long>(guarded),
+				static_cast<unsigned long>(getCycleCounterFrequency()));
+		if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+			return -1;
+
+		return ret;
+	}
+
+	LOCK_TCPIP_CORE();
+	const auto histogram = txPriorityStatistics.delays[index - 1];
+	UNLOCK_TCPIP_CORE();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "txQueue/%s", classNames[index - 1]);
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	return formatLog2Histogram(histogram, payload, payloadSize);
+}
+
+size_t TxPriorityStatisticsSource::getCount() const
+{
+	return 1 + static_cast<size_t>(TxClass::count);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+err_t transmitWithPriority(pbuf& frame, TransmitFunction& transmit)
+{
+	const auto queued = getCycleCount();
+	// headers of all protocols are always in the first pbuf of the chain
+	const auto txClass = classifyFrame(static_cast<const uint8_t*>(frame.payload), frame.len);
+
+	if (txScheduler.empty() == true)
+	{
+		const auto ret = transmit(frame);
+		if (ret == ERR_OK)
+			txPriorityStatistics.delays[static_cast<size_t>(txClass)].add({});
+		if (ret != ERR_MEM)
+			return ret;
+	}
+
+	if (txScheduler.push(txClass, {&frame, queued}) == false)
+	{
+		++txPriorityStatistics.dropped[static_cast<size_t>(txClass)];
+		return ERR_MEM;
+	}
+
+	pbuf_ref(&frame);
+	++txPriorityStatistics.queued;
+	return transmitQueuedFrames(transmit) == true ? ERR_OK : ERR_INPROGRESS;
+}
+
+bool transmitQueuedFrames(TransmitFunction& transmit)
+{
+	TxClass txClass;
+	QueuedFrame* queuedFrame;
+	while (queuedFrame = txScheduler.front(txClass), queuedFrame != nullptr)
+	{
+		const auto ret = transmit(*queuedFrame->frame);
+		if (ret == ERR_MEM)
+			return false;
+
+		// frame which could not be passed to Ethernet DMA for other reason is dropped
+		if (ret == ERR_OK)
+			txPriorityStatistics.delays[static_cast<size_t>(txClass)].add(getCycleCount() - queuedFrame->queued);
+		pbuf_free(queuedFrame->frame);
+		txScheduler.pop(txClass);
+	}
+
+	return true;
+}
@@ -0,0 +1,114 @@
+/**
+ * \file
+ * \brief Declarations related to priority queues of transmitted Ethernet frames
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TXPRIORITY_HPP_
+#define TXPRIORITY_HPP_
+
+#include "Log2Histogram.hpp"
+#include "StatisticsSource.hpp"
+#include "TxScheduler.hpp"
+
+#include "lwip/err.h"
+
+struct pbuf;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// histogram of queueing delays of one class of transmitted frames, cycles of cycle counter
+using TxQueueingDelayHistogram = Log2Histogram<24>;
+
+/**
+ * \brief Type of function which passes frame to Ethernet DMA.
+ *
+ * \param [in] frame is a reference to transmitted frame (including MAC header)
+ *
+ * \return ERR_OK if frame was passed to Ethernet DMA, ERR_MEM if there was no free DMA descriptor (frame may be
+ * passed again later), other error code if the frame could not be passed to Ethernet DMA (frame should be dropped)
+ */
+
+using TransmitFunction = err_t(const pbuf& frame);
+
+/**
+ * \brief Source of statistics of priority queues of transmitted frames.
+ *
+ * Summary is published in "stats/txQueue/summary" topic, histograms of queueing delays are published in
+ * "stats/txQueue/control" and "stats/txQueue/bulk" topics.
+ */
+
+class TxPriorityStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats summary or histogram of queueing delays of one class.
+	 *
+	 * Payload of summary has following format: "queued=<queued> controlDropped=<controlDropped>
+	 * bulkDropped=<bulkDropped> guarded=<guarded> frequency=<frequency>", where "queued" is the number of frames which
+	 * had to wait for a free DMA descriptor, "controlDropped" and "bulkDropped" are the numbers of frames dropped
+	 * because the queue of their class was full, "guarded" is the number of bulk frames served before waiting control
+	 * frames by the starvation guard and "frequency" is the frequency of cycle counter in Hz. Payload of histogram has
+	 * the same format as in UdpEchoStatisticsSource, frames which were passed to DMA directly are counted in bucket 0.
+	 *
+	 * \param [in] index is the index of entry, 0 - summary, [1; getCount()) - histograms of classes
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of entries - summary and histograms of all classes
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Transmits frame or queues it until a DMA descriptor is free.
+ *
+ * Frame is passed to \a transmit directly only if all queues are empty, otherwise it would overtake frames of the same
+ * class. Queued frame is referenced with pbuf_ref(), so the caller may free it as usual.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] frame is a reference to transmitted frame (including MAC header)
+ * \param [in] transmit is a reference to function which passes frame to Ethernet DMA
+ *
+ * \return ERR_OK if frame was transmitted, ERR_INPROGRESS if it was queued, ERR_MEM if queue of its class is full,
+ * other error code returned by \a transmit if frame could not be passed to Ethernet DMA
+ */
+
+err_t transmitWithPriority(pbuf& frame, TransmitFunction& transmit);
+
+/**
+ * \brief Transmits queued frames with priority of their classes.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ *
+ * \param [in] transmit is a reference to function which passes frame to Ethernet DMA
+ *
+ * \return true if all queues are empty, false if some frames still wait for a free DMA descriptor
+ */
+
+bool transmitQueuedFrames(TransmitFunction& transmit);
+
+#endif	// TXPRIORITY_HPP_
@@ -0,0 +1,270 @@
+/**
+ * \file
+ * \brief Definitions related to UDP echo responder with latency measurement
+ *
+ * Ethernet driver stamps every received frame which is a UDP echo request with the value of cycle counter at
+ * "Ethernet RX transfer completed" interrupt and at wakeup of Ethernet input thread. These timestamps are passed to
+ * tcpip thread via lock-free ring buffer, along with the address of the frame's pbuf, which is later used to match
+ * them with the datagram in UDP receive callback. The reply is sent synchronously from the callback, so the frame is
+ * passed to Ethernet DMA when udp_sendto() returns. Frames are processed by the stack in the same order as they are
+ * received, so timestamps of the frames which were dropped by the stack before reaching the callback are discarded
+ * during matching.
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "udpEcho.hpp"
+
+#include "cycleCounter.hpp"
+#include "formatLog2Histogram.hpp"
+#include "SpscRingBuffer.hpp"
+
+#include "distortos/assert.h"
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include "lwip/prot/ethernet.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/udp.h"
+#include "lwip/tcpip.h"
+#include "lwip/udp.h"
+
+#include <iterator>
+
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// ingress timestamps of received UDP echo request
+struct IngressTimestamps
+{
+	/// frame with UDP echo request
+	const pbuf* frame;
+
+	/// value of cycle counter at "Ethernet RX transfer completed" interrupt
+	uint32_t interrupt;
+
+	/// value of cycle counter at wakeup of Ethernet input thread
+	uint32_t wakeup;
+};
+
+/// statistics of UDP echo responder
+struct UdpEchoStatistics
+{
+	/// histograms of latencies of all stages
+	UdpEchoHistogram stages[static_cast<size_t>(UdpEchoStage::count)];
+
+	/// number of echoed datagrams
+	uint32_t echoed;
+
+	/// number of echoed datagrams for which ingress timestamps were not found
+	uint32_t unmatched;
+
+	/// number of datagrams which could not be echoed
+	uint32_t errors;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// UDP port of echo service
+constexpr uint16_t echoPort {7};
+
+/// names of stages, used in topics
+const char* const stageNames[]
+{
+		"wakeup",
+		"stack",
+		"transmit",
+		"total",
+};
+
+static_assert(std::size(stageNames) == static_cast<size_t>(UdpEchoStage::count));
+
+/// timestamps of received UDP echo requests, passed from Ethernet input thread to tcpip thread
+SpscRingBuffer<IngressTimestamps, 16> ingressTimestamps;
+
+/// value of cycle counter at the first "Ethernet RX transfer completed" interrupt since the last wakeup
+uint32_t rxInterruptTime;
+
+/// true if rxInterruptTime is valid, false otherwise
+bool rxInterruptPending;
+
+/// value of cycle counter at "Ethernet RX transfer completed" interrupt which woke Ethernet input thread
+uint32_t wakeupInterruptTime;
+
+/// value of cycle counter at the last wakeup of Ethernet input thread
+uint32_t wakeupTime;
+
+/// statistics of UDP echo responder
+UdpEchoStatistics udpEchoStatistics;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief UDP receive callback of echo responder
+ *
+ * Sends the datagram back to its sender and records latencies of all stages.
+ *
+ * \param [in] pcb is a pointer to UDP PCB of echo responder
+ * \param [in] pbuf is a pointer to received datagram
+ * \param [in] address is a pointer to address of sender
+ * \param [in] port is the port of sender
+ */
+
+void udpEchoReceiveCallback(void*, udp_pcb* const pcb, pbuf* const pbuf, const ip_addr_t* const address,
+		const u16_t port)
+{
+	const auto received = getCycleCount();
+
+	IngressTimestamps timestamps;
+	bool matched {};
+	while (matched == false && ingressTimestamps.pop(timestamps) == true)
+		matched = timestamps.frame == pbuf;
+
+	const auto ret = udp_sendto(pcb, pbuf, address, port);
+	const auto transmitted = getCycleCount();
+	pbuf_free(pbuf);
+
+	if (ret != ERR_OK)
+	{
+		++udpEchoStatistics.errors;
+		return;
+	}
+
+	++udpEchoStatistics.echoed;
+	if (matched == false)
+	{
+		++udpEchoStatistics.unmatched;
+		return;
+	}
+
+	auto& stages = udpEchoStatistics.stages;
+	stages[static_cast<size_t>(UdpEchoStage::wakeup)].add(timestamps.wakeup - timestamps.interrupt);
+	stages[static_cast<size_t>(UdpEchoStage::stack)].add(received - timestamps.wakeup);
+	stages[static_cast<size_t>(UdpEchoStage::transmit)].add(transmitted - received);
+	stages[static_cast<size_t>(UdpEchoStage::total)].add(transmitted - timestamps.interrupt);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| UdpEchoStatisticsSource's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int UdpEchoStatisticsSource::format(const size_t index, char* const topic, const size_t topicSize,
+		char* const payload, const size_t payloadSize) const
+{
+	assert(index < getCount());
+
+	if (index == 0)
+	{
+		LOCK_TCPIP_CORE();
+		const auto echoed = udpEchoStatistics.echoed;
+		const auto unmatched = udpEchoStatistics.unmatched;
+		const auto errors = udpEchoStatistics.errors;
+		UNLOCK_TCPIP_CORE();
+
+		{
+			const auto ret = sniprintf(topic, topicSize, "udpEcho/summary");
+			if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+				return -1;
+		}
+
+		const auto ret = sniprintf(payload, payloadSize, "echoed=%lu unmatched=%lu errors=%lu frequency=%lu",
+				static_cast<unsigned long>(echoed), static_cast<unsigned long>(unmatched),
+				static_cast<unsigned long>(errors), static_cast<unsigned long>(getCycleCounterFrequency()));
+		if (ret < 0 || static_cast<size_t>(ret) >= payloadSize)
+			return -1;
+
+		return ret;
+	}
+
+	LOCK_TCPIP_CORE();
+	const auto histogram = udpEchoStatistics.stages[index - 1];
+	UNLOCK_TCPIP_CORE();
+
+	{
+		const auto ret = sniprintf(topic, topicSize, "udpEcho/%s", stageNames[index - 1]);
+		if (ret < 0 || static_cast<size_t>(ret) >= topicSize)
+			return -1;
+	}
+
+	return formatLog2Histogram(histogram, payload, payloadSize);
+}
+
+size_t UdpEchoStatisticsSource::getCount() const
+{
+	return 1 + static_cast<size_t>(UdpEchoStage::count);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void recordEthernetFrame(const pbuf& frame)
+{
+	constexpr size_t minLength {SIZEOF_ETH_HDR + IP_HLEN + UDP_HLEN};
+	if (frame.len < minLength)
+		return;
+
+	const auto ethernetHeader = static_cast<const eth_hdr*>(frame.payload);
+	if (ethernetHeader->type != PP_HTONS(ETHTYPE_IP))
+		return;
+
+	const auto ipHeader = reinterpret_cast<const ip_hdr*>(static_cast<const uint8_t*>(frame.payload) +
+			SIZEOF_ETH_HDR);
+	if (IPH_PROTO(ipHeader) != IP_PROTO_UDP || SIZEOF_ETH_HDR + IPH_HL_BYTES(ipHeader) + UDP_HLEN > frame.len)
+		return;
+
+	const auto udpHeader = reinterpret_cast<const udp_hdr*>(reinterpret_cast<const uint8_t*>(ipHeader) +
+			IPH_HL_BYTES(ipHeader));
+	if (udpHeader->dest != PP_HTONS(echoPort))
+		return;
+
+	// ring buffer is full only if tcpip thread is far behind, such frame will be reported as unmatched
+	ingressTimestamps.push({&frame, wakeupInterruptTime, wakeupTime});
+}
+
+void recordEthernetInputWakeup()
+{
+	wakeupTime = getCycleCount();
+
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+	// without pending interrupt (e.g. frame received after previous wakeup was handled), wakeup stage is 0
+	wakeupInterruptTime = rxInterruptPending == true ? rxInterruptTime : wakeupTime;
+	rxInterruptPending = {};
+}
+
+void recordEthernetRxInterrupt()
+{
+	if (rxInterruptPending == true)
+		return;
+
+	rxInterruptTime = getCycleCount();
+	rxInterruptPending = true;
+}
+
+void startUdpEcho()
+{
+	const auto pcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+	assert(pcb != nullptr);
+
+	{
+		const auto ret = udp_bind(pcb, IP_ANY_TYPE, echoPort);
+		assert(ret == ERR_OK);
+	}
+
+	udp_recv(pcb, udpEchoReceiveCallback, {});
+}
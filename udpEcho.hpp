@@ -0,0 +1,128 @@
+/**
+ * \file
+ * \brief Declarations related to UDP echo responder with latency measurement
+ *
+ * \author Copyright (C) 2026 agent agent@local
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef UDPECHO_HPP_
+#define UDPECHO_HPP_
+
+#include "Log2Histogram.hpp"
+#include "StatisticsSource.hpp"
+
+struct pbuf;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// histogram of latencies of one stage of UDP echo, cycles of cycle counter
+using UdpEchoHistogram = Log2Histogram<24>;
+
+/// stage of UDP echo, for which latencies are measured
+enum class UdpEchoStage : uint8_t
+{
+	/// from "Ethernet RX transfer completed" interrupt to wakeup of Ethernet input thread
+	wakeup,
+	/// from wakeup of Ethernet input thread to UDP receive callback in tcpip thread
+	stack,
+	/// from UDP receive callback to passing the reply to Ethernet DMA
+	transmit,
+	/// from "Ethernet RX transfer completed" interrupt to passing the reply to Ethernet DMA
+	total,
+
+	/// number of stages
+	count
+};
+
+/**
+ * \brief Source of statistics of UDP echo responder.
+ *
+ * Summary is published in "stats/udpEcho/summary" topic, histograms of stages are published in
+ * "stats/udpEcho/wakeup", "stats/udpEcho/stack", "stats/udpEcho/transmit" and "stats/udpEcho/total" topics.
+ */
+
+class UdpEchoStatisticsSource : public StatisticsSource
+{
+public:
+
+	/**
+	 * \brief Formats summary or histogram of one stage.
+	 *
+	 * Payload of summary has following format: "echoed=<echoed> unmatched=<unmatched> errors=<errors>
+	 * frequency=<frequency>", where "echoed" is the number of echoed datagrams, "unmatched" is the number of echoed
+	 * datagrams for which ingress timestamps were not found (not included in histograms), "errors" is the number of
+	 * datagrams which could not be echoed and "frequency" is the frequency of cycle counter in Hz. Payload of histogram
+	 * has following format: "count=<count> max=<max> mean=<mean> hist=<first>:<bucket>,<bucket>,...", where all times
+	 * are in cycles of cycle counter and only buckets from the first non-empty (with index <first>) to the last
+	 * non-empty are listed.
+	 *
+	 * \param [in] index is the index of entry, 0 - summary, [1; getCount()) - histograms of stages
+	 * \param [out] topic is a buffer for topic of entry
+	 * \param [in] topicSize is the size of \a topic, bytes
+	 * \param [out] payload is a buffer for payload of entry
+	 * \param [in] payloadSize is the size of \a payload, bytes
+	 *
+	 * \return length of formatted payload (without terminating null character) on success, negative value if the entry
+	 * could not be formatted
+	 */
+
+	int format(size_t index, char* topic, size_t topicSize, char* payload, size_t payloadSize) const override;
+
+	/**
+	 * \return number of entries - summary and histograms of all stages
+	 */
+
+	size_t getCount() const override;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Records ingress timestamps of received frame.
+ *
+ * Timestamps are recorded only for frames which are UDP echo requests, the rest is ignored.
+ *
+ * \warning This function may be called only by Ethernet input thread, after the frame was successfully passed to the
+ * stack.
+ *
+ * \param [in] frame is a reference to received frame (including MAC header)
+ */
+
+void recordEthernetFrame(const pbuf& frame);
+
+/**
+ * \brief Records wakeup of Ethernet input thread.
+ *
+ * \warning This function may be called only by Ethernet input thread, right after it is woken by "Ethernet RX transfer
+ * completed" interrupt.
+ */
+
+void recordEthernetInputWakeup();
+
+/**
+ * \brief Records "Ethernet RX transfer completed" interrupt.
+ *
+ * Only the first interrupt since the last wakeup of Ethernet input thread is recorded.
+ *
+ * \warning This function may be called only from "Ethernet RX transfer completed" interrupt callback.
+ */
+
+void recordEthernetRxInterrupt();
+
+/**
+ * \brief Starts UDP echo responder on port 7.
+ *
+ * \warning lwIP core must be locked when this function is called.
+ */
+
+void startUdpEcho();
+
+#endif	// UDPECHO_HPP_